@@ -0,0 +1,456 @@
+//
+//  hpxbench.c
+//  HEALPix CLI
+//
+//  Created by Andrei Frolov on 2026-10-17.
+//
+
+#include <math.h>
+#include <time.h>
+#include <stdio.h>
+#include <limits.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <unistd.h>
+#include <sys/utsname.h>
+#include "rawmap.h"
+#include "ranking.h"
+
+// micro-benchmark of the C core conversion and ranking kernels on synthetic maps:
+// every kernel is timed at each resolution and thread count, reporting time per
+// pixel, nominal memory bandwidth (bytes read and written once) and speedup over
+// the first thread count tried, as a table and as JSON for tracking regressions
+
+// MARK: benchmark options
+static struct {
+    long nmin, nmax;                    // nside range
+    int threads[64], nthreads;          // thread counts to try
+    const char *filter;                 // comma separated kernel name substrings
+    const char *json;                   // JSON output path ("-" for stdout)
+    int repeats;                        // timed samples per measurement
+    double sample;                      // minimal duration of a sample (seconds)
+} options = { .nmin = 64, .nmax = 8192, .repeats = 5, .sample = 0.01 };
+
+// MARK: workspace
+// synthetic inputs of the current nside, regenerated when kernel input type changes
+
+struct workspace {
+    long nside, npix, nobs;             // resolution, and number of pixels in partial-sky inputs
+    char type;                          // type of generated inputs
+    void *data;                         // native values (npix of current type)
+    void *fits;                         // big-endian values in FITS table rows
+    void *pixels;                       // partial-sky pixel numbers (nobs of current type)
+    long *idx;                          // partial-sky NESTED pixel index (sorted)
+    long *reindexed;                    // output of reindex kernels
+    float *out;                         // converted map
+    float *map;                         // float map input of ranking kernels
+    float *ranked;                      // output of rank_map
+    void *index; long nindex;           // output of index_map (32 or 64 bit)
+};
+
+// FITS table layout of synthetic inputs
+#define FITS_REPEAT 1024
+
+// size of input element of given type
+static size_t sizeof_type(char type) {
+    switch (type) {
+        case 'f': return sizeof(float);
+        case 'd': return sizeof(double);
+        case 's': return sizeof(short);
+        case 'i': return sizeof(int);
+        case 'l': return sizeof(long);
+        case 'x': return sizeof(long long);
+        default:  return 0;
+    }
+}
+
+static const char *type_name(char type) {
+    switch (type) {
+        case 'f': return "float";
+        case 'd': return "double";
+        case 's': return "int16";
+        case 'i': return "int32";
+        case 'l': return "long";
+        case 'x': return "int64";
+        default:  return "none";
+    }
+}
+
+// deterministic pseudo-random stream (splitmix64)
+static inline uint64_t hash(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+// byte swap n elements of given size in place
+static void bswap(void *data, long n, size_t size) {
+    unsigned char *p = data;
+    
+    for (long i = 0; i < n; i++, p += size) for (size_t k = 0; k < size/2; k++) {
+        const unsigned char t = p[k]; p[k] = p[size-1-k]; p[size-1-k] = t;
+    }
+}
+
+// fill inputs with values of given type (with one in a hundred pixels missing)
+static void generate(struct workspace *w, char type) {
+    if (w->type == type) { return; }
+    
+    const long npix = w->npix;
+    
+    for (long i = 0; i < npix; i++) {
+        const uint64_t h = hash(i); const int bad = (h % 100 == 0);
+        const double v = (double)(h >> 11) * 0x1.0p-53 * 2.0 - 1.0;
+        
+        switch (type) {
+            case 'f': ((float *) w->data)[i] = bad ? BAD_DATA : (float) v; break;
+            case 'd': ((double *) w->data)[i] = bad ? BAD_DATA : v; break;
+            case 's': ((short *) w->data)[i] = (short)(h >> 48); break;
+            case 'i': ((int *) w->data)[i] = (int)(h >> 32); break;
+            case 'l': ((long *) w->data)[i] = (long)(h >> 8); break;
+            case 'x': ((long long *) w->data)[i] = (long long)(h >> 8); break;
+        }
+    }
+    
+    // big-endian copy, single column table
+    const size_t size = sizeof_type(type);
+    memcpy(w->fits, w->data, npix*size); bswap(w->fits, npix, size);
+    
+    // partial-sky pixel numbers, valid in both orderings
+    for (long i = 0; i < w->nobs; i++) {
+        const long p = w->idx[i];
+        
+        switch (type) {
+            case 's': ((short *) w->pixels)[i] = (short) p; break;
+            case 'i': ((int *) w->pixels)[i] = (int) p; break;
+            case 'l': ((long *) w->pixels)[i] = p; break;
+            case 'x': ((long long *) w->pixels)[i] = p; break;
+        }
+    }
+    
+    w->type = type;
+}
+
+static void free_workspace(struct workspace *w) {
+    free(w->data); free(w->fits); free(w->pixels); free(w->idx);
+    free(w->reindexed); free(w->out); free(w->map); free(w->ranked); free(w->index);
+    memset(w, 0, sizeof(*w));
+}
+
+// allocate workspace for given nside, returning 0 on success
+static int make_workspace(struct workspace *w, long nside) {
+    const long npix = 12*nside*nside, nobs = npix/4;
+    
+    memset(w, 0, sizeof(*w));
+    w->nside = nside; w->npix = npix; w->nobs = nobs; w->nindex = npix;
+    
+    w->data = malloc(npix*sizeof(double));
+    w->fits = malloc(npix*sizeof(double));
+    w->pixels = malloc(nobs*sizeof(long));
+    w->idx = malloc(nobs*sizeof(long));
+    w->reindexed = malloc(nobs*sizeof(long));
+    w->out = malloc(npix*sizeof(float));
+    w->map = malloc(npix*sizeof(float));
+    w->ranked = malloc(npix*sizeof(float));
+    w->index = malloc(npix*((npix > INT_MAX) ? sizeof(long) : sizeof(int)));
+    
+    if (!w->data || !w->fits || !w->pixels || !w->idx || !w->reindexed || !w->out || !w->map || !w->ranked || !w->index) { free_workspace(w); return -1; }
+    
+    // one pixel out of four, picked at random from each group of four
+    for (long i = 0; i < nobs; i++) { w->idx[i] = 4*i + (long)(hash(~i) & 3); }
+    
+    return 0;
+}
+
+// memory needed by workspace of given nside
+static double workspace_size(long nside) {
+    const double npix = 12.0*nside*nside;
+    return npix*(8.0 + 8.0 + 4.0 + 4.0 + 4.0 + 8.0) + 3.0*(npix/4)*8.0;
+}
+
+// MARK: kernels
+// uniform wrappers around kernels of each family
+
+enum family { RAW2MAP = 0, IDX2MAP, SEG2MAP, FITS2MAP, REINDEX, INDEX_MAP, RANK_MAP };
+static const char *families[] = { "raw2map", "idx2map", "seg2map", "fits2map", "reindex", "index_map", "rank_map" };
+
+struct kernel {
+    const char *name;
+    enum family family;
+    char type;                          // input type (0 for ranking kernels)
+    const char *ordering;               // input ordering or sorting backend
+    void (*run)(struct workspace *w);
+};
+
+// data bounds returned by conversion kernels
+static double vmin, vmax;
+
+#define RAW(name)  static void run_##name(struct workspace *w) { if (name(w->data, w->out, w->nside, &vmin, &vmax, NULL)) { fprintf(stderr, "hpxbench: " #name " failed\n"); } }
+#define IDX(name)  static void run_##name(struct workspace *w) { if (name(w->idx, w->data, w->out, w->nobs, &vmin, &vmax, NULL)) { fprintf(stderr, "hpxbench: " #name " failed\n"); } }
+#define SEG(name)  static void run_##name(struct workspace *w) { if (name(w->data, w->out, w->npix, &vmin, &vmax, NULL)) { fprintf(stderr, "hpxbench: " #name " failed\n"); } }
+#define FITS(name) static void run_##name(struct workspace *w) { if (name(w->fits, FITS_REPEAT, FITS_REPEAT*sizeof_type(w->type), w->out, w->nside, &vmin, &vmax, NULL)) { fprintf(stderr, "hpxbench: " #name " failed\n"); } }
+#define RIDX(name) static void run_##name(struct workspace *w) { if (name(w->pixels, w->reindexed, w->nobs, w->nside)) { fprintf(stderr, "hpxbench: " #name " failed\n"); } }
+
+#define TYPE(t) \
+    RAW(raw2map_##t##rp) RAW(raw2map_##t##rn) RAW(raw2map_##t##np) RAW(raw2map_##t##nn) \
+    IDX(idx2map_##t##p) IDX(idx2map_##t##n) SEG(seg2map_##t##p) SEG(seg2map_##t##n)
+
+TYPE(f) TYPE(d) TYPE(s) TYPE(i) TYPE(l) TYPE(x)
+
+#define FITS_TYPE(t) FITS(fits2map_##t##rp) FITS(fits2map_##t##rn) FITS(fits2map_##t##np) FITS(fits2map_##t##nn)
+
+FITS_TYPE(f) FITS_TYPE(d) FITS_TYPE(s) FITS_TYPE(i) FITS_TYPE(x)
+
+RIDX(reindex_sr) RIDX(reindex_sn) RIDX(reindex_ir) RIDX(reindex_in)
+RIDX(reindex_lr) RIDX(reindex_ln) RIDX(reindex_xr) RIDX(reindex_xn)
+
+// ranking kernels work on the float map, converted once per nside
+static void index_with(struct workspace *w, enum ranking_backend backend) {
+    ranking_backend(backend);
+    
+    if (w->npix > INT_MAX) { long nobs; index_map64(w->map, w->npix, w->index, &nobs); w->nindex = nobs; }
+    else { int nobs; index_map(w->map, (int) w->npix, w->index, &nobs); w->nindex = nobs; }
+    
+    ranking_backend(RANKING_AUTO);
+}
+
+static void run_index_map(struct workspace *w) { index_with(w, RANKING_AUTO); }
+static void run_quadsort(struct workspace *w) { index_with(w, RANKING_QUADSORT); }
+static void run_radixsort(struct workspace *w) { index_with(w, RANKING_RADIX); }
+
+static void run_rank_map(struct workspace *w) {
+    if (w->npix > INT_MAX) { rank_map64(w->map, w->index, w->nindex, w->ranked); }
+    else { rank_map(w->map, w->index, (int) w->nindex, w->ranked); }
+}
+
+#undef TYPE
+#undef FITS_TYPE
+
+#define K(family,name,t,ord) { #name, family, t, ord, run_##name }
+#define TYPE(t) \
+    K(RAW2MAP, raw2map_##t##rp, #t[0], "ring"), K(RAW2MAP, raw2map_##t##rn, #t[0], "ring"), \
+    K(RAW2MAP, raw2map_##t##np, #t[0], "nested"), K(RAW2MAP, raw2map_##t##nn, #t[0], "nested"), \
+    K(IDX2MAP, idx2map_##t##p, #t[0], "nested"), K(IDX2MAP, idx2map_##t##n, #t[0], "nested"), \
+    K(SEG2MAP, seg2map_##t##p, #t[0], "nested"), K(SEG2MAP, seg2map_##t##n, #t[0], "nested")
+#define FITS_TYPE(t) \
+    K(FITS2MAP, fits2map_##t##rp, #t[0], "ring"), K(FITS2MAP, fits2map_##t##rn, #t[0], "ring"), \
+    K(FITS2MAP, fits2map_##t##np, #t[0], "nested"), K(FITS2MAP, fits2map_##t##nn, #t[0], "nested")
+
+static const struct kernel kernels[] = {
+    TYPE(f), TYPE(d), TYPE(s), TYPE(i), TYPE(l), TYPE(x),
+    FITS_TYPE(f), FITS_TYPE(d), FITS_TYPE(s), FITS_TYPE(i), FITS_TYPE(x),
+    K(REINDEX, reindex_sr, 's', "ring"), K(REINDEX, reindex_sn, 's', "nested"),
+    K(REINDEX, reindex_ir, 'i', "ring"), K(REINDEX, reindex_in, 'i', "nested"),
+    K(REINDEX, reindex_lr, 'l', "ring"), K(REINDEX, reindex_ln, 'l', "nested"),
+    K(REINDEX, reindex_xr, 'x', "ring"), K(REINDEX, reindex_xn, 'x', "nested"),
+    K(INDEX_MAP, index_map, 0, "auto"), K(INDEX_MAP, quadsort, 0, "quadsort"), K(INDEX_MAP, radixsort, 0, "radix"),
+    K(RANK_MAP, rank_map, 0, "auto")
+};
+
+static const int nkernels = sizeof(kernels)/sizeof(struct kernel);
+
+#undef K
+#undef TYPE
+#undef FITS_TYPE
+
+// pixels processed and nominal bytes moved by a kernel call
+static void traffic(const struct kernel *k, const struct workspace *w, double *pixels, double *bytes) {
+    const double size = sizeof_type(k->type), npix = w->npix, nobs = w->nobs, nindex = w->nindex;
+    const double isize = (w->npix > INT_MAX) ? sizeof(long) : sizeof(int);
+    
+    *pixels = npix; *bytes = 0.0;
+    
+    switch (k->family) {
+        case RAW2MAP:
+        case SEG2MAP:
+        case FITS2MAP:  *pixels = npix; *bytes = npix*(size + sizeof(float)); break;
+        case IDX2MAP:   *pixels = nobs; *bytes = nobs*(sizeof(long) + size + sizeof(float)); break;
+        case REINDEX:   *pixels = nobs; *bytes = nobs*(size + sizeof(long)); break;
+        case INDEX_MAP: *pixels = npix; *bytes = npix*sizeof(float) + nindex*isize; break;
+        case RANK_MAP:  *pixels = nindex; *bytes = nindex*(isize + 2*sizeof(float)); break;
+    }
+}
+
+// kernel inputs are available at this resolution
+static int applicable(const struct kernel *k, const struct workspace *w) {
+    if (k->family == REINDEX && k->type == 's') { return w->npix-1 <= SHRT_MAX; }
+    return 1;
+}
+
+// kernel is selected by name filter
+static int selected(const struct kernel *k) {
+    if (!options.filter) { return 1; }
+    
+    char *list = strdup(options.filter), *state = NULL; int found = 0;
+    for (char *s = strtok_r(list, ",", &state); s && !found; s = strtok_r(NULL, ",", &state)) {
+        if (strstr(k->name, s) || strcmp(families[k->family], s) == 0) { found = 1; }
+    }
+    
+    free(list); return found;
+}
+
+// MARK: timing
+
+static double now(void) {
+    struct timespec t; clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + 1.0e-9*t.tv_nsec;
+}
+
+static int compare(const void *a, const void *b) {
+    const double x = *(const double *) a, y = *(const double *) b;
+    return (x > y) - (x < y);
+}
+
+// time kernel calls, returning best and median time per call
+static void measure(const struct kernel *k, struct workspace *w, double *best, double *median) {
+    double t = now(); k->run(w); t = now() - t;
+    
+    // calls per sample, so that short kernels are not dominated by timer resolution
+    const long calls = (t < options.sample) ? (long) ceil(options.sample/fmax(t, 1.0e-9)) : 1;
+    double samples[options.repeats];
+    
+    for (int r = 0; r < options.repeats; r++) {
+        const double start = now(); for (long c = 0; c < calls; c++) { k->run(w); }
+        samples[r] = (now() - start)/calls;
+    }
+    
+    qsort(samples, options.repeats, sizeof(double), compare);
+    *best = samples[0]; *median = samples[options.repeats/2];
+}
+
+// MARK: option parsing
+
+static void usage(FILE *out) {
+    fprintf(out,
+        "usage: hpxbench [options]\n"
+        "\n"
+        "Time map conversion and ranking kernels of HEALPix Viewer on synthetic maps.\n"
+        "\n"
+        "  -n, --nside MIN[,MAX]      range of map resolutions (powers of two) [64,8192]\n"
+        "  -j, --threads N[,N...]     thread counts to time [1,2,4,... up to CPU count]\n"
+        "  -k, --kernels NAME[,...]   kernels matching any of the names or families [all]\n"
+        "  -r, --repeats N            timed samples per measurement, median is reported [5]\n"
+        "  -o, --json PATH            write results as JSON (- for standard output)\n"
+        "  -h, --help                 print this message\n"
+        "\n"
+        "Resolutions that would not fit into 3/4 of physical memory are skipped.\n"
+    );
+}
+
+static void parse_options(int argc, char *argv[]) {
+    static const struct option longopts[] = {
+        { "nside",   required_argument, NULL, 'n' },
+        { "threads", required_argument, NULL, 'j' },
+        { "kernels", required_argument, NULL, 'k' },
+        { "repeats", required_argument, NULL, 'r' },
+        { "json",    required_argument, NULL, 'o' },
+        { "help",    no_argument,       NULL, 'h' },
+        { NULL, 0, NULL, 0 }
+    };
+    
+    int c; char *end = NULL;
+    
+    #define INVALID(what) { fprintf(stderr, "hpxbench: invalid %s '%s'\n", what, optarg); exit(1); }
+    
+    while ((c = getopt_long(argc, argv, "n:j:k:r:o:h", longopts, NULL)) != -1) {
+        switch (c) {
+            case 'n':
+                options.nmin = options.nmax = strtol(optarg, &end, 10);
+                if (*end == ',') { options.nmax = strtol(end+1, &end, 10); }
+                if (*end != 0 || options.nmin < 1 || options.nmax < options.nmin ||
+                    (options.nmin & (options.nmin-1)) || (options.nmax & (options.nmax-1))) INVALID("nside range"); break;
+            case 'j':
+                options.nthreads = 0; end = optarg;
+                do {
+                    const long n = strtol(end + (*end == ','), &end, 10);
+                    if (n < 1 || options.nthreads == 64) INVALID("thread counts");
+                    options.threads[options.nthreads++] = (int) n;
+                } while (*end == ',');
+                if (*end != 0) INVALID("thread counts"); break;
+            case 'k': options.filter = optarg; break;
+            case 'r': options.repeats = (int) strtol(optarg, &end, 10); if (*end != 0 || options.repeats < 1) INVALID("repeat count"); break;
+            case 'o': options.json = optarg; break;
+            case 'h': usage(stdout); exit(0);
+            default: usage(stderr); exit(1);
+        }
+    }
+    
+    #undef INVALID
+    
+    // powers of two up to CPU count, and CPU count itself
+    if (options.nthreads == 0) {
+        const int ncpu = (int) sysconf(_SC_NPROCESSORS_ONLN);
+        for (int n = 1; n < ncpu && options.nthreads < 63; n *= 2) { options.threads[options.nthreads++] = n; }
+        options.threads[options.nthreads++] = (ncpu > 0) ? ncpu : 1;
+    }
+}
+
+// MARK: benchmark
+
+int main(int argc, char *argv[]) {
+    parse_options(argc, argv);
+    
+    FILE *json = NULL;
+    if (options.json) { json = strcmp(options.json, "-") ? fopen(options.json, "w") : stdout; }
+    if (options.json && !json) { perror(options.json); return 1; }
+    
+    FILE *table = (json == stdout) ? stderr : stdout;
+    const double memory = (double) sysconf(_SC_PHYS_PAGES) * sysconf(_SC_PAGESIZE);
+    struct utsname host; uname(&host);
+    
+    if (json) {
+        fprintf(json, "{\n  \"machine\": { \"system\": \"%s\", \"release\": \"%s\", \"arch\": \"%s\", \"cpus\": %ld, \"memory\": %.0f },\n",
+                host.sysname, host.release, host.machine, sysconf(_SC_NPROCESSORS_ONLN), memory);
+        fprintf(json, "  \"repeats\": %d,\n  \"results\": [", options.repeats);
+    }
+        
+    fprintf(table, "%-18s %-7s %6s %7s %12s %10s %8s\n", "kernel", "type", "nside", "threads", "ns/pixel", "GB/s", "speedup");
+        
+    int first = 1;
+        
+    for (long nside = options.nmin; nside <= options.nmax; nside *= 2) {
+        struct workspace w;
+            
+        if (workspace_size(nside) > 0.75*memory || make_workspace(&w, nside)) {
+            fprintf(stderr, "hpxbench: skipping nside = %ld (not enough memory)\n", nside); continue;
+        }
+            
+        // float map for ranking kernels (with index for rank_map)
+        generate(&w, 'f'); if (raw2map_fnp(w.data, w.map, nside, &vmin, &vmax, NULL)) { fprintf(stderr, "hpxbench: raw2map_fnp failed\n"); } index_with(&w, RANKING_AUTO);
+            
+        for (int i = 0; i < nkernels; i++) {
+            const struct kernel *k = &kernels[i]; double single = 0.0;     // time at first thread count
+            if (!selected(k) || !applicable(k, &w)) { continue; }
+                
+            if (k->type) { generate(&w, k->type); }
+                
+            for (int j = 0; j < options.nthreads; j++) {
+                const int threads = options.threads[j]; double best, median, pixels, bytes;
+                rawmap_threads(threads); ranking_threads(threads);
+                    
+                measure(k, &w, &best, &median); traffic(k, &w, &pixels, &bytes);
+                if (j == 0) { single = median; }
+                    
+                const double ns = 1.0e9*median/pixels, gbs = 1.0e-9*bytes/median, speedup = single/median;
+                fprintf(table, "%-18s %-7s %6ld %7d %12.3f %10.2f %8.2f\n", k->name, k->type ? type_name(k->type) : "float", nside, threads, ns, gbs, speedup);
+                    
+                if (json) {
+                    fprintf(json, "%s\n    { \"kernel\": \"%s\", \"family\": \"%s\", \"type\": \"%s\", \"ordering\": \"%s\", \"nside\": %ld, \"pixels\": %.0f, \"threads\": %d, "
+                            "\"time\": { \"min\": %.9g, \"median\": %.9g }, \"ns_per_pixel\": %.6g, \"gb_per_s\": %.6g, \"speedup\": %.4g }",
+                            first ? "" : ",", k->name, families[k->family], k->type ? type_name(k->type) : "float", k->ordering,
+                            nside, pixels, threads, best, median, ns, gbs, speedup);
+                    first = 0;
+                }
+            }
+        }
+            
+        free_workspace(&w);
+    }
+        
+    if (json) { fprintf(json, "\n  ]\n}\n"); if (json != stdout) { fclose(json); } }
+    
+    return 0;
+}
@@ -0,0 +1,147 @@
+//
+//  hpxfile.c
+//  HEALPix CLI
+//
+//  Created by Andrei Frolov on 2026-10-17.
+//
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fitsio.h>
+#include "hpxfile.h"
+#include "rawmap.h"
+#include "trace.h"
+
+// HEALPix FITS reader without Swift dependencies, following read_hpxfile in FitsIO.swift
+// (table is read through CFITSIO type conversion, and then brought to canonical form
+// by the same conversion primitives that the app uses)
+
+// report CFITSIO error
+static int fits_error(const char *file, int status) {
+    char text[FLEN_STATUS]; ffgerr(status, text);
+    fprintf(stderr, "%s: %s\n", file, text); return -1;
+}
+
+// read string card, falling back to default value if absent
+static void read_string(fitsfile *fptr, const char *key, const char *fallback, char value[FLEN_VALUE]) {
+    int status = 0; ffgkys(fptr, key, value, NULL, &status);
+    if (status) { snprintf(value, FLEN_VALUE, "%s", fallback); }
+}
+
+// read integer card, falling back to default value if absent
+static long read_long(fitsfile *fptr, const char *key, long fallback) {
+    long value = 0; int status = 0; ffgkyj(fptr, key, &value, NULL, &status);
+    return status ? fallback : value;
+}
+
+// map types with sign flipped in IAU polarization convention
+static int polarization_u(const char *type) {
+    static const char *names[] = { "Polarization U", "U_POLARISATION", "U_STOKES", "U" };
+    for (size_t i = 0; i < sizeof(names)/sizeof(*names); i++) { if (strcmp(type, names[i]) == 0) return 1; }
+    return 0;
+}
+
+int read_hpxmap(const char *file, const char *column, struct hpxmap *map) {
+    fitsfile *fptr = NULL; int hdu = 0, status = 0, result = -1;
+    float *data = NULL; long *raw = NULL, *idx = NULL;
+    char order[FLEN_VALUE], indexing[FLEN_VALUE], object[FLEN_VALUE], polconv[FLEN_VALUE], type[FLEN_VALUE], key[FLEN_KEYWORD];
+    
+    memset(map, 0, sizeof(struct hpxmap));
+    
+    // open FITS file and move to first table HDU (should be BINARY_TBL)
+    long trace = trace_begin("open and parse header");
+    fftopn(&fptr, file, READONLY, &status);
+    if (status) { return fits_error(file, status); }
+    
+    ffghdt(fptr, &hdu, &status);
+    if (status || hdu != BINARY_TBL) { fprintf(stderr, "%s: not a HEALPix binary table\n", file); goto cleanup; }
+    
+    // parse HEALPix header
+    read_string(fptr, "ORDERING", "", order);
+    read_string(fptr, "OBJECT", "IMPLICIT", object);
+    read_string(fptr, "INDXSCHM", object, indexing);
+    read_string(fptr, "POLCCONV", "COSMO", polconv);
+    
+    const long nside = read_long(fptr, "NSIDE", 0), nmaps = read_long(fptr, "TFIELDS", 0), nrows = read_long(fptr, "NAXIS2", 0);
+    int polar = 0; status = 0; ffgkyl(fptr, "POLAR", &polar, NULL, &status); status = 0;
+    
+    const int nested = (strcmp(order, "NESTED") == 0), ring = (strcmp(order, "RING") == 0);
+    const int indexed = (strcmp(indexing, "EXPLICIT") == 0 || strcmp(indexing, "PARTIAL") == 0);
+    const int fullsky = (strcmp(indexing, "IMPLICIT") == 0 || strcmp(indexing, "FULLSKY") == 0);
+    
+    if (nside <= 0 || nmaps <= indexed || nrows <= 0 || !(nested || ring) || !(indexed || fullsky)) {
+        fprintf(stderr, "%s: unsupported HEALPix table (nside = %ld, %s ordering, %s indexing)\n", file, nside, order, indexing); goto cleanup;
+    }
+    
+    // find map column (first column of indexed map is pixel index)
+    char *end = NULL; long m = strtol(column ? column : "1", &end, 10); int col = 0;
+    
+    if (end && *end == 0) {
+        col = (int)(m + indexed); if (m < 1 || col > nmaps) { fprintf(stderr, "%s: no map %ld in file\n", file, m); goto cleanup; }
+    } else {
+        ffgcno(fptr, CASEINSEN, (char *)column, &col, &status);
+        if (status) { fprintf(stderr, "%s: no map named '%s' in file\n", file, column); goto cleanup; }
+    }
+    
+    snprintf(key, sizeof(key), "TTYPE%d", col); read_string(fptr, key, "", type);
+    const int flip = polar && strcmp(polconv, "IAU") == 0 && polarization_u(type);
+    trace_end(trace, 0);
+    
+    strncpy(map->name, type, sizeof(map->name)-1);
+    map->nside = nside; map->npix = 12*nside*nside;
+    map->data = malloc(map->npix*sizeof(float));
+    if (!map->data) { fprintf(stderr, "%s: out of memory\n", file); goto cleanup; }
+    
+    if (fullsky) {
+        // full sky map (without pixel index)
+        data = malloc(map->npix*sizeof(float));
+        if (!data) { fprintf(stderr, "%s: out of memory\n", file); goto cleanup; }
+        
+        trace = trace_begin("read column");
+        ffgcv(fptr, TFLOAT, col, 1, 1, map->npix, NULL, data, NULL, &status);
+        if (status) { fits_error(file, status); goto cleanup; }
+        trace_end(trace, map->npix*sizeof(float));
+        
+        trace = trace_begin("raw2map");
+        if ((ring ? (flip ? raw2map_frn : raw2map_frp) : (flip ? raw2map_fnn : raw2map_fnp))(data, map->data, nside, &map->min, &map->max, NULL)) {
+            fprintf(stderr, "%s: out of memory\n", file); goto cleanup;
+        }
+        trace_end(trace, map->npix*sizeof(float));
+    } else {
+        // indexed sky map (first column contains pixel index)
+        const long nobs = read_long(fptr, "OBS_NPIX", nrows);
+        
+        data = malloc(nobs*sizeof(float)); raw = malloc(nobs*sizeof(long)); idx = malloc(nobs*sizeof(long));
+        if (!data || !raw || !idx) { fprintf(stderr, "%s: out of memory\n", file); goto cleanup; }
+        
+        trace = trace_begin("read column");
+        ffgcv(fptr, TLONG, 1, 1, 1, nobs, NULL, raw, NULL, &status);
+        ffgcv(fptr, TFLOAT, col, 1, 1, nobs, NULL, data, NULL, &status);
+        if (status) { fits_error(file, status); goto cleanup; }
+        trace_end(trace, nobs*(sizeof(long)+sizeof(float)));
+        
+        trace = trace_begin("reindex");
+        if ((ring ? reindex_lr : reindex_ln)(raw, idx, nobs, nside)) { fprintf(stderr, "%s: invalid pixel index\n", file); goto cleanup; }
+        trace_end(trace, nobs*sizeof(long));
+        
+        trace = trace_begin("idx2map");
+        for (long i = 0; i < map->npix; i++) { map->data[i] = NAN; }
+        if ((flip ? idx2map_fn : idx2map_fp)(idx, data, map->data, nobs, &map->min, &map->max, NULL)) { fprintf(stderr, "%s: out of memory\n", file); goto cleanup; }
+        trace_end(trace, nobs*sizeof(float));
+    }
+    
+    result = 0;
+    
+cleanup:
+    free(data); free(raw); free(idx);
+    if (result) { free_hpxmap(map); }
+    status = 0; ffclos(fptr, &status);
+    
+    return result;
+}
+
+void free_hpxmap(struct hpxmap *map) {
+    free(map->data); map->data = NULL;
+}
@@ -0,0 +1,27 @@
+//
+//  hpxfile.h
+//  HEALPix CLI
+//
+//  Created by Andrei Frolov on 2026-10-17.
+//
+
+#ifndef hpxfile_h
+#define hpxfile_h
+
+// HEALPix map in canonical format (NESTED single precision, NaN for missing pixels)
+struct hpxmap {
+    long nside, npix;
+    float *data;
+    double min, max;
+    char name[72];
+};
+
+// read map from the first binary table HDU of a HEALPix FITS file; map is selected
+// by its number (counting from 1, not including pixel index of partial-sky maps)
+// or by its TTYPE name; returns 0 on success, printing diagnostics on failure
+int read_hpxmap(const char *file, const char *column, struct hpxmap *map);
+
+// free map data
+void free_hpxmap(struct hpxmap *map);
+
+#endif /* hpxfile_h */
@@ -0,0 +1,431 @@
+//
+//  hpxrender.c
+//  HEALPix CLI
+//
+//  Created by Andrei Frolov on 2026-10-17.
+//
+
+#include <math.h>
+#include <ctype.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <getopt.h>
+#include <libgen.h>
+#include <sys/stat.h>
+#include "hpxfile.h"
+#include "image.h"
+#include "rawmap.h"
+#include "ranking.h"
+#include "pyramid.h"
+#include "project.h"
+#include "palettes.h"
+#include "colorize.h"
+#include "trace.h"
+
+// headless renderer producing the same images as the app's export, without Metal or a GPU:
+// maps are converted by the C core, transformed, projected and colorized on CPU
+
+// MARK: data transforms (as Function enum in the app)
+enum transform { NONE = 0, LOG, ASINH, ATAN, TANH, POWER, EXP, EQUALIZE, NORMALIZE, TRANSFORMS };
+static const char *transforms[TRANSFORMS] = { "none", "log", "asinh", "atan", "tanh", "power", "exp", "equalize", "normalize" };
+
+// MARK: bounds modifiers (as BoundsModifier enum in the app)
+enum bounds { FULL = 0, SYMMETRIC, POSITIVE, NEGATIVE, BOUNDS };
+static const char *bounds[BOUNDS] = { "full", "symmetric", "positive", "negative" };
+
+// MARK: interpolation and antialiasing (as AntiAliasing enum in the app)
+static const char *interpolations[] = { "nearest", "bilinear" };
+static const char *antialiasings[] = { "none", "less", "more" };
+
+// MARK: output formats
+enum format { PNG8 = 0, PNG16, EXR, FORMATS };
+static const char *formats[FORMATS] = { "png", "png16", "exr" };
+static const char *extensions[FORMATS] = { ".png", ".png", ".exr" };
+static const enum colorize_format pixels[FORMATS] = { COLORIZE_RGBA8, COLORIZE_RGBA16, COLORIZE_HALF };
+
+// rendering options
+static struct {
+    const char *column, *output;
+    enum projection projection;
+    long width, height;
+    double lat, lon, az, padding;
+    int outside, threads;
+    enum interpolation interpolation;
+    enum antialiasing antialiasing;
+    enum transform transform; double mu, sigma;
+    enum bounds bounds; int range; double min, max;
+    const struct palette *palette;
+    float colors[4][4];                 // below, above, nan, and background colors
+    int custom[2];                      // below and above colors set explicitly (colormap end colors otherwise)
+    enum format format; int explicit;
+    const char *trace;                  // Chrome trace file (tracing is off if NULL)
+} options = {
+    .projection = PROJECT_MOLLWEIDE, .width = 1920, .antialiasing = ANTIALIAS_MORE,
+    .palette = &palettes[0],
+    .colors = { {0}, {0}, {0.5,0.5,0.5,1.0}, {0,0,0,0} }
+};
+
+// MARK: option parsing
+
+// look name up in a list (case insensitive, unique prefix allowed)
+static int lookup(const char *name, const char **list, int count) {
+    int found = -1; const size_t n = strlen(name);
+    
+    for (int i = 0; i < count; i++) {
+        if (strcasecmp(name, list[i]) == 0) { return i; }
+        if (strncasecmp(name, list[i], n) == 0) { found = (found < 0) ? i : -2; }
+    }
+    
+    return (found >= 0) ? found : -1;
+}
+
+// parse color as #RRGGBB or #RRGGBBAA hex string
+static int parse_color(const char *s, float *c) {
+    unsigned int v[4] = { 0, 0, 0, 255 }; if (*s == '#') { s++; }
+    const size_t n = strlen(s); if (n != 6 && n != 8) { return -1; }
+    
+    for (size_t i = 0; i < n/2; i++) {
+        char hex[3] = { s[2*i], s[2*i+1], 0 }, *end = NULL;
+        if (!isxdigit(hex[0]) || !isxdigit(hex[1])) { return -1; }
+        v[i] = (unsigned int) strtoul(hex, &end, 16);
+    }
+    
+    for (int i = 0; i < 4; i++) { c[i] = v[i]/255.0f; }
+    return 0;
+}
+
+// parse comma-separated list of doubles
+static int parse_list(const char *s, double *x, int n) {
+    for (int i = 0; i < n; i++) {
+        char *end = NULL; x[i] = strtod(s, &end);
+        if (end == s || (i < n-1 && *end != ',') || (i == n-1 && *end != 0)) { return -1; }
+        s = end+1;
+    }
+    
+    return 0;
+}
+
+static void usage(FILE *out) {
+    fprintf(out,
+        "usage: hpxrender [options] map.fits [...]\n"
+        "\n"
+        "Render HEALPix maps to images without a GPU, the same way HEALPix Viewer exports them.\n"
+        "\n"
+        "  -o, --output PATH          output image (or directory, if rendering several maps)\n"
+        "  -f, --format FORMAT        png (8 bit), png16 or exr (half float); guessed from output name\n"
+        "  -c, --column MAP           map number (counting from 1) or TTYPE name [1]\n"
+        "  -p, --projection NAME      mollweide, aitoff, hammer, lambert, equidistant, orthographic,\n"
+        "                             stereographic, gnomonic, mercator, cartesian, werner [mollweide]\n"
+        "  -s, --size WIDTH[xHEIGHT]  image size, height fitted to projection if omitted [1920]\n"
+        "  -v, --view LAT,LON[,AZ]    view center and azimuth, in degrees [0,0,0]\n"
+        "  -O, --outside              view sphere from outside (flipping the image horizontally)\n"
+        "  -P, --padding FRACTION     padding around projection [0]\n"
+        "  -i, --interpolation NAME   nearest, bilinear [nearest]\n"
+        "  -a, --antialiasing NAME    none, less, more (downsampling map to image resolution) [more]\n"
+        "  -t, --transform NAME       none, log, asinh, atan, tanh, power, exp, equalize, normalize [none]\n"
+        "  -m, --mu VALUE             transform offset [0]\n"
+        "  -S, --sigma VALUE          transform scale, as log of the scale [0]\n"
+        "  -b, --bounds NAME          full, symmetric, positive, negative [full]\n"
+        "  -r, --range MIN,MAX        color range (after transform), overriding bounds\n"
+        "  -C, --colormap NAME        Planck, Faded, Spectral, HEALPix, Seismic, Difference, Frequency,\n"
+        "                             Greyscale, Hot, Cold, Lime, Viridis, BGRY, GRV [Planck]\n"
+        "      --below COLOR          color of values below range [first colormap entry]\n"
+        "      --above COLOR          color of values above range [last colormap entry]\n"
+        "      --nan COLOR            color of missing values [#808080]\n"
+        "      --background COLOR     color outside of projection [#00000000]\n"
+        "  -j, --threads N            number of threads (0 = one per CPU core) [0]\n"
+        "  -T, --trace FILE           write Chrome trace of loading and rendering stages to FILE,\n"
+        "                             printing stage summary of each map to stderr\n"
+        "  -h, --help                 print this message\n"
+        "\n"
+        "Colors are given as #RRGGBB or #RRGGBBAA.\n"
+    );
+}
+
+static void parse_options(int argc, char *argv[]) {
+    static const struct option longopts[] = {
+        { "output",        required_argument, NULL, 'o' },
+        { "format",        required_argument, NULL, 'f' },
+        { "column",        required_argument, NULL, 'c' },
+        { "projection",    required_argument, NULL, 'p' },
+        { "size",          required_argument, NULL, 's' },
+        { "view",          required_argument, NULL, 'v' },
+        { "outside",       no_argument,       NULL, 'O' },
+        { "padding",       required_argument, NULL, 'P' },
+        { "interpolation", required_argument, NULL, 'i' },
+        { "antialiasing",  required_argument, NULL, 'a' },
+        { "transform",     required_argument, NULL, 't' },
+        { "mu",            required_argument, NULL, 'm' },
+        { "sigma",         required_argument, NULL, 'S' },
+        { "bounds",        required_argument, NULL, 'b' },
+        { "range",         required_argument, NULL, 'r' },
+        { "colormap",      required_argument, NULL, 'C' },
+        { "below",         required_argument, NULL, 1 },
+        { "above",         required_argument, NULL, 2 },
+        { "nan",           required_argument, NULL, 3 },
+        { "background",    required_argument, NULL, 4 },
+        { "threads",       required_argument, NULL, 'j' },
+        { "trace",         required_argument, NULL, 'T' },
+        { "help",          no_argument,       NULL, 'h' },
+        { NULL, 0, NULL, 0 }
+    };
+    
+    const char *projections[PROJECTIONS]; for (int i = 0; i < PROJECTIONS; i++) { projections[i] = projection_name(i); }
+    int c, k; double x[3]; char *end = NULL;
+    
+    #define INVALID(what) { fprintf(stderr, "hpxrender: invalid %s '%s'\n", what, optarg); exit(1); }
+    
+    while ((c = getopt_long(argc, argv, "o:f:c:p:s:v:OP:i:a:t:m:S:b:r:C:j:T:h", longopts, NULL)) != -1) {
+        switch (c) {
+            case 'o': options.output = optarg; break;
+            case 'f': if ((k = lookup(optarg, formats, FORMATS)) < 0) INVALID("format"); options.format = k; options.explicit = 1; break;
+            case 'c': options.column = optarg; break;
+            case 'p': if ((k = lookup(optarg, projections, PROJECTIONS)) < 0) INVALID("projection"); options.projection = k; break;
+            case 's':
+                options.width = strtol(optarg, &end, 10); options.height = 0;
+                if (*end == 'x') { options.height = strtol(end+1, &end, 10); if (options.height <= 0) INVALID("size"); }
+                if (*end != 0 || options.width <= 0) INVALID("size"); break;
+            case 'v':
+                x[2] = 0.0; if (parse_list(optarg, x, 3) && parse_list(optarg, x, 2)) INVALID("view");
+                options.lat = x[0]; options.lon = x[1]; options.az = x[2]; break;
+            case 'O': options.outside = 1; break;
+            case 'P': if (parse_list(optarg, &options.padding, 1) || options.padding < 0.0) INVALID("padding"); break;
+            case 'i': if ((k = lookup(optarg, interpolations, 2)) < 0) INVALID("interpolation"); options.interpolation = k; break;
+            case 'a': if ((k = lookup(optarg, antialiasings, 3)) < 0) INVALID("antialiasing"); options.antialiasing = k; break;
+            case 't': if ((k = lookup(optarg, transforms, TRANSFORMS)) < 0) INVALID("transform"); options.transform = k; break;
+            case 'm': if (parse_list(optarg, &options.mu, 1)) INVALID("mu"); break;
+            case 'S': if (parse_list(optarg, &options.sigma, 1)) INVALID("sigma"); break;
+            case 'b': if ((k = lookup(optarg, bounds, BOUNDS)) < 0) INVALID("bounds"); options.bounds = k; break;
+            case 'r':
+                if (parse_list(optarg, x, 2) || !(x[0] < x[1])) INVALID("range");
+                options.range = 1; options.min = x[0]; options.max = x[1]; break;
+            case 'C': if (!(options.palette = find_palette(optarg))) INVALID("colormap"); break;
+            case 1: case 2: case 3: case 4:
+                if (parse_color(optarg, options.colors[c-1])) INVALID("color");
+                if (c < 3) { options.custom[c-1] = 1; } break;
+            case 'j': options.threads = (int) strtol(optarg, &end, 10); if (*end != 0 || options.threads < 0) INVALID("thread count"); break;
+            case 'T': options.trace = optarg; break;
+            case 'h': usage(stdout); exit(0);
+            default: usage(stderr); exit(1);
+        }
+    }
+    
+    #undef INVALID
+    
+    // output format guessed from output name, unless given explicitly
+    if (!options.explicit && options.output) {
+        const char *ext = strrchr(options.output, '.');
+        if (ext && strcasecmp(ext, ".exr") == 0) { options.format = EXR; }
+    }
+    
+    // image height fitted to projection extent
+    if (options.height == 0) {
+        double ex, ey; projection_extent(options.projection, &ex, &ey);
+        options.height = lround(options.width*ey/ex); if (options.height < 1) { options.height = 1; }
+    }
+}
+
+// MARK: map transforms
+
+// erfinv from Mike Giles (as in Transforms.metal)
+static float erfinv(float x) {
+    float w = -logf((1.0f-x)*(1.0f+x)), p;
+    
+    if (w < 5.0f) {
+        w = w - 2.5f;
+        p =  2.81022636e-08f;
+        p =  3.43273939e-07f + p*w;
+        p = -3.5233877e-06f  + p*w;
+        p = -4.39150654e-06f + p*w;
+        p =  0.00021858087f  + p*w;
+        p = -0.00125372503f  + p*w;
+        p = -0.00417768164f  + p*w;
+        p =  0.246640727f    + p*w;
+        p =  1.50140941f     + p*w;
+    } else {
+        w = sqrtf(w) - 3.0f;
+        p = -0.000200214257f;
+        p =  0.000100950558f + p*w;
+        p =  0.00134934322f  + p*w;
+        p = -0.00367342844f  + p*w;
+        p =  0.00573950773f  + p*w;
+        p = -0.0076224613f   + p*w;
+        p =  0.00943887047f  + p*w;
+        p =  1.00167406f     + p*w;
+        p =  2.83297682f     + p*w;
+    }
+    
+    return p*x;
+}
+
+// rank map values, replacing them with their CDF
+static int rank(struct hpxmap *map) {
+    float *ranked = malloc(map->npix*sizeof(float)); int status = -1;
+    if (!ranked) { return -1; }
+    
+    for (long i = 0; i < map->npix; i++) { ranked[i] = NAN; }
+    
+    if (map->npix <= INT32_MAX) {
+        int *idx = malloc(map->npix*sizeof(int)), nobs = 0;
+        if (idx) { index_map(map->data, (int) map->npix, idx, &nobs); rank_map(map->data, idx, nobs, ranked); status = 0; }
+        free(idx);
+    } else {
+        long *idx = malloc(map->npix*sizeof(long)), nobs = 0;
+        if (idx) { index_map64(map->data, map->npix, idx, &nobs); rank_map64(map->data, idx, nobs, ranked); status = 0; }
+        free(idx);
+    }
+    
+    if (status) { free(ranked); } else { free(map->data); map->data = ranked; }
+    return status;
+}
+
+// apply transform to map values in place
+static int transform(struct hpxmap *map, enum transform f, double mu, double sigma) {
+    float *x = map->data; const long npix = map->npix;
+    
+    switch (f) {
+        case NONE:      return 0;
+        case EQUALIZE:  if (rank(map)) { return -1; } break;
+        case NORMALIZE: if (rank(map)) { return -1; } x = map->data;
+                        for (long i = 0; i < npix; i++) { x[i] = M_SQRT2 * erfinv(2.0f*x[i]-1.0f); } break;
+        default:        if (f >= TRANSFORMS) { return -1; }
+                        colorize_transform((enum colorize_function) f, mu, sigma, x, x, npix); break;
+    }
+    
+    // transformed value bounds
+    x = map->data; map->min = INFINITY; map->max = -INFINITY;
+    for (long i = 0; i < npix; i++) { if (isfinite(x[i])) { map->min = fmin(map->min, x[i]); map->max = fmax(map->max, x[i]); } }
+    if (map->min > map->max) { map->min = map->max = 0.0; }
+    
+    return 0;
+}
+
+// MARK: rendering
+
+// map degraded by 2^lod (pyramid levels above it are built along the way and discarded)
+static float *degrade(const struct hpxmap *map, int lod) {
+    float *levels[32] = { NULL }, *out = NULL; double min[32], max[32]; int n = 0, ok = 1;
+    while ((map->nside >> (n+1)) > 0 && n < 32) { n++; }
+    
+    for (int k = 0; k < n; k++) { const long nside = map->nside >> (k+1); if (!(levels[k] = malloc(12*nside*nside*sizeof(float)))) { ok = 0; } }
+    if (ok && pyramid_build(map->data, map->nside, levels, min, max) == 0) { out = levels[lod-1]; levels[lod-1] = NULL; }
+    
+    for (int k = 0; k < n; k++) { free(levels[k]); }
+    return out;
+}
+
+// output path for an input file (in output directory, if rendering several maps)
+static char *output_path(const char *input, int several) {
+    const char *ext = extensions[options.format];
+    
+    if (options.output && !several) { return strdup(options.output); }
+    
+    char *copy = strdup(input), *name = basename(copy), *dot = strrchr(name, '.');
+    if (dot && (strcasecmp(dot, ".fits") == 0 || strcasecmp(dot, ".fit") == 0 || strcasecmp(dot, ".fts") == 0)) { *dot = 0; }
+    
+    const char *dir = options.output ? options.output : ".";
+    const size_t n = strlen(dir) + strlen(name) + strlen(ext) + 2;
+    char *path = malloc(n); snprintf(path, n, "%s/%s%s", dir, name, ext);
+    
+    free(copy); return path;
+}
+
+static int render(const char *input, const char *output) {
+    struct hpxmap map; float transform_matrix[6], rotation[9];
+    const long width = options.width, height = options.height, npix = width*height;
+    float *image = NULL, *level = NULL; void *rgba = NULL; unsigned char *inside = NULL; int status = -1;
+    colorize_lut *lut = NULL; struct stat st;
+    
+    // whole rendering is traced, with stage summary reported at the end
+    const char *file = strrchr(input, '/'); char name[64]; snprintf(name, sizeof(name), "render %s", file ? file+1 : input);
+    const long trace = trace_begin(name); long stage = -1;
+    
+    if (read_hpxmap(input, options.column, &map)) { trace_end(trace, 0); return -1; }
+    
+    stage = trace_begin("transform");
+    if (transform(&map, options.transform, options.mu, options.sigma)) { fprintf(stderr, "%s: out of memory\n", input); goto cleanup; }
+    trace_end(stage, map.npix*sizeof(float));
+    
+    // color range, with bounds modifier applied (as in RangeView)
+    double min = map.min, max = map.max;
+    
+    switch (options.bounds) {
+        case SYMMETRIC: { const double a = fmax(fabs(min), fabs(max)); min = -a; max = a; } break;
+        case POSITIVE:  min = 0.0; break;
+        case NEGATIVE:  max = 0.0; break;
+        default: break;
+    }
+    
+    if (options.range) { min = options.min; max = options.max; }
+    
+    // project and colorize map
+    const enum colorize_format format = pixels[options.format];
+    image = malloc(npix*sizeof(float)); inside = malloc(npix); rgba = malloc(4*npix*((format == COLORIZE_RGBA8) ? sizeof(uint8_t) : sizeof(uint16_t)));
+    lut = make_colorize_lut(options.palette, options.custom[0] ? options.colors[0] : NULL, options.custom[1] ? options.colors[1] : NULL, options.colors[2], options.colors[3]);
+    if (!image || !inside || !rgba || !lut) { fprintf(stderr, "%s: out of memory\n", input); goto cleanup; }
+    
+    project_transform(options.projection, width, height, options.padding, !options.outside, transform_matrix);
+    project_rotation(options.lat, options.lon, options.az, rotation);
+    
+    // map degraded to image resolution, if antialiasing calls for it
+    const int lod = project_lod(options.projection, transform_matrix, map.nside, options.antialiasing);
+    stage = trace_begin("degrade");
+    if (lod > 0 && !(level = degrade(&map, lod))) { fprintf(stderr, "%s: out of memory\n", input); goto cleanup; }
+    trace_end(stage, (lod > 0) ? map.npix*sizeof(float) : 0);
+    
+    stage = trace_begin("project");
+    project_map(level ? level : map.data, map.nside >> lod, options.projection, options.interpolation, transform_matrix, rotation, image, inside, width, height);
+    trace_end(stage, npix*(sizeof(float)+1));
+    
+    stage = trace_begin("colorize");
+    colorize(lut, image, inside, npix, COLORIZE_NONE, 0.0, 0.0, min, max, format, rgba);
+    trace_end(stage, npix*sizeof(float));
+    
+    stage = trace_begin("write");
+    switch (options.format) {
+        case PNG8:  status = write_png(output, rgba, width, height, 8); break;
+        case PNG16: status = write_png(output, rgba, width, height, 16); break;
+        case EXR:   status = write_exr(output, rgba, width, height); break;
+        default: break;
+    }
+    
+    trace_end(stage, (!status && !stat(output, &st)) ? st.st_size : 0);
+    
+    if (status) { fprintf(stderr, "%s: %s\n", output, strerror(errno)); }
+    else { printf("%s (%s, nside = %ld, range [%g,%g]) -> %s\n", input, map.name, map.nside, min, max, output); }
+    
+cleanup:
+    free_hpxmap(&map); free(image); free(inside); free(rgba); free(level); free_colorize_lut(lut);
+    trace_end(trace, stat(input, &st) ? 0 : st.st_size); trace_summary(stderr, trace);
+    
+    return status;
+}
+
+int main(int argc, char *argv[]) {
+    parse_options(argc, argv);
+    if (optind >= argc) { usage(stderr); return 1; }
+    
+    // several maps are rendered into output directory
+    const int several = (argc - optind > 1); struct stat st;
+    if (several && options.output && (stat(options.output, &st) || !S_ISDIR(st.st_mode))) {
+        fprintf(stderr, "hpxrender: output '%s' must be a directory when rendering several maps\n", options.output); return 1;
+    }
+    
+    rawmap_threads(options.threads); ranking_threads(options.threads); pyramid_threads(options.threads); project_threads(options.threads); colorize_threads(options.threads);
+    
+    int failed = 0; trace_enable(options.trace != NULL);
+    
+    for (int i = optind; i < argc; i++) {
+        char *output = output_path(argv[i], several);
+        if (render(argv[i], output)) { failed++; }
+        free(output);
+    }
+    
+    if (options.trace && trace_write_json(options.trace)) { fprintf(stderr, "%s: %s\n", options.trace, strerror(errno)); failed++; }
+    
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,141 @@
+//
+//  image.c
+//  HEALPix CLI
+//
+//  Created by Andrei Frolov on 2026-10-17.
+//
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zlib.h>
+#include "image.h"
+
+// minimal image writers, so that headless renderer depends on nothing but zlib
+
+// MARK: byte order helpers
+static void put16(unsigned char *p, uint32_t x) { p[0] = x; p[1] = x >> 8; }
+static void put32(unsigned char *p, uint32_t x) { p[0] = x; p[1] = x >> 8; p[2] = x >> 16; p[3] = x >> 24; }
+static void put64(unsigned char *p, uint64_t x) { put32(p, (uint32_t) x); put32(p+4, (uint32_t)(x >> 32)); }
+static void be32(unsigned char *p, uint32_t x) { p[0] = x >> 24; p[1] = x >> 16; p[2] = x >> 8; p[3] = x; }
+
+// MARK: PNG writer
+
+// write PNG chunk
+static int chunk(FILE *file, const char *type, const unsigned char *data, uint32_t length) {
+    unsigned char head[8], tail[4]; be32(head, length); memcpy(head+4, type, 4);
+    uLong crc = crc32(crc32(0, NULL, 0), head+4, 4); if (length) { crc = crc32(crc, data, length); } be32(tail, (uint32_t) crc);
+    
+    return (fwrite(head, 8, 1, file) == 1 && (length == 0 || fwrite(data, length, 1, file) == 1) && fwrite(tail, 4, 1, file) == 1) ? 0 : -1;
+}
+
+int write_png(const char *path, const void *rgba, long width, long height, int depth) {
+    static const unsigned char signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    const long bpp = (depth == 16) ? 8 : 4, stride = width*bpp + 1;
+    if (width <= 0 || height <= 0 || width > INT32_MAX || height > INT32_MAX || (depth != 8 && depth != 16)) { errno = EINVAL; return -1; }
+    
+    FILE *file = fopen(path, "wb"); if (!file) { return -1; }
+    unsigned char *row = malloc(2*stride), *out = malloc(1<<16); z_stream z = {0}; int status = -1;
+    if (!row || !out || deflateInit(&z, Z_DEFAULT_COMPRESSION) != Z_OK) { errno = ENOMEM; goto cleanup; }
+    
+    // header (sRGB color space, perceptual intent)
+    unsigned char ihdr[13] = { 0 }, srgb[1] = { 0 };
+    be32(ihdr, (uint32_t) width); be32(ihdr+4, (uint32_t) height); ihdr[8] = depth; ihdr[9] = 6;
+    if (fwrite(signature, 8, 1, file) != 1 || chunk(file, "IHDR", ihdr, 13) || chunk(file, "sRGB", srgb, 1)) { goto cleanup; }
+    
+    // image rows, with sub filter applied
+    for (long j = 0; j < height; j++) {
+        unsigned char *raw = row + stride, *filtered = row;
+        
+        if (depth == 16) { const uint16_t *p = (const uint16_t *) rgba + 4*j*width; for (long i = 0; i < 4*width; i++) { raw[2*i] = p[i] >> 8; raw[2*i+1] = p[i]; } }
+        else { memcpy(raw, (const unsigned char *) rgba + 4*j*width, 4*width); }
+        
+        filtered[0] = 1; for (long i = 0; i < stride-1; i++) { filtered[i+1] = raw[i] - ((i >= bpp) ? raw[i-bpp] : 0); }
+        
+        z.next_in = filtered; z.avail_in = (uInt) stride;
+        do {
+            z.next_out = out; z.avail_out = 1<<16;
+            deflate(&z, (j == height-1) ? Z_FINISH : Z_NO_FLUSH);
+            if (z.avail_out < 1<<16 && chunk(file, "IDAT", out, (1<<16) - z.avail_out)) { goto cleanup; }
+        } while (z.avail_out == 0);
+    }
+    
+    status = chunk(file, "IEND", NULL, 0);
+    
+cleanup:
+    deflateEnd(&z); free(row); free(out);
+    if (fclose(file)) { status = -1; }
+    
+    return status;
+}
+
+// MARK: OpenEXR writer
+
+// append header attribute
+static unsigned char *attribute(unsigned char *p, const char *name, const char *type, const void *value, uint32_t size) {
+    const size_t n = strlen(name)+1, t = strlen(type)+1;
+    memcpy(p, name, n); memcpy(p+n, type, t); put32(p+n+t, size); memcpy(p+n+t+4, value, size);
+    return p+n+t+4+size;
+}
+
+int write_exr(const char *path, const uint16_t *rgba, long width, long height) {
+    if (width <= 0 || height <= 0 || width > INT32_MAX/8 || height > INT32_MAX) { errno = EINVAL; return -1; }
+    
+    FILE *file = fopen(path, "wb"); if (!file) { return -1; }
+    const long size = 8*width; unsigned char header[512], *p = header, *line = malloc(size + 8); int status = -1;
+    if (!line) { errno = ENOMEM; goto cleanup; }
+    
+    // magic number and version (single part scanline image)
+    put32(p, 20000630); put32(p+4, 2); p += 8;
+    
+    // channels, in alphabetical order
+    unsigned char channels[73] = { 0 }, *c = channels;
+    for (const char *name = "ABGR"; *name; name++) { c[0] = *name; put32(c+2, 1); put32(c+10, 1); put32(c+14, 1); c += 18; }
+    
+    unsigned char window[16], flt[4], center[8] = { 0 }, zero = 0; const float one = 1.0f;
+    put32(window, 0); put32(window+4, 0); put32(window+8, (uint32_t)(width-1)); put32(window+12, (uint32_t)(height-1));
+    memcpy(flt, &one, 4);
+    
+    p = attribute(p, "channels", "chlist", channels, sizeof(channels));
+    p = attribute(p, "compression", "compression", &zero, 1);
+    p = attribute(p, "dataWindow", "box2i", window, 16);
+    p = attribute(p, "displayWindow", "box2i", window, 16);
+    p = attribute(p, "lineOrder", "lineOrder", &zero, 1);
+    p = attribute(p, "pixelAspectRatio", "float", flt, 4);
+    p = attribute(p, "screenWindowCenter", "v2f", center, 8);
+    p = attribute(p, "screenWindowWidth", "float", flt, 4);
+    *p++ = 0;
+    
+    if (fwrite(header, p-header, 1, file) != 1) { goto cleanup; }
+    
+    // scanline offset table
+    const uint64_t start = (p-header) + 8*height;
+    for (long j = 0; j < height; j++) {
+        unsigned char offset[8]; put64(offset, start + j*(size+8));
+        if (fwrite(offset, 8, 1, file) != 1) { goto cleanup; }
+    }
+    
+    // scanlines (channels stored one after another)
+    for (long j = 0; j < height; j++) {
+        const uint16_t *q = rgba + 4*j*width; put32(line, (uint32_t) j); put32(line+4, (uint32_t) size);
+        
+        for (long i = 0; i < width; i++) {
+            put16(line + 8 + 2*i, q[4*i+3]);
+            put16(line + 8 + 2*(width+i), q[4*i+2]);
+            put16(line + 8 + 2*(2*width+i), q[4*i+1]);
+            put16(line + 8 + 2*(3*width+i), q[4*i]);
+        }
+        
+        if (fwrite(line, size+8, 1, file) != 1) { goto cleanup; }
+    }
+    
+    status = 0;
+    
+cleanup:
+    free(line);
+    if (fclose(file)) { status = -1; }
+    
+    return status;
+}
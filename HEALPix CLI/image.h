@@ -0,0 +1,23 @@
+//
+//  image.h
+//  HEALPix CLI
+//
+//  Created by Andrei Frolov on 2026-10-17.
+//
+
+#ifndef image_h
+#define image_h
+
+#include <stdint.h>
+
+// RGBA images are passed as interleaved components in colorization output
+// formats (see colorize.h), with rows stored from top to bottom; writers
+// return 0 on success and -1 on failure (with errno set)
+
+// PNG image from 8 or 16 bit sRGB components with straight alpha
+int write_png(const char *file, const void *rgba, long width, long height, int depth);
+
+// OpenEXR image (uncompressed scanlines) from linear half float components with premultiplied alpha
+int write_exr(const char *file, const uint16_t *rgba, long width, long height);
+
+#endif /* image_h */
@@ -0,0 +1,7 @@
+//
+//  Use this file to import your target's public headers that you would like to expose to Swift.
+//
+
+#include "../HEALPix Viewer/Map Data/Bridging Header.h"
+#include "../HEALPix Viewer/Map Data/project.h"
+#include "../HEALPix Viewer/Colormaps/colorize.h"
@@ -0,0 +1,128 @@
+//
+//  Colorize Tests.swift
+//  HEALPix Viewer Tests
+//
+//  Created by Andrei Frolov on 2026-10-17.
+//
+
+import XCTest
+import MetalKit
+@testable import HEALPix_Viewer
+
+final class Colorize_Tests: XCTestCase {
+    let nside = 64
+    
+    // transforms on GPU and their CPU counterparts
+    let transforms: [(Function, colorize_function)] = [
+        (.log, COLORIZE_LOG), (.asinh, COLORIZE_ASINH), (.atan, COLORIZE_ATAN),
+        (.tanh, COLORIZE_TANH), (.power, COLORIZE_POWER), (.exp, COLORIZE_EXP)
+    ]
+    
+    override func setUpWithError() throws {
+        // Put setup code here. This method is called before the invocation of each test method in the class.
+    }
+    
+    override func tearDownWithError() throws {
+        // Put teardown code here. This method is called after the invocation of each test method in the class.
+    }
+    
+    // test map values, with NaN and infinite pixels sprinkled in
+    func values(_ npix: Int) -> [Float] {
+        (0..<npix).map { p in
+            switch p % 101 {
+                case 0: return .nan
+                case 1: return .infinity
+                case 2: return -.infinity
+                default: return Float(sin(Double(p)*0.003) * 150.0)
+            }
+        }
+    }
+    
+    // test map in canonical format
+    func map(_ data: [Float]) -> CpuMap {
+        let buffer = UnsafeMutablePointer<Float>.allocate(capacity: data.count); buffer.initialize(from: data, count: data.count)
+        return CpuMap(nside: nside, buffer: buffer, min: -150.0, max: 150.0)
+    }
+    
+    // wait for commands queued so far to complete
+    func finish() throws {
+        let command = try XCTUnwrap(metal.queue.makeCommandBuffer())
+        command.commit(); command.waitUntilCompleted()
+    }
+    
+    // straight alpha components of a color
+    func rgba(_ color: Color) -> [Float] {
+        let c = color.components.demultiply; return [c.x, c.y, c.z, c.w]
+    }
+    
+    // NESTED pixel of texel (x,y) of face f
+    func pixel(_ x: Int, _ y: Int, _ f: Int) -> Int {
+        var p = 0; for b in 0..<nside.trailingZeroBitCount { p |= ((x >> b) & 1) << (2*b) | ((y >> b) & 1) << (2*b+1) }
+        return f*nside*nside + p
+    }
+    
+    func test_transform() throws {
+        let npix = 12*nside*nside, data = values(npix), transformer = DataTransformer()
+        
+        for (f, c) in transforms {
+            let transform = Transform(f: f, mu: -20.0, sigma: 0.5)
+            let gpu = try XCTUnwrap(transformer.apply(map: map(data), transform: transform)); try finish()
+            var cpu = [Float](repeating: 0.0, count: npix), bad = 0
+            
+            colorize_transform(c, transform.mu, transform.sigma, data, &cpu, npix)
+            
+            // NaN and infinities (e.g. log of values below mu) have to come out the same
+            for p in 0..<npix {
+                let x = gpu.ptr[p], y = cpu[p]
+                if (x.isNaN || y.isNaN) { if (x.isNaN != y.isNaN) { bad += 1 }; continue }
+                if (x.isInfinite || y.isInfinite) { if (x != y) { bad += 1 }; continue }
+                if (abs(x-y) > 1.0e-4*Swift.max(abs(x), 1.0)) { bad += 1 }
+            }
+            
+            XCTAssertEqual(bad, 0, "\(f)")
+        }
+    }
+    
+    func test_colorize() throws {
+        let npix = 12*nside*nside, data = values(npix), transformer = DataTransformer(), mapper = ColorMapper()
+        let palette = Palette(), scheme = try XCTUnwrap(find_palette(palette.scheme.rawValue))
+        let lut = try XCTUnwrap(make_colorize_lut(scheme, rgba(palette.min), rgba(palette.max), rgba(palette.nan), rgba(palette.bg)))
+        defer { free_colorize_lut(lut) }
+        
+        // texture faces read back into shared buffer
+        let texture = HPXTexture(nside: nside, format: .rgba32Float, mipmapped: false)
+        let row = nside*MemoryLayout<SIMD4<Float>>.size, face = nside*row
+        let readback = try XCTUnwrap(metal.device.makeBuffer(length: 12*face, options: .storageModeShared))
+        let texels = readback.contents().bindMemory(to: SIMD4<Float>.self, capacity: npix)
+        
+        // plain data, and data transformed with values below mu (NaN after log transform)
+        for (f, c, range) in [(Function.none, COLORIZE_NONE, Bounds(min: -100.0, max: 100.0)), (.log, COLORIZE_LOG, Bounds(min: 0.0, max: 5.0)), (.asinh, COLORIZE_ASINH, Bounds(min: -3.0, max: 3.0))] {
+            let transform = Transform(f: f, mu: -20.0, sigma: 0.5), source = map(data)
+            var input: Map = source; if (f != .none) { input = try XCTUnwrap(transformer.apply(map: source, transform: transform)) }
+            
+            mapper.colorize(map: input, color: palette, range: range, output: texture)
+            
+            let command = try XCTUnwrap(metal.queue.makeCommandBuffer()), blit = try XCTUnwrap(command.makeBlitCommandEncoder())
+            
+            for z in 0..<12 {
+                blit.copy(from: texture, sourceSlice: z, sourceLevel: 0, sourceOrigin: MTLOrigin(x: 0, y: 0, z: 0), sourceSize: MTLSize(width: nside, height: nside, depth: 1),
+                          to: readback, destinationOffset: z*face, destinationBytesPerRow: row, destinationBytesPerImage: face)
+            }
+            
+            blit.endEncoding(); command.commit(); command.waitUntilCompleted()
+            
+            // CPU colorization of the same data (GPU texture holds premultiplied components)
+            var cpu = [UInt16](repeating: 0, count: 4*npix), worst: Float = 0.0, missing = 0
+            colorize(lut, data, nil, npix, c, transform.mu, transform.sigma, range.min, range.max, COLORIZE_RGBA16, &cpu)
+            
+            for z in 0..<12 { for y in 0..<nside { for x in 0..<nside {
+                let p = pixel(x, y, z), texel = texels[(z*nside + y)*nside + x], gpu = texel.demultiply
+                for k in 0..<4 { worst = Swift.max(worst, abs(gpu[k] - Float(cpu[4*p+k])/65535.0)) }
+                if (data[p].isNaN && texel != palette.nan.components) { missing += 1 }
+            } } }
+            
+            XCTAssertLessThan(worst, 1.0/255.0, "\(f)")
+            XCTAssertEqual(missing, 0, "\(f)")
+        }
+    }
+}
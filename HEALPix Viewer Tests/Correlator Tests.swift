@@ -0,0 +1,153 @@
+//
+//  Correlator Tests.swift
+//  HEALPix Viewer Tests
+//
+//  Created by Andrei Frolov on 2026-10-17.
+//
+
+import XCTest
+@testable import HEALPix_Viewer
+
+final class Correlator_Tests: XCTestCase {
+    let nside = 256
+    
+    override func setUpWithError() throws {
+        // Put setup code here. This method is called before the invocation of each test method in the class.
+    }
+    
+    override func tearDownWithError() throws {
+        correlate_threads(0)
+    }
+    
+    // three correlated test channels, with NaN and infinite pixels sprinkled in
+    func value(_ c: Int, _ p: Int) -> Float {
+        let x = 100.0*sin(Double(p)*1.0e-3) + 3.0
+        
+        switch c {
+            case 0:  return (p % 101 == 0) ? .nan : Float(x)
+            case 1:  return (p % 211 == 0) ? .infinity : Float(0.5*x + 20.0*cos(Double(p)*7.0e-4))
+            default: return Float(p % 1000)/10.0 - 50.0
+        }
+    }
+    
+    func channels(_ npix: Int) -> [[Float]] { (0..<3).map { c in (0..<npix).map { value(c, $0) } } }
+    
+    // two-pass reference: mean over pixels within bounds (compared in single precision), then centered products
+    func reference(_ maps: [[Float]], lo: [Double], hi: [Double]) -> (avg: [Double], cov: [Double], count: Int) {
+        let n = maps.count, npix = maps[0].count
+        let used = (0..<npix).filter { p in (0..<n).allSatisfy { maps[$0][p] >= Float(lo[$0]) && maps[$0][p] <= Float(hi[$0]) } }
+        var avg = [Double](repeating: 0.0, count: n), cov = [Double](repeating: 0.0, count: n*n)
+        
+        for p in used { for i in 0..<n { avg[i] += Double(maps[i][p]) } }
+        avg = avg.map { $0/Double(used.count) }
+        
+        for p in used { for i in 0..<n { for j in 0..<n { cov[i*n+j] += (Double(maps[i][p])-avg[i])*(Double(maps[j][p])-avg[j]) } } }
+        cov = cov.map { $0/Double(used.count) }
+        
+        return (avg, cov, used.count)
+    }
+    
+    // largest deviation of mean and covariance from reference, in units of standard deviations of channels
+    func deviation(_ avg: [Double], _ cov: [Double], from ref: (avg: [Double], cov: [Double], count: Int)) -> (avg: Double, cov: Double) {
+        let n = ref.avg.count, sigma = (0..<n).map { sqrt(ref.cov[$0*n+$0]) }
+        var da = 0.0, dc = 0.0
+        
+        for i in 0..<n {
+            da = Swift.max(da, abs(avg[i] - ref.avg[i])/sigma[i])
+            for j in 0..<n { dc = Swift.max(dc, abs(cov[i*n+j] - ref.cov[i*n+j])/(sigma[i]*sigma[j])) }
+        }
+        
+        return (da, dc)
+    }
+    
+    // correlate maps with specified bounds
+    func correlate(_ maps: [[Float]], lo: [Double], hi: [Double], stride: Int = 1, seed: UInt = 0) -> (avg: [Double], cov: [Double], count: Int) {
+        let n = maps.count; var avg = [Double](repeating: .nan, count: n), cov = [Double](repeating: .nan, count: n*n), count = 0
+        
+        maps[0].withUnsafeBufferPointer { x in maps[1].withUnsafeBufferPointer { y in maps[2].withUnsafeBufferPointer { z in
+            let ptrs: [UnsafePointer<Float>?] = [x.baseAddress, y.baseAddress, z.baseAddress]
+            XCTAssertEqual(correlate_maps(ptrs, Int32(n), x.count, lo, hi, stride, seed, &avg, &cov, &count), 0)
+        } } }
+        
+        return (avg, cov, count)
+    }
+    
+    func test_reference() throws {
+        let maps = channels(12*nside*nside), lo = [-1.0e30, -1.0e30, -40.0], hi = [1.0e30, 1.0e30, 40.0]
+        let ref = reference(maps, lo: lo, hi: hi), result = correlate(maps, lo: lo, hi: hi)
+        
+        XCTAssertEqual(result.count, ref.count)
+        
+        let error = deviation(result.avg, result.cov, from: ref)
+        XCTAssertLessThan(error.avg, 1.0e-12); XCTAssertLessThan(error.cov, 1.0e-12)
+        
+        // covariance matrix is symmetric
+        for i in 0..<3 { for j in 0..<3 { XCTAssertEqual(result.cov[i*3+j], result.cov[j*3+i]) } }
+    }
+    
+    func test_stride() throws {
+        let maps = channels(12*nside*nside), lo = [-1.0e30, -1.0e30, -40.0], hi = [1.0e30, 1.0e30, 40.0]
+        let ref = reference(maps, lo: lo, hi: hi)
+        
+        // one pixel out of each run of stride pixels, giving estimates well within a percent of sigma
+        for stride in [4, 16, 64] {
+            let result = correlate(maps, lo: lo, hi: hi, stride: stride), error = deviation(result.avg, result.cov, from: ref)
+            XCTAssertEqual(Double(result.count), Double(ref.count)/Double(stride), accuracy: 0.01*Double(ref.count)/Double(stride))
+            XCTAssertLessThan(error.avg, 0.01, "stride \(stride)"); XCTAssertLessThan(error.cov, 0.01, "stride \(stride)")
+            
+            // subsample is fixed by seed
+            let again = correlate(maps, lo: lo, hi: hi, stride: stride), other = correlate(maps, lo: lo, hi: hi, stride: stride, seed: 1)
+            XCTAssertEqual(again.avg, result.avg); XCTAssertEqual(again.cov, result.cov)
+            XCTAssertNotEqual(other.avg, result.avg)
+        }
+    }
+    
+    func test_threads() throws {
+        let maps = channels(12*nside*nside), lo = [-1.0e30, -1.0e30, -40.0], hi = [1.0e30, 1.0e30, 40.0]
+        
+        // order of merges is fixed, so results are bitwise identical
+        correlate_threads(1); let serial = correlate(maps, lo: lo, hi: hi)
+        correlate_threads(4); let parallel = correlate(maps, lo: lo, hi: hi)
+        
+        XCTAssertEqual(serial.count, parallel.count)
+        XCTAssertEqual(serial.avg, parallel.avg); XCTAssertEqual(serial.cov, parallel.cov)
+    }
+    
+    func test_sparse() throws {
+        let npix = 12*nside*nside
+        let idx = Array(5000..<25000) + Array(7*npix/12+1234..<7*npix/12+9234), nobs = idx.count
+        let layout = try XCTUnwrap(SparseLayout(nside: nside, idx: idx, nobs: nobs))
+        var pos = [Int](repeating: -1, count: nobs); sparse_pack(layout.ptr, idx, &pos, nobs)
+        
+        // sparse maps sharing layout, and full sky maps holding the same data
+        var full = [[Float]](), sparse = [Map](), dense = [Map]()
+        
+        for c in 0..<3 {
+            var data = [Float](repeating: .nan, count: npix); for p in idx { data[p] = value(c, p) }
+            let finite = data.filter { $0.isFinite }, min = Double(finite.min()!), max = Double(finite.max()!)
+            
+            let store = UnsafeMutablePointer<Float>.allocate(capacity: layout.size); store.initialize(repeating: .nan, count: layout.size)
+            for (p, q) in zip(idx, pos) { store[q] = data[p] }
+            let buffer = UnsafeMutablePointer<Float>.allocate(capacity: npix); buffer.initialize(from: data, count: npix)
+            
+            full.append(data)
+            sparse.append(SparseMap(nside: nside, layout: layout, buffer: store, min: min, max: max))
+            dense.append(CpuMap(nside: nside, buffer: buffer, min: min, max: max))
+        }
+        
+        // sparse maps are correlated over stored tiles, without being expanded
+        let pixels = try XCTUnwrap(Correlator.pixels(sparse))
+        XCTAssertEqual(pixels.npix, layout.size); XCTAssertLessThan(layout.size, npix/4)
+        XCTAssertEqual(pixels.data, sparse.map { ($0 as? SparseMap)?.store })
+        
+        let ref = reference(full, lo: sparse.map { $0.min }, hi: sparse.map { $0.max })
+        let a = try XCTUnwrap(Correlator().covariance(sparse)), b = try XCTUnwrap(Correlator().covariance(dense))
+        
+        XCTAssertEqual(a.count, ref.count); XCTAssertEqual(b.count, ref.count)
+        
+        for result in [a, b] {
+            let error = deviation(result.avg, result.cov, from: ref)
+            XCTAssertLessThan(error.avg, 1.0e-12); XCTAssertLessThan(error.cov, 1.0e-12)
+        }
+    }
+}
@@ -0,0 +1,105 @@
+//
+//  FitsIO Tests.swift
+//  HEALPix Viewer Tests
+//
+//  Created by Andrei Frolov on 2026-10-17.
+//
+
+import CFitsIO
+import XCTest
+@testable import HEALPix_Viewer
+
+final class FitsIO_Tests: XCTestCase {
+    let nside = 64, repeats = 1024
+    var cache: String? = nil
+    
+    override func setUpWithError() throws {
+        // converted map cache would bypass the loaders being tested
+        cache = UserDefaults.standard.string(forKey: CacheSize.key)
+        UserDefaults.standard.set(CacheSize.none.rawValue, forKey: CacheSize.key)
+    }
+    
+    override func tearDownWithError() throws {
+        if let cache = cache { UserDefaults.standard.set(cache, forKey: CacheSize.key) }
+        else { UserDefaults.standard.removeObject(forKey: CacheSize.key) }
+    }
+    
+    // test map values in file order, with a few pixels marked as bad
+    func values(_ npix: Int, _ m: Int) -> [Double] {
+        (0..<npix).map { p in (p % 997 == m) ? Double(BAD_DATA) : sin(Double(p)*0.01 + Double(m)) * 1.0e3 }
+    }
+    
+    // write full sky map with one float and one double column, packed Planck-style into rows of 1024 pixels
+    func write(_ file: URL, order: String) throws -> [[Double]] {
+        let npix = 12*nside*nside, nrows = npix/repeats
+        let data = [values(npix, 0), values(npix, 1)]
+        var fptr: UnsafeMutablePointer<fitsfile>? = nil, status: Int32 = 0
+        
+        var ttype = ["TEMPERATURE", "Q_POLARISATION"].map { strdup($0) }
+        var tform = ["\(repeats)E", "\(repeats)D"].map { strdup($0) }
+        var tunit = ["K", "K"].map { strdup($0) }
+        defer { for s in ttype + tform + tunit { free(s) } }
+        
+        ffinit(&fptr, "!" + file.path, &status)
+        ffcrtb(fptr, BINARY_TBL, Int64(nrows), 2, &ttype, &tform, &tunit, "xtension", &status)
+        ffpkys(fptr, "PIXTYPE", "HEALPIX", nil, &status)
+        ffpkys(fptr, "ORDERING", order, nil, &status)
+        ffpkyj(fptr, "NSIDE", Int64(nside), nil, &status)
+        ffpkys(fptr, "INDXSCHM", "IMPLICIT", nil, &status)
+        ffpkye(fptr, "BAD_DATA", BAD_DATA, 8, nil, &status)
+        
+        var single = data[0].map { Float($0) }, double = data[1]
+        ffpcle(fptr, 1, 1, 1, Int64(npix), &single, &status)
+        ffpcld(fptr, 2, 1, 1, Int64(npix), &double, &status)
+        ffclos(fptr, &status)
+        
+        XCTAssertEqual(status, 0); return data
+    }
+    
+    // compare loaded map against file data (canonical maps are NESTED, bad pixels are NaN)
+    func check(_ map: Map, _ data: [Double], order: String) -> Int {
+        var bad = 0, q = 0
+        
+        for p in 0..<map.npix {
+            if (order == "RING") { nest2ring(nside, p, &q) } else { q = p }
+            let x = Float(data[q]), y = map.ptr[p]
+            
+            if (x == BAD_DATA) { if (!y.isNaN) { bad += 1 } } else if (x != y) { bad += 1 }
+        }
+        
+        return bad
+    }
+    
+    func test_loaders() throws {
+        let file = FileManager.default.temporaryDirectory.appendingPathComponent("fitsio-test.fits")
+        defer { try? FileManager.default.removeItem(at: file) }
+        
+        for order in ["RING", "NESTED"] {
+            let data = try write(file, order: order)
+            
+            // memory-mapped table, CFITSIO reading the whole table, and CFITSIO streaming it in chunks
+            for (mapping, streaming) in [(true, false), (false, false), (false, true)] {
+                let hpx = try XCTUnwrap(read_hpxfile(url: file, mapping: mapping, streaming: streaming))
+                XCTAssertEqual(hpx.nmaps, 2)
+                
+                for m in 0..<2 {
+                    XCTAssertEqual(hpx[m].nside, nside)
+                    XCTAssertEqual(check(hpx[m], data[m], order: order), 0, "\(order) map \(m), mapping \(mapping), streaming \(streaming)")
+                }
+            }
+        }
+    }
+    
+    func test_truncated() throws {
+        let file = FileManager.default.temporaryDirectory.appendingPathComponent("fitsio-truncated.fits")
+        defer { try? FileManager.default.removeItem(at: file) }
+        
+        // header is intact, but data section is cut short
+        _ = try write(file, order: "NESTED")
+        let size = try XCTUnwrap(FileManager.default.attributesOfItem(atPath: file.path)[.size] as? Int)
+        XCTAssertEqual(truncate(file.path, off_t(size/2)), 0)
+        
+        XCTAssertNil(read_hpxfile(url: file, mapping: true, streaming: false))
+        XCTAssertNil(read_hpxfile(url: file, mapping: true, streaming: true))
+    }
+}
@@ -0,0 +1,119 @@
+//
+//  Harmonics Tests.swift
+//  HEALPix Viewer Tests
+//
+//  Created by Andrei Frolov on 2026-10-17.
+//
+
+import CFitsIO
+import XCTest
+
+final class Harmonics_Tests: XCTestCase {
+    let nside = 32
+    let lmax = 8
+    
+    override func setUpWithError() throws {
+        // Put setup code here. This method is called before the invocation of each test method in the class.
+    }
+    
+    override func tearDownWithError() throws {
+        // Put teardown code here. This method is called after the invocation of each test method in the class.
+    }
+    
+    // coefficients a_10 = 1, a_11 = 1, a_22 = i (up to lmax), and the map they describe
+    func coefficients() -> [Double] {
+        var alm = [Double](repeating: 0.0, count: 2*sht_alm_size(Int32(lmax), Int32(lmax)))
+        
+        alm[2*sht_alm_index(Int32(lmax), 1, 0)] = 1.0
+        alm[2*sht_alm_index(Int32(lmax), 1, 1)] = 1.0
+        alm[2*sht_alm_index(Int32(lmax), 2, 2)+1] = 1.0
+        
+        return alm
+    }
+    
+    func harmonics(_ theta: Double, _ phi: Double) -> Double {
+        let y10 = sqrt(3.0/(4.0*Double.pi))*cos(theta)
+        let y11 = -sqrt(3.0/(8.0*Double.pi))*sin(theta)*cos(phi)
+        let y22 = -0.25*sqrt(15.0/(2.0*Double.pi))*sin(theta)*sin(theta)*sin(2.0*phi)
+        
+        // a_l,-m terms double real parts of m > 0 terms
+        return y10 + 2.0*y11 + 2.0*y22
+    }
+    
+    func test_index() throws {
+        for lmax in [0, 1, 7, 64] { for mmax in [0, lmax/2, lmax] {
+            var k = 0, bad = 0
+            
+            // coefficients are laid out by m, then by l, without gaps
+            for m in 0...mmax { for l in m...lmax {
+                if (sht_alm_index(Int32(lmax), Int32(l), Int32(m)) != k) { bad += 1 }; k += 1
+            } }
+            
+            XCTAssertEqual(bad, 0); XCTAssertEqual(k, sht_alm_size(Int32(lmax), Int32(mmax)))
+        } }
+    }
+    
+    func test_synthesis() throws {
+        let npix = 12*nside*nside, alm = coefficients()
+        var map = [Float](repeating: .nan, count: npix), minval = 0.0, maxval = 0.0, theta = 0.0, phi = 0.0, worst = 0.0
+        
+        XCTAssertEqual(sht_alm2map(alm, Int32(lmax), Int32(lmax), &map, nside, &minval, &maxval), 0)
+        
+        for p in 0..<npix {
+            pix2ang_nest(nside, p, &theta, &phi)
+            worst = Swift.max(worst, abs(Double(map[p]) - harmonics(theta, phi)))
+        }
+        
+        XCTAssertLessThan(worst, 1.0e-6)
+        XCTAssertEqual(minval, Double(map.min()!)); XCTAssertEqual(maxval, Double(map.max()!))
+    }
+    
+    func test_analysis() throws {
+        let npix = 12*nside*nside, alm = coefficients()
+        var map = [Float](repeating: 0.0, count: npix), theta = 0.0, phi = 0.0
+        
+        for p in 0..<npix { pix2ang_nest(nside, p, &theta, &phi); map[p] = Float(harmonics(theta, phi)) }
+        
+        // single precision map sampled at pixel centers, well within band limit
+        var out = [Double](repeating: .nan, count: alm.count)
+        XCTAssertEqual(sht_map2alm(map, nside, Int32(lmax), Int32(lmax), 3, &out), 0)
+        
+        for k in 0..<alm.count { XCTAssertEqual(out[k], alm[k], accuracy: 1.0e-6, "a_lm component \(k)") }
+    }
+    
+    func test_round_trip() throws {
+        let npix = 12*nside*nside, lmax = 2*nside, size = sht_alm_size(Int32(lmax), Int32(lmax))
+        var alm = [Double](repeating: 0.0, count: 2*size), map = [Float](repeating: 0.0, count: npix), minval = 0.0, maxval = 0.0
+        
+        // coefficients of order unity at all scales, with real a_l0
+        for m in 0...lmax { for l in m...lmax {
+            let k = 2*sht_alm_index(Int32(lmax), Int32(l), Int32(m))
+            alm[k] = sin(Double(l)*1.3 + Double(m)*0.7); alm[k+1] = (m > 0) ? cos(Double(l)*0.9 - Double(m)*1.1) : 0.0
+        } }
+        
+        XCTAssertEqual(sht_alm2map(alm, Int32(lmax), Int32(lmax), &map, nside, &minval, &maxval), 0)
+        
+        // Jacobi iterations converge to single precision of the map for lmax <= 2*nside
+        let norm = sqrt(alm.reduce(0.0) { $0 + $1*$1 }); var last = Double.infinity
+        
+        for iterations in 0...3 {
+            var out = [Double](repeating: .nan, count: 2*size)
+            XCTAssertEqual(sht_map2alm(map, nside, Int32(lmax), Int32(lmax), Int32(iterations), &out), 0)
+            
+            let error = sqrt(zip(out, alm).reduce(0.0) { $0 + ($1.0-$1.1)*($1.0-$1.1) })/norm
+            XCTAssertLessThan(error, last/4.0, "\(iterations) iterations"); last = error
+        }
+        
+        XCTAssertLessThan(last, 2.0e-6)
+    }
+    
+    func test_missing() throws {
+        let npix = 12*nside*nside, fl = [Double](repeating: 1.0, count: lmax+1)
+        let map = [Float](repeating: .nan, count: npix); var out = [Float](repeating: 0.0, count: npix), minval = 1.0, maxval = -1.0
+        
+        // map with no data stays missing, with bounds reported as zero like in other kernels
+        XCTAssertEqual(sht_filter(map, nside, Int32(lmax), 3, fl, &out, &minval, &maxval), 0)
+        XCTAssertEqual(out.filter { !$0.isNaN }.count, 0)
+        XCTAssertEqual(minval, 0.0); XCTAssertEqual(maxval, 0.0)
+    }
+}
@@ -0,0 +1,59 @@
+//
+//  Line Convolution Tests.swift
+//  HEALPix Viewer Tests
+//
+//  Created by Andrei Frolov on 2026-10-17.
+//
+
+import CFitsIO
+import XCTest
+
+final class LineConvolution_Tests: XCTestCase {
+    let nside = 256
+    
+    override func setUpWithError() throws {
+        // Put setup code here. This method is called before the invocation of each test method in the class.
+    }
+    
+    override func tearDownWithError() throws {
+        lic_threads(0)
+    }
+    
+    // convolve noise along uniform vector field (x,y) in (e_theta, e_phi) basis
+    func convolve(x: Float, y: Float, noise: [Float]? = nil, length: Double = 0.2) -> (out: [Float], min: Double, max: Double) {
+        let npix = 12*nside*nside, a = [Float](repeating: x, count: npix), b = [Float](repeating: y, count: npix)
+        var out = [Float](repeating: .nan, count: npix), minval = 0.0, maxval = 0.0
+        
+        let status = noise.map { lic_convolve(a, b, $0, nside, LIC_VECTOR, length, 0, &out, &minval, &maxval) } ?? lic_convolve(a, b, nil, nside, LIC_VECTOR, length, 0, &out, &minval, &maxval)
+        XCTAssertEqual(status, 0)
+        return (out, minval, maxval)
+    }
+    
+    func test_bounds() throws {
+        let result = convolve(x: 0.6, y: 0.8)
+        
+        // averages of noise in [0,1) along streamlines, defined everywhere (no pixel center sits at a pole)
+        XCTAssertEqual(result.out.filter { $0.isNaN }.count, 0)
+        XCTAssertEqual(result.min, Double(result.out.min()!)); XCTAssertEqual(result.max, Double(result.out.max()!))
+        XCTAssertGreaterThanOrEqual(result.min, 0.0); XCTAssertLessThan(result.max, 1.0)
+    }
+    
+    func test_meridian() throws {
+        let npix = 12*nside*nside; var theta = 0.0, phi = 0.0, q = 0
+        
+        // noise symmetric under reflection phi -> -phi, so that mirrored streamlines see the same values
+        var noise = [Float](repeating: 0.0, count: npix), meridian = [Int]()
+        
+        for p in 0..<npix {
+            pix2ang_nest(nside, p, &theta, &phi); ang2pix_nest(nside, theta, (phi > 0.0) ? 2.0*Double.pi - phi : 0.0, &q)
+            noise[p] = Float(Swift.min(p, q))/Float(npix); if (phi == 0.0) { meridian.append(p) }
+        }
+        
+        // streamlines starting at pixel centers on phi = 0 drift off it by tiny angles either way,
+        // points at phi = -ε (where t+4 rounds to 4) have to be found in the same pixels as at phi = +ε
+        let west = convolve(x: 1.0, y: -1.0e-8, noise: noise), east = convolve(x: 1.0, y: 1.0e-8, noise: noise)
+        
+        XCTAssertEqual(meridian.count, nside)
+        for p in meridian { XCTAssertEqual(west.out[p], east.out[p], "pixel \(p)") }
+    }
+}
@@ -0,0 +1,124 @@
+//
+//  Neighbours Tests.swift
+//  HEALPix Viewer Tests
+//
+//  Created by Andrei Frolov on 2026-10-17.
+//
+
+import XCTest
+
+final class Neighbours_Tests: XCTestCase {
+    let maxtries = 123456
+    let nsides = [1, 2, 4, 16, 128, 1024]
+    
+    // neighbour offsets, and face lookup across face edges, from healpix_base.cc
+    let xoffset = [ -1,-1, 0, 1, 1, 1, 0,-1 ]
+    let yoffset = [  0, 1, 1, 1, 0,-1,-1,-1 ]
+    
+    let facearray = [
+        [  8, 9,10,11,-1,-1,-1,-1,10,11, 8, 9 ],   // S
+        [  5, 6, 7, 4, 8, 9,10,11, 9,10,11, 8 ],   // SE
+        [ -1,-1,-1,-1, 5, 6, 7, 4,-1,-1,-1,-1 ],   // E
+        [  4, 5, 6, 7,11, 8, 9,10,11, 8, 9,10 ],   // SW
+        [  0, 1, 2, 3, 4, 5, 6, 7, 8, 9,10,11 ],   // center
+        [  1, 2, 3, 0, 0, 1, 2, 3, 5, 6, 7, 4 ],   // NE
+        [ -1,-1,-1,-1, 7, 4, 5, 6,-1,-1,-1,-1 ],   // W
+        [  3, 0, 1, 2, 3, 0, 1, 2, 4, 5, 6, 7 ],   // NW
+        [  2, 3, 0, 1,-1,-1,-1,-1, 0, 1, 2, 3 ]    // N
+    ]
+    
+    let swaparray = [
+        [ 0,0,3 ], [ 0,0,6 ], [ 0,0,0 ], [ 0,0,5 ], [ 0,0,0 ], [ 5,0,0 ], [ 0,0,0 ], [ 6,0,0 ], [ 3,0,0 ]
+    ]
+    
+    override func setUpWithError() throws {
+        // Put setup code here. This method is called before the invocation of each test method in the class.
+    }
+    
+    override func tearDownWithError() throws {
+        // Put teardown code here. This method is called after the invocation of each test method in the class.
+    }
+    
+    // interleave lower order bits of x into even bit positions, and back
+    func spread(_ x: Int, _ order: Int) -> Int { var r = 0; for b in 0..<order { r |= ((x >> b) & 1) << (2*b) }; return r }
+    func compress(_ x: Int, _ order: Int) -> Int { var r = 0; for b in 0..<order { r |= ((x >> (2*b)) & 1) << b }; return r }
+    
+    // neighbours of NESTED pixel p, computed one pixel at a time as in Healpix_Base::neighbors()
+    func reference(_ nside: Int, _ p: Int) -> [Int] {
+        let order = nside.trailingZeroBitCount, face = p >> (2*order), local = p & (nside*nside-1)
+        let ix = compress(local, order), iy = compress(local >> 1, order)
+        var nb = [Int](repeating: -1, count: 8)
+        
+        for i in 0..<8 {
+            var x = ix + xoffset[i], y = iy + yoffset[i], k = 4
+            
+            if (x < 0) { x += nside; k -= 1 } else if (x >= nside) { x -= nside; k += 1 }
+            if (y < 0) { y += nside; k -= 3 } else if (y >= nside) { y -= nside; k += 3 }
+            
+            let f = facearray[k][face]; if (f < 0) { continue }
+            let bits = swaparray[k][face >> 2]
+            
+            if (bits & 1 != 0) { x = nside - x - 1 }
+            if (bits & 2 != 0) { y = nside - y - 1 }
+            if (bits & 4 != 0) { swap(&x, &y) }
+            
+            nb[i] = (f << (2*order)) | spread(x, order) | (spread(y, order) << 1)
+        }
+        
+        return nb
+    }
+    
+    func test_reference() throws {
+        for nside in nsides {
+            let table = try XCTUnwrap(neighbours_for(nside)), order = nside.trailingZeroBitCount, skip = nside*nside/maxtries + 1
+            var nb = [Int](repeating: 0, count: 8), bad = 0
+            
+            for p in stride(from: 0, to: 12*nside*nside, by: skip) {
+                neighbours(table, p, &nb); if (nb != reference(nside, p)) { bad += 1 }
+            }
+            
+            XCTAssertEqual(bad, 0, "nside \(nside)")
+            
+            // face edges in full, where neighbours come from the stored table
+            for face in 0..<12 { for k in 0..<nside {
+                for (x, y) in [(k, 0), (nside-1, k), (k, nside-1), (0, k)] {
+                    let p = face*nside*nside | spread(x, order) | (spread(y, order) << 1)
+                    neighbours(table, p, &nb); if (nb != reference(nside, p)) { bad += 1 }
+                }
+            } }
+            
+            XCTAssertEqual(bad, 0, "nside \(nside)")
+        }
+    }
+    
+    func test_symmetry() throws {
+        for nside in nsides.filter({ $0 <= 128 }) {
+            let table = try XCTUnwrap(neighbours_for(nside)), npix = 12*nside*nside
+            var nb = [Int](repeating: 0, count: 8*npix), bad = 0, missing = 0
+            
+            neighbours_batch(table, nil, 0, npix, &nb)
+            
+            // neighbours are distinct, and each pixel is a neighbour of its neighbours
+            for p in 0..<npix {
+                let n = nb[8*p..<8*p+8].filter { $0 >= 0 }; missing += 8 - n.count
+                if (Set(n).count != n.count || n.contains(p)) { bad += 1 }
+                for q in n { if (!nb[8*q..<8*q+8].contains(p)) { bad += 1 } }
+            }
+            
+            // three pixels around each of the 8 vertices where only three faces meet lack a neighbour
+            XCTAssertEqual(bad, 0, "nside \(nside)")
+            XCTAssertEqual(missing, 24, "nside \(nside)")
+        }
+    }
+    
+    func test_batch() throws {
+        let nside = 64, npix = 12*nside*nside, table = try XCTUnwrap(neighbours_for(nside))
+        let idx = (0..<1000).map { ($0*7919 + 13) % npix }
+        var nb = [Int](repeating: 0, count: 8*idx.count), one = [Int](repeating: 0, count: 8), bad = 0
+        
+        neighbours_batch(table, idx, 0, idx.count, &nb)
+        
+        for (k, p) in idx.enumerated() { neighbours(table, p, &one); if (Array(nb[8*k..<8*k+8]) != one) { bad += 1 } }
+        XCTAssertEqual(bad, 0)
+    }
+}
@@ -0,0 +1,165 @@
+//
+//  Projection Tests.swift
+//  HEALPix Viewer Tests
+//
+//  Created by Andrei Frolov on 2026-10-17.
+//
+
+import CFitsIO
+import XCTest
+
+final class Projection_Tests: XCTestCase {
+    let nside = 256
+    
+    // test map holding its own pixel indices (exact in single precision)
+    lazy var map: [Float] = (0..<12*nside*nside).map { Float($0) }
+    
+    override func setUpWithError() throws {
+        // Put setup code here. This method is called before the invocation of each test method in the class.
+    }
+    
+    override func tearDownWithError() throws {
+        project_threads(0)
+    }
+    
+    // inverse projections as in Projections.metal, in double precision
+    func unproject(_ p: projection, _ x: Double, _ y: Double) -> (inside: Bool, v: [Double]) {
+        let pi = Double.pi, halfpi = Double.pi/2.0
+        func ang2vec(_ theta: Double, _ phi: Double) -> [Double] { [sin(theta)*cos(phi), sin(theta)*sin(phi), cos(theta)] }
+        
+        switch p {
+            case PROJECT_MOLLWEIDE:
+                let psi = asin(y), phi = halfpi*x/cos(psi), theta = acos((2.0*psi + sin(2.0*psi))/pi)
+                return (!(y < -1.0 || y > 1.0 || phi < -pi || phi > pi), ang2vec(theta, phi))
+            case PROJECT_HAMMER:
+                let p = x*x/4.0 + y*y, q = 1.0 - p/4.0, z = sqrt(q)
+                let theta = acos(z*y), phi = 2.0*atan(z*x/(2.0*q-1.0)/2.0)
+                return (!(p > 2.0), ang2vec(theta, phi))
+            case PROJECT_AITOFF:
+                let a = sqrt(x*x/4.0 + y*y), sinc = a > 0.0 ? sin(a)/a : 1.0
+                let z = y*sinc, r = sqrt(1.0-z*z), phi = 2.0*asin(0.5*x*sinc/r)
+                return (!(a > pi/2.0), [r*cos(phi), r*sin(phi), z])
+            case PROJECT_LAMBERT:
+                let q = 1.0 - (x*x + y*y)/4.0
+                return (!(q < 0.0), [2.0*q-1.0, sqrt(q)*x, sqrt(q)*y])
+            case PROJECT_EQUIDISTANT:
+                let theta = sqrt(x*x + y*y), phi = atan2(x,y), u = ang2vec(theta, phi)
+                return (!(theta > pi), [u[2], u[1], u[0]])
+            case PROJECT_ORTHOGRAPHIC:
+                let q = 1.0 - (x*x + y*y)
+                return (!(q < 0.0), [sqrt(q), x, y])
+            case PROJECT_STEREOGRAPHIC:
+                let s = 4.0/(4.0+x*x+y*y)
+                return (true, [2.0*s-1.0, s*x, s*y])
+            case PROJECT_GNOMONIC:
+                let r = 1.0/sqrt(1.0+x*x+y*y)
+                return (true, [r, r*x, r*y])
+            case PROJECT_MERCATOR:
+                let phi = x, theta = halfpi - atan(sinh(y))
+                return (!(phi < -pi || phi > pi), ang2vec(theta, phi))
+            case PROJECT_CARTESIAN:
+                let phi = x, theta = halfpi - y
+                return (!(phi < -pi || phi > pi || theta < 0.0 || theta > pi), ang2vec(theta, phi))
+            case PROJECT_WERNER:
+                let ux = x, uy = y - 1.111983413, theta = sqrt(ux*ux + uy*uy), phi = theta/sin(theta)*atan2(ux,-uy)
+                return (!(theta > pi || phi < -pi || phi > pi), ang2vec(theta, phi))
+            default:
+                return (false, [0.0, 0.0, 0.0])
+        }
+    }
+    
+    // project test map with view centered at (0,0), using nearest pixel lookup
+    func render(_ p: projection, _ transform: [Float], width: Int, height: Int) -> (out: [Float], inside: [UInt8]) {
+        var rotation = [Float](repeating: 0.0, count: 9); project_rotation(0.0, 0.0, 0.0, &rotation)
+        var out = [Float](repeating: 0.0, count: width*height), inside = [UInt8](repeating: 0, count: width*height)
+        
+        project_map(map, nside, p, PROJECT_NEAREST, transform, rotation, &out, &inside, width, height)
+        return (out, inside)
+    }
+    
+    // pixel center within two pixel sizes of unit vector v (float and double lookups differ at pixel boundaries)
+    func near(_ p: Float, _ v: [Double]) -> Bool {
+        var u = [Double](repeating: 0.0, count: 3); pix2vec_nest(nside, Int(p), &u)
+        return u[0]*v[0] + u[1]*v[1] + u[2]*v[2] > cos(2.0*sqrt(4.0*Double.pi/Double(12*nside*nside)))
+    }
+    
+    func test_inverse() throws {
+        let s = 1.0/sqrt(2.0), r = 1.0/sqrt(3.0), h = sqrt(3.0)/2.0
+        
+        // points on projection plane and directions they come from, worked out from Projections.metal formulas
+        let points: [(projection, Double, Double, [Double])] = [
+            (PROJECT_MOLLWEIDE, 1.0, 0.0, [0.0, 1.0, 0.0]),
+            (PROJECT_AITOFF, 1.0, 0.0, [cos(1.0), sin(1.0), 0.0]),
+            (PROJECT_HAMMER, 0.0, 1.0, [0.5, 0.0, h]),
+            (PROJECT_LAMBERT, 1.0, 0.0, [0.5, h, 0.0]),
+            (PROJECT_EQUIDISTANT, Double.pi/4.0, 0.0, [s, s, 0.0]),
+            (PROJECT_ORTHOGRAPHIC, 0.6, 0.0, [0.8, 0.6, 0.0]),
+            (PROJECT_STEREOGRAPHIC, 2.0, 0.0, [0.0, 1.0, 0.0]),
+            (PROJECT_GNOMONIC, 1.0, 1.0, [r, r, r]),
+            (PROJECT_MERCATOR, 0.5, asinh(1.0), [s*cos(0.5), s*sin(0.5), s]),
+            (PROJECT_CARTESIAN, -2.0, 0.3, [cos(0.3)*cos(2.0), -cos(0.3)*sin(2.0), sin(0.3)]),
+            (PROJECT_WERNER, 0.0, 1.111983413 - 1.0, [sin(1.0), 0.0, cos(1.0)])
+        ]
+        
+        for (p, x, y, v) in points {
+            let name = String(cString: projection_name(p)), ref = unproject(p, x, y)
+            XCTAssertTrue(ref.inside, name); for k in 0..<3 { XCTAssertEqual(ref.v[k], v[k], accuracy: 1.0e-12, name) }
+            
+            // single pixel image centered on the point
+            let image = render(p, [0.0, 0.0, 0.0, 0.0, Float(x), Float(y)], width: 1, height: 1)
+            XCTAssertEqual(image.inside[0], 1, name); XCTAssertFalse(image.out[0].isNaN, name)
+            if (!image.out[0].isNaN) { XCTAssertTrue(near(image.out[0], v), name) }
+        }
+    }
+    
+    func test_lookup() throws {
+        let width = 800, height = 400
+        
+        for k in 0..<PROJECTIONS.rawValue {
+            let p = projection(rawValue: k), name = String(cString: projection_name(p))
+            var transform = [Float](repeating: 0.0, count: 6); project_transform(p, width, height, 0.1, 0, &transform)
+            let image = render(p, transform, width: width, height: height)
+            var n = 0, exact = 0, far = 0, bounds = 0, missing = 0
+            
+            for j in 0..<height { for i in 0..<width {
+                let x = Double(transform[0])*Double(i) + Double(transform[2])*Double(j) + Double(transform[4])
+                let y = Double(transform[1])*Double(i) + Double(transform[3])*Double(j) + Double(transform[5])
+                let ref = unproject(p, x, y), out = image.out[j*width + i]
+                
+                if (ref.inside != (image.inside[j*width + i] != 0)) { bounds += 1; continue }
+                if (!ref.inside || !(ref.v[0]+ref.v[1]+ref.v[2]).isFinite) { continue }
+                
+                // Aitoff arcsine argument may round past 1 at the rim in single precision
+                n += 1; if (out.isNaN) { missing += 1; continue }
+                
+                var q = 0; vec2pix_nest(nside, ref.v, &q)
+                if (Int(out) == q) { exact += 1 } else if (!near(out, ref.v)) { far += 1 }
+            } }
+            
+            XCTAssertGreaterThan(n, 0, name)
+            XCTAssertGreaterThan(Double(exact), 0.999*Double(n), name)
+            XCTAssertEqual(far, 0, name)
+            XCTAssertLessThanOrEqual(bounds, width*height/1000, name)
+            XCTAssertLessThanOrEqual(missing, n/1000, name)
+        }
+    }
+    
+    func test_meridian() throws {
+        let npix = 12*nside*nside, n = Double(nside); var theta = 0.0, phi = 0.0, q = 0
+        
+        // test map symmetric under reflection phi -> -phi, so that mirrored points see the same values
+        for p in 0..<npix {
+            pix2ang_nest(nside, p, &theta, &phi); ang2pix_nest(nside, theta, (phi > 0.0) ? 2.0*Double.pi - phi : 0.0, &q)
+            map[p] = Float(Swift.min(p, q))
+        }
+        
+        // points at phi = -ε (where t+4 rounds to 4) on pixel center rings have to be found in the same pixels as at phi = +ε
+        for i in 1..<4*nside {
+            let k = Double(i), z = (i < nside) ? 1.0 - k*k/(3.0*n*n) : (i > 3*nside) ? (4.0*n-k)*(4.0*n-k)/(3.0*n*n) - 1.0 : 4.0/3.0 - 2.0*k/(3.0*n)
+            let west = render(PROJECT_CARTESIAN, [0.0, 0.0, 0.0, 0.0, -1.0e-8, Float(asin(z))], width: 1, height: 1)
+            let east = render(PROJECT_CARTESIAN, [0.0, 0.0, 0.0, 0.0, 1.0e-8, Float(asin(z))], width: 1, height: 1)
+            
+            XCTAssertEqual(west.out[0], east.out[0], "ring \(i)")
+        }
+    }
+}
@@ -0,0 +1,68 @@
+//
+//  Reorder Tests.swift
+//  HEALPix Viewer Tests
+//
+//  Created by Andrei Frolov on 2026-10-17.
+//
+
+import CFitsIO
+import XCTest
+
+final class Reorder_Tests: XCTestCase {
+    let nsides = [1, 2, 16, 64, 256, 1024]
+    
+    override func setUpWithError() throws {
+        // Put setup code here. This method is called before the invocation of each test method in the class.
+    }
+    
+    override func tearDownWithError() throws {
+        // Put teardown code here. This method is called after the invocation of each test method in the class.
+    }
+    
+    func test_lut() throws {
+        for nside in nsides {
+            let lut = make_ring_lut(nside)
+            XCTAssertNotNil(lut); free_ring_lut(lut)
+        }
+    }
+    
+    func test_nest2ring() throws {
+        for nside in nsides {
+            let npix = 12*nside*nside, lut = try XCTUnwrap(make_ring_lut(nside)); defer { free_ring_lut(lut) }
+            var ring = [Int](repeating: -1, count: npix), first = 0, q = 0, bad = 0
+            
+            // whole map, one block at a time
+            while first < npix {
+                let n = ring.withUnsafeMutableBufferPointer { nest2ring_block(lut, first, npix-first, $0.baseAddress! + first) }
+                XCTAssert(n > 0 && n <= Int(REORDER_BLOCK)); if (n < 1) { break }
+                first += n
+            }
+            
+            for p in 0..<npix { nest2ring(nside, p, &q); if (ring[p] != q) { bad += 1 } }
+            XCTAssertEqual(bad, 0, "nside \(nside)")
+            
+            // short runs starting at unaligned pixels
+            for first in stride(from: 3, to: npix, by: 7*37+5) {
+                let count = Swift.min(37, npix-first)
+                let n = ring.withUnsafeMutableBufferPointer { nest2ring_block(lut, first, count, $0.baseAddress!) }
+                XCTAssert(n > 0 && n <= count)
+                
+                for k in 0..<n { nest2ring(nside, first+k, &q); if (ring[k] != q) { bad += 1 } }
+            }
+            
+            XCTAssertEqual(bad, 0, "nside \(nside)")
+        }
+    }
+    
+    func test_ring2nest() throws {
+        for nside in nsides {
+            let npix = 12*nside*nside, lut = try XCTUnwrap(make_ring_lut(nside)); defer { free_ring_lut(lut) }
+            let ring = [Int](0..<npix); var nest = [Int](repeating: -1, count: npix), q = 0, bad = 0
+            
+            ring2nest_bulk(lut, ring, npix, &nest)
+            
+            for p in 0..<npix { ring2nest(nside, p, &q); if (nest[p] != q) { bad += 1 } }
+            XCTAssertEqual(bad, 0, "nside \(nside)")
+        }
+    }
+}
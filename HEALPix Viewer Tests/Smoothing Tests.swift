@@ -0,0 +1,74 @@
+//
+//  Smoothing Tests.swift
+//  HEALPix Viewer Tests
+//
+//  Created by Andrei Frolov on 2026-10-17.
+//
+
+import XCTest
+
+final class Smoothing_Tests: XCTestCase {
+    let nside = 128
+    
+    // FWHM in pixels, from two pixels to about 15 degrees
+    let beams = [2.0, 4.0, 8.0, 16.0, 32.0]
+    
+    override func setUpWithError() throws {
+        // Put setup code here. This method is called before the invocation of each test method in the class.
+    }
+    
+    override func tearDownWithError() throws {
+        // Put teardown code here. This method is called after the invocation of each test method in the class.
+    }
+    
+    // random map band-limited to l <= 2*nside, with power spectrum C_l ~ (l+1)^-slope
+    func random(slope: Double, seed: UInt64 = 3) -> [Float] {
+        let lmax = 3*nside-1, npix = 12*nside*nside; var s = seed
+        var alm = [Double](repeating: 0.0, count: 2*sht_alm_size(Int32(lmax), Int32(lmax)))
+        
+        func urand() -> Double { s = s &* 6364136223846793005 &+ 1442695040888963407; return Double(s >> 11)/9007199254740992.0 - 0.5 }
+        
+        for m in 0...lmax { for l in m...lmax {
+            let i = 2*sht_alm_index(Int32(lmax), Int32(l), Int32(m)), a = (l <= 2*nside) ? pow(Double(l+1), -slope/2.0) : 0.0
+            alm[i] = a*urand(); alm[i+1] = (m > 0) ? a*urand() : 0.0
+        } }
+        
+        var map = [Float](repeating: 0.0, count: npix), minval = 0.0, maxval = 0.0
+        XCTAssertEqual(sht_alm2map(alm, Int32(lmax), Int32(lmax), &map, nside, &minval, &maxval), 0)
+        
+        return map
+    }
+    
+    // rms difference between pixel space and harmonic smoothing, relative to rms of the latter
+    func deviation(_ map: [Float], fwhm: Double) -> Double {
+        let npix = map.count, lmax = 3*nside-1
+        var bl = [Double](repeating: 0.0, count: lmax+1), harmonic = [Float](repeating: .nan, count: npix), smooth = harmonic, minval = 0.0, maxval = 0.0
+        
+        sht_gaussian_beam(fwhm, Int32(lmax), &bl)
+        XCTAssertEqual(sht_filter(map, nside, Int32(lmax), 3, bl, &harmonic, &minval, &maxval), 0)
+        XCTAssertEqual(smooth_gaussian(map, nside, fwhm, nside, &smooth, &minval, &maxval), 0)
+        XCTAssertEqual(minval, Double(smooth.min()!)); XCTAssertEqual(maxval, Double(smooth.max()!))
+        
+        let mean = harmonic.reduce(0.0) { $0 + Double($1) }/Double(npix); var d2 = 0.0, h2 = 0.0
+        
+        for p in 0..<npix {
+            let h = Double(harmonic[p]), d = Double(smooth[p]) - h
+            d2 += d*d; h2 += (h-mean)*(h-mean)
+        }
+        
+        return sqrt(d2/h2)
+    }
+    
+    func test_white() throws {
+        let data = random(slope: 0.0), pixel = sqrt(Double.pi/3.0)/Double(nside)
+        
+        // worst case, as the beam cuts deepest into the spectrum
+        for f in beams { XCTAssertLessThan(deviation(data, fwhm: f*pixel), 0.03, "FWHM \(f) pixels") }
+    }
+    
+    func test_red() throws {
+        let data = random(slope: 1.0), pixel = sqrt(Double.pi/3.0)/Double(nside)
+        
+        for f in beams { XCTAssertLessThan(deviation(data, fwhm: f*pixel), 0.02, "FWHM \(f) pixels") }
+    }
+}
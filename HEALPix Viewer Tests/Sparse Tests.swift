@@ -0,0 +1,201 @@
+//
+//  Sparse Tests.swift
+//  HEALPix Viewer Tests
+//
+//  Created by Andrei Frolov on 2026-10-17.
+//
+
+import CFitsIO
+import XCTest
+@testable import HEALPix_Viewer
+
+final class Sparse_Tests: XCTestCase {
+    let nside = 256
+    var cache: String? = nil
+    
+    override func setUpWithError() throws {
+        // converted map cache would bypass the loaders being tested
+        cache = UserDefaults.standard.string(forKey: CacheSize.key)
+        UserDefaults.standard.set(CacheSize.none.rawValue, forKey: CacheSize.key)
+    }
+    
+    override func tearDownWithError() throws {
+        if let cache = cache { UserDefaults.standard.set(cache, forKey: CacheSize.key) }
+        else { UserDefaults.standard.removeObject(forKey: CacheSize.key) }
+    }
+    
+    // observed NESTED pixels: two compact patches, and isolated pixels sprinkled over another face
+    func observed() -> [Int] {
+        let npix = 12*nside*nside; var pixels = Set<Int>()
+        
+        for p in 5000..<25000 { pixels.insert(p) }
+        for p in 7*npix/12+1234..<7*npix/12+9234 { pixels.insert(p) }
+        for k in 0..<500 { pixels.insert(3*npix/12 + (k*7919 + 13) % (npix/12)) }
+        
+        return pixels.sorted()
+    }
+    
+    // test value of NESTED pixel p (nil marks bad pixels)
+    func value(_ p: Int) -> Float? { (p % 997 == 0) ? nil : Float(sin(Double(p)*0.01) * 1.0e3) }
+    
+    // full sky reference map (unobserved and bad pixels are NaN)
+    func reference(_ idx: [Int]) -> [Float] {
+        var full = [Float](repeating: .nan, count: 12*nside*nside)
+        for p in idx { full[p] = value(p) ?? .nan }; return full
+    }
+    
+    // number of pixels where sparse map differs from reference (NaN matching NaN)
+    func check(_ map: SparseMap, _ full: [Float]) -> Int {
+        var bad = 0
+        
+        for p in 0..<map.npix {
+            let x = full[p], y = map[p]
+            if (x.isNaN) { if (!y.isNaN) { bad += 1 } } else if (x != y) { bad += 1 }
+        }
+        
+        return bad
+    }
+    
+    func test_layout() throws {
+        let npix = 12*nside*nside, idx = observed(), nobs = idx.count
+        let layout = try XCTUnwrap(SparseLayout(nside: nside, idx: idx, nobs: nobs))
+        
+        XCTAssertEqual(layout.size, layout.ptr.pointee.filled*sparse_tile(layout.ptr))
+        XCTAssertLessThan(layout.size, npix/4)
+        
+        // pixels pack to distinct positions in stored data, and unpack back
+        var pos = [Int](repeating: -1, count: nobs), back = [Int](repeating: -1, count: nobs)
+        sparse_pack(layout.ptr, idx, &pos, nobs); sparse_unpack(layout.ptr, pos, &back, nobs)
+        
+        XCTAssertEqual(back, idx); XCTAssertEqual(Set(pos).count, nobs)
+        XCTAssert(pos.allSatisfy { $0 >= 0 && $0 < layout.size })
+        
+        // 32-bit index agrees with 64-bit one
+        var idx32 = idx.map { Int32($0) }, pos32 = [Int32](repeating: -1, count: nobs)
+        sparse_pack32(layout.ptr, idx32, &pos32, nobs); XCTAssertEqual(pos32.map { Int($0) }, pos)
+        sparse_unpack32(layout.ptr, pos32, &idx32, nobs); XCTAssertEqual(idx32.map { Int($0) }, idx)
+        
+        // sparse map filled through packed positions
+        let store = UnsafeMutablePointer<Float>.allocate(capacity: layout.size)
+        store.initialize(repeating: .nan, count: layout.size)
+        for (p, q) in zip(idx, pos) { store[q] = value(p) ?? .nan }
+        
+        let finite = idx.compactMap { value($0) }, full = reference(idx)
+        let map = SparseMap(nside: nside, layout: layout, buffer: store, min: Double(finite.min()!), max: Double(finite.max()!))
+        XCTAssertEqual(check(map, full), 0)
+        
+        // expanded map, and full sky map materialized on demand
+        let expanded = map.expand(); defer { expanded.deallocate() }
+        var bad = 0
+        
+        for p in 0..<npix {
+            let x = full[p], y = expanded[p], z = map.ptr[p]
+            if (x.isNaN) { if (!y.isNaN || !z.isNaN) { bad += 1 } } else if (x != y || x != z) { bad += 1 }
+        }
+        
+        XCTAssertEqual(bad, 0)
+        
+        // index of stored data lists finite observed pixels in ascending order of value
+        let index = map.idx; XCTAssertEqual(index.count, finite.count)
+        var seen = Set<Int>(), last = -Float.infinity
+        
+        for k in 0..<index.count {
+            let p = index[k], v = full[p]
+            if (v.isNaN || v < last || !seen.insert(p).inserted) { bad += 1 }; last = v
+        }
+        
+        XCTAssertEqual(bad, 0)
+        
+        // copy shares layout, but not data
+        let copy = map.copy
+        XCTAssert(copy.layout === map.layout); XCTAssertNotEqual(copy.store, map.store)
+        XCTAssertEqual(check(copy, full), 0)
+    }
+    
+    // write explicitly indexed partial sky map, with float pixel values and a 32-bit pixel index
+    func write(_ file: URL, order: String, idx: [Int]) throws {
+        var fptr: UnsafeMutablePointer<fitsfile>? = nil, status: Int32 = 0
+        
+        var ttype = ["PIXEL", "SIGNAL"].map { strdup($0) }
+        var tform = ["1J", "1E"].map { strdup($0) }
+        var tunit = ["", "K"].map { strdup($0) }
+        defer { for s in ttype + tform + tunit { free(s) } }
+        
+        ffinit(&fptr, "!" + file.path, &status)
+        ffcrtb(fptr, BINARY_TBL, Int64(idx.count), 2, &ttype, &tform, &tunit, "xtension", &status)
+        ffpkys(fptr, "PIXTYPE", "HEALPIX", nil, &status)
+        ffpkys(fptr, "ORDERING", order, nil, &status)
+        ffpkyj(fptr, "NSIDE", Int64(nside), nil, &status)
+        ffpkys(fptr, "INDXSCHM", "EXPLICIT", nil, &status)
+        ffpkys(fptr, "OBJECT", "PARTIAL", nil, &status)
+        ffpkyj(fptr, "OBS_NPIX", Int64(idx.count), nil, &status)
+        ffpkye(fptr, "BAD_DATA", BAD_DATA, 8, nil, &status)
+        
+        // pixels are written in file ordering, backwards to exercise scattering
+        var pixels = [Int32](), values = [Float](), q = 0
+        
+        for p in idx.reversed() {
+            if (order == "RING") { nest2ring(nside, p, &q) } else { q = p }
+            pixels.append(Int32(q)); values.append(value(p) ?? BAD_DATA)
+        }
+        
+        XCTAssertEqual(Set(pixels).count, idx.count)
+        ffpclk(fptr, 1, 1, 1, Int64(idx.count), &pixels, &status)
+        ffpcle(fptr, 2, 1, 1, Int64(idx.count), &values, &status)
+        ffclos(fptr, &status)
+        
+        XCTAssertEqual(status, 0)
+    }
+    
+    func test_explicit() throws {
+        let file = FileManager.default.temporaryDirectory.appendingPathComponent("sparse-test.fits")
+        defer { try? FileManager.default.removeItem(at: file) }
+        
+        let idx = observed(), full = reference(idx)
+        let finite = idx.compactMap { value($0) }
+        
+        for order in ["RING", "NESTED"] {
+            try write(file, order: order, idx: idx)
+            
+            // CFITSIO reading the whole table, and CFITSIO streaming it in chunks
+            for streaming in [false, true] {
+                let hpx = try XCTUnwrap(read_hpxfile(url: file, streaming: streaming))
+                XCTAssertEqual(hpx.nmaps, 1)
+                
+                let map = try XCTUnwrap(hpx[0] as? SparseMap, "\(order) map, streaming \(streaming)")
+                XCTAssertEqual(map.nside, nside)
+                XCTAssertLessThan(map.layout.size, map.npix/4)
+                XCTAssertEqual(map.min, Double(finite.min()!)); XCTAssertEqual(map.max, Double(finite.max()!))
+                XCTAssertEqual(check(map, full), 0, "\(order) map, streaming \(streaming)")
+            }
+        }
+    }
+    
+    func test_cached() throws {
+        let file = FileManager.default.temporaryDirectory.appendingPathComponent("sparse-cached.fits")
+        defer { try? FileManager.default.removeItem(at: file) }
+        
+        let idx = observed(), full = reference(idx)
+        try write(file, order: "RING", idx: idx)
+        
+        // map column of the first table extension
+        UserDefaults.standard.set(CacheSize.small.rawValue, forKey: CacheSize.key)
+        let key = try XCTUnwrap(mapCache.keys(url: file, hdu: 2, columns: 2..<3)?.first)
+        let entry = mapCache.directory.appendingPathComponent(key.name).appendingPathExtension("map")
+        defer { for ext in ["map", "idx"] { try? FileManager.default.removeItem(at: entry.deletingPathExtension().appendingPathExtension(ext)) } }
+        
+        // first load converts the map, writing it out to cache in background
+        _ = try XCTUnwrap(read_hpxfile(url: file))
+        
+        let deadline = Date(timeIntervalSinceNow: 10.0)
+        while (!FileManager.default.fileExists(atPath: entry.path) && Date() < deadline) { usleep(10000) }
+        
+        // entry holds stored tiles only, and is mapped back in as sparse map
+        let size = try XCTUnwrap(FileManager.default.attributesOfItem(atPath: entry.path)[.size] as? Int)
+        XCTAssertLessThan(size, 12*nside*nside*MemoryLayout<Float>.size/4)
+        
+        let hpx = try XCTUnwrap(read_hpxfile(url: file))
+        let map = try XCTUnwrap(hpx[0] as? SparseMap)
+        XCTAssertEqual(check(map, full), 0)
+    }
+}
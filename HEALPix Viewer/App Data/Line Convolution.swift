@@ -17,3 +17,40 @@ enum LineConvolution: String, CaseIterable, Codable, Preference {
     static let key = "convolution"
     static let defaultValue: Self = .none
 }
+
+// line integral convolution engine (see lic.h)
+extension LineConvolution {
+    // default streamline length traced each way, in radians
+    static let length = 0.02
+    
+    // field type passed to convolution engine
+    var field: lic_field? {
+        switch self {
+            case .none:         return nil
+            case .vector:       return LIC_VECTOR
+            case .polarization: return LIC_POLARIZATION
+        }
+    }
+    
+    // convolve white noise along field given by a pair of maps (vector components or Stokes Q and U),
+    // optionally computing a quick preview from field maps degraded to lower resolution nside
+    func convolve(_ x: Map, _ y: Map, length: Double = Self.length, nside: Int? = nil, seed: Int = 0) -> CpuMap? {
+        guard let field = field, x.nside == y.nside else { return nil }
+        
+        // field maps degraded for preview
+        func degraded(_ map: Map) -> Map {
+            guard let nside = nside, nside < map.nside else { return map }
+            return (map as? CpuMap)?.degraded(nside: nside) ?? MapPyramid(map)[nside: nside] ?? map
+        }
+        
+        let x = degraded(x), y = degraded(y)
+        guard x.nside == y.nside else { return nil }
+        
+        let output = UnsafeMutablePointer<Float>.allocate(capacity: x.npix); var minval = 0.0, maxval = 0.0
+        
+        lic_threads(Int32(CpuThreads.value.count))
+        guard lic_convolve(x.ptr, y.ptr, nil, x.nside, field, length, UInt(truncatingIfNeeded: seed), output, &minval, &maxval) == 0 else { output.deallocate(); return nil }
+        
+        return CpuMap(nside: x.nside, buffer: output, min: minval, max: maxval)
+    }
+}
@@ -176,6 +176,50 @@ enum ProxySize: String, CaseIterable, Codable, Preference {
     static let defaultValue: Self = .none
 }
 
+// CPU threads used for map conversion
+enum CpuThreads: String, CaseIterable, Codable, Preference {
+    case all = "All cores"
+    case half = "Half of cores"
+    case single = "Single thread"
+    
+    // default value
+    static let key = "threads"
+    static let defaultValue: Self = .all
+    
+    // thread count passed to C backends (0 = one per active core)
+    var count: Int {
+        switch self {
+            case .all:    return 0
+            case .half:   return max(ProcessInfo.processInfo.activeProcessorCount/2, 1)
+            case .single: return 1
+        }
+    }
+}
+
+// size cap of converted map cache
+enum CacheSize: String, CaseIterable, Codable, Preference {
+    case none = "Disabled"
+    case small = "1 GB"
+    case medium = "4 GB"
+    case large = "16 GB"
+    case huge = "64 GB"
+    
+    // default value
+    static let key = "cache"
+    static let defaultValue: Self = .medium
+    
+    // cap in bytes
+    var bytes: Int {
+        switch self {
+            case .none:   return 0
+            case .small:  return 1<<30
+            case .medium: return 4<<30
+            case .large:  return 16<<30
+            case .huge:   return 64<<30
+        }
+    }
+}
+
 // output image format
 enum ImageFormat: String, CaseIterable, Codable, Preference {
     case gif = "GIF"
@@ -0,0 +1,203 @@
+//
+//  colorize.c
+//  HEALPix Viewer
+//
+//  Created by Andrei Frolov on 2026-10-17.
+//
+
+#include <math.h>
+#include <float.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <dispatch/dispatch.h>
+#include "colorize.h"
+
+// CPU counterpart of colorize kernel in Colorize.metal: values are normalized to
+// color range and looked up in a colormap resampled finely enough that nearest
+// entry is indistinguishable from linear texture sampling; lookup tables are
+// kept in every output format, so that colorization is a pure gather
+
+// MARK: color conversions
+
+// sRGB transfer function
+static inline float linear(float c) {
+    return (c <= 0.04045f) ? c/12.92f : powf((c+0.055f)/1.055f, 2.4f);
+}
+
+// quantize component to n-bit integer
+static inline uint32_t quantize(float x, uint32_t max) {
+    return (x > 0.0f) ? ((x < 1.0f) ? (uint32_t) lrintf(x*max) : max) : 0;
+}
+
+// convert float to half float (rounding to nearest even)
+static uint16_t half(float f) {
+    union { float f; uint32_t u; } v = { f };
+    const uint32_t sign = (v.u >> 16) & 0x8000, x = v.u & 0x7FFFFFFF;
+    
+    if (x >= 0x7F800000) { return sign | 0x7C00 | ((x > 0x7F800000) ? 0x200 : 0); }      // infinity and NaN
+    if (x >= 0x477FF000) { return sign | 0x7C00; }                                      // overflow
+    if (x < 0x33000000) { return sign; }                                                // underflow
+    if (x < 0x38800000) {                                                               // denormals
+        const uint32_t m = (x & 0x7FFFFF) | 0x800000, s = 126 - (x >> 23);
+        return sign | ((m + (1u << (s-1)) - 1 + ((m >> s) & 1)) >> s);
+    }
+    
+    return sign | ((x + 0xC8000000 + 0xFFF + ((x >> 13) & 1)) >> 13);
+}
+
+// MARK: lookup tables
+
+// sample palette with linear interpolation, clamped to edge texels (as GPU sampler does)
+static void sample(const struct palette *palette, float v, float *c) {
+    const float x = fminf(fmaxf(v*palette->size - 0.5f, 0.0f), palette->size - 1);
+    const int i = (int) x, j = (i+1 < palette->size) ? i+1 : i; const float t = x-i;
+    for (int k = 0; k < 4; k++) { c[k] = (1.0f-t)*palette->lut[i][k] + t*palette->lut[j][k]; }
+}
+
+colorize_lut *make_colorize_lut(const struct palette *palette, const float below[4], const float above[4], const float nan[4], const float background[4]) {
+    const int size = COLORIZE_LUT_SIZE, n = size + 4;
+    colorize_lut *lut = calloc(1, sizeof(colorize_lut)); if (!lut) { return NULL; }
+    
+    lut->size = size;
+    lut->rgba = malloc(n*sizeof(float[4]));
+    lut->rgba8 = malloc(n*sizeof(uint8_t[4]));
+    lut->rgba16 = malloc(n*sizeof(uint16_t[4]));
+    lut->half = malloc(n*sizeof(uint16_t[4]));
+    
+    if (!lut->rgba || !lut->rgba8 || !lut->rgba16 || !lut->half) { free_colorize_lut(lut); return NULL; }
+    
+    // palette entries, followed by special colors
+    for (int i = 0; i < size; i++) { sample(palette, (float) i/(size-1), lut->rgba[i]); }
+    
+    memcpy(lut->rgba[size], below ? below : palette->lut[0], sizeof(float[4]));
+    memcpy(lut->rgba[size+1], above ? above : palette->lut[palette->size-1], sizeof(float[4]));
+    memcpy(lut->rgba[size+2], nan, sizeof(float[4]));
+    memcpy(lut->rgba[size+3], background, sizeof(float[4]));
+    
+    // entries in output formats
+    for (int i = 0; i < n; i++) {
+        const float *c = lut->rgba[i];
+        
+        for (int k = 0; k < 4; k++) {
+            lut->rgba8[i][k] = quantize(c[k], 255);
+            lut->rgba16[i][k] = quantize(c[k], 65535);
+            lut->half[i][k] = half((k < 3) ? c[3]*linear(c[k]) : c[3]);
+        }
+    }
+    
+    return lut;
+}
+
+void free_colorize_lut(colorize_lut *lut) {
+    if (!lut) { return; }
+    
+    free(lut->rgba); free(lut->rgba8); free(lut->rgba16); free(lut->half);
+    free(lut);
+}
+
+// MARK: pointwise transforms (as Transforms.metal)
+
+// transform a block of values, with function switch hoisted out of the loops (values
+// outside of the domain of log transform become NaN or -inf, as they do on GPU)
+static void transform_block(enum colorize_function f, float m, float s, const float *in, float *out, long n) {
+    switch (f) {
+        case COLORIZE_LOG:      for (long i = 0; i < n; i++) { out[i] = logf(in[i]-m); } break;
+        case COLORIZE_ASINH:    for (long i = 0; i < n; i++) { out[i] = asinhf((in[i]-m)/s); } break;
+        case COLORIZE_ATAN:     for (long i = 0; i < n; i++) { out[i] = atanf((in[i]-m)/s); } break;
+        case COLORIZE_TANH:     for (long i = 0; i < n; i++) { out[i] = tanhf((in[i]-m)/s); } break;
+        case COLORIZE_POWER:    for (long i = 0; i < n; i++) { const float y = in[i]-m; out[i] = copysignf(powf(fabsf(y), s), y); } break;
+        case COLORIZE_EXP:      for (long i = 0; i < n; i++) { out[i] = expf((in[i]-m)/s); } break;
+        default:                if (out != in) { memcpy(out, in, n*sizeof(float)); } break;
+    }
+}
+
+// MARK: parallel colorization
+// values are split into slices processed concurrently by libdispatch workers;
+// each slice is colorized in blocks, one stage at a time: transform, branchless
+// computation of table index (which vectorizes), and gather of table entries
+
+// arrays with fewer values than this are colorized on a single thread
+#define SERIAL_PIXELS (1L<<16)
+
+// number of values processed in a block
+#define BLOCK 1024
+
+// number of worker threads (0 = one per active CPU core)
+static int colorize_nthreads = 0;
+
+void colorize_threads(int threads) { colorize_nthreads = (threads > 0) ? threads : 0; }
+
+// parallel colorization job (lut is NULL for transform only)
+struct colorize_job {
+    const colorize_lut *lut;
+    const float *data; const unsigned char *inside; long n;
+    enum colorize_function f; float mu, sigma, min, max;
+    enum colorize_format format;
+    void *out; long slices;
+};
+
+// colorize a block of n values starting at offset
+static void colorize_block(const struct colorize_job *job, long offset, long n) {
+    const colorize_lut *lut = job->lut; const int last = lut->size-1;
+    const int below = lut->size, above = lut->size+1, nan = lut->size+2, background = lut->size+3;
+    const float min = job->min, range = job->max - job->min;
+    float x[BLOCK]; int idx[BLOCK];
+    
+    transform_block(job->f, job->mu, job->sigma, job->data + offset, x, n);
+    
+    // table index (NaN and infinite values, including those of degenerate range, are missing data)
+    for (long k = 0; k < n; k++) {
+        const float v = (x[k] - min)/range, c = fminf(fmaxf(v, 0.0f), 1.0f);
+        int i = (int)(c*last + 0.5f);
+        
+        i = (v < 0.0f) ? below : i;
+        i = (v > 1.0f) ? above : i;
+        idx[k] = (fabsf(v) <= FLT_MAX) ? i : nan;
+    }
+    
+    if (job->inside) { const unsigned char *inside = job->inside + offset; for (long k = 0; k < n; k++) { if (!inside[k]) { idx[k] = background; } } }
+    
+    // gather table entries
+    switch (job->format) {
+        case COLORIZE_RGBA8:  { uint8_t (*out)[4] = (uint8_t (*)[4]) job->out + offset; for (long k = 0; k < n; k++) { memcpy(out[k], lut->rgba8[idx[k]], 4); } } break;
+        case COLORIZE_RGBA16: { uint16_t (*out)[4] = (uint16_t (*)[4]) job->out + offset; for (long k = 0; k < n; k++) { memcpy(out[k], lut->rgba16[idx[k]], 8); } } break;
+        case COLORIZE_HALF:   { uint16_t (*out)[4] = (uint16_t (*)[4]) job->out + offset; for (long k = 0; k < n; k++) { memcpy(out[k], lut->half[idx[k]], 8); } } break;
+    }
+}
+
+// process values of a single slice of the job
+static void colorize_slice(void *context, size_t s) {
+    const struct colorize_job *job = context;
+    const long first = job->n*s/job->slices, last = job->n*(s+1)/job->slices;
+    
+    for (long i = first; i < last; i += BLOCK) {
+        const long n = (i+BLOCK < last) ? BLOCK : last-i;
+        
+        if (job->lut) { colorize_block(job, i, n); }
+        else { transform_block(job->f, job->mu, job->sigma, job->data + i, (float *) job->out + i, n); }
+    }
+}
+
+// run the job on slices of values
+static void colorize_run(struct colorize_job *job) {
+    long slices = colorize_nthreads ? colorize_nthreads : sysconf(_SC_NPROCESSORS_ONLN);
+    if (job->n < SERIAL_PIXELS || slices < 2) { slices = 1; }
+    
+    job->slices = slices;
+    
+    if (slices > 1) { dispatch_apply_f(slices, DISPATCH_APPLY_AUTO, job, colorize_slice); }
+    else { colorize_slice(job, 0); }
+}
+
+void colorize_transform(enum colorize_function f, double mu, double sigma, const float *in, float *out, long n) {
+    struct colorize_job job = { NULL, in, NULL, n, f, mu, exp(sigma), 0.0f, 0.0f, COLORIZE_RGBA8, out, 1 };
+    colorize_run(&job);
+}
+
+void colorize(const colorize_lut *lut, const float *data, const unsigned char *inside, long n,
+              enum colorize_function f, double mu, double sigma, double min, double max,
+              enum colorize_format format, void *out) {
+    struct colorize_job job = { lut, data, inside, n, f, mu, exp(sigma), min, max, format, out, 1 };
+    colorize_run(&job);
+}
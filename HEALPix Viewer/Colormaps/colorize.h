@@ -0,0 +1,67 @@
+//
+//  colorize.h
+//  HEALPix Viewer
+//
+//  Created by Andrei Frolov on 2026-10-17.
+//
+
+#ifndef colorize_h
+#define colorize_h
+
+#include <stdint.h>
+#include "palettes.h"
+
+// pointwise data transforms (in the same order as Function enum in the app,
+// rank based transforms have to be applied to the whole map beforehand)
+enum colorize_function {
+    COLORIZE_NONE = 0,
+    COLORIZE_LOG,
+    COLORIZE_ASINH,
+    COLORIZE_ATAN,
+    COLORIZE_TANH,
+    COLORIZE_POWER,
+    COLORIZE_EXP
+};
+
+// output pixel formats: 8 or 16 bit sRGB with straight alpha (as stored in PNG),
+// or half float linear RGB with premultiplied alpha (as stored in OpenEXR)
+enum colorize_format {
+    COLORIZE_RGBA8 = 0,
+    COLORIZE_RGBA16,
+    COLORIZE_HALF
+};
+
+// colormap resampled to high resolution lookup tables in all output formats;
+// entries 0..size-1 cover the color range, and are followed by below range,
+// above range, missing data (NaN) and background colors
+typedef struct {
+    int size;
+    float (*rgba)[4];
+    uint8_t (*rgba8)[4];
+    uint16_t (*rgba16)[4];
+    uint16_t (*half)[4];
+} colorize_lut;
+
+// number of entries covering the color range
+#define COLORIZE_LUT_SIZE 8192
+
+// lookup tables for palette (sampled with linear interpolation, as by GPU texture
+// sampler) and special colors, all given as straight alpha sRGB components; below
+// and above range colors default to palette end colors if NULL
+colorize_lut *make_colorize_lut(const struct palette *palette, const float below[4], const float above[4], const float nan[4], const float background[4]);
+void free_colorize_lut(colorize_lut *lut);
+
+// number of threads used by colorization (0 = one per active CPU core)
+void colorize_threads(int threads);
+
+// apply pointwise transform to n values (in place is fine), with scale exp(sigma)
+void colorize_transform(enum colorize_function f, double mu, double sigma, const float *in, float *out, long n);
+
+// colorize n values (transformed first) mapping [min,max] onto palette; values
+// with inside flag cleared (if mask is not NULL) get background color, and out
+// receives n pixels of 4 components in specified format
+void colorize(const colorize_lut *lut, const float *data, const unsigned char *inside, long n,
+              enum colorize_function f, double mu, double sigma, double min, double max,
+              enum colorize_format format, void *out);
+
+#endif /* colorize_h */
@@ -0,0 +1,2568 @@
+//
+//  palettes.c
+//  HEALPix Viewer
+//
+//  Generated by palettes.py from Swift colormap LUTs, do not edit.
+//
+
+#include <stddef.h>
+#include <strings.h>
+#include "palettes.h"
+
+static const float Planck_Parchment_LUT[256][4] = {
+    { 0.0f, 0.0f, 1.0f, 1.0f },
+    { 0.0f, 0.00784313725f, 1.0f, 1.0f },
+    { 0.0f, 0.0196078431f, 1.0f, 1.0f },
+    { 0.0f, 0.031372549f, 1.0f, 1.0f },
+    { 0.0f, 0.0392156863f, 1.0f, 1.0f },
+    { 0.0f, 0.0509803922f, 1.0f, 1.0f },
+    { 0.0f, 0.062745098f, 1.0f, 1.0f },
+    { 0.0f, 0.0705882353f, 1.0f, 1.0f },
+    { 0.0f, 0.0823529412f, 1.0f, 1.0f },
+    { 0.0f, 0.0941176471f, 1.0f, 1.0f },
+    { 0.0f, 0.101960784f, 1.0f, 1.0f },
+    { 0.0f, 0.11372549f, 1.0f, 1.0f },
+    { 0.0f, 0.125490196f, 1.0f, 1.0f },
+    { 0.0f, 0.133333333f, 1.0f, 1.0f },
+    { 0.0f, 0.145098039f, 1.0f, 1.0f },
+    { 0.0f, 0.156862745f, 1.0f, 1.0f },
+    { 0.0f, 0.164705882f, 1.0f, 1.0f },
+    { 0.0f, 0.176470588f, 1.0f, 1.0f },
+    { 0.0f, 0.188235294f, 1.0f, 1.0f },
+    { 0.0f, 0.196078431f, 1.0f, 1.0f },
+    { 0.0f, 0.207843137f, 1.0f, 1.0f },
+    { 0.0f, 0.219607843f, 1.0f, 1.0f },
+    { 0.0f, 0.22745098f, 1.0f, 1.0f },
+    { 0.0f, 0.239215686f, 1.0f, 1.0f },
+    { 0.0f, 0.250980392f, 1.0f, 1.0f },
+    { 0.0f, 0.258823529f, 1.0f, 1.0f },
+    { 0.0f, 0.270588235f, 1.0f, 1.0f },
+    { 0.0f, 0.282352941f, 1.0f, 1.0f },
+    { 0.0f, 0.290196078f, 1.0f, 1.0f },
+    { 0.0f, 0.301960784f, 1.0f, 1.0f },
+    { 0.0f, 0.31372549f, 1.0f, 1.0f },
+    { 0.0f, 0.321568627f, 1.0f, 1.0f },
+    { 0.0f, 0.333333333f, 1.0f, 1.0f },
+    { 0.0f, 0.345098039f, 1.0f, 1.0f },
+    { 0.0f, 0.352941176f, 1.0f, 1.0f },
+    { 0.0f, 0.364705882f, 1.0f, 1.0f },
+    { 0.0f, 0.376470588f, 1.0f, 1.0f },
+    { 0.0f, 0.384313725f, 1.0f, 1.0f },
+    { 0.0f, 0.396078431f, 1.0f, 1.0f },
+    { 0.0f, 0.407843137f, 1.0f, 1.0f },
+    { 0.0f, 0.415686275f, 1.0f, 1.0f },
+    { 0.0f, 0.42745098f, 1.0f, 1.0f },
+    { 0.0f, 0.439215686f, 1.0f, 1.0f },
+    { 0.0f, 0.447058824f, 1.0f, 1.0f },
+    { 0.0f, 0.458823529f, 1.0f, 1.0f },
+    { 0.0f, 0.466666667f, 1.0f, 1.0f },
+    { 0.0f, 0.478431373f, 1.0f, 1.0f },
+    { 0.0f, 0.48627451f, 1.0f, 1.0f },
+    { 0.0f, 0.498039216f, 1.0f, 1.0f },
+    { 0.0f, 0.505882353f, 1.0f, 1.0f },
+    { 0.0f, 0.517647059f, 1.0f, 1.0f },
+    { 0.0f, 0.525490196f, 1.0f, 1.0f },
+    { 0.0f, 0.537254902f, 1.0f, 1.0f },
+    { 0.0f, 0.545098039f, 1.0f, 1.0f },
+    { 0.0f, 0.556862745f, 1.0f, 1.0f },
+    { 0.0f, 0.564705882f, 1.0f, 1.0f },
+    { 0.0f, 0.576470588f, 1.0f, 1.0f },
+    { 0.0f, 0.588235294f, 1.0f, 1.0f },
+    { 0.0f, 0.596078431f, 1.0f, 1.0f },
+    { 0.0f, 0.607843137f, 1.0f, 1.0f },
+    { 0.0f, 0.615686275f, 1.0f, 1.0f },
+    { 0.0f, 0.62745098f, 1.0f, 1.0f },
+    { 0.0f, 0.635294118f, 1.0f, 1.0f },
+    { 0.0f, 0.647058824f, 1.0f, 1.0f },
+    { 0.0f, 0.654901961f, 1.0f, 1.0f },
+    { 0.0f, 0.666666667f, 1.0f, 1.0f },
+    { 0.0f, 0.674509804f, 1.0f, 1.0f },
+    { 0.0f, 0.68627451f, 1.0f, 1.0f },
+    { 0.0f, 0.694117647f, 1.0f, 1.0f },
+    { 0.0f, 0.705882353f, 1.0f, 1.0f },
+    { 0.0f, 0.71372549f, 1.0f, 1.0f },
+    { 0.0f, 0.725490196f, 1.0f, 1.0f },
+    { 0.0f, 0.737254902f, 1.0f, 1.0f },
+    { 0.0f, 0.745098039f, 1.0f, 1.0f },
+    { 0.0f, 0.756862745f, 1.0f, 1.0f },
+    { 0.0f, 0.764705882f, 1.0f, 1.0f },
+    { 0.0f, 0.776470588f, 1.0f, 1.0f },
+    { 0.0f, 0.784313725f, 1.0f, 1.0f },
+    { 0.0f, 0.796078431f, 1.0f, 1.0f },
+    { 0.0f, 0.803921569f, 1.0f, 1.0f },
+    { 0.0f, 0.815686275f, 1.0f, 1.0f },
+    { 0.0f, 0.823529412f, 1.0f, 1.0f },
+    { 0.0f, 0.835294118f, 1.0f, 1.0f },
+    { 0.0f, 0.843137255f, 1.0f, 1.0f },
+    { 0.0f, 0.854901961f, 1.0f, 1.0f },
+    { 0.0f, 0.866666667f, 1.0f, 1.0f },
+    { 0.0235294118f, 0.866666667f, 0.996078431f, 1.0f },
+    { 0.0470588235f, 0.866666667f, 0.992156863f, 1.0f },
+    { 0.0705882353f, 0.870588235f, 0.988235294f, 1.0f },
+    { 0.0941176471f, 0.870588235f, 0.984313725f, 1.0f },
+    { 0.117647059f, 0.870588235f, 0.980392157f, 1.0f },
+    { 0.141176471f, 0.874509804f, 0.976470588f, 1.0f },
+    { 0.164705882f, 0.874509804f, 0.97254902f, 1.0f },
+    { 0.188235294f, 0.878431373f, 0.968627451f, 1.0f },
+    { 0.211764706f, 0.878431373f, 0.964705882f, 1.0f },
+    { 0.235294118f, 0.878431373f, 0.960784314f, 1.0f },
+    { 0.258823529f, 0.882352941f, 0.960784314f, 1.0f },
+    { 0.282352941f, 0.882352941f, 0.956862745f, 1.0f },
+    { 0.305882353f, 0.882352941f, 0.952941176f, 1.0f },
+    { 0.333333333f, 0.88627451f, 0.949019608f, 1.0f },
+    { 0.356862745f, 0.88627451f, 0.945098039f, 1.0f },
+    { 0.380392157f, 0.890196078f, 0.941176471f, 1.0f },
+    { 0.403921569f, 0.890196078f, 0.937254902f, 1.0f },
+    { 0.42745098f, 0.890196078f, 0.933333333f, 1.0f },
+    { 0.450980392f, 0.894117647f, 0.929411765f, 1.0f },
+    { 0.474509804f, 0.894117647f, 0.925490196f, 1.0f },
+    { 0.498039216f, 0.898039216f, 0.925490196f, 1.0f },
+    { 0.521568627f, 0.898039216f, 0.921568627f, 1.0f },
+    { 0.545098039f, 0.898039216f, 0.917647059f, 1.0f },
+    { 0.568627451f, 0.901960784f, 0.91372549f, 1.0f },
+    { 0.592156863f, 0.901960784f, 0.909803922f, 1.0f },
+    { 0.615686275f, 0.901960784f, 0.905882353f, 1.0f },
+    { 0.639215686f, 0.905882353f, 0.901960784f, 1.0f },
+    { 0.666666667f, 0.905882353f, 0.898039216f, 1.0f },
+    { 0.690196078f, 0.909803922f, 0.894117647f, 1.0f },
+    { 0.71372549f, 0.909803922f, 0.890196078f, 1.0f },
+    { 0.737254902f, 0.909803922f, 0.88627451f, 1.0f },
+    { 0.760784314f, 0.91372549f, 0.88627451f, 1.0f },
+    { 0.784313725f, 0.91372549f, 0.882352941f, 1.0f },
+    { 0.807843137f, 0.91372549f, 0.878431373f, 1.0f },
+    { 0.831372549f, 0.917647059f, 0.874509804f, 1.0f },
+    { 0.854901961f, 0.917647059f, 0.870588235f, 1.0f },
+    { 0.878431373f, 0.921568627f, 0.866666667f, 1.0f },
+    { 0.901960784f, 0.921568627f, 0.862745098f, 1.0f },
+    { 0.925490196f, 0.921568627f, 0.858823529f, 1.0f },
+    { 0.949019608f, 0.925490196f, 0.854901961f, 1.0f },
+    { 0.97254902f, 0.925490196f, 0.850980392f, 1.0f },
+    { 1.0f, 0.929411765f, 0.850980392f, 1.0f },
+    { 1.0f, 0.921568627f, 0.82745098f, 1.0f },
+    { 1.0f, 0.917647059f, 0.807843137f, 1.0f },
+    { 1.0f, 0.91372549f, 0.788235294f, 1.0f },
+    { 1.0f, 0.905882353f, 0.768627451f, 1.0f },
+    { 1.0f, 0.901960784f, 0.749019608f, 1.0f },
+    { 1.0f, 0.898039216f, 0.729411765f, 1.0f },
+    { 1.0f, 0.890196078f, 0.709803922f, 1.0f },
+    { 1.0f, 0.88627451f, 0.690196078f, 1.0f },
+    { 1.0f, 0.882352941f, 0.670588235f, 1.0f },
+    { 1.0f, 0.874509804f, 0.650980392f, 1.0f },
+    { 1.0f, 0.870588235f, 0.631372549f, 1.0f },
+    { 1.0f, 0.866666667f, 0.611764706f, 1.0f },
+    { 1.0f, 0.858823529f, 0.592156863f, 1.0f },
+    { 1.0f, 0.854901961f, 0.57254902f, 1.0f },
+    { 1.0f, 0.850980392f, 0.552941176f, 1.0f },
+    { 1.0f, 0.843137255f, 0.533333333f, 1.0f },
+    { 1.0f, 0.839215686f, 0.51372549f, 1.0f },
+    { 1.0f, 0.835294118f, 0.494117647f, 1.0f },
+    { 1.0f, 0.82745098f, 0.474509804f, 1.0f },
+    { 1.0f, 0.823529412f, 0.454901961f, 1.0f },
+    { 1.0f, 0.819607843f, 0.435294118f, 1.0f },
+    { 1.0f, 0.811764706f, 0.411764706f, 1.0f },
+    { 1.0f, 0.807843137f, 0.392156863f, 1.0f },
+    { 1.0f, 0.803921569f, 0.37254902f, 1.0f },
+    { 1.0f, 0.796078431f, 0.352941176f, 1.0f },
+    { 1.0f, 0.792156863f, 0.333333333f, 1.0f },
+    { 1.0f, 0.788235294f, 0.31372549f, 1.0f },
+    { 1.0f, 0.780392157f, 0.294117647f, 1.0f },
+    { 1.0f, 0.776470588f, 0.274509804f, 1.0f },
+    { 1.0f, 0.77254902f, 0.254901961f, 1.0f },
+    { 1.0f, 0.764705882f, 0.235294118f, 1.0f },
+    { 1.0f, 0.760784314f, 0.215686275f, 1.0f },
+    { 1.0f, 0.756862745f, 0.196078431f, 1.0f },
+    { 1.0f, 0.749019608f, 0.176470588f, 1.0f },
+    { 1.0f, 0.745098039f, 0.156862745f, 1.0f },
+    { 1.0f, 0.741176471f, 0.137254902f, 1.0f },
+    { 1.0f, 0.733333333f, 0.117647059f, 1.0f },
+    { 1.0f, 0.729411765f, 0.0980392157f, 1.0f },
+    { 1.0f, 0.725490196f, 0.0784313725f, 1.0f },
+    { 1.0f, 0.717647059f, 0.0588235294f, 1.0f },
+    { 1.0f, 0.71372549f, 0.0392156863f, 1.0f },
+    { 1.0f, 0.709803922f, 0.0196078431f, 1.0f },
+    { 1.0f, 0.705882353f, 0.0f, 1.0f },
+    { 1.0f, 0.694117647f, 0.0f, 1.0f },
+    { 1.0f, 0.68627451f, 0.0f, 1.0f },
+    { 1.0f, 0.674509804f, 0.0f, 1.0f },
+    { 1.0f, 0.666666667f, 0.0f, 1.0f },
+    { 1.0f, 0.654901961f, 0.0f, 1.0f },
+    { 1.0f, 0.647058824f, 0.0f, 1.0f },
+    { 1.0f, 0.635294118f, 0.0f, 1.0f },
+    { 1.0f, 0.62745098f, 0.0f, 1.0f },
+    { 1.0f, 0.615686275f, 0.0f, 1.0f },
+    { 1.0f, 0.607843137f, 0.0f, 1.0f },
+    { 1.0f, 0.596078431f, 0.0f, 1.0f },
+    { 1.0f, 0.588235294f, 0.0f, 1.0f },
+    { 1.0f, 0.576470588f, 0.0f, 1.0f },
+    { 1.0f, 0.568627451f, 0.0f, 1.0f },
+    { 1.0f, 0.556862745f, 0.0f, 1.0f },
+    { 1.0f, 0.549019608f, 0.0f, 1.0f },
+    { 1.0f, 0.537254902f, 0.0f, 1.0f },
+    { 1.0f, 0.529411765f, 0.0f, 1.0f },
+    { 1.0f, 0.517647059f, 0.0f, 1.0f },
+    { 1.0f, 0.509803922f, 0.0f, 1.0f },
+    { 1.0f, 0.498039216f, 0.0f, 1.0f },
+    { 1.0f, 0.490196078f, 0.0f, 1.0f },
+    { 1.0f, 0.478431373f, 0.0f, 1.0f },
+    { 1.0f, 0.470588235f, 0.0f, 1.0f },
+    { 1.0f, 0.458823529f, 0.0f, 1.0f },
+    { 1.0f, 0.450980392f, 0.0f, 1.0f },
+    { 1.0f, 0.439215686f, 0.0f, 1.0f },
+    { 1.0f, 0.431372549f, 0.0f, 1.0f },
+    { 1.0f, 0.419607843f, 0.0f, 1.0f },
+    { 1.0f, 0.411764706f, 0.0f, 1.0f },
+    { 1.0f, 0.4f, 0.0f, 1.0f },
+    { 1.0f, 0.392156863f, 0.0f, 1.0f },
+    { 1.0f, 0.380392157f, 0.0f, 1.0f },
+    { 1.0f, 0.37254902f, 0.0f, 1.0f },
+    { 1.0f, 0.360784314f, 0.0f, 1.0f },
+    { 1.0f, 0.352941176f, 0.0f, 1.0f },
+    { 1.0f, 0.341176471f, 0.0f, 1.0f },
+    { 1.0f, 0.333333333f, 0.0f, 1.0f },
+    { 1.0f, 0.321568627f, 0.0f, 1.0f },
+    { 1.0f, 0.31372549f, 0.0f, 1.0f },
+    { 1.0f, 0.301960784f, 0.0f, 1.0f },
+    { 1.0f, 0.294117647f, 0.0f, 1.0f },
+    { 0.984313725f, 0.28627451f, 0.0f, 1.0f },
+    { 0.968627451f, 0.278431373f, 0.0f, 1.0f },
+    { 0.956862745f, 0.270588235f, 0.0f, 1.0f },
+    { 0.941176471f, 0.266666667f, 0.0f, 1.0f },
+    { 0.925490196f, 0.258823529f, 0.0f, 1.0f },
+    { 0.91372549f, 0.250980392f, 0.0f, 1.0f },
+    { 0.898039216f, 0.243137255f, 0.0f, 1.0f },
+    { 0.88627451f, 0.239215686f, 0.0f, 1.0f },
+    { 0.870588235f, 0.231372549f, 0.0f, 1.0f },
+    { 0.854901961f, 0.223529412f, 0.0f, 1.0f },
+    { 0.843137255f, 0.215686275f, 0.0f, 1.0f },
+    { 0.82745098f, 0.211764706f, 0.0f, 1.0f },
+    { 0.815686275f, 0.203921569f, 0.0f, 1.0f },
+    { 0.8f, 0.196078431f, 0.0f, 1.0f },
+    { 0.784313725f, 0.188235294f, 0.0f, 1.0f },
+    { 0.77254902f, 0.184313725f, 0.0f, 1.0f },
+    { 0.756862745f, 0.176470588f, 0.0f, 1.0f },
+    { 0.745098039f, 0.168627451f, 0.0f, 1.0f },
+    { 0.729411765f, 0.160784314f, 0.0f, 1.0f },
+    { 0.71372549f, 0.156862745f, 0.0f, 1.0f },
+    { 0.701960784f, 0.149019608f, 0.0f, 1.0f },
+    { 0.68627451f, 0.141176471f, 0.0f, 1.0f },
+    { 0.674509804f, 0.133333333f, 0.0f, 1.0f },
+    { 0.658823529f, 0.129411765f, 0.0f, 1.0f },
+    { 0.643137255f, 0.121568627f, 0.0f, 1.0f },
+    { 0.631372549f, 0.11372549f, 0.0f, 1.0f },
+    { 0.615686275f, 0.105882353f, 0.0f, 1.0f },
+    { 0.603921569f, 0.101960784f, 0.0f, 1.0f },
+    { 0.588235294f, 0.0941176471f, 0.0f, 1.0f },
+    { 0.57254902f, 0.0862745098f, 0.0f, 1.0f },
+    { 0.560784314f, 0.0784313725f, 0.0f, 1.0f },
+    { 0.545098039f, 0.0745098039f, 0.0f, 1.0f },
+    { 0.533333333f, 0.0666666667f, 0.0f, 1.0f },
+    { 0.517647059f, 0.0588235294f, 0.0f, 1.0f },
+    { 0.501960784f, 0.0509803922f, 0.0f, 1.0f },
+    { 0.490196078f, 0.0470588235f, 0.0f, 1.0f },
+    { 0.474509804f, 0.0392156863f, 0.0f, 1.0f },
+    { 0.462745098f, 0.031372549f, 0.0f, 1.0f },
+    { 0.447058824f, 0.0235294118f, 0.0f, 1.0f },
+    { 0.431372549f, 0.0196078431f, 0.0f, 1.0f },
+    { 0.419607843f, 0.0117647059f, 0.0f, 1.0f },
+    { 0.403921569f, 0.00392156863f, 0.0f, 1.0f },
+    { 0.392156863f, 0.0f, 0.0f, 1.0f },
+};
+
+static const float Python_RdBu_LUT[256][4] = {
+    { 0.0196078431f, 0.188235294f, 0.380392157f, 1.0f },
+    { 0.0239138793f, 0.196539792f, 0.391926182f, 1.0f },
+    { 0.0282199154f, 0.204844291f, 0.403460208f, 1.0f },
+    { 0.0325259516f, 0.213148789f, 0.414994233f, 1.0f },
+    { 0.0368319877f, 0.221453287f, 0.426528258f, 1.0f },
+    { 0.0411380238f, 0.229757785f, 0.438062284f, 1.0f },
+    { 0.04544406f, 0.238062284f, 0.449596309f, 1.0f },
+    { 0.0497500961f, 0.246366782f, 0.461130334f, 1.0f },
+    { 0.0540561323f, 0.25467128f, 0.47266436f, 1.0f },
+    { 0.0583621684f, 0.262975779f, 0.484198385f, 1.0f },
+    { 0.0626682045f, 0.271280277f, 0.495732411f, 1.0f },
+    { 0.0669742407f, 0.279584775f, 0.507266436f, 1.0f },
+    { 0.0712802768f, 0.287889273f, 0.518800461f, 1.0f },
+    { 0.075586313f, 0.296193772f, 0.530334487f, 1.0f },
+    { 0.0798923491f, 0.30449827f, 0.541868512f, 1.0f },
+    { 0.0841983852f, 0.312802768f, 0.553402537f, 1.0f },
+    { 0.0885044214f, 0.321107266f, 0.564936563f, 1.0f },
+    { 0.0928104575f, 0.329411765f, 0.576470588f, 1.0f },
+    { 0.0971164937f, 0.337716263f, 0.588004614f, 1.0f },
+    { 0.10142253f, 0.346020761f, 0.599538639f, 1.0f },
+    { 0.105728566f, 0.35432526f, 0.611072664f, 1.0f },
+    { 0.110034602f, 0.362629758f, 0.62260669f, 1.0f },
+    { 0.114340638f, 0.370934256f, 0.634140715f, 1.0f },
+    { 0.118646674f, 0.379238754f, 0.64567474f, 1.0f },
+    { 0.12295271f, 0.387543253f, 0.657208766f, 1.0f },
+    { 0.127258747f, 0.395847751f, 0.668742791f, 1.0f },
+    { 0.132026144f, 0.403460208f, 0.676278354f, 1.0f },
+    { 0.137254902f, 0.410380623f, 0.679815456f, 1.0f },
+    { 0.14248366f, 0.417301038f, 0.683352557f, 1.0f },
+    { 0.147712418f, 0.424221453f, 0.686889658f, 1.0f },
+    { 0.152941176f, 0.431141869f, 0.690426759f, 1.0f },
+    { 0.158169935f, 0.438062284f, 0.69396386f, 1.0f },
+    { 0.163398693f, 0.444982699f, 0.697500961f, 1.0f },
+    { 0.168627451f, 0.451903114f, 0.701038062f, 1.0f },
+    { 0.173856209f, 0.458823529f, 0.704575163f, 1.0f },
+    { 0.179084967f, 0.465743945f, 0.708112265f, 1.0f },
+    { 0.184313725f, 0.47266436f, 0.711649366f, 1.0f },
+    { 0.189542484f, 0.479584775f, 0.715186467f, 1.0f },
+    { 0.194771242f, 0.48650519f, 0.718723568f, 1.0f },
+    { 0.2f, 0.493425606f, 0.722260669f, 1.0f },
+    { 0.205228758f, 0.500346021f, 0.72579777f, 1.0f },
+    { 0.210457516f, 0.507266436f, 0.729334871f, 1.0f },
+    { 0.215686275f, 0.514186851f, 0.732871972f, 1.0f },
+    { 0.220915033f, 0.521107266f, 0.736409073f, 1.0f },
+    { 0.226143791f, 0.528027682f, 0.739946175f, 1.0f },
+    { 0.231372549f, 0.534948097f, 0.743483276f, 1.0f },
+    { 0.236601307f, 0.541868512f, 0.747020377f, 1.0f },
+    { 0.241830065f, 0.548788927f, 0.750557478f, 1.0f },
+    { 0.247058824f, 0.555709343f, 0.754094579f, 1.0f },
+    { 0.252287582f, 0.562629758f, 0.75763168f, 1.0f },
+    { 0.25751634f, 0.569550173f, 0.761168781f, 1.0f },
+    { 0.262745098f, 0.576470588f, 0.764705882f, 1.0f },
+    { 0.274894271f, 0.584159938f, 0.768858131f, 1.0f },
+    { 0.287043445f, 0.591849289f, 0.773010381f, 1.0f },
+    { 0.299192618f, 0.599538639f, 0.77716263f, 1.0f },
+    { 0.311341792f, 0.607227989f, 0.781314879f, 1.0f },
+    { 0.323490965f, 0.614917339f, 0.785467128f, 1.0f },
+    { 0.335640138f, 0.62260669f, 0.789619377f, 1.0f },
+    { 0.347789312f, 0.63029604f, 0.793771626f, 1.0f },
+    { 0.359938485f, 0.63798539f, 0.797923875f, 1.0f },
+    { 0.372087659f, 0.64567474f, 0.802076125f, 1.0f },
+    { 0.384236832f, 0.653364091f, 0.806228374f, 1.0f },
+    { 0.396386005f, 0.661053441f, 0.810380623f, 1.0f },
+    { 0.408535179f, 0.668742791f, 0.814532872f, 1.0f },
+    { 0.420684352f, 0.676432141f, 0.818685121f, 1.0f },
+    { 0.432833526f, 0.684121492f, 0.82283737f, 1.0f },
+    { 0.444982699f, 0.691810842f, 0.826989619f, 1.0f },
+    { 0.457131872f, 0.699500192f, 0.831141869f, 1.0f },
+    { 0.469281046f, 0.707189542f, 0.835294118f, 1.0f },
+    { 0.481430219f, 0.714878893f, 0.839446367f, 1.0f },
+    { 0.493579393f, 0.722568243f, 0.843598616f, 1.0f },
+    { 0.505728566f, 0.730257593f, 0.847750865f, 1.0f },
+    { 0.517877739f, 0.737946943f, 0.851903114f, 1.0f },
+    { 0.530026913f, 0.745636294f, 0.856055363f, 1.0f },
+    { 0.542176086f, 0.753325644f, 0.860207612f, 1.0f },
+    { 0.55432526f, 0.761014994f, 0.864359862f, 1.0f },
+    { 0.566474433f, 0.768704344f, 0.868512111f, 1.0f },
+    { 0.57739331f, 0.775009612f, 0.871972318f, 1.0f },
+    { 0.587081892f, 0.779930796f, 0.874740484f, 1.0f },
+    { 0.596770473f, 0.78485198f, 0.877508651f, 1.0f },
+    { 0.606459054f, 0.789773164f, 0.880276817f, 1.0f },
+    { 0.616147636f, 0.794694348f, 0.883044983f, 1.0f },
+    { 0.625836217f, 0.799615532f, 0.885813149f, 1.0f },
+    { 0.635524798f, 0.804536717f, 0.888581315f, 1.0f },
+    { 0.645213379f, 0.809457901f, 0.891349481f, 1.0f },
+    { 0.654901961f, 0.814379085f, 0.894117647f, 1.0f },
+    { 0.664590542f, 0.819300269f, 0.896885813f, 1.0f },
+    { 0.674279123f, 0.824221453f, 0.899653979f, 1.0f },
+    { 0.683967705f, 0.829142637f, 0.902422145f, 1.0f },
+    { 0.693656286f, 0.834063822f, 0.905190311f, 1.0f },
+    { 0.703344867f, 0.838985006f, 0.907958478f, 1.0f },
+    { 0.713033449f, 0.84390619f, 0.910726644f, 1.0f },
+    { 0.72272203f, 0.848827374f, 0.91349481f, 1.0f },
+    { 0.732410611f, 0.853748558f, 0.916262976f, 1.0f },
+    { 0.742099193f, 0.858669742f, 0.919031142f, 1.0f },
+    { 0.751787774f, 0.863590927f, 0.921799308f, 1.0f },
+    { 0.761476355f, 0.868512111f, 0.924567474f, 1.0f },
+    { 0.771164937f, 0.873433295f, 0.92733564f, 1.0f },
+    { 0.780853518f, 0.878354479f, 0.930103806f, 1.0f },
+    { 0.790542099f, 0.883275663f, 0.932871972f, 1.0f },
+    { 0.800230681f, 0.888196847f, 0.935640138f, 1.0f },
+    { 0.809919262f, 0.893118032f, 0.938408304f, 1.0f },
+    { 0.819607843f, 0.898039216f, 0.941176471f, 1.0f },
+    { 0.825451749f, 0.900807382f, 0.94225298f, 1.0f },
+    { 0.831295656f, 0.903575548f, 0.943329489f, 1.0f },
+    { 0.837139562f, 0.906343714f, 0.944405998f, 1.0f },
+    { 0.842983468f, 0.90911188f, 0.945482507f, 1.0f },
+    { 0.848827374f, 0.911880046f, 0.946559016f, 1.0f },
+    { 0.85467128f, 0.914648212f, 0.947635525f, 1.0f },
+    { 0.860515186f, 0.917416378f, 0.948712034f, 1.0f },
+    { 0.866359093f, 0.920184544f, 0.949788543f, 1.0f },
+    { 0.872202999f, 0.92295271f, 0.950865052f, 1.0f },
+    { 0.878046905f, 0.925720877f, 0.951941561f, 1.0f },
+    { 0.883890811f, 0.928489043f, 0.95301807f, 1.0f },
+    { 0.889734717f, 0.931257209f, 0.954094579f, 1.0f },
+    { 0.895578624f, 0.934025375f, 0.955171088f, 1.0f },
+    { 0.90142253f, 0.936793541f, 0.956247597f, 1.0f },
+    { 0.907266436f, 0.939561707f, 0.957324106f, 1.0f },
+    { 0.913110342f, 0.942329873f, 0.958400615f, 1.0f },
+    { 0.918954248f, 0.945098039f, 0.959477124f, 1.0f },
+    { 0.924798155f, 0.947866205f, 0.960553633f, 1.0f },
+    { 0.930642061f, 0.950634371f, 0.961630142f, 1.0f },
+    { 0.936485967f, 0.953402537f, 0.962706651f, 1.0f },
+    { 0.942329873f, 0.956170704f, 0.96378316f, 1.0f },
+    { 0.948173779f, 0.95893887f, 0.964859669f, 1.0f },
+    { 0.954017686f, 0.961707036f, 0.965936178f, 1.0f },
+    { 0.959861592f, 0.964475202f, 0.967012687f, 1.0f },
+    { 0.965705498f, 0.967243368f, 0.968089196f, 1.0f },
+    { 0.969088812f, 0.966474433f, 0.964936563f, 1.0f },
+    { 0.970011534f, 0.962168397f, 0.957554787f, 1.0f },
+    { 0.970934256f, 0.957862361f, 0.95017301f, 1.0f },
+    { 0.971856978f, 0.953556324f, 0.942791234f, 1.0f },
+    { 0.9727797f, 0.949250288f, 0.935409458f, 1.0f },
+    { 0.973702422f, 0.944944252f, 0.928027682f, 1.0f },
+    { 0.974625144f, 0.940638216f, 0.920645905f, 1.0f },
+    { 0.975547866f, 0.93633218f, 0.913264129f, 1.0f },
+    { 0.976470588f, 0.932026144f, 0.905882353f, 1.0f },
+    { 0.97739331f, 0.927720108f, 0.898500577f, 1.0f },
+    { 0.978316032f, 0.923414072f, 0.8911188f, 1.0f },
+    { 0.979238754f, 0.919108035f, 0.883737024f, 1.0f },
+    { 0.980161476f, 0.914801999f, 0.876355248f, 1.0f },
+    { 0.981084198f, 0.910495963f, 0.868973472f, 1.0f },
+    { 0.98200692f, 0.906189927f, 0.861591696f, 1.0f },
+    { 0.982929642f, 0.901883891f, 0.854209919f, 1.0f },
+    { 0.983852364f, 0.897577855f, 0.846828143f, 1.0f },
+    { 0.984775087f, 0.893271819f, 0.839446367f, 1.0f },
+    { 0.985697809f, 0.888965782f, 0.832064591f, 1.0f },
+    { 0.986620531f, 0.884659746f, 0.824682814f, 1.0f },
+    { 0.987543253f, 0.88035371f, 0.817301038f, 1.0f },
+    { 0.988465975f, 0.876047674f, 0.809919262f, 1.0f },
+    { 0.989388697f, 0.871741638f, 0.802537486f, 1.0f },
+    { 0.990311419f, 0.867435602f, 0.795155709f, 1.0f },
+    { 0.991234141f, 0.863129566f, 0.787773933f, 1.0f },
+    { 0.992156863f, 0.858823529f, 0.780392157f, 1.0f },
+    { 0.99077278f, 0.850519031f, 0.769780854f, 1.0f },
+    { 0.989388697f, 0.842214533f, 0.75916955f, 1.0f },
+    { 0.988004614f, 0.833910035f, 0.748558247f, 1.0f },
+    { 0.986620531f, 0.825605536f, 0.737946943f, 1.0f },
+    { 0.985236448f, 0.817301038f, 0.72733564f, 1.0f },
+    { 0.983852364f, 0.80899654f, 0.716724337f, 1.0f },
+    { 0.982468281f, 0.800692042f, 0.706113033f, 1.0f },
+    { 0.981084198f, 0.792387543f, 0.69550173f, 1.0f },
+    { 0.979700115f, 0.784083045f, 0.684890427f, 1.0f },
+    { 0.978316032f, 0.775778547f, 0.674279123f, 1.0f },
+    { 0.976931949f, 0.767474048f, 0.66366782f, 1.0f },
+    { 0.975547866f, 0.75916955f, 0.653056517f, 1.0f },
+    { 0.974163783f, 0.750865052f, 0.642445213f, 1.0f },
+    { 0.9727797f, 0.742560554f, 0.63183391f, 1.0f },
+    { 0.971395617f, 0.734256055f, 0.621222607f, 1.0f },
+    { 0.970011534f, 0.725951557f, 0.610611303f, 1.0f },
+    { 0.968627451f, 0.717647059f, 0.6f, 1.0f },
+    { 0.967243368f, 0.709342561f, 0.589388697f, 1.0f },
+    { 0.965859285f, 0.701038062f, 0.578777393f, 1.0f },
+    { 0.964475202f, 0.692733564f, 0.56816609f, 1.0f },
+    { 0.963091119f, 0.684429066f, 0.557554787f, 1.0f },
+    { 0.961707036f, 0.676124567f, 0.546943483f, 1.0f },
+    { 0.960322953f, 0.667820069f, 0.53633218f, 1.0f },
+    { 0.95893887f, 0.659515571f, 0.525720877f, 1.0f },
+    { 0.957554787f, 0.651211073f, 0.515109573f, 1.0f },
+    { 0.95455594f, 0.641753172f, 0.505728566f, 1.0f },
+    { 0.94994233f, 0.631141869f, 0.497577855f, 1.0f },
+    { 0.94532872f, 0.620530565f, 0.489427143f, 1.0f },
+    { 0.94071511f, 0.609919262f, 0.481276432f, 1.0f },
+    { 0.936101499f, 0.599307958f, 0.473125721f, 1.0f },
+    { 0.931487889f, 0.588696655f, 0.46497501f, 1.0f },
+    { 0.926874279f, 0.578085352f, 0.456824298f, 1.0f },
+    { 0.922260669f, 0.567474048f, 0.448673587f, 1.0f },
+    { 0.917647059f, 0.556862745f, 0.440522876f, 1.0f },
+    { 0.913033449f, 0.546251442f, 0.432372165f, 1.0f },
+    { 0.908419839f, 0.535640138f, 0.424221453f, 1.0f },
+    { 0.903806228f, 0.525028835f, 0.416070742f, 1.0f },
+    { 0.899192618f, 0.514417532f, 0.407920031f, 1.0f },
+    { 0.894579008f, 0.503806228f, 0.399769319f, 1.0f },
+    { 0.889965398f, 0.493194925f, 0.391618608f, 1.0f },
+    { 0.885351788f, 0.482583622f, 0.383467897f, 1.0f },
+    { 0.880738178f, 0.471972318f, 0.375317186f, 1.0f },
+    { 0.876124567f, 0.461361015f, 0.367166474f, 1.0f },
+    { 0.871510957f, 0.450749712f, 0.359015763f, 1.0f },
+    { 0.866897347f, 0.440138408f, 0.350865052f, 1.0f },
+    { 0.862283737f, 0.429527105f, 0.342714341f, 1.0f },
+    { 0.857670127f, 0.418915802f, 0.334563629f, 1.0f },
+    { 0.853056517f, 0.408304498f, 0.326412918f, 1.0f },
+    { 0.848442907f, 0.397693195f, 0.318262207f, 1.0f },
+    { 0.843829296f, 0.387081892f, 0.310111496f, 1.0f },
+    { 0.839215686f, 0.376470588f, 0.301960784f, 1.0f },
+    { 0.833679354f, 0.365397924f, 0.296732026f, 1.0f },
+    { 0.828143022f, 0.35432526f, 0.291503268f, 1.0f },
+    { 0.82260669f, 0.343252595f, 0.28627451f, 1.0f },
+    { 0.817070358f, 0.332179931f, 0.281045752f, 1.0f },
+    { 0.811534025f, 0.321107266f, 0.275816993f, 1.0f },
+    { 0.805997693f, 0.310034602f, 0.270588235f, 1.0f },
+    { 0.800461361f, 0.298961938f, 0.265359477f, 1.0f },
+    { 0.794925029f, 0.287889273f, 0.260130719f, 1.0f },
+    { 0.789388697f, 0.276816609f, 0.254901961f, 1.0f },
+    { 0.783852364f, 0.265743945f, 0.249673203f, 1.0f },
+    { 0.778316032f, 0.25467128f, 0.244444444f, 1.0f },
+    { 0.7727797f, 0.243598616f, 0.239215686f, 1.0f },
+    { 0.767243368f, 0.232525952f, 0.233986928f, 1.0f },
+    { 0.761707036f, 0.221453287f, 0.22875817f, 1.0f },
+    { 0.756170704f, 0.210380623f, 0.223529412f, 1.0f },
+    { 0.750634371f, 0.199307958f, 0.218300654f, 1.0f },
+    { 0.745098039f, 0.188235294f, 0.213071895f, 1.0f },
+    { 0.739561707f, 0.17716263f, 0.207843137f, 1.0f },
+    { 0.734025375f, 0.166089965f, 0.202614379f, 1.0f },
+    { 0.728489043f, 0.155017301f, 0.197385621f, 1.0f },
+    { 0.72295271f, 0.143944637f, 0.192156863f, 1.0f },
+    { 0.717416378f, 0.132871972f, 0.186928105f, 1.0f },
+    { 0.711880046f, 0.121799308f, 0.181699346f, 1.0f },
+    { 0.706343714f, 0.110726644f, 0.176470588f, 1.0f },
+    { 0.700807382f, 0.0996539792f, 0.17124183f, 1.0f },
+    { 0.692272203f, 0.092272203f, 0.167704729f, 1.0f },
+    { 0.680738178f, 0.0885813149f, 0.165859285f, 1.0f },
+    { 0.669204152f, 0.0848904268f, 0.164013841f, 1.0f },
+    { 0.657670127f, 0.0811995386f, 0.162168397f, 1.0f },
+    { 0.646136101f, 0.0775086505f, 0.160322953f, 1.0f },
+    { 0.634602076f, 0.0738177624f, 0.158477509f, 1.0f },
+    { 0.623068051f, 0.0701268743f, 0.156632065f, 1.0f },
+    { 0.611534025f, 0.0664359862f, 0.154786621f, 1.0f },
+    { 0.6f, 0.062745098f, 0.152941176f, 1.0f },
+    { 0.588465975f, 0.0590542099f, 0.151095732f, 1.0f },
+    { 0.576931949f, 0.0553633218f, 0.149250288f, 1.0f },
+    { 0.565397924f, 0.0516724337f, 0.147404844f, 1.0f },
+    { 0.553863899f, 0.0479815456f, 0.1455594f, 1.0f },
+    { 0.542329873f, 0.0442906574f, 0.143713956f, 1.0f },
+    { 0.530795848f, 0.0405997693f, 0.141868512f, 1.0f },
+    { 0.519261822f, 0.0369088812f, 0.140023068f, 1.0f },
+    { 0.507727797f, 0.0332179931f, 0.138177624f, 1.0f },
+    { 0.496193772f, 0.029527105f, 0.13633218f, 1.0f },
+    { 0.484659746f, 0.0258362168f, 0.134486736f, 1.0f },
+    { 0.473125721f, 0.0221453287f, 0.132641292f, 1.0f },
+    { 0.461591696f, 0.0184544406f, 0.130795848f, 1.0f },
+    { 0.45005767f, 0.0147635525f, 0.128950404f, 1.0f },
+    { 0.438523645f, 0.0110726644f, 0.12710496f, 1.0f },
+    { 0.426989619f, 0.00738177624f, 0.125259516f, 1.0f },
+    { 0.415455594f, 0.00369088812f, 0.123414072f, 1.0f },
+    { 0.403921569f, 0.0f, 0.121568627f, 1.0f },
+};
+
+static const float Python_Spectral_LUT[256][4] = {
+    { 0.368627451f, 0.309803922f, 0.635294118f, 1.0f },
+    { 0.361860823f, 0.318569781f, 0.639446367f, 1.0f },
+    { 0.355094195f, 0.32733564f, 0.643598616f, 1.0f },
+    { 0.348327566f, 0.336101499f, 0.647750865f, 1.0f },
+    { 0.341560938f, 0.344867359f, 0.651903114f, 1.0f },
+    { 0.33479431f, 0.353633218f, 0.656055363f, 1.0f },
+    { 0.328027682f, 0.362399077f, 0.660207612f, 1.0f },
+    { 0.321261053f, 0.371164937f, 0.664359862f, 1.0f },
+    { 0.314494425f, 0.379930796f, 0.668512111f, 1.0f },
+    { 0.307727797f, 0.388696655f, 0.67266436f, 1.0f },
+    { 0.300961169f, 0.397462514f, 0.676816609f, 1.0f },
+    { 0.294194541f, 0.406228374f, 0.680968858f, 1.0f },
+    { 0.287427912f, 0.414994233f, 0.685121107f, 1.0f },
+    { 0.280661284f, 0.423760092f, 0.689273356f, 1.0f },
+    { 0.273894656f, 0.432525952f, 0.693425606f, 1.0f },
+    { 0.267128028f, 0.441291811f, 0.697577855f, 1.0f },
+    { 0.260361399f, 0.45005767f, 0.701730104f, 1.0f },
+    { 0.253594771f, 0.458823529f, 0.705882353f, 1.0f },
+    { 0.246828143f, 0.467589389f, 0.710034602f, 1.0f },
+    { 0.240061515f, 0.476355248f, 0.714186851f, 1.0f },
+    { 0.233294887f, 0.485121107f, 0.7183391f, 1.0f },
+    { 0.226528258f, 0.493886967f, 0.722491349f, 1.0f },
+    { 0.21976163f, 0.502652826f, 0.726643599f, 1.0f },
+    { 0.212995002f, 0.511418685f, 0.730795848f, 1.0f },
+    { 0.206228374f, 0.520184544f, 0.734948097f, 1.0f },
+    { 0.199461745f, 0.528950404f, 0.739100346f, 1.0f },
+    { 0.200076894f, 0.537793156f, 0.739331027f, 1.0f },
+    { 0.208073818f, 0.546712803f, 0.735640138f, 1.0f },
+    { 0.216070742f, 0.555632449f, 0.73194925f, 1.0f },
+    { 0.224067666f, 0.564552095f, 0.728258362f, 1.0f },
+    { 0.232064591f, 0.573471742f, 0.724567474f, 1.0f },
+    { 0.240061515f, 0.582391388f, 0.720876586f, 1.0f },
+    { 0.248058439f, 0.591311034f, 0.717185698f, 1.0f },
+    { 0.256055363f, 0.600230681f, 0.71349481f, 1.0f },
+    { 0.264052288f, 0.609150327f, 0.709803922f, 1.0f },
+    { 0.272049212f, 0.618069973f, 0.706113033f, 1.0f },
+    { 0.280046136f, 0.626989619f, 0.702422145f, 1.0f },
+    { 0.28804306f, 0.635909266f, 0.698731257f, 1.0f },
+    { 0.296039985f, 0.644828912f, 0.695040369f, 1.0f },
+    { 0.304036909f, 0.653748558f, 0.691349481f, 1.0f },
+    { 0.312033833f, 0.662668205f, 0.687658593f, 1.0f },
+    { 0.320030757f, 0.671587851f, 0.683967705f, 1.0f },
+    { 0.328027682f, 0.680507497f, 0.680276817f, 1.0f },
+    { 0.336024606f, 0.689427143f, 0.676585928f, 1.0f },
+    { 0.34402153f, 0.69834679f, 0.67289504f, 1.0f },
+    { 0.352018454f, 0.707266436f, 0.669204152f, 1.0f },
+    { 0.360015379f, 0.716186082f, 0.665513264f, 1.0f },
+    { 0.368012303f, 0.725105729f, 0.661822376f, 1.0f },
+    { 0.376009227f, 0.734025375f, 0.658131488f, 1.0f },
+    { 0.384006151f, 0.742945021f, 0.6544406f, 1.0f },
+    { 0.392003076f, 0.751864667f, 0.650749712f, 1.0f },
+    { 0.4f, 0.760784314f, 0.647058824f, 1.0f },
+    { 0.410611303f, 0.764936563f, 0.646905037f, 1.0f },
+    { 0.421222607f, 0.769088812f, 0.64675125f, 1.0f },
+    { 0.43183391f, 0.773241061f, 0.646597463f, 1.0f },
+    { 0.442445213f, 0.77739331f, 0.646443676f, 1.0f },
+    { 0.453056517f, 0.781545559f, 0.646289889f, 1.0f },
+    { 0.46366782f, 0.785697809f, 0.646136101f, 1.0f },
+    { 0.474279123f, 0.789850058f, 0.645982314f, 1.0f },
+    { 0.484890427f, 0.794002307f, 0.645828527f, 1.0f },
+    { 0.49550173f, 0.798154556f, 0.64567474f, 1.0f },
+    { 0.506113033f, 0.802306805f, 0.645520953f, 1.0f },
+    { 0.516724337f, 0.806459054f, 0.645367166f, 1.0f },
+    { 0.52733564f, 0.810611303f, 0.645213379f, 1.0f },
+    { 0.537946943f, 0.814763552f, 0.645059592f, 1.0f },
+    { 0.548558247f, 0.818915802f, 0.644905805f, 1.0f },
+    { 0.55916955f, 0.823068051f, 0.644752018f, 1.0f },
+    { 0.569780854f, 0.8272203f, 0.644598231f, 1.0f },
+    { 0.580392157f, 0.831372549f, 0.644444444f, 1.0f },
+    { 0.59100346f, 0.835524798f, 0.644290657f, 1.0f },
+    { 0.601614764f, 0.839677047f, 0.64413687f, 1.0f },
+    { 0.612226067f, 0.843829296f, 0.643983083f, 1.0f },
+    { 0.62283737f, 0.847981546f, 0.643829296f, 1.0f },
+    { 0.633448674f, 0.852133795f, 0.643675509f, 1.0f },
+    { 0.644059977f, 0.856286044f, 0.643521722f, 1.0f },
+    { 0.65467128f, 0.860438293f, 0.643367935f, 1.0f },
+    { 0.665282584f, 0.864590542f, 0.643214148f, 1.0f },
+    { 0.675124952f, 0.868512111f, 0.642214533f, 1.0f },
+    { 0.684198385f, 0.872202999f, 0.640369089f, 1.0f },
+    { 0.693271819f, 0.875893887f, 0.638523645f, 1.0f },
+    { 0.702345252f, 0.879584775f, 0.636678201f, 1.0f },
+    { 0.711418685f, 0.883275663f, 0.634832757f, 1.0f },
+    { 0.720492118f, 0.886966551f, 0.632987313f, 1.0f },
+    { 0.729565552f, 0.890657439f, 0.631141869f, 1.0f },
+    { 0.738638985f, 0.894348328f, 0.629296424f, 1.0f },
+    { 0.747712418f, 0.898039216f, 0.62745098f, 1.0f },
+    { 0.756785852f, 0.901730104f, 0.625605536f, 1.0f },
+    { 0.765859285f, 0.905420992f, 0.623760092f, 1.0f },
+    { 0.774932718f, 0.90911188f, 0.621914648f, 1.0f },
+    { 0.784006151f, 0.912802768f, 0.620069204f, 1.0f },
+    { 0.793079585f, 0.916493656f, 0.61822376f, 1.0f },
+    { 0.802153018f, 0.920184544f, 0.616378316f, 1.0f },
+    { 0.811226451f, 0.923875433f, 0.614532872f, 1.0f },
+    { 0.820299885f, 0.927566321f, 0.612687428f, 1.0f },
+    { 0.829373318f, 0.931257209f, 0.610841984f, 1.0f },
+    { 0.838446751f, 0.934948097f, 0.60899654f, 1.0f },
+    { 0.847520185f, 0.938638985f, 0.607151096f, 1.0f },
+    { 0.856593618f, 0.942329873f, 0.605305652f, 1.0f },
+    { 0.865667051f, 0.946020761f, 0.603460208f, 1.0f },
+    { 0.874740484f, 0.949711649f, 0.601614764f, 1.0f },
+    { 0.883813918f, 0.953402537f, 0.599769319f, 1.0f },
+    { 0.892887351f, 0.957093426f, 0.597923875f, 1.0f },
+    { 0.901960784f, 0.960784314f, 0.596078431f, 1.0f },
+    { 0.905805459f, 0.962322184f, 0.602076125f, 1.0f },
+    { 0.909650135f, 0.963860054f, 0.608073818f, 1.0f },
+    { 0.91349481f, 0.965397924f, 0.614071511f, 1.0f },
+    { 0.917339485f, 0.966935794f, 0.620069204f, 1.0f },
+    { 0.92118416f, 0.968473664f, 0.626066897f, 1.0f },
+    { 0.925028835f, 0.970011534f, 0.632064591f, 1.0f },
+    { 0.92887351f, 0.971549404f, 0.638062284f, 1.0f },
+    { 0.932718185f, 0.973087274f, 0.644059977f, 1.0f },
+    { 0.93656286f, 0.974625144f, 0.65005767f, 1.0f },
+    { 0.940407536f, 0.976163014f, 0.656055363f, 1.0f },
+    { 0.944252211f, 0.977700884f, 0.662053057f, 1.0f },
+    { 0.948096886f, 0.979238754f, 0.66805075f, 1.0f },
+    { 0.951941561f, 0.980776624f, 0.674048443f, 1.0f },
+    { 0.955786236f, 0.982314494f, 0.680046136f, 1.0f },
+    { 0.959630911f, 0.983852364f, 0.686043829f, 1.0f },
+    { 0.963475586f, 0.985390235f, 0.692041522f, 1.0f },
+    { 0.967320261f, 0.986928105f, 0.698039216f, 1.0f },
+    { 0.971164937f, 0.988465975f, 0.704036909f, 1.0f },
+    { 0.975009612f, 0.990003845f, 0.710034602f, 1.0f },
+    { 0.978854287f, 0.991541715f, 0.716032295f, 1.0f },
+    { 0.982698962f, 0.993079585f, 0.722029988f, 1.0f },
+    { 0.986543637f, 0.994617455f, 0.728027682f, 1.0f },
+    { 0.990388312f, 0.996155325f, 0.734025375f, 1.0f },
+    { 0.994232987f, 0.997693195f, 0.740023068f, 1.0f },
+    { 0.998077662f, 0.999231065f, 0.746020761f, 1.0f },
+    { 0.999923106f, 0.997616301f, 0.745021146f, 1.0f },
+    { 0.999769319f, 0.992848904f, 0.737024221f, 1.0f },
+    { 0.999615532f, 0.988081507f, 0.729027297f, 1.0f },
+    { 0.999461745f, 0.98331411f, 0.721030373f, 1.0f },
+    { 0.999307958f, 0.978546713f, 0.713033449f, 1.0f },
+    { 0.999154171f, 0.973779316f, 0.705036524f, 1.0f },
+    { 0.999000384f, 0.969011918f, 0.6970396f, 1.0f },
+    { 0.998846597f, 0.964244521f, 0.689042676f, 1.0f },
+    { 0.99869281f, 0.959477124f, 0.681045752f, 1.0f },
+    { 0.998539023f, 0.954709727f, 0.673048827f, 1.0f },
+    { 0.998385236f, 0.94994233f, 0.665051903f, 1.0f },
+    { 0.998231449f, 0.945174933f, 0.657054979f, 1.0f },
+    { 0.998077662f, 0.940407536f, 0.649058055f, 1.0f },
+    { 0.997923875f, 0.935640138f, 0.64106113f, 1.0f },
+    { 0.997770088f, 0.930872741f, 0.633064206f, 1.0f },
+    { 0.997616301f, 0.926105344f, 0.625067282f, 1.0f },
+    { 0.997462514f, 0.921337947f, 0.617070358f, 1.0f },
+    { 0.997308727f, 0.91657055f, 0.609073433f, 1.0f },
+    { 0.99715494f, 0.911803153f, 0.601076509f, 1.0f },
+    { 0.997001153f, 0.907035755f, 0.593079585f, 1.0f },
+    { 0.996847366f, 0.902268358f, 0.585082661f, 1.0f },
+    { 0.996693579f, 0.897500961f, 0.577085736f, 1.0f },
+    { 0.996539792f, 0.892733564f, 0.569088812f, 1.0f },
+    { 0.996386005f, 0.887966167f, 0.561091888f, 1.0f },
+    { 0.996232218f, 0.88319877f, 0.553094963f, 1.0f },
+    { 0.996078431f, 0.878431373f, 0.545098039f, 1.0f },
+    { 0.995924644f, 0.870742022f, 0.538638985f, 1.0f },
+    { 0.995770857f, 0.863052672f, 0.532179931f, 1.0f },
+    { 0.99561707f, 0.855363322f, 0.525720877f, 1.0f },
+    { 0.995463283f, 0.847673972f, 0.519261822f, 1.0f },
+    { 0.995309496f, 0.839984621f, 0.512802768f, 1.0f },
+    { 0.995155709f, 0.832295271f, 0.506343714f, 1.0f },
+    { 0.995001922f, 0.824605921f, 0.49988466f, 1.0f },
+    { 0.994848135f, 0.816916571f, 0.493425606f, 1.0f },
+    { 0.994694348f, 0.80922722f, 0.486966551f, 1.0f },
+    { 0.994540561f, 0.80153787f, 0.480507497f, 1.0f },
+    { 0.994386774f, 0.79384852f, 0.474048443f, 1.0f },
+    { 0.994232987f, 0.78615917f, 0.467589389f, 1.0f },
+    { 0.9940792f, 0.778469819f, 0.461130334f, 1.0f },
+    { 0.993925413f, 0.770780469f, 0.45467128f, 1.0f },
+    { 0.993771626f, 0.763091119f, 0.448212226f, 1.0f },
+    { 0.993617839f, 0.755401769f, 0.441753172f, 1.0f },
+    { 0.993464052f, 0.747712418f, 0.435294118f, 1.0f },
+    { 0.993310265f, 0.740023068f, 0.428835063f, 1.0f },
+    { 0.993156478f, 0.732333718f, 0.422376009f, 1.0f },
+    { 0.993002691f, 0.724644368f, 0.415916955f, 1.0f },
+    { 0.992848904f, 0.716955017f, 0.409457901f, 1.0f },
+    { 0.992695117f, 0.709265667f, 0.402998847f, 1.0f },
+    { 0.99254133f, 0.701576317f, 0.396539792f, 1.0f },
+    { 0.992387543f, 0.693886967f, 0.390080738f, 1.0f },
+    { 0.992233756f, 0.686197616f, 0.383621684f, 1.0f },
+    { 0.991464821f, 0.677354864f, 0.378085352f, 1.0f },
+    { 0.990080738f, 0.667358708f, 0.373471742f, 1.0f },
+    { 0.988696655f, 0.657362553f, 0.368858131f, 1.0f },
+    { 0.987312572f, 0.647366398f, 0.364244521f, 1.0f },
+    { 0.985928489f, 0.637370242f, 0.359630911f, 1.0f },
+    { 0.984544406f, 0.627374087f, 0.355017301f, 1.0f },
+    { 0.983160323f, 0.617377932f, 0.350403691f, 1.0f },
+    { 0.98177624f, 0.607381776f, 0.345790081f, 1.0f },
+    { 0.980392157f, 0.597385621f, 0.341176471f, 1.0f },
+    { 0.979008074f, 0.587389466f, 0.33656286f, 1.0f },
+    { 0.977623991f, 0.57739331f, 0.33194925f, 1.0f },
+    { 0.976239908f, 0.567397155f, 0.32733564f, 1.0f },
+    { 0.974855825f, 0.557401f, 0.32272203f, 1.0f },
+    { 0.973471742f, 0.547404844f, 0.31810842f, 1.0f },
+    { 0.972087659f, 0.537408689f, 0.31349481f, 1.0f },
+    { 0.970703576f, 0.527412534f, 0.3088812f, 1.0f },
+    { 0.969319493f, 0.517416378f, 0.304267589f, 1.0f },
+    { 0.967935409f, 0.507420223f, 0.299653979f, 1.0f },
+    { 0.966551326f, 0.497424068f, 0.295040369f, 1.0f },
+    { 0.965167243f, 0.487427912f, 0.290426759f, 1.0f },
+    { 0.96378316f, 0.477431757f, 0.285813149f, 1.0f },
+    { 0.962399077f, 0.467435602f, 0.281199539f, 1.0f },
+    { 0.961014994f, 0.457439446f, 0.276585928f, 1.0f },
+    { 0.959630911f, 0.447443291f, 0.271972318f, 1.0f },
+    { 0.958246828f, 0.437447136f, 0.267358708f, 1.0f },
+    { 0.956862745f, 0.42745098f, 0.262745098f, 1.0f },
+    { 0.952095348f, 0.420222991f, 0.264590542f, 1.0f },
+    { 0.947327951f, 0.412995002f, 0.266435986f, 1.0f },
+    { 0.942560554f, 0.405767013f, 0.26828143f, 1.0f },
+    { 0.937793156f, 0.398539023f, 0.270126874f, 1.0f },
+    { 0.933025759f, 0.391311034f, 0.271972318f, 1.0f },
+    { 0.928258362f, 0.384083045f, 0.273817762f, 1.0f },
+    { 0.923490965f, 0.376855056f, 0.275663206f, 1.0f },
+    { 0.918723568f, 0.369627067f, 0.277508651f, 1.0f },
+    { 0.913956171f, 0.362399077f, 0.279354095f, 1.0f },
+    { 0.909188774f, 0.355171088f, 0.281199539f, 1.0f },
+    { 0.904421376f, 0.347943099f, 0.283044983f, 1.0f },
+    { 0.899653979f, 0.34071511f, 0.284890427f, 1.0f },
+    { 0.894886582f, 0.33348712f, 0.286735871f, 1.0f },
+    { 0.890119185f, 0.326259131f, 0.288581315f, 1.0f },
+    { 0.885351788f, 0.319031142f, 0.290426759f, 1.0f },
+    { 0.880584391f, 0.311803153f, 0.292272203f, 1.0f },
+    { 0.875816993f, 0.304575163f, 0.294117647f, 1.0f },
+    { 0.871049596f, 0.297347174f, 0.295963091f, 1.0f },
+    { 0.866282199f, 0.290119185f, 0.297808535f, 1.0f },
+    { 0.861514802f, 0.282891196f, 0.299653979f, 1.0f },
+    { 0.856747405f, 0.275663206f, 0.301499423f, 1.0f },
+    { 0.851980008f, 0.268435217f, 0.303344867f, 1.0f },
+    { 0.847212611f, 0.261207228f, 0.305190311f, 1.0f },
+    { 0.842445213f, 0.253979239f, 0.307035755f, 1.0f },
+    { 0.837677816f, 0.24675125f, 0.3088812f, 1.0f },
+    { 0.831064975f, 0.238446751f, 0.308804306f, 1.0f },
+    { 0.82260669f, 0.229065744f, 0.306805075f, 1.0f },
+    { 0.814148404f, 0.219684737f, 0.304805844f, 1.0f },
+    { 0.805690119f, 0.210303729f, 0.302806613f, 1.0f },
+    { 0.797231834f, 0.200922722f, 0.300807382f, 1.0f },
+    { 0.788773549f, 0.191541715f, 0.298808151f, 1.0f },
+    { 0.780315263f, 0.182160707f, 0.29680892f, 1.0f },
+    { 0.771856978f, 0.1727797f, 0.294809689f, 1.0f },
+    { 0.763398693f, 0.163398693f, 0.292810458f, 1.0f },
+    { 0.754940408f, 0.154017686f, 0.290811226f, 1.0f },
+    { 0.746482122f, 0.144636678f, 0.288811995f, 1.0f },
+    { 0.738023837f, 0.135255671f, 0.286812764f, 1.0f },
+    { 0.729565552f, 0.125874664f, 0.284813533f, 1.0f },
+    { 0.721107266f, 0.116493656f, 0.282814302f, 1.0f },
+    { 0.712648981f, 0.107112649f, 0.280815071f, 1.0f },
+    { 0.704190696f, 0.0977316417f, 0.27881584f, 1.0f },
+    { 0.695732411f, 0.0883506344f, 0.276816609f, 1.0f },
+    { 0.687274125f, 0.0789696271f, 0.274817378f, 1.0f },
+    { 0.67881584f, 0.0695886198f, 0.272818147f, 1.0f },
+    { 0.670357555f, 0.0602076125f, 0.270818916f, 1.0f },
+    { 0.66189927f, 0.0508266052f, 0.268819685f, 1.0f },
+    { 0.653440984f, 0.0414455978f, 0.266820454f, 1.0f },
+    { 0.644982699f, 0.0320645905f, 0.264821223f, 1.0f },
+    { 0.636524414f, 0.0226835832f, 0.262821992f, 1.0f },
+    { 0.628066128f, 0.0133025759f, 0.26082276f, 1.0f },
+    { 0.619607843f, 0.00392156863f, 0.258823529f, 1.0f },
+};
+
+static const float HEALPix_CMB_LUT[100][4] = {
+    { 0.0f, 0.0f, 0.51372549f, 1.0f },
+    { 0.0f, 0.0f, 0.529411765f, 1.0f },
+    { 0.0f, 0.0f, 0.576470588f, 1.0f },
+    { 0.0f, 0.0f, 0.607843137f, 1.0f },
+    { 0.0f, 0.0f, 0.654901961f, 1.0f },
+    { 0.0f, 0.0f, 0.68627451f, 1.0f },
+    { 0.0f, 0.0f, 0.733333333f, 1.0f },
+    { 0.0f, 0.0f, 0.780392157f, 1.0f },
+    { 0.0f, 0.0f, 0.811764706f, 1.0f },
+    { 0.0f, 0.0f, 0.858823529f, 1.0f },
+    { 0.0f, 0.0f, 0.890196078f, 1.0f },
+    { 0.0f, 0.0f, 0.937254902f, 1.0f },
+    { 0.0f, 0.0f, 0.968627451f, 1.0f },
+    { 0.0f, 0.0f, 1.0f, 1.0f },
+    { 0.0f, 0.0431372549f, 1.0f, 1.0f },
+    { 0.0f, 0.0745098039f, 1.0f, 1.0f },
+    { 0.0f, 0.121568627f, 1.0f, 1.0f },
+    { 0.0f, 0.152941176f, 1.0f, 1.0f },
+    { 0.0f, 0.2f, 1.0f, 1.0f },
+    { 0.0f, 0.231372549f, 1.0f, 1.0f },
+    { 0.0f, 0.278431373f, 1.0f, 1.0f },
+    { 0.0f, 0.325490196f, 1.0f, 1.0f },
+    { 0.0f, 0.356862745f, 1.0f, 1.0f },
+    { 0.0f, 0.403921569f, 1.0f, 1.0f },
+    { 0.0f, 0.435294118f, 1.0f, 1.0f },
+    { 0.0f, 0.482352941f, 1.0f, 1.0f },
+    { 0.0f, 0.51372549f, 1.0f, 1.0f },
+    { 0.0f, 0.560784314f, 1.0f, 1.0f },
+    { 0.0f, 0.607843137f, 1.0f, 1.0f },
+    { 0.0f, 0.639215686f, 1.0f, 1.0f },
+    { 0.0f, 0.68627451f, 1.0f, 1.0f },
+    { 0.0f, 0.717647059f, 1.0f, 1.0f },
+    { 0.0f, 0.764705882f, 1.0f, 1.0f },
+    { 0.0f, 0.811764706f, 1.0f, 1.0f },
+    { 0.0f, 0.843137255f, 1.0f, 1.0f },
+    { 0.0f, 0.890196078f, 1.0f, 1.0f },
+    { 0.0f, 0.921568627f, 1.0f, 1.0f },
+    { 0.0f, 0.968627451f, 1.0f, 1.0f },
+    { 0.0f, 1.0f, 1.0f, 1.0f },
+    { 0.0274509804f, 1.0f, 0.968627451f, 1.0f },
+    { 0.0745098039f, 1.0f, 0.921568627f, 1.0f },
+    { 0.105882353f, 1.0f, 0.890196078f, 1.0f },
+    { 0.152941176f, 1.0f, 0.843137255f, 1.0f },
+    { 0.184313725f, 1.0f, 0.811764706f, 1.0f },
+    { 0.231372549f, 1.0f, 0.764705882f, 1.0f },
+    { 0.262745098f, 1.0f, 0.733333333f, 1.0f },
+    { 0.309803922f, 1.0f, 0.68627451f, 1.0f },
+    { 0.356862745f, 1.0f, 0.639215686f, 1.0f },
+    { 0.388235294f, 1.0f, 0.607843137f, 1.0f },
+    { 0.435294118f, 1.0f, 0.560784314f, 1.0f },
+    { 0.466666667f, 1.0f, 0.529411765f, 1.0f },
+    { 0.51372549f, 1.0f, 0.482352941f, 1.0f },
+    { 0.545098039f, 1.0f, 0.450980392f, 1.0f },
+    { 0.592156863f, 1.0f, 0.403921569f, 1.0f },
+    { 0.639215686f, 1.0f, 0.356862745f, 1.0f },
+    { 0.670588235f, 1.0f, 0.325490196f, 1.0f },
+    { 0.717647059f, 1.0f, 0.278431373f, 1.0f },
+    { 0.749019608f, 1.0f, 0.247058824f, 1.0f },
+    { 0.796078431f, 1.0f, 0.2f, 1.0f },
+    { 0.82745098f, 1.0f, 0.168627451f, 1.0f },
+    { 0.874509804f, 1.0f, 0.121568627f, 1.0f },
+    { 0.921568627f, 1.0f, 0.0745098039f, 1.0f },
+    { 0.952941176f, 1.0f, 0.0431372549f, 1.0f },
+    { 1.0f, 1.0f, 0.0f, 1.0f },
+    { 1.0f, 0.968627451f, 0.0f, 1.0f },
+    { 1.0f, 0.921568627f, 0.0f, 1.0f },
+    { 1.0f, 0.874509804f, 0.0f, 1.0f },
+    { 1.0f, 0.843137255f, 0.0f, 1.0f },
+    { 1.0f, 0.796078431f, 0.0f, 1.0f },
+    { 1.0f, 0.764705882f, 0.0f, 1.0f },
+    { 1.0f, 0.717647059f, 0.0f, 1.0f },
+    { 1.0f, 0.68627451f, 0.0f, 1.0f },
+    { 1.0f, 0.639215686f, 0.0f, 1.0f },
+    { 1.0f, 0.592156863f, 0.0f, 1.0f },
+    { 1.0f, 0.560784314f, 0.0f, 1.0f },
+    { 1.0f, 0.51372549f, 0.0f, 1.0f },
+    { 1.0f, 0.482352941f, 0.0f, 1.0f },
+    { 1.0f, 0.435294118f, 0.0f, 1.0f },
+    { 1.0f, 0.403921569f, 0.0f, 1.0f },
+    { 1.0f, 0.356862745f, 0.0f, 1.0f },
+    { 1.0f, 0.309803922f, 0.0f, 1.0f },
+    { 1.0f, 0.278431373f, 0.0f, 1.0f },
+    { 1.0f, 0.231372549f, 0.0f, 1.0f },
+    { 1.0f, 0.2f, 0.0f, 1.0f },
+    { 1.0f, 0.152941176f, 0.0f, 1.0f },
+    { 1.0f, 0.121568627f, 0.0f, 1.0f },
+    { 1.0f, 0.0745098039f, 0.0f, 1.0f },
+    { 1.0f, 0.0274509804f, 0.0f, 1.0f },
+    { 1.0f, 0.0f, 0.0f, 1.0f },
+    { 0.945098039f, 0.0f, 0.0f, 1.0f },
+    { 0.91372549f, 0.0f, 0.0f, 1.0f },
+    { 0.858823529f, 0.0f, 0.0f, 1.0f },
+    { 0.82745098f, 0.0f, 0.0f, 1.0f },
+    { 0.77254902f, 0.0f, 0.0f, 1.0f },
+    { 0.721568627f, 0.0f, 0.0f, 1.0f },
+    { 0.68627451f, 0.0f, 0.0f, 1.0f },
+    { 0.635294118f, 0.0f, 0.0f, 1.0f },
+    { 0.6f, 0.0f, 0.0f, 1.0f },
+    { 0.549019608f, 0.0f, 0.0f, 1.0f },
+    { 0.51372549f, 0.0f, 0.0f, 1.0f },
+};
+
+static const float Python_Seismic_LUT[256][4] = {
+    { 0.0f, 0.0f, 0.3f, 1.0f },
+    { 0.0f, 0.0f, 0.310980392f, 1.0f },
+    { 0.0f, 0.0f, 0.321960784f, 1.0f },
+    { 0.0f, 0.0f, 0.332941176f, 1.0f },
+    { 0.0f, 0.0f, 0.343921569f, 1.0f },
+    { 0.0f, 0.0f, 0.354901961f, 1.0f },
+    { 0.0f, 0.0f, 0.365882353f, 1.0f },
+    { 0.0f, 0.0f, 0.376862745f, 1.0f },
+    { 0.0f, 0.0f, 0.387843137f, 1.0f },
+    { 0.0f, 0.0f, 0.398823529f, 1.0f },
+    { 0.0f, 0.0f, 0.409803922f, 1.0f },
+    { 0.0f, 0.0f, 0.420784314f, 1.0f },
+    { 0.0f, 0.0f, 0.431764706f, 1.0f },
+    { 0.0f, 0.0f, 0.442745098f, 1.0f },
+    { 0.0f, 0.0f, 0.45372549f, 1.0f },
+    { 0.0f, 0.0f, 0.464705882f, 1.0f },
+    { 0.0f, 0.0f, 0.475686275f, 1.0f },
+    { 0.0f, 0.0f, 0.486666667f, 1.0f },
+    { 0.0f, 0.0f, 0.497647059f, 1.0f },
+    { 0.0f, 0.0f, 0.508627451f, 1.0f },
+    { 0.0f, 0.0f, 0.519607843f, 1.0f },
+    { 0.0f, 0.0f, 0.530588235f, 1.0f },
+    { 0.0f, 0.0f, 0.541568627f, 1.0f },
+    { 0.0f, 0.0f, 0.55254902f, 1.0f },
+    { 0.0f, 0.0f, 0.563529412f, 1.0f },
+    { 0.0f, 0.0f, 0.574509804f, 1.0f },
+    { 0.0f, 0.0f, 0.585490196f, 1.0f },
+    { 0.0f, 0.0f, 0.596470588f, 1.0f },
+    { 0.0f, 0.0f, 0.60745098f, 1.0f },
+    { 0.0f, 0.0f, 0.618431373f, 1.0f },
+    { 0.0f, 0.0f, 0.629411765f, 1.0f },
+    { 0.0f, 0.0f, 0.640392157f, 1.0f },
+    { 0.0f, 0.0f, 0.651372549f, 1.0f },
+    { 0.0f, 0.0f, 0.662352941f, 1.0f },
+    { 0.0f, 0.0f, 0.673333333f, 1.0f },
+    { 0.0f, 0.0f, 0.684313725f, 1.0f },
+    { 0.0f, 0.0f, 0.695294118f, 1.0f },
+    { 0.0f, 0.0f, 0.70627451f, 1.0f },
+    { 0.0f, 0.0f, 0.717254902f, 1.0f },
+    { 0.0f, 0.0f, 0.728235294f, 1.0f },
+    { 0.0f, 0.0f, 0.739215686f, 1.0f },
+    { 0.0f, 0.0f, 0.750196078f, 1.0f },
+    { 0.0f, 0.0f, 0.761176471f, 1.0f },
+    { 0.0f, 0.0f, 0.772156863f, 1.0f },
+    { 0.0f, 0.0f, 0.783137255f, 1.0f },
+    { 0.0f, 0.0f, 0.794117647f, 1.0f },
+    { 0.0f, 0.0f, 0.805098039f, 1.0f },
+    { 0.0f, 0.0f, 0.816078431f, 1.0f },
+    { 0.0f, 0.0f, 0.827058824f, 1.0f },
+    { 0.0f, 0.0f, 0.838039216f, 1.0f },
+    { 0.0f, 0.0f, 0.849019608f, 1.0f },
+    { 0.0f, 0.0f, 0.86f, 1.0f },
+    { 0.0f, 0.0f, 0.870980392f, 1.0f },
+    { 0.0f, 0.0f, 0.881960784f, 1.0f },
+    { 0.0f, 0.0f, 0.892941176f, 1.0f },
+    { 0.0f, 0.0f, 0.903921569f, 1.0f },
+    { 0.0f, 0.0f, 0.914901961f, 1.0f },
+    { 0.0f, 0.0f, 0.925882353f, 1.0f },
+    { 0.0f, 0.0f, 0.936862745f, 1.0f },
+    { 0.0f, 0.0f, 0.947843137f, 1.0f },
+    { 0.0f, 0.0f, 0.958823529f, 1.0f },
+    { 0.0f, 0.0f, 0.969803922f, 1.0f },
+    { 0.0f, 0.0f, 0.980784314f, 1.0f },
+    { 0.0f, 0.0f, 0.991764706f, 1.0f },
+    { 0.00392156863f, 0.00392156863f, 1.0f, 1.0f },
+    { 0.0196078431f, 0.0196078431f, 1.0f, 1.0f },
+    { 0.0352941176f, 0.0352941176f, 1.0f, 1.0f },
+    { 0.0509803922f, 0.0509803922f, 1.0f, 1.0f },
+    { 0.0666666667f, 0.0666666667f, 1.0f, 1.0f },
+    { 0.0823529412f, 0.0823529412f, 1.0f, 1.0f },
+    { 0.0980392157f, 0.0980392157f, 1.0f, 1.0f },
+    { 0.11372549f, 0.11372549f, 1.0f, 1.0f },
+    { 0.129411765f, 0.129411765f, 1.0f, 1.0f },
+    { 0.145098039f, 0.145098039f, 1.0f, 1.0f },
+    { 0.160784314f, 0.160784314f, 1.0f, 1.0f },
+    { 0.176470588f, 0.176470588f, 1.0f, 1.0f },
+    { 0.192156863f, 0.192156863f, 1.0f, 1.0f },
+    { 0.207843137f, 0.207843137f, 1.0f, 1.0f },
+    { 0.223529412f, 0.223529412f, 1.0f, 1.0f },
+    { 0.239215686f, 0.239215686f, 1.0f, 1.0f },
+    { 0.254901961f, 0.254901961f, 1.0f, 1.0f },
+    { 0.270588235f, 0.270588235f, 1.0f, 1.0f },
+    { 0.28627451f, 0.28627451f, 1.0f, 1.0f },
+    { 0.301960784f, 0.301960784f, 1.0f, 1.0f },
+    { 0.317647059f, 0.317647059f, 1.0f, 1.0f },
+    { 0.333333333f, 0.333333333f, 1.0f, 1.0f },
+    { 0.349019608f, 0.349019608f, 1.0f, 1.0f },
+    { 0.364705882f, 0.364705882f, 1.0f, 1.0f },
+    { 0.380392157f, 0.380392157f, 1.0f, 1.0f },
+    { 0.396078431f, 0.396078431f, 1.0f, 1.0f },
+    { 0.411764706f, 0.411764706f, 1.0f, 1.0f },
+    { 0.42745098f, 0.42745098f, 1.0f, 1.0f },
+    { 0.443137255f, 0.443137255f, 1.0f, 1.0f },
+    { 0.458823529f, 0.458823529f, 1.0f, 1.0f },
+    { 0.474509804f, 0.474509804f, 1.0f, 1.0f },
+    { 0.490196078f, 0.490196078f, 1.0f, 1.0f },
+    { 0.505882353f, 0.505882353f, 1.0f, 1.0f },
+    { 0.521568627f, 0.521568627f, 1.0f, 1.0f },
+    { 0.537254902f, 0.537254902f, 1.0f, 1.0f },
+    { 0.552941176f, 0.552941176f, 1.0f, 1.0f },
+    { 0.568627451f, 0.568627451f, 1.0f, 1.0f },
+    { 0.584313725f, 0.584313725f, 1.0f, 1.0f },
+    { 0.6f, 0.6f, 1.0f, 1.0f },
+    { 0.615686275f, 0.615686275f, 1.0f, 1.0f },
+    { 0.631372549f, 0.631372549f, 1.0f, 1.0f },
+    { 0.647058824f, 0.647058824f, 1.0f, 1.0f },
+    { 0.662745098f, 0.662745098f, 1.0f, 1.0f },
+    { 0.678431373f, 0.678431373f, 1.0f, 1.0f },
+    { 0.694117647f, 0.694117647f, 1.0f, 1.0f },
+    { 0.709803922f, 0.709803922f, 1.0f, 1.0f },
+    { 0.725490196f, 0.725490196f, 1.0f, 1.0f },
+    { 0.741176471f, 0.741176471f, 1.0f, 1.0f },
+    { 0.756862745f, 0.756862745f, 1.0f, 1.0f },
+    { 0.77254902f, 0.77254902f, 1.0f, 1.0f },
+    { 0.788235294f, 0.788235294f, 1.0f, 1.0f },
+    { 0.803921569f, 0.803921569f, 1.0f, 1.0f },
+    { 0.819607843f, 0.819607843f, 1.0f, 1.0f },
+    { 0.835294118f, 0.835294118f, 1.0f, 1.0f },
+    { 0.850980392f, 0.850980392f, 1.0f, 1.0f },
+    { 0.866666667f, 0.866666667f, 1.0f, 1.0f },
+    { 0.882352941f, 0.882352941f, 1.0f, 1.0f },
+    { 0.898039216f, 0.898039216f, 1.0f, 1.0f },
+    { 0.91372549f, 0.91372549f, 1.0f, 1.0f },
+    { 0.929411765f, 0.929411765f, 1.0f, 1.0f },
+    { 0.945098039f, 0.945098039f, 1.0f, 1.0f },
+    { 0.960784314f, 0.960784314f, 1.0f, 1.0f },
+    { 0.976470588f, 0.976470588f, 1.0f, 1.0f },
+    { 0.992156863f, 0.992156863f, 1.0f, 1.0f },
+    { 1.0f, 0.992156863f, 0.992156863f, 1.0f },
+    { 1.0f, 0.976470588f, 0.976470588f, 1.0f },
+    { 1.0f, 0.960784314f, 0.960784314f, 1.0f },
+    { 1.0f, 0.945098039f, 0.945098039f, 1.0f },
+    { 1.0f, 0.929411765f, 0.929411765f, 1.0f },
+    { 1.0f, 0.91372549f, 0.91372549f, 1.0f },
+    { 1.0f, 0.898039216f, 0.898039216f, 1.0f },
+    { 1.0f, 0.882352941f, 0.882352941f, 1.0f },
+    { 1.0f, 0.866666667f, 0.866666667f, 1.0f },
+    { 1.0f, 0.850980392f, 0.850980392f, 1.0f },
+    { 1.0f, 0.835294118f, 0.835294118f, 1.0f },
+    { 1.0f, 0.819607843f, 0.819607843f, 1.0f },
+    { 1.0f, 0.803921569f, 0.803921569f, 1.0f },
+    { 1.0f, 0.788235294f, 0.788235294f, 1.0f },
+    { 1.0f, 0.77254902f, 0.77254902f, 1.0f },
+    { 1.0f, 0.756862745f, 0.756862745f, 1.0f },
+    { 1.0f, 0.741176471f, 0.741176471f, 1.0f },
+    { 1.0f, 0.725490196f, 0.725490196f, 1.0f },
+    { 1.0f, 0.709803922f, 0.709803922f, 1.0f },
+    { 1.0f, 0.694117647f, 0.694117647f, 1.0f },
+    { 1.0f, 0.678431373f, 0.678431373f, 1.0f },
+    { 1.0f, 0.662745098f, 0.662745098f, 1.0f },
+    { 1.0f, 0.647058824f, 0.647058824f, 1.0f },
+    { 1.0f, 0.631372549f, 0.631372549f, 1.0f },
+    { 1.0f, 0.615686275f, 0.615686275f, 1.0f },
+    { 1.0f, 0.6f, 0.6f, 1.0f },
+    { 1.0f, 0.584313725f, 0.584313725f, 1.0f },
+    { 1.0f, 0.568627451f, 0.568627451f, 1.0f },
+    { 1.0f, 0.552941176f, 0.552941176f, 1.0f },
+    { 1.0f, 0.537254902f, 0.537254902f, 1.0f },
+    { 1.0f, 0.521568627f, 0.521568627f, 1.0f },
+    { 1.0f, 0.505882353f, 0.505882353f, 1.0f },
+    { 1.0f, 0.490196078f, 0.490196078f, 1.0f },
+    { 1.0f, 0.474509804f, 0.474509804f, 1.0f },
+    { 1.0f, 0.458823529f, 0.458823529f, 1.0f },
+    { 1.0f, 0.443137255f, 0.443137255f, 1.0f },
+    { 1.0f, 0.42745098f, 0.42745098f, 1.0f },
+    { 1.0f, 0.411764706f, 0.411764706f, 1.0f },
+    { 1.0f, 0.396078431f, 0.396078431f, 1.0f },
+    { 1.0f, 0.380392157f, 0.380392157f, 1.0f },
+    { 1.0f, 0.364705882f, 0.364705882f, 1.0f },
+    { 1.0f, 0.349019608f, 0.349019608f, 1.0f },
+    { 1.0f, 0.333333333f, 0.333333333f, 1.0f },
+    { 1.0f, 0.317647059f, 0.317647059f, 1.0f },
+    { 1.0f, 0.301960784f, 0.301960784f, 1.0f },
+    { 1.0f, 0.28627451f, 0.28627451f, 1.0f },
+    { 1.0f, 0.270588235f, 0.270588235f, 1.0f },
+    { 1.0f, 0.254901961f, 0.254901961f, 1.0f },
+    { 1.0f, 0.239215686f, 0.239215686f, 1.0f },
+    { 1.0f, 0.223529412f, 0.223529412f, 1.0f },
+    { 1.0f, 0.207843137f, 0.207843137f, 1.0f },
+    { 1.0f, 0.192156863f, 0.192156863f, 1.0f },
+    { 1.0f, 0.176470588f, 0.176470588f, 1.0f },
+    { 1.0f, 0.160784314f, 0.160784314f, 1.0f },
+    { 1.0f, 0.145098039f, 0.145098039f, 1.0f },
+    { 1.0f, 0.129411765f, 0.129411765f, 1.0f },
+    { 1.0f, 0.11372549f, 0.11372549f, 1.0f },
+    { 1.0f, 0.0980392157f, 0.0980392157f, 1.0f },
+    { 1.0f, 0.0823529412f, 0.0823529412f, 1.0f },
+    { 1.0f, 0.0666666667f, 0.0666666667f, 1.0f },
+    { 1.0f, 0.0509803922f, 0.0509803922f, 1.0f },
+    { 1.0f, 0.0352941176f, 0.0352941176f, 1.0f },
+    { 1.0f, 0.0196078431f, 0.0196078431f, 1.0f },
+    { 1.0f, 0.00392156863f, 0.00392156863f, 1.0f },
+    { 0.994117647f, 0.0f, 0.0f, 1.0f },
+    { 0.98627451f, 0.0f, 0.0f, 1.0f },
+    { 0.978431373f, 0.0f, 0.0f, 1.0f },
+    { 0.970588235f, 0.0f, 0.0f, 1.0f },
+    { 0.962745098f, 0.0f, 0.0f, 1.0f },
+    { 0.954901961f, 0.0f, 0.0f, 1.0f },
+    { 0.947058824f, 0.0f, 0.0f, 1.0f },
+    { 0.939215686f, 0.0f, 0.0f, 1.0f },
+    { 0.931372549f, 0.0f, 0.0f, 1.0f },
+    { 0.923529412f, 0.0f, 0.0f, 1.0f },
+    { 0.915686275f, 0.0f, 0.0f, 1.0f },
+    { 0.907843137f, 0.0f, 0.0f, 1.0f },
+    { 0.9f, 0.0f, 0.0f, 1.0f },
+    { 0.892156863f, 0.0f, 0.0f, 1.0f },
+    { 0.884313725f, 0.0f, 0.0f, 1.0f },
+    { 0.876470588f, 0.0f, 0.0f, 1.0f },
+    { 0.868627451f, 0.0f, 0.0f, 1.0f },
+    { 0.860784314f, 0.0f, 0.0f, 1.0f },
+    { 0.852941176f, 0.0f, 0.0f, 1.0f },
+    { 0.845098039f, 0.0f, 0.0f, 1.0f },
+    { 0.837254902f, 0.0f, 0.0f, 1.0f },
+    { 0.829411765f, 0.0f, 0.0f, 1.0f },
+    { 0.821568627f, 0.0f, 0.0f, 1.0f },
+    { 0.81372549f, 0.0f, 0.0f, 1.0f },
+    { 0.805882353f, 0.0f, 0.0f, 1.0f },
+    { 0.798039216f, 0.0f, 0.0f, 1.0f },
+    { 0.790196078f, 0.0f, 0.0f, 1.0f },
+    { 0.782352941f, 0.0f, 0.0f, 1.0f },
+    { 0.774509804f, 0.0f, 0.0f, 1.0f },
+    { 0.766666667f, 0.0f, 0.0f, 1.0f },
+    { 0.758823529f, 0.0f, 0.0f, 1.0f },
+    { 0.750980392f, 0.0f, 0.0f, 1.0f },
+    { 0.743137255f, 0.0f, 0.0f, 1.0f },
+    { 0.735294118f, 0.0f, 0.0f, 1.0f },
+    { 0.72745098f, 0.0f, 0.0f, 1.0f },
+    { 0.719607843f, 0.0f, 0.0f, 1.0f },
+    { 0.711764706f, 0.0f, 0.0f, 1.0f },
+    { 0.703921569f, 0.0f, 0.0f, 1.0f },
+    { 0.696078431f, 0.0f, 0.0f, 1.0f },
+    { 0.688235294f, 0.0f, 0.0f, 1.0f },
+    { 0.680392157f, 0.0f, 0.0f, 1.0f },
+    { 0.67254902f, 0.0f, 0.0f, 1.0f },
+    { 0.664705882f, 0.0f, 0.0f, 1.0f },
+    { 0.656862745f, 0.0f, 0.0f, 1.0f },
+    { 0.649019608f, 0.0f, 0.0f, 1.0f },
+    { 0.641176471f, 0.0f, 0.0f, 1.0f },
+    { 0.633333333f, 0.0f, 0.0f, 1.0f },
+    { 0.625490196f, 0.0f, 0.0f, 1.0f },
+    { 0.617647059f, 0.0f, 0.0f, 1.0f },
+    { 0.609803922f, 0.0f, 0.0f, 1.0f },
+    { 0.601960784f, 0.0f, 0.0f, 1.0f },
+    { 0.594117647f, 0.0f, 0.0f, 1.0f },
+    { 0.58627451f, 0.0f, 0.0f, 1.0f },
+    { 0.578431373f, 0.0f, 0.0f, 1.0f },
+    { 0.570588235f, 0.0f, 0.0f, 1.0f },
+    { 0.562745098f, 0.0f, 0.0f, 1.0f },
+    { 0.554901961f, 0.0f, 0.0f, 1.0f },
+    { 0.547058824f, 0.0f, 0.0f, 1.0f },
+    { 0.539215686f, 0.0f, 0.0f, 1.0f },
+    { 0.531372549f, 0.0f, 0.0f, 1.0f },
+    { 0.523529412f, 0.0f, 0.0f, 1.0f },
+    { 0.515686275f, 0.0f, 0.0f, 1.0f },
+    { 0.507843137f, 0.0f, 0.0f, 1.0f },
+    { 0.5f, 0.0f, 0.0f, 1.0f },
+};
+
+static const float Python_Difference_LUT[256][4] = {
+    { 0.0f, 0.0f, 1.0f, 1.0f },
+    { 0.00784313725f, 0.00784313725f, 1.0f, 1.0f },
+    { 0.0156862745f, 0.0156862745f, 1.0f, 1.0f },
+    { 0.0235294118f, 0.0235294118f, 1.0f, 1.0f },
+    { 0.031372549f, 0.031372549f, 1.0f, 1.0f },
+    { 0.0392156863f, 0.0392156863f, 1.0f, 1.0f },
+    { 0.0470588235f, 0.0470588235f, 1.0f, 1.0f },
+    { 0.0549019608f, 0.0549019608f, 1.0f, 1.0f },
+    { 0.062745098f, 0.062745098f, 1.0f, 1.0f },
+    { 0.0705882353f, 0.0705882353f, 1.0f, 1.0f },
+    { 0.0784313725f, 0.0784313725f, 1.0f, 1.0f },
+    { 0.0862745098f, 0.0862745098f, 1.0f, 1.0f },
+    { 0.0941176471f, 0.0941176471f, 1.0f, 1.0f },
+    { 0.101960784f, 0.101960784f, 1.0f, 1.0f },
+    { 0.109803922f, 0.109803922f, 1.0f, 1.0f },
+    { 0.117647059f, 0.117647059f, 1.0f, 1.0f },
+    { 0.125490196f, 0.125490196f, 1.0f, 1.0f },
+    { 0.133333333f, 0.133333333f, 1.0f, 1.0f },
+    { 0.141176471f, 0.141176471f, 1.0f, 1.0f },
+    { 0.149019608f, 0.149019608f, 1.0f, 1.0f },
+    { 0.156862745f, 0.156862745f, 1.0f, 1.0f },
+    { 0.164705882f, 0.164705882f, 1.0f, 1.0f },
+    { 0.17254902f, 0.17254902f, 1.0f, 1.0f },
+    { 0.180392157f, 0.180392157f, 1.0f, 1.0f },
+    { 0.188235294f, 0.188235294f, 1.0f, 1.0f },
+    { 0.196078431f, 0.196078431f, 1.0f, 1.0f },
+    { 0.203921569f, 0.203921569f, 1.0f, 1.0f },
+    { 0.211764706f, 0.211764706f, 1.0f, 1.0f },
+    { 0.219607843f, 0.219607843f, 1.0f, 1.0f },
+    { 0.22745098f, 0.22745098f, 1.0f, 1.0f },
+    { 0.235294118f, 0.235294118f, 1.0f, 1.0f },
+    { 0.243137255f, 0.243137255f, 1.0f, 1.0f },
+    { 0.250980392f, 0.250980392f, 1.0f, 1.0f },
+    { 0.258823529f, 0.258823529f, 1.0f, 1.0f },
+    { 0.266666667f, 0.266666667f, 1.0f, 1.0f },
+    { 0.274509804f, 0.274509804f, 1.0f, 1.0f },
+    { 0.282352941f, 0.282352941f, 1.0f, 1.0f },
+    { 0.290196078f, 0.290196078f, 1.0f, 1.0f },
+    { 0.298039216f, 0.298039216f, 1.0f, 1.0f },
+    { 0.305882353f, 0.305882353f, 1.0f, 1.0f },
+    { 0.31372549f, 0.31372549f, 1.0f, 1.0f },
+    { 0.321568627f, 0.321568627f, 1.0f, 1.0f },
+    { 0.329411765f, 0.329411765f, 1.0f, 1.0f },
+    { 0.337254902f, 0.337254902f, 1.0f, 1.0f },
+    { 0.345098039f, 0.345098039f, 1.0f, 1.0f },
+    { 0.352941176f, 0.352941176f, 1.0f, 1.0f },
+    { 0.360784314f, 0.360784314f, 1.0f, 1.0f },
+    { 0.368627451f, 0.368627451f, 1.0f, 1.0f },
+    { 0.376470588f, 0.376470588f, 1.0f, 1.0f },
+    { 0.384313725f, 0.384313725f, 1.0f, 1.0f },
+    { 0.392156863f, 0.392156863f, 1.0f, 1.0f },
+    { 0.4f, 0.4f, 1.0f, 1.0f },
+    { 0.407843137f, 0.407843137f, 1.0f, 1.0f },
+    { 0.415686275f, 0.415686275f, 1.0f, 1.0f },
+    { 0.423529412f, 0.423529412f, 1.0f, 1.0f },
+    { 0.431372549f, 0.431372549f, 1.0f, 1.0f },
+    { 0.439215686f, 0.439215686f, 1.0f, 1.0f },
+    { 0.447058824f, 0.447058824f, 1.0f, 1.0f },
+    { 0.454901961f, 0.454901961f, 1.0f, 1.0f },
+    { 0.462745098f, 0.462745098f, 1.0f, 1.0f },
+    { 0.470588235f, 0.470588235f, 1.0f, 1.0f },
+    { 0.478431373f, 0.478431373f, 1.0f, 1.0f },
+    { 0.48627451f, 0.48627451f, 1.0f, 1.0f },
+    { 0.494117647f, 0.494117647f, 1.0f, 1.0f },
+    { 0.501960784f, 0.501960784f, 1.0f, 1.0f },
+    { 0.509803922f, 0.509803922f, 1.0f, 1.0f },
+    { 0.517647059f, 0.517647059f, 1.0f, 1.0f },
+    { 0.525490196f, 0.525490196f, 1.0f, 1.0f },
+    { 0.533333333f, 0.533333333f, 1.0f, 1.0f },
+    { 0.541176471f, 0.541176471f, 1.0f, 1.0f },
+    { 0.549019608f, 0.549019608f, 1.0f, 1.0f },
+    { 0.556862745f, 0.556862745f, 1.0f, 1.0f },
+    { 0.564705882f, 0.564705882f, 1.0f, 1.0f },
+    { 0.57254902f, 0.57254902f, 1.0f, 1.0f },
+    { 0.580392157f, 0.580392157f, 1.0f, 1.0f },
+    { 0.588235294f, 0.588235294f, 1.0f, 1.0f },
+    { 0.596078431f, 0.596078431f, 1.0f, 1.0f },
+    { 0.603921569f, 0.603921569f, 1.0f, 1.0f },
+    { 0.611764706f, 0.611764706f, 1.0f, 1.0f },
+    { 0.619607843f, 0.619607843f, 1.0f, 1.0f },
+    { 0.62745098f, 0.62745098f, 1.0f, 1.0f },
+    { 0.635294118f, 0.635294118f, 1.0f, 1.0f },
+    { 0.643137255f, 0.643137255f, 1.0f, 1.0f },
+    { 0.650980392f, 0.650980392f, 1.0f, 1.0f },
+    { 0.658823529f, 0.658823529f, 1.0f, 1.0f },
+    { 0.666666667f, 0.666666667f, 1.0f, 1.0f },
+    { 0.674509804f, 0.674509804f, 1.0f, 1.0f },
+    { 0.682352941f, 0.682352941f, 1.0f, 1.0f },
+    { 0.690196078f, 0.690196078f, 1.0f, 1.0f },
+    { 0.698039216f, 0.698039216f, 1.0f, 1.0f },
+    { 0.705882353f, 0.705882353f, 1.0f, 1.0f },
+    { 0.71372549f, 0.71372549f, 1.0f, 1.0f },
+    { 0.721568627f, 0.721568627f, 1.0f, 1.0f },
+    { 0.729411765f, 0.729411765f, 1.0f, 1.0f },
+    { 0.737254902f, 0.737254902f, 1.0f, 1.0f },
+    { 0.745098039f, 0.745098039f, 1.0f, 1.0f },
+    { 0.752941176f, 0.752941176f, 1.0f, 1.0f },
+    { 0.760784314f, 0.760784314f, 1.0f, 1.0f },
+    { 0.768627451f, 0.768627451f, 1.0f, 1.0f },
+    { 0.776470588f, 0.776470588f, 1.0f, 1.0f },
+    { 0.784313725f, 0.784313725f, 1.0f, 1.0f },
+    { 0.792156863f, 0.792156863f, 1.0f, 1.0f },
+    { 0.8f, 0.8f, 1.0f, 1.0f },
+    { 0.807843137f, 0.807843137f, 1.0f, 1.0f },
+    { 0.815686275f, 0.815686275f, 1.0f, 1.0f },
+    { 0.823529412f, 0.823529412f, 1.0f, 1.0f },
+    { 0.831372549f, 0.831372549f, 1.0f, 1.0f },
+    { 0.839215686f, 0.839215686f, 1.0f, 1.0f },
+    { 0.847058824f, 0.847058824f, 1.0f, 1.0f },
+    { 0.854901961f, 0.854901961f, 1.0f, 1.0f },
+    { 0.862745098f, 0.862745098f, 1.0f, 1.0f },
+    { 0.870588235f, 0.870588235f, 1.0f, 1.0f },
+    { 0.878431373f, 0.878431373f, 1.0f, 1.0f },
+    { 0.88627451f, 0.88627451f, 1.0f, 1.0f },
+    { 0.894117647f, 0.894117647f, 1.0f, 1.0f },
+    { 0.901960784f, 0.901960784f, 1.0f, 1.0f },
+    { 0.909803922f, 0.909803922f, 1.0f, 1.0f },
+    { 0.917647059f, 0.917647059f, 1.0f, 1.0f },
+    { 0.925490196f, 0.925490196f, 1.0f, 1.0f },
+    { 0.933333333f, 0.933333333f, 1.0f, 1.0f },
+    { 0.941176471f, 0.941176471f, 1.0f, 1.0f },
+    { 0.949019608f, 0.949019608f, 1.0f, 1.0f },
+    { 0.956862745f, 0.956862745f, 1.0f, 1.0f },
+    { 0.964705882f, 0.964705882f, 1.0f, 1.0f },
+    { 0.97254902f, 0.97254902f, 1.0f, 1.0f },
+    { 0.980392157f, 0.980392157f, 1.0f, 1.0f },
+    { 0.988235294f, 0.988235294f, 1.0f, 1.0f },
+    { 0.996078431f, 0.996078431f, 1.0f, 1.0f },
+    { 1.0f, 0.996078431f, 0.996078431f, 1.0f },
+    { 1.0f, 0.988235294f, 0.988235294f, 1.0f },
+    { 1.0f, 0.980392157f, 0.980392157f, 1.0f },
+    { 1.0f, 0.97254902f, 0.97254902f, 1.0f },
+    { 1.0f, 0.964705882f, 0.964705882f, 1.0f },
+    { 1.0f, 0.956862745f, 0.956862745f, 1.0f },
+    { 1.0f, 0.949019608f, 0.949019608f, 1.0f },
+    { 1.0f, 0.941176471f, 0.941176471f, 1.0f },
+    { 1.0f, 0.933333333f, 0.933333333f, 1.0f },
+    { 1.0f, 0.925490196f, 0.925490196f, 1.0f },
+    { 1.0f, 0.917647059f, 0.917647059f, 1.0f },
+    { 1.0f, 0.909803922f, 0.909803922f, 1.0f },
+    { 1.0f, 0.901960784f, 0.901960784f, 1.0f },
+    { 1.0f, 0.894117647f, 0.894117647f, 1.0f },
+    { 1.0f, 0.88627451f, 0.88627451f, 1.0f },
+    { 1.0f, 0.878431373f, 0.878431373f, 1.0f },
+    { 1.0f, 0.870588235f, 0.870588235f, 1.0f },
+    { 1.0f, 0.862745098f, 0.862745098f, 1.0f },
+    { 1.0f, 0.854901961f, 0.854901961f, 1.0f },
+    { 1.0f, 0.847058824f, 0.847058824f, 1.0f },
+    { 1.0f, 0.839215686f, 0.839215686f, 1.0f },
+    { 1.0f, 0.831372549f, 0.831372549f, 1.0f },
+    { 1.0f, 0.823529412f, 0.823529412f, 1.0f },
+    { 1.0f, 0.815686275f, 0.815686275f, 1.0f },
+    { 1.0f, 0.807843137f, 0.807843137f, 1.0f },
+    { 1.0f, 0.8f, 0.8f, 1.0f },
+    { 1.0f, 0.792156863f, 0.792156863f, 1.0f },
+    { 1.0f, 0.784313725f, 0.784313725f, 1.0f },
+    { 1.0f, 0.776470588f, 0.776470588f, 1.0f },
+    { 1.0f, 0.768627451f, 0.768627451f, 1.0f },
+    { 1.0f, 0.760784314f, 0.760784314f, 1.0f },
+    { 1.0f, 0.752941176f, 0.752941176f, 1.0f },
+    { 1.0f, 0.745098039f, 0.745098039f, 1.0f },
+    { 1.0f, 0.737254902f, 0.737254902f, 1.0f },
+    { 1.0f, 0.729411765f, 0.729411765f, 1.0f },
+    { 1.0f, 0.721568627f, 0.721568627f, 1.0f },
+    { 1.0f, 0.71372549f, 0.71372549f, 1.0f },
+    { 1.0f, 0.705882353f, 0.705882353f, 1.0f },
+    { 1.0f, 0.698039216f, 0.698039216f, 1.0f },
+    { 1.0f, 0.690196078f, 0.690196078f, 1.0f },
+    { 1.0f, 0.682352941f, 0.682352941f, 1.0f },
+    { 1.0f, 0.674509804f, 0.674509804f, 1.0f },
+    { 1.0f, 0.666666667f, 0.666666667f, 1.0f },
+    { 1.0f, 0.658823529f, 0.658823529f, 1.0f },
+    { 1.0f, 0.650980392f, 0.650980392f, 1.0f },
+    { 1.0f, 0.643137255f, 0.643137255f, 1.0f },
+    { 1.0f, 0.635294118f, 0.635294118f, 1.0f },
+    { 1.0f, 0.62745098f, 0.62745098f, 1.0f },
+    { 1.0f, 0.619607843f, 0.619607843f, 1.0f },
+    { 1.0f, 0.611764706f, 0.611764706f, 1.0f },
+    { 1.0f, 0.603921569f, 0.603921569f, 1.0f },
+    { 1.0f, 0.596078431f, 0.596078431f, 1.0f },
+    { 1.0f, 0.588235294f, 0.588235294f, 1.0f },
+    { 1.0f, 0.580392157f, 0.580392157f, 1.0f },
+    { 1.0f, 0.57254902f, 0.57254902f, 1.0f },
+    { 1.0f, 0.564705882f, 0.564705882f, 1.0f },
+    { 1.0f, 0.556862745f, 0.556862745f, 1.0f },
+    { 1.0f, 0.549019608f, 0.549019608f, 1.0f },
+    { 1.0f, 0.541176471f, 0.541176471f, 1.0f },
+    { 1.0f, 0.533333333f, 0.533333333f, 1.0f },
+    { 1.0f, 0.525490196f, 0.525490196f, 1.0f },
+    { 1.0f, 0.517647059f, 0.517647059f, 1.0f },
+    { 1.0f, 0.509803922f, 0.509803922f, 1.0f },
+    { 1.0f, 0.501960784f, 0.501960784f, 1.0f },
+    { 1.0f, 0.494117647f, 0.494117647f, 1.0f },
+    { 1.0f, 0.48627451f, 0.48627451f, 1.0f },
+    { 1.0f, 0.478431373f, 0.478431373f, 1.0f },
+    { 1.0f, 0.470588235f, 0.470588235f, 1.0f },
+    { 1.0f, 0.462745098f, 0.462745098f, 1.0f },
+    { 1.0f, 0.454901961f, 0.454901961f, 1.0f },
+    { 1.0f, 0.447058824f, 0.447058824f, 1.0f },
+    { 1.0f, 0.439215686f, 0.439215686f, 1.0f },
+    { 1.0f, 0.431372549f, 0.431372549f, 1.0f },
+    { 1.0f, 0.423529412f, 0.423529412f, 1.0f },
+    { 1.0f, 0.415686275f, 0.415686275f, 1.0f },
+    { 1.0f, 0.407843137f, 0.407843137f, 1.0f },
+    { 1.0f, 0.4f, 0.4f, 1.0f },
+    { 1.0f, 0.392156863f, 0.392156863f, 1.0f },
+    { 1.0f, 0.384313725f, 0.384313725f, 1.0f },
+    { 1.0f, 0.376470588f, 0.376470588f, 1.0f },
+    { 1.0f, 0.368627451f, 0.368627451f, 1.0f },
+    { 1.0f, 0.360784314f, 0.360784314f, 1.0f },
+    { 1.0f, 0.352941176f, 0.352941176f, 1.0f },
+    { 1.0f, 0.345098039f, 0.345098039f, 1.0f },
+    { 1.0f, 0.337254902f, 0.337254902f, 1.0f },
+    { 1.0f, 0.329411765f, 0.329411765f, 1.0f },
+    { 1.0f, 0.321568627f, 0.321568627f, 1.0f },
+    { 1.0f, 0.31372549f, 0.31372549f, 1.0f },
+    { 1.0f, 0.305882353f, 0.305882353f, 1.0f },
+    { 1.0f, 0.298039216f, 0.298039216f, 1.0f },
+    { 1.0f, 0.290196078f, 0.290196078f, 1.0f },
+    { 1.0f, 0.282352941f, 0.282352941f, 1.0f },
+    { 1.0f, 0.274509804f, 0.274509804f, 1.0f },
+    { 1.0f, 0.266666667f, 0.266666667f, 1.0f },
+    { 1.0f, 0.258823529f, 0.258823529f, 1.0f },
+    { 1.0f, 0.250980392f, 0.250980392f, 1.0f },
+    { 1.0f, 0.243137255f, 0.243137255f, 1.0f },
+    { 1.0f, 0.235294118f, 0.235294118f, 1.0f },
+    { 1.0f, 0.22745098f, 0.22745098f, 1.0f },
+    { 1.0f, 0.219607843f, 0.219607843f, 1.0f },
+    { 1.0f, 0.211764706f, 0.211764706f, 1.0f },
+    { 1.0f, 0.203921569f, 0.203921569f, 1.0f },
+    { 1.0f, 0.196078431f, 0.196078431f, 1.0f },
+    { 1.0f, 0.188235294f, 0.188235294f, 1.0f },
+    { 1.0f, 0.180392157f, 0.180392157f, 1.0f },
+    { 1.0f, 0.17254902f, 0.17254902f, 1.0f },
+    { 1.0f, 0.164705882f, 0.164705882f, 1.0f },
+    { 1.0f, 0.156862745f, 0.156862745f, 1.0f },
+    { 1.0f, 0.149019608f, 0.149019608f, 1.0f },
+    { 1.0f, 0.141176471f, 0.141176471f, 1.0f },
+    { 1.0f, 0.133333333f, 0.133333333f, 1.0f },
+    { 1.0f, 0.125490196f, 0.125490196f, 1.0f },
+    { 1.0f, 0.117647059f, 0.117647059f, 1.0f },
+    { 1.0f, 0.109803922f, 0.109803922f, 1.0f },
+    { 1.0f, 0.101960784f, 0.101960784f, 1.0f },
+    { 1.0f, 0.0941176471f, 0.0941176471f, 1.0f },
+    { 1.0f, 0.0862745098f, 0.0862745098f, 1.0f },
+    { 1.0f, 0.0784313725f, 0.0784313725f, 1.0f },
+    { 1.0f, 0.0705882353f, 0.0705882353f, 1.0f },
+    { 1.0f, 0.062745098f, 0.062745098f, 1.0f },
+    { 1.0f, 0.0549019608f, 0.0549019608f, 1.0f },
+    { 1.0f, 0.0470588235f, 0.0470588235f, 1.0f },
+    { 1.0f, 0.0392156863f, 0.0392156863f, 1.0f },
+    { 1.0f, 0.031372549f, 0.031372549f, 1.0f },
+    { 1.0f, 0.0235294118f, 0.0235294118f, 1.0f },
+    { 1.0f, 0.0156862745f, 0.0156862745f, 1.0f },
+    { 1.0f, 0.00784313725f, 0.00784313725f, 1.0f },
+    { 1.0f, 0.0f, 0.0f, 1.0f },
+};
+
+static const float Planck_FreqMap_LUT[256][4] = {
+    { 0.0f, 0.0f, 1.0f, 1.0f },
+    { 0.00301659216f, 0.00603317647f, 1.0f, 1.0f },
+    { 0.00603317647f, 0.0120663529f, 1.0f, 1.0f },
+    { 0.00904976471f, 0.0180995294f, 1.0f, 1.0f },
+    { 0.0120663529f, 0.0241327451f, 1.0f, 1.0f },
+    { 0.0150829412f, 0.0301659216f, 1.0f, 1.0f },
+    { 0.0180995294f, 0.036199098f, 1.0f, 1.0f },
+    { 0.0211161569f, 0.0422321569f, 1.0f, 1.0f },
+    { 0.0241327451f, 0.0482654902f, 1.0f, 1.0f },
+    { 0.0271493333f, 0.0542988235f, 1.0f, 1.0f },
+    { 0.0301659216f, 0.0603317647f, 1.0f, 1.0f },
+    { 0.0331825098f, 0.066365098f, 1.0f, 1.0f },
+    { 0.036199098f, 0.0723980392f, 1.0f, 1.0f },
+    { 0.0392156863f, 0.0784313725f, 1.0f, 1.0f },
+    { 0.0452490196f, 0.127903529f, 1.0f, 1.0f },
+    { 0.0512819608f, 0.177375686f, 1.0f, 1.0f },
+    { 0.0573152941f, 0.226847843f, 1.0f, 1.0f },
+    { 0.0633482353f, 0.276319608f, 1.0f, 1.0f },
+    { 0.0693815686f, 0.325791765f, 1.0f, 1.0f },
+    { 0.075414902f, 0.375263922f, 1.0f, 1.0f },
+    { 0.0814478431f, 0.424737255f, 1.0f, 1.0f },
+    { 0.0874811765f, 0.474207843f, 1.0f, 1.0f },
+    { 0.0935145098f, 0.523678431f, 1.0f, 1.0f },
+    { 0.099547451f, 0.573152941f, 1.0f, 1.0f },
+    { 0.105580784f, 0.622623529f, 1.0f, 1.0f },
+    { 0.111613725f, 0.672098039f, 1.0f, 1.0f },
+    { 0.117647059f, 0.721568627f, 1.0f, 1.0f },
+    { 0.132730196f, 0.736952941f, 1.0f, 1.0f },
+    { 0.147812941f, 0.752337255f, 1.0f, 1.0f },
+    { 0.162896078f, 0.767721569f, 1.0f, 1.0f },
+    { 0.177978824f, 0.783105882f, 1.0f, 1.0f },
+    { 0.193061961f, 0.798490196f, 1.0f, 1.0f },
+    { 0.208144706f, 0.81387451f, 1.0f, 1.0f },
+    { 0.223227843f, 0.829262745f, 1.0f, 1.0f },
+    { 0.238310588f, 0.844647059f, 1.0f, 1.0f },
+    { 0.253393725f, 0.860031373f, 1.0f, 1.0f },
+    { 0.268476471f, 0.875415686f, 1.0f, 1.0f },
+    { 0.283559608f, 0.8908f, 1.0f, 1.0f },
+    { 0.298642353f, 0.906184314f, 1.0f, 1.0f },
+    { 0.31372549f, 0.921568627f, 1.0f, 1.0f },
+    { 0.347209804f, 0.922776471f, 0.998490196f, 1.0f },
+    { 0.380693725f, 0.923980392f, 0.996984314f, 1.0f },
+    { 0.414176471f, 0.925188235f, 0.99547451f, 1.0f },
+    { 0.447662745f, 0.926396078f, 0.993968627f, 1.0f },
+    { 0.481145098f, 0.9276f, 0.992458824f, 1.0f },
+    { 0.514631373f, 0.928807843f, 0.99094902f, 1.0f },
+    { 0.548113725f, 0.930015686f, 0.989443137f, 1.0f },
+    { 0.5816f, 0.931223529f, 0.987933333f, 1.0f },
+    { 0.615082353f, 0.932427451f, 0.986423529f, 1.0f },
+    { 0.648568627f, 0.933635294f, 0.984917647f, 1.0f },
+    { 0.68205098f, 0.934843137f, 0.983407843f, 1.0f },
+    { 0.715537255f, 0.936047059f, 0.981901961f, 1.0f },
+    { 0.749019608f, 0.937254902f, 0.980392157f, 1.0f },
+    { 0.760180392f, 0.937556863f, 0.978882353f, 1.0f },
+    { 0.771341176f, 0.937858824f, 0.977376471f, 1.0f },
+    { 0.782501961f, 0.938160784f, 0.975866667f, 1.0f },
+    { 0.793666667f, 0.938462745f, 0.974360784f, 1.0f },
+    { 0.804827451f, 0.938764706f, 0.97285098f, 1.0f },
+    { 0.815988235f, 0.939066667f, 0.971341176f, 1.0f },
+    { 0.82714902f, 0.939364706f, 0.969835294f, 1.0f },
+    { 0.838309804f, 0.939666667f, 0.96832549f, 1.0f },
+    { 0.849470588f, 0.939968627f, 0.966815686f, 1.0f },
+    { 0.860635294f, 0.940270588f, 0.965309804f, 1.0f },
+    { 0.871796078f, 0.940572549f, 0.9638f, 1.0f },
+    { 0.882956863f, 0.94087451f, 0.962294118f, 1.0f },
+    { 0.894117647f, 0.941176471f, 0.960784314f, 1.0f },
+    { 0.898752941f, 0.941533333f, 0.949019608f, 1.0f },
+    { 0.903388235f, 0.941890196f, 0.937254902f, 1.0f },
+    { 0.908019608f, 0.942247059f, 0.925490196f, 1.0f },
+    { 0.912654902f, 0.942603922f, 0.91372549f, 1.0f },
+    { 0.917290196f, 0.942960784f, 0.901960784f, 1.0f },
+    { 0.92192549f, 0.943313725f, 0.890196078f, 1.0f },
+    { 0.926560784f, 0.943670588f, 0.878431373f, 1.0f },
+    { 0.931196078f, 0.944027451f, 0.866666667f, 1.0f },
+    { 0.935827451f, 0.944384314f, 0.854901961f, 1.0f },
+    { 0.940462745f, 0.944741176f, 0.843137255f, 1.0f },
+    { 0.945098039f, 0.945098039f, 0.831372549f, 1.0f },
+    { 0.945098039f, 0.945098039f, 0.831372549f, 1.0f },
+    { 0.94652549f, 0.944741176f, 0.818180392f, 1.0f },
+    { 0.94794902f, 0.944384314f, 0.804992157f, 1.0f },
+    { 0.949376471f, 0.944027451f, 0.7918f, 1.0f },
+    { 0.950803922f, 0.943670588f, 0.778607843f, 1.0f },
+    { 0.952227451f, 0.943313725f, 0.765419608f, 1.0f },
+    { 0.953654902f, 0.942960784f, 0.752227451f, 1.0f },
+    { 0.955078431f, 0.942603922f, 0.739039216f, 1.0f },
+    { 0.956505882f, 0.942247059f, 0.725847059f, 1.0f },
+    { 0.957933333f, 0.941890196f, 0.712654902f, 1.0f },
+    { 0.959356863f, 0.941533333f, 0.699466667f, 1.0f },
+    { 0.960784314f, 0.941176471f, 0.68627451f, 1.0f },
+    { 0.961690196f, 0.939666667f, 0.672698039f, 1.0f },
+    { 0.962596078f, 0.938160784f, 0.65912549f, 1.0f },
+    { 0.963498039f, 0.93665098f, 0.64554902f, 1.0f },
+    { 0.964403922f, 0.935145098f, 0.631976471f, 1.0f },
+    { 0.965309804f, 0.933635294f, 0.6184f, 1.0f },
+    { 0.966215686f, 0.93212549f, 0.604827451f, 1.0f },
+    { 0.967117647f, 0.930619608f, 0.59125098f, 1.0f },
+    { 0.968023529f, 0.929109804f, 0.577678431f, 1.0f },
+    { 0.968929412f, 0.9276f, 0.564101961f, 1.0f },
+    { 0.969835294f, 0.926094118f, 0.550529412f, 1.0f },
+    { 0.970737255f, 0.924584314f, 0.536952941f, 1.0f },
+    { 0.971643137f, 0.923078431f, 0.523380392f, 1.0f },
+    { 0.97254902f, 0.921568627f, 0.509803922f, 1.0f },
+    { 0.973121569f, 0.912215686f, 0.48212549f, 1.0f },
+    { 0.973694118f, 0.902866667f, 0.45445098f, 1.0f },
+    { 0.974266667f, 0.893513725f, 0.426772549f, 1.0f },
+    { 0.974843137f, 0.884164706f, 0.399094118f, 1.0f },
+    { 0.975415686f, 0.874811765f, 0.371417647f, 1.0f },
+    { 0.975988235f, 0.865458824f, 0.343740784f, 1.0f },
+    { 0.976560784f, 0.856109804f, 0.316063529f, 1.0f },
+    { 0.977133333f, 0.846756863f, 0.288386275f, 1.0f },
+    { 0.977705882f, 0.837403922f, 0.26070902f, 1.0f },
+    { 0.978282353f, 0.828054902f, 0.233031765f, 1.0f },
+    { 0.978854902f, 0.818701961f, 0.20535451f, 1.0f },
+    { 0.979427451f, 0.809352941f, 0.177677255f, 1.0f },
+    { 0.98f, 0.8f, 0.15f, 1.0f },
+    { 0.977694118f, 0.784615686f, 0.142307843f, 1.0f },
+    { 0.975384314f, 0.769231373f, 0.134615294f, 1.0f },
+    { 0.973078431f, 0.753847059f, 0.126923137f, 1.0f },
+    { 0.970768627f, 0.738462745f, 0.119230588f, 1.0f },
+    { 0.968462745f, 0.723078431f, 0.111538431f, 1.0f },
+    { 0.966152941f, 0.707694118f, 0.103846275f, 1.0f },
+    { 0.963847059f, 0.692305882f, 0.0961537255f, 1.0f },
+    { 0.961537255f, 0.676921569f, 0.0884615686f, 1.0f },
+    { 0.959231373f, 0.661537255f, 0.0807694118f, 1.0f },
+    { 0.956921569f, 0.646152941f, 0.0730768627f, 1.0f },
+    { 0.954615686f, 0.630768627f, 0.0653847059f, 1.0f },
+    { 0.952305882f, 0.615384314f, 0.0576921569f, 1.0f },
+    { 0.95f, 0.6f, 0.05f, 1.0f },
+    { 0.938462745f, 0.576921569f, 0.0461537255f, 1.0f },
+    { 0.926921569f, 0.553847059f, 0.0423078431f, 1.0f },
+    { 0.915384314f, 0.530768627f, 0.0384615294f, 1.0f },
+    { 0.903847059f, 0.507694118f, 0.0346153725f, 1.0f },
+    { 0.892305882f, 0.484615686f, 0.0307692157f, 1.0f },
+    { 0.880768627f, 0.461537255f, 0.026923098f, 1.0f },
+    { 0.869231373f, 0.438462745f, 0.023076902f, 1.0f },
+    { 0.857694118f, 0.415384314f, 0.0192307843f, 1.0f },
+    { 0.846152941f, 0.392305882f, 0.0153846275f, 1.0f },
+    { 0.834615686f, 0.369230588f, 0.0115384706f, 1.0f },
+    { 0.823078431f, 0.346153725f, 0.00769231373f, 1.0f },
+    { 0.811537255f, 0.323076863f, 0.00384615294f, 1.0f },
+    { 0.8f, 0.3f, 0.0f, 1.0f },
+    { 0.788235294f, 0.286576078f, 0.00965309804f, 1.0f },
+    { 0.776470588f, 0.273152157f, 0.0193061961f, 1.0f },
+    { 0.764705882f, 0.259728627f, 0.0289592941f, 1.0f },
+    { 0.752941176f, 0.246304706f, 0.0386123922f, 1.0f },
+    { 0.741176471f, 0.232880784f, 0.0482654902f, 1.0f },
+    { 0.729411765f, 0.219456863f, 0.0579184314f, 1.0f },
+    { 0.717647059f, 0.206033333f, 0.0675717647f, 1.0f },
+    { 0.705882353f, 0.192609412f, 0.0772247059f, 1.0f },
+    { 0.694117647f, 0.17918549f, 0.0868776471f, 1.0f },
+    { 0.682352941f, 0.165761569f, 0.0965309804f, 1.0f },
+    { 0.670588235f, 0.152338039f, 0.106183922f, 1.0f },
+    { 0.658823529f, 0.138914118f, 0.115837255f, 1.0f },
+    { 0.647058824f, 0.125490196f, 0.125490196f, 1.0f },
+    { 0.63167451f, 0.115837255f, 0.125490196f, 1.0f },
+    { 0.616290196f, 0.106183922f, 0.125490196f, 1.0f },
+    { 0.600905882f, 0.0965309804f, 0.125490196f, 1.0f },
+    { 0.585521569f, 0.0868776471f, 0.125490196f, 1.0f },
+    { 0.570137255f, 0.0772247059f, 0.125490196f, 1.0f },
+    { 0.554752941f, 0.0675717647f, 0.125490196f, 1.0f },
+    { 0.539364706f, 0.0579184314f, 0.125490196f, 1.0f },
+    { 0.523980392f, 0.0482654902f, 0.125490196f, 1.0f },
+    { 0.508596078f, 0.0386123529f, 0.125490196f, 1.0f },
+    { 0.493211765f, 0.0289592941f, 0.125490196f, 1.0f },
+    { 0.477827451f, 0.0193061961f, 0.125490196f, 1.0f },
+    { 0.462443137f, 0.00965309804f, 0.125490196f, 1.0f },
+    { 0.447058824f, 0.0f, 0.125490196f, 1.0f },
+    { 0.451129412f, 0.0384615294f, 0.16199098f, 1.0f },
+    { 0.455203922f, 0.0769231373f, 0.198491765f, 1.0f },
+    { 0.45927451f, 0.115384706f, 0.234992549f, 1.0f },
+    { 0.46334902f, 0.153846275f, 0.271493333f, 1.0f },
+    { 0.467419608f, 0.192307843f, 0.307994118f, 1.0f },
+    { 0.471494118f, 0.230769412f, 0.344494902f, 1.0f },
+    { 0.475564706f, 0.269230588f, 0.380995686f, 1.0f },
+    { 0.479639216f, 0.307692157f, 0.417498039f, 1.0f },
+    { 0.483709804f, 0.346153725f, 0.453996078f, 1.0f },
+    { 0.487784314f, 0.384615294f, 0.490498039f, 1.0f },
+    { 0.491854902f, 0.423078431f, 0.527f, 1.0f },
+    { 0.495929412f, 0.461537255f, 0.563498039f, 1.0f },
+    { 0.5f, 0.5f, 0.6f, 1.0f },
+    { 0.515384314f, 0.515384314f, 0.615384314f, 1.0f },
+    { 0.530768627f, 0.530768627f, 0.630768627f, 1.0f },
+    { 0.546152941f, 0.546152941f, 0.646152941f, 1.0f },
+    { 0.561537255f, 0.561537255f, 0.661537255f, 1.0f },
+    { 0.576921569f, 0.576921569f, 0.676921569f, 1.0f },
+    { 0.592305882f, 0.592305882f, 0.692305882f, 1.0f },
+    { 0.607694118f, 0.607694118f, 0.707694118f, 1.0f },
+    { 0.623078431f, 0.623078431f, 0.723078431f, 1.0f },
+    { 0.638462745f, 0.638462745f, 0.738462745f, 1.0f },
+    { 0.653847059f, 0.653847059f, 0.753847059f, 1.0f },
+    { 0.669231373f, 0.669231373f, 0.769231373f, 1.0f },
+    { 0.684615686f, 0.684615686f, 0.784615686f, 1.0f },
+    { 0.7f, 0.7f, 0.8f, 1.0f },
+    { 0.707694118f, 0.707694118f, 0.807694118f, 1.0f },
+    { 0.715384314f, 0.715384314f, 0.815384314f, 1.0f },
+    { 0.723078431f, 0.723078431f, 0.823078431f, 1.0f },
+    { 0.730768627f, 0.730768627f, 0.830768627f, 1.0f },
+    { 0.738462745f, 0.738462745f, 0.838462745f, 1.0f },
+    { 0.746152941f, 0.746152941f, 0.846152941f, 1.0f },
+    { 0.753847059f, 0.753847059f, 0.853847059f, 1.0f },
+    { 0.761537255f, 0.761537255f, 0.861537255f, 1.0f },
+    { 0.769231373f, 0.769231373f, 0.869231373f, 1.0f },
+    { 0.776921569f, 0.776921569f, 0.876921569f, 1.0f },
+    { 0.784615686f, 0.784615686f, 0.884615686f, 1.0f },
+    { 0.792305882f, 0.792305882f, 0.892305882f, 1.0f },
+    { 0.8f, 0.8f, 0.9f, 1.0f },
+    { 0.807694118f, 0.807694118f, 0.903847059f, 1.0f },
+    { 0.815384314f, 0.815384314f, 0.907694118f, 1.0f },
+    { 0.823078431f, 0.823078431f, 0.911537255f, 1.0f },
+    { 0.830768627f, 0.830768627f, 0.915384314f, 1.0f },
+    { 0.838462745f, 0.838462745f, 0.919231373f, 1.0f },
+    { 0.846152941f, 0.846152941f, 0.923078431f, 1.0f },
+    { 0.853847059f, 0.853847059f, 0.926921569f, 1.0f },
+    { 0.861537255f, 0.861537255f, 0.930768627f, 1.0f },
+    { 0.869231373f, 0.869231373f, 0.934615686f, 1.0f },
+    { 0.876921569f, 0.876921569f, 0.938462745f, 1.0f },
+    { 0.884615686f, 0.884615686f, 0.942305882f, 1.0f },
+    { 0.892305882f, 0.892305882f, 0.946152941f, 1.0f },
+    { 0.9f, 0.9f, 0.95f, 1.0f },
+    { 0.903847059f, 0.903847059f, 0.952305882f, 1.0f },
+    { 0.907694118f, 0.907694118f, 0.954615686f, 1.0f },
+    { 0.911537255f, 0.911537255f, 0.956921569f, 1.0f },
+    { 0.915384314f, 0.915384314f, 0.959231373f, 1.0f },
+    { 0.919231373f, 0.919231373f, 0.961537255f, 1.0f },
+    { 0.923078431f, 0.923078431f, 0.963847059f, 1.0f },
+    { 0.926921569f, 0.926921569f, 0.966152941f, 1.0f },
+    { 0.930768627f, 0.930768627f, 0.968462745f, 1.0f },
+    { 0.934615686f, 0.934615686f, 0.970768627f, 1.0f },
+    { 0.938462745f, 0.938462745f, 0.973078431f, 1.0f },
+    { 0.942305882f, 0.942305882f, 0.975384314f, 1.0f },
+    { 0.946152941f, 0.946152941f, 0.977694118f, 1.0f },
+    { 0.95f, 0.95f, 0.98f, 1.0f },
+    { 0.951537255f, 0.951537255f, 0.980768627f, 1.0f },
+    { 0.953078431f, 0.953078431f, 0.981537255f, 1.0f },
+    { 0.954615686f, 0.954615686f, 0.982305882f, 1.0f },
+    { 0.956152941f, 0.956152941f, 0.983078431f, 1.0f },
+    { 0.957694118f, 0.957694118f, 0.983847059f, 1.0f },
+    { 0.959231373f, 0.959231373f, 0.984615686f, 1.0f },
+    { 0.960768627f, 0.960768627f, 0.985384314f, 1.0f },
+    { 0.962305882f, 0.962305882f, 0.986152941f, 1.0f },
+    { 0.963847059f, 0.963847059f, 0.986921569f, 1.0f },
+    { 0.965384314f, 0.965384314f, 0.987694118f, 1.0f },
+    { 0.966921569f, 0.966921569f, 0.988462745f, 1.0f },
+    { 0.968462745f, 0.968462745f, 0.989231373f, 1.0f },
+    { 0.97f, 0.97f, 0.99f, 1.0f },
+    { 0.971819608f, 0.971819608f, 0.990909804f, 1.0f },
+    { 0.973635294f, 0.973635294f, 0.991819608f, 1.0f },
+    { 0.975454902f, 0.975454902f, 0.99272549f, 1.0f },
+    { 0.97727451f, 0.97727451f, 0.993635294f, 1.0f },
+    { 0.979090196f, 0.979090196f, 0.994545098f, 1.0f },
+    { 0.980909804f, 0.980909804f, 0.995454902f, 1.0f },
+    { 0.98272549f, 0.98272549f, 0.996364706f, 1.0f },
+    { 0.984545098f, 0.984545098f, 0.99727451f, 1.0f },
+    { 0.986364706f, 0.986364706f, 0.998180392f, 1.0f },
+    { 0.988180392f, 0.988180392f, 0.999090196f, 1.0f },
+    { 0.99f, 0.99f, 1.0f, 1.0f },
+};
+
+static const float HEALPix_Grey_LUT[100][4] = {
+    { 0.0f, 0.0f, 0.0f, 1.0f },
+    { 0.00784313725f, 0.00784313725f, 0.00784313725f, 1.0f },
+    { 0.0196078431f, 0.0196078431f, 0.0196078431f, 1.0f },
+    { 0.0274509804f, 0.0274509804f, 0.0274509804f, 1.0f },
+    { 0.0392156863f, 0.0392156863f, 0.0392156863f, 1.0f },
+    { 0.0470588235f, 0.0470588235f, 0.0470588235f, 1.0f },
+    { 0.0588235294f, 0.0588235294f, 0.0588235294f, 1.0f },
+    { 0.0705882353f, 0.0705882353f, 0.0705882353f, 1.0f },
+    { 0.0784313725f, 0.0784313725f, 0.0784313725f, 1.0f },
+    { 0.0901960784f, 0.0901960784f, 0.0901960784f, 1.0f },
+    { 0.0980392157f, 0.0980392157f, 0.0980392157f, 1.0f },
+    { 0.109803922f, 0.109803922f, 0.109803922f, 1.0f },
+    { 0.117647059f, 0.117647059f, 0.117647059f, 1.0f },
+    { 0.129411765f, 0.129411765f, 0.129411765f, 1.0f },
+    { 0.141176471f, 0.141176471f, 0.141176471f, 1.0f },
+    { 0.149019608f, 0.149019608f, 0.149019608f, 1.0f },
+    { 0.160784314f, 0.160784314f, 0.160784314f, 1.0f },
+    { 0.168627451f, 0.168627451f, 0.168627451f, 1.0f },
+    { 0.180392157f, 0.180392157f, 0.180392157f, 1.0f },
+    { 0.188235294f, 0.188235294f, 0.188235294f, 1.0f },
+    { 0.2f, 0.2f, 0.2f, 1.0f },
+    { 0.211764706f, 0.211764706f, 0.211764706f, 1.0f },
+    { 0.219607843f, 0.219607843f, 0.219607843f, 1.0f },
+    { 0.231372549f, 0.231372549f, 0.231372549f, 1.0f },
+    { 0.239215686f, 0.239215686f, 0.239215686f, 1.0f },
+    { 0.250980392f, 0.250980392f, 0.250980392f, 1.0f },
+    { 0.258823529f, 0.258823529f, 0.258823529f, 1.0f },
+    { 0.270588235f, 0.270588235f, 0.270588235f, 1.0f },
+    { 0.282352941f, 0.282352941f, 0.282352941f, 1.0f },
+    { 0.290196078f, 0.290196078f, 0.290196078f, 1.0f },
+    { 0.301960784f, 0.301960784f, 0.301960784f, 1.0f },
+    { 0.309803922f, 0.309803922f, 0.309803922f, 1.0f },
+    { 0.321568627f, 0.321568627f, 0.321568627f, 1.0f },
+    { 0.333333333f, 0.333333333f, 0.333333333f, 1.0f },
+    { 0.341176471f, 0.341176471f, 0.341176471f, 1.0f },
+    { 0.352941176f, 0.352941176f, 0.352941176f, 1.0f },
+    { 0.360784314f, 0.360784314f, 0.360784314f, 1.0f },
+    { 0.37254902f, 0.37254902f, 0.37254902f, 1.0f },
+    { 0.380392157f, 0.380392157f, 0.380392157f, 1.0f },
+    { 0.392156863f, 0.392156863f, 0.392156863f, 1.0f },
+    { 0.403921569f, 0.403921569f, 0.403921569f, 1.0f },
+    { 0.411764706f, 0.411764706f, 0.411764706f, 1.0f },
+    { 0.423529412f, 0.423529412f, 0.423529412f, 1.0f },
+    { 0.431372549f, 0.431372549f, 0.431372549f, 1.0f },
+    { 0.443137255f, 0.443137255f, 0.443137255f, 1.0f },
+    { 0.450980392f, 0.450980392f, 0.450980392f, 1.0f },
+    { 0.462745098f, 0.462745098f, 0.462745098f, 1.0f },
+    { 0.474509804f, 0.474509804f, 0.474509804f, 1.0f },
+    { 0.482352941f, 0.482352941f, 0.482352941f, 1.0f },
+    { 0.494117647f, 0.494117647f, 0.494117647f, 1.0f },
+    { 0.501960784f, 0.501960784f, 0.501960784f, 1.0f },
+    { 0.51372549f, 0.51372549f, 0.51372549f, 1.0f },
+    { 0.521568627f, 0.521568627f, 0.521568627f, 1.0f },
+    { 0.533333333f, 0.533333333f, 0.533333333f, 1.0f },
+    { 0.545098039f, 0.545098039f, 0.545098039f, 1.0f },
+    { 0.552941176f, 0.552941176f, 0.552941176f, 1.0f },
+    { 0.564705882f, 0.564705882f, 0.564705882f, 1.0f },
+    { 0.57254902f, 0.57254902f, 0.57254902f, 1.0f },
+    { 0.584313725f, 0.584313725f, 0.584313725f, 1.0f },
+    { 0.592156863f, 0.592156863f, 0.592156863f, 1.0f },
+    { 0.603921569f, 0.603921569f, 0.603921569f, 1.0f },
+    { 0.615686275f, 0.615686275f, 0.615686275f, 1.0f },
+    { 0.623529412f, 0.623529412f, 0.623529412f, 1.0f },
+    { 0.635294118f, 0.635294118f, 0.635294118f, 1.0f },
+    { 0.643137255f, 0.643137255f, 0.643137255f, 1.0f },
+    { 0.654901961f, 0.654901961f, 0.654901961f, 1.0f },
+    { 0.666666667f, 0.666666667f, 0.666666667f, 1.0f },
+    { 0.674509804f, 0.674509804f, 0.674509804f, 1.0f },
+    { 0.68627451f, 0.68627451f, 0.68627451f, 1.0f },
+    { 0.694117647f, 0.694117647f, 0.694117647f, 1.0f },
+    { 0.705882353f, 0.705882353f, 0.705882353f, 1.0f },
+    { 0.71372549f, 0.71372549f, 0.71372549f, 1.0f },
+    { 0.725490196f, 0.725490196f, 0.725490196f, 1.0f },
+    { 0.737254902f, 0.737254902f, 0.737254902f, 1.0f },
+    { 0.745098039f, 0.745098039f, 0.745098039f, 1.0f },
+    { 0.756862745f, 0.756862745f, 0.756862745f, 1.0f },
+    { 0.764705882f, 0.764705882f, 0.764705882f, 1.0f },
+    { 0.776470588f, 0.776470588f, 0.776470588f, 1.0f },
+    { 0.784313725f, 0.784313725f, 0.784313725f, 1.0f },
+    { 0.796078431f, 0.796078431f, 0.796078431f, 1.0f },
+    { 0.807843137f, 0.807843137f, 0.807843137f, 1.0f },
+    { 0.815686275f, 0.815686275f, 0.815686275f, 1.0f },
+    { 0.82745098f, 0.82745098f, 0.82745098f, 1.0f },
+    { 0.835294118f, 0.835294118f, 0.835294118f, 1.0f },
+    { 0.847058824f, 0.847058824f, 0.847058824f, 1.0f },
+    { 0.854901961f, 0.854901961f, 0.854901961f, 1.0f },
+    { 0.866666667f, 0.866666667f, 0.866666667f, 1.0f },
+    { 0.878431373f, 0.878431373f, 0.878431373f, 1.0f },
+    { 0.88627451f, 0.88627451f, 0.88627451f, 1.0f },
+    { 0.898039216f, 0.898039216f, 0.898039216f, 1.0f },
+    { 0.905882353f, 0.905882353f, 0.905882353f, 1.0f },
+    { 0.917647059f, 0.917647059f, 0.917647059f, 1.0f },
+    { 0.925490196f, 0.925490196f, 0.925490196f, 1.0f },
+    { 0.937254902f, 0.937254902f, 0.937254902f, 1.0f },
+    { 0.949019608f, 0.949019608f, 0.949019608f, 1.0f },
+    { 0.956862745f, 0.956862745f, 0.956862745f, 1.0f },
+    { 0.968627451f, 0.968627451f, 0.968627451f, 1.0f },
+    { 0.976470588f, 0.976470588f, 0.976470588f, 1.0f },
+    { 0.988235294f, 0.988235294f, 0.988235294f, 1.0f },
+    { 1.0f, 1.0f, 1.0f, 1.0f },
+};
+
+static const float HEALPix_Hot_LUT[100][4] = {
+    { 0.0f, 0.0f, 0.0f, 1.0f },
+    { 0.00784313725f, 0.0f, 0.0f, 1.0f },
+    { 0.0274509804f, 0.0f, 0.0f, 1.0f },
+    { 0.0392156863f, 0.0f, 0.0f, 1.0f },
+    { 0.0549019608f, 0.0f, 0.0f, 1.0f },
+    { 0.0666666667f, 0.0f, 0.0f, 1.0f },
+    { 0.0823529412f, 0.0f, 0.0f, 1.0f },
+    { 0.101960784f, 0.0f, 0.0f, 1.0f },
+    { 0.109803922f, 0.0f, 0.0f, 1.0f },
+    { 0.129411765f, 0.0f, 0.0f, 1.0f },
+    { 0.141176471f, 0.0f, 0.0f, 1.0f },
+    { 0.156862745f, 0.0f, 0.0f, 1.0f },
+    { 0.168627451f, 0.0f, 0.0f, 1.0f },
+    { 0.184313725f, 0.0f, 0.0f, 1.0f },
+    { 0.203921569f, 0.0f, 0.0f, 1.0f },
+    { 0.215686275f, 0.0f, 0.0f, 1.0f },
+    { 0.231372549f, 0.0f, 0.0f, 1.0f },
+    { 0.243137255f, 0.0f, 0.0f, 1.0f },
+    { 0.258823529f, 0.0f, 0.0f, 1.0f },
+    { 0.270588235f, 0.0f, 0.0f, 1.0f },
+    { 0.28627451f, 0.0f, 0.0f, 1.0f },
+    { 0.305882353f, 0.0f, 0.0f, 1.0f },
+    { 0.317647059f, 0.0f, 0.0f, 1.0f },
+    { 0.333333333f, 0.0f, 0.0f, 1.0f },
+    { 0.345098039f, 0.0f, 0.0f, 1.0f },
+    { 0.360784314f, 0.0f, 0.0f, 1.0f },
+    { 0.37254902f, 0.0f, 0.0f, 1.0f },
+    { 0.388235294f, 0.0f, 0.0f, 1.0f },
+    { 0.407843137f, 0.0f, 0.0f, 1.0f },
+    { 0.419607843f, 0.0f, 0.0f, 1.0f },
+    { 0.435294118f, 0.0f, 0.0f, 1.0f },
+    { 0.447058824f, 0.0f, 0.0f, 1.0f },
+    { 0.462745098f, 0.0f, 0.0f, 1.0f },
+    { 0.482352941f, 0.0f, 0.0f, 1.0f },
+    { 0.494117647f, 0.0f, 0.0f, 1.0f },
+    { 0.509803922f, 0.0f, 0.0f, 1.0f },
+    { 0.521568627f, 0.0f, 0.0f, 1.0f },
+    { 0.537254902f, 0.0f, 0.0f, 1.0f },
+    { 0.549019608f, 0.0f, 0.0f, 1.0f },
+    { 0.564705882f, 0.0f, 0.0f, 1.0f },
+    { 0.584313725f, 0.0f, 0.0f, 1.0f },
+    { 0.596078431f, 0.0f, 0.0f, 1.0f },
+    { 0.611764706f, 0.0f, 0.0f, 1.0f },
+    { 0.623529412f, 0.0f, 0.0f, 1.0f },
+    { 0.639215686f, 0.0f, 0.0f, 1.0f },
+    { 0.650980392f, 0.0f, 0.0f, 1.0f },
+    { 0.666666667f, 0.0f, 0.0f, 1.0f },
+    { 0.68627451f, 0.00392156863f, 0.0f, 1.0f },
+    { 0.698039216f, 0.0196078431f, 0.0f, 1.0f },
+    { 0.71372549f, 0.0431372549f, 0.0f, 1.0f },
+    { 0.725490196f, 0.0588235294f, 0.0f, 1.0f },
+    { 0.741176471f, 0.0784313725f, 0.0f, 1.0f },
+    { 0.752941176f, 0.0941176471f, 0.0f, 1.0f },
+    { 0.77254902f, 0.117647059f, 0.0f, 1.0f },
+    { 0.788235294f, 0.137254902f, 0.0f, 1.0f },
+    { 0.8f, 0.152941176f, 0.0f, 1.0f },
+    { 0.815686275f, 0.176470588f, 0.0f, 1.0f },
+    { 0.82745098f, 0.192156863f, 0.0f, 1.0f },
+    { 0.843137255f, 0.211764706f, 0.0f, 1.0f },
+    { 0.854901961f, 0.22745098f, 0.0f, 1.0f },
+    { 0.874509804f, 0.250980392f, 0.0f, 1.0f },
+    { 0.890196078f, 0.270588235f, 0.0f, 1.0f },
+    { 0.901960784f, 0.28627451f, 0.0f, 1.0f },
+    { 0.917647059f, 0.309803922f, 0.0f, 1.0f },
+    { 0.929411765f, 0.325490196f, 0.0f, 1.0f },
+    { 0.945098039f, 0.345098039f, 0.0f, 1.0f },
+    { 0.964705882f, 0.368627451f, 0.0f, 1.0f },
+    { 0.976470588f, 0.384313725f, 0.0f, 1.0f },
+    { 0.992156863f, 0.403921569f, 0.0f, 1.0f },
+    { 1.0f, 0.419607843f, 0.0f, 1.0f },
+    { 1.0f, 0.443137255f, 0.0f, 1.0f },
+    { 1.0f, 0.458823529f, 0.0f, 1.0f },
+    { 1.0f, 0.478431373f, 0.0f, 1.0f },
+    { 1.0f, 0.501960784f, 0.0f, 1.0f },
+    { 1.0f, 0.517647059f, 0.0f, 1.0f },
+    { 1.0f, 0.537254902f, 0.0431372549f, 1.0f },
+    { 1.0f, 0.552941176f, 0.0745098039f, 1.0f },
+    { 1.0f, 0.576470588f, 0.121568627f, 1.0f },
+    { 1.0f, 0.592156863f, 0.152941176f, 1.0f },
+    { 1.0f, 0.611764706f, 0.2f, 1.0f },
+    { 1.0f, 0.635294118f, 0.243137255f, 1.0f },
+    { 1.0f, 0.650980392f, 0.274509804f, 1.0f },
+    { 1.0f, 0.670588235f, 0.321568627f, 1.0f },
+    { 1.0f, 0.68627451f, 0.352941176f, 1.0f },
+    { 1.0f, 0.709803922f, 0.4f, 1.0f },
+    { 1.0f, 0.725490196f, 0.42745098f, 1.0f },
+    { 1.0f, 0.745098039f, 0.474509804f, 1.0f },
+    { 1.0f, 0.768627451f, 0.521568627f, 1.0f },
+    { 1.0f, 0.784313725f, 0.552941176f, 1.0f },
+    { 1.0f, 0.803921569f, 0.6f, 1.0f },
+    { 1.0f, 0.819607843f, 0.62745098f, 1.0f },
+    { 1.0f, 0.843137255f, 0.674509804f, 1.0f },
+    { 1.0f, 0.858823529f, 0.705882353f, 1.0f },
+    { 1.0f, 0.878431373f, 0.752941176f, 1.0f },
+    { 1.0f, 0.901960784f, 0.8f, 1.0f },
+    { 1.0f, 0.917647059f, 0.82745098f, 1.0f },
+    { 1.0f, 0.937254902f, 0.874509804f, 1.0f },
+    { 1.0f, 0.952941176f, 0.905882353f, 1.0f },
+    { 1.0f, 0.976470588f, 0.952941176f, 1.0f },
+    { 1.0f, 1.0f, 1.0f, 1.0f },
+};
+
+static const float HEALPix_Cold_LUT[100][4] = {
+    { 0.0f, 0.0f, 0.0f, 1.0f },
+    { 0.0f, 0.0f, 0.00784313725f, 1.0f },
+    { 0.0f, 0.0f, 0.0235294118f, 1.0f },
+    { 0.0f, 0.0f, 0.0352941176f, 1.0f },
+    { 0.0f, 0.0f, 0.0509803922f, 1.0f },
+    { 0.0f, 0.0f, 0.062745098f, 1.0f },
+    { 0.0f, 0.0f, 0.0784313725f, 1.0f },
+    { 0.0f, 0.0f, 0.0941176471f, 1.0f },
+    { 0.0f, 0.0f, 0.105882353f, 1.0f },
+    { 0.0f, 0.0f, 0.121568627f, 1.0f },
+    { 0.0f, 0.0f, 0.129411765f, 1.0f },
+    { 0.0f, 0.0f, 0.145098039f, 1.0f },
+    { 0.0f, 0.0f, 0.156862745f, 1.0f },
+    { 0.0f, 0.0f, 0.17254902f, 1.0f },
+    { 0.0f, 0.0f, 0.188235294f, 1.0f },
+    { 0.0f, 0.0f, 0.2f, 1.0f },
+    { 0.0f, 0.0f, 0.215686275f, 1.0f },
+    { 0.0f, 0.0f, 0.22745098f, 1.0f },
+    { 0.0f, 0.0f, 0.243137255f, 1.0f },
+    { 0.0f, 0.0f, 0.254901961f, 1.0f },
+    { 0.0f, 0.0f, 0.270588235f, 1.0f },
+    { 0.0f, 0.0f, 0.28627451f, 1.0f },
+    { 0.0f, 0.0f, 0.294117647f, 1.0f },
+    { 0.0f, 0.0f, 0.31372549f, 1.0f },
+    { 0.0f, 0.0f, 0.321568627f, 1.0f },
+    { 0.0f, 0.0f, 0.337254902f, 1.0f },
+    { 0.0f, 0.0f, 0.349019608f, 1.0f },
+    { 0.0f, 0.0f, 0.364705882f, 1.0f },
+    { 0.0f, 0.0f, 0.380392157f, 1.0f },
+    { 0.0f, 0.0f, 0.392156863f, 1.0f },
+    { 0.0f, 0.0f, 0.407843137f, 1.0f },
+    { 0.0f, 0.0f, 0.419607843f, 1.0f },
+    { 0.0f, 0.0f, 0.435294118f, 1.0f },
+    { 0.0f, 0.0f, 0.450980392f, 1.0f },
+    { 0.0f, 0.0f, 0.462745098f, 1.0f },
+    { 0.0f, 0.0f, 0.478431373f, 1.0f },
+    { 0.0f, 0.0f, 0.48627451f, 1.0f },
+    { 0.0f, 0.0f, 0.501960784f, 1.0f },
+    { 0.0f, 0.00784313725f, 0.51372549f, 1.0f },
+    { 0.0f, 0.0274509804f, 0.529411765f, 1.0f },
+    { 0.0f, 0.0470588235f, 0.545098039f, 1.0f },
+    { 0.0f, 0.0588235294f, 0.556862745f, 1.0f },
+    { 0.0f, 0.0784313725f, 0.57254902f, 1.0f },
+    { 0.0f, 0.0901960784f, 0.584313725f, 1.0f },
+    { 0.0f, 0.109803922f, 0.6f, 1.0f },
+    { 0.0f, 0.121568627f, 0.607843137f, 1.0f },
+    { 0.0f, 0.141176471f, 0.62745098f, 1.0f },
+    { 0.0f, 0.160784314f, 0.643137255f, 1.0f },
+    { 0.0f, 0.17254902f, 0.650980392f, 1.0f },
+    { 0.0f, 0.192156863f, 0.666666667f, 1.0f },
+    { 0.0f, 0.203921569f, 0.678431373f, 1.0f },
+    { 0.0f, 0.223529412f, 0.694117647f, 1.0f },
+    { 0.0f, 0.235294118f, 0.705882353f, 1.0f },
+    { 0.0f, 0.254901961f, 0.721568627f, 1.0f },
+    { 0.0f, 0.270588235f, 0.737254902f, 1.0f },
+    { 0.0f, 0.28627451f, 0.749019608f, 1.0f },
+    { 0.0f, 0.301960784f, 0.764705882f, 1.0f },
+    { 0.0f, 0.317647059f, 0.776470588f, 1.0f },
+    { 0.0f, 0.333333333f, 0.792156863f, 1.0f },
+    { 0.0f, 0.349019608f, 0.8f, 1.0f },
+    { 0.0f, 0.368627451f, 0.815686275f, 1.0f },
+    { 0.0f, 0.384313725f, 0.831372549f, 1.0f },
+    { 0.0f, 0.4f, 0.843137255f, 1.0f },
+    { 0.0f, 0.415686275f, 0.858823529f, 1.0f },
+    { 0.0f, 0.431372549f, 0.870588235f, 1.0f },
+    { 0.0f, 0.447058824f, 0.88627451f, 1.0f },
+    { 0.0f, 0.466666667f, 0.901960784f, 1.0f },
+    { 0.0f, 0.478431373f, 0.91372549f, 1.0f },
+    { 0.0f, 0.498039216f, 0.929411765f, 1.0f },
+    { 0.0f, 0.509803922f, 0.941176471f, 1.0f },
+    { 0.0f, 0.529411765f, 0.956862745f, 1.0f },
+    { 0.0f, 0.541176471f, 0.964705882f, 1.0f },
+    { 0.0f, 0.560784314f, 0.980392157f, 1.0f },
+    { 0.0f, 0.580392157f, 1.0f, 1.0f },
+    { 0.0f, 0.592156863f, 1.0f, 1.0f },
+    { 0.0196078431f, 0.611764706f, 1.0f, 1.0f },
+    { 0.0509803922f, 0.623529412f, 1.0f, 1.0f },
+    { 0.0980392157f, 0.643137255f, 1.0f, 1.0f },
+    { 0.129411765f, 0.654901961f, 1.0f, 1.0f },
+    { 0.176470588f, 0.674509804f, 1.0f, 1.0f },
+    { 0.223529412f, 0.694117647f, 1.0f, 1.0f },
+    { 0.254901961f, 0.705882353f, 1.0f, 1.0f },
+    { 0.301960784f, 0.725490196f, 1.0f, 1.0f },
+    { 0.333333333f, 0.737254902f, 1.0f, 1.0f },
+    { 0.384313725f, 0.756862745f, 1.0f, 1.0f },
+    { 0.415686275f, 0.768627451f, 1.0f, 1.0f },
+    { 0.462745098f, 0.788235294f, 1.0f, 1.0f },
+    { 0.509803922f, 0.807843137f, 1.0f, 1.0f },
+    { 0.541176471f, 0.819607843f, 1.0f, 1.0f },
+    { 0.588235294f, 0.839215686f, 1.0f, 1.0f },
+    { 0.619607843f, 0.850980392f, 1.0f, 1.0f },
+    { 0.666666667f, 0.870588235f, 1.0f, 1.0f },
+    { 0.701960784f, 0.882352941f, 1.0f, 1.0f },
+    { 0.749019608f, 0.901960784f, 1.0f, 1.0f },
+    { 0.796078431f, 0.921568627f, 1.0f, 1.0f },
+    { 0.82745098f, 0.933333333f, 1.0f, 1.0f },
+    { 0.874509804f, 0.952941176f, 1.0f, 1.0f },
+    { 0.905882353f, 0.964705882f, 1.0f, 1.0f },
+    { 0.952941176f, 0.984313725f, 1.0f, 1.0f },
+    { 1.0f, 1.0f, 1.0f, 1.0f },
+};
+
+static const float HEALPix_Lime_LUT[100][4] = {
+    { 0.0f, 0.0f, 0.0f, 1.0f },
+    { 0.0f, 0.00784313725f, 0.0f, 1.0f },
+    { 0.0f, 0.0274509804f, 0.0f, 1.0f },
+    { 0.0f, 0.0392156863f, 0.0f, 1.0f },
+    { 0.0f, 0.0549019608f, 0.0f, 1.0f },
+    { 0.0f, 0.0666666667f, 0.0f, 1.0f },
+    { 0.0f, 0.0823529412f, 0.0f, 1.0f },
+    { 0.0f, 0.101960784f, 0.0f, 1.0f },
+    { 0.0f, 0.109803922f, 0.0f, 1.0f },
+    { 0.0f, 0.129411765f, 0.0f, 1.0f },
+    { 0.0f, 0.141176471f, 0.0f, 1.0f },
+    { 0.0f, 0.156862745f, 0.0f, 1.0f },
+    { 0.0f, 0.168627451f, 0.0f, 1.0f },
+    { 0.0f, 0.184313725f, 0.0f, 1.0f },
+    { 0.0f, 0.203921569f, 0.0f, 1.0f },
+    { 0.0f, 0.215686275f, 0.0f, 1.0f },
+    { 0.0f, 0.231372549f, 0.0f, 1.0f },
+    { 0.0f, 0.243137255f, 0.0f, 1.0f },
+    { 0.0f, 0.258823529f, 0.0f, 1.0f },
+    { 0.0f, 0.270588235f, 0.0f, 1.0f },
+    { 0.0f, 0.28627451f, 0.0f, 1.0f },
+    { 0.0f, 0.305882353f, 0.0f, 1.0f },
+    { 0.0f, 0.317647059f, 0.0f, 1.0f },
+    { 0.0f, 0.333333333f, 0.0f, 1.0f },
+    { 0.0f, 0.345098039f, 0.0f, 1.0f },
+    { 0.0f, 0.360784314f, 0.0f, 1.0f },
+    { 0.0f, 0.37254902f, 0.0f, 1.0f },
+    { 0.0f, 0.388235294f, 0.0f, 1.0f },
+    { 0.0f, 0.407843137f, 0.0f, 1.0f },
+    { 0.0f, 0.419607843f, 0.0f, 1.0f },
+    { 0.0f, 0.435294118f, 0.0f, 1.0f },
+    { 0.0f, 0.447058824f, 0.0f, 1.0f },
+    { 0.0f, 0.462745098f, 0.0f, 1.0f },
+    { 0.0f, 0.482352941f, 0.0f, 1.0f },
+    { 0.0f, 0.494117647f, 0.0f, 1.0f },
+    { 0.0f, 0.509803922f, 0.0f, 1.0f },
+    { 0.0f, 0.521568627f, 0.0f, 1.0f },
+    { 0.0f, 0.537254902f, 0.0f, 1.0f },
+    { 0.0f, 0.549019608f, 0.0f, 1.0f },
+    { 0.0f, 0.564705882f, 0.0f, 1.0f },
+    { 0.0f, 0.584313725f, 0.0f, 1.0f },
+    { 0.0f, 0.596078431f, 0.0f, 1.0f },
+    { 0.0f, 0.611764706f, 0.0f, 1.0f },
+    { 0.0f, 0.623529412f, 0.0f, 1.0f },
+    { 0.0f, 0.639215686f, 0.0f, 1.0f },
+    { 0.0f, 0.650980392f, 0.0f, 1.0f },
+    { 0.0f, 0.666666667f, 0.0f, 1.0f },
+    { 0.00392156863f, 0.68627451f, 0.0f, 1.0f },
+    { 0.0196078431f, 0.698039216f, 0.0f, 1.0f },
+    { 0.0431372549f, 0.71372549f, 0.0f, 1.0f },
+    { 0.0588235294f, 0.725490196f, 0.0f, 1.0f },
+    { 0.0784313725f, 0.741176471f, 0.0f, 1.0f },
+    { 0.0941176471f, 0.752941176f, 0.0f, 1.0f },
+    { 0.117647059f, 0.77254902f, 0.0f, 1.0f },
+    { 0.137254902f, 0.788235294f, 0.0f, 1.0f },
+    { 0.152941176f, 0.8f, 0.0f, 1.0f },
+    { 0.176470588f, 0.815686275f, 0.0f, 1.0f },
+    { 0.192156863f, 0.82745098f, 0.0f, 1.0f },
+    { 0.211764706f, 0.843137255f, 0.0f, 1.0f },
+    { 0.22745098f, 0.854901961f, 0.0f, 1.0f },
+    { 0.250980392f, 0.874509804f, 0.0f, 1.0f },
+    { 0.270588235f, 0.890196078f, 0.0f, 1.0f },
+    { 0.28627451f, 0.901960784f, 0.0f, 1.0f },
+    { 0.309803922f, 0.917647059f, 0.0f, 1.0f },
+    { 0.325490196f, 0.929411765f, 0.0f, 1.0f },
+    { 0.345098039f, 0.945098039f, 0.0f, 1.0f },
+    { 0.368627451f, 0.964705882f, 0.0f, 1.0f },
+    { 0.384313725f, 0.976470588f, 0.0f, 1.0f },
+    { 0.403921569f, 0.992156863f, 0.0f, 1.0f },
+    { 0.419607843f, 1.0f, 0.0f, 1.0f },
+    { 0.443137255f, 1.0f, 0.0f, 1.0f },
+    { 0.458823529f, 1.0f, 0.0f, 1.0f },
+    { 0.478431373f, 1.0f, 0.0f, 1.0f },
+    { 0.501960784f, 1.0f, 0.0f, 1.0f },
+    { 0.517647059f, 1.0f, 0.0f, 1.0f },
+    { 0.537254902f, 1.0f, 0.0431372549f, 1.0f },
+    { 0.552941176f, 1.0f, 0.0745098039f, 1.0f },
+    { 0.576470588f, 1.0f, 0.121568627f, 1.0f },
+    { 0.592156863f, 1.0f, 0.152941176f, 1.0f },
+    { 0.611764706f, 1.0f, 0.2f, 1.0f },
+    { 0.635294118f, 1.0f, 0.243137255f, 1.0f },
+    { 0.650980392f, 1.0f, 0.274509804f, 1.0f },
+    { 0.670588235f, 1.0f, 0.321568627f, 1.0f },
+    { 0.68627451f, 1.0f, 0.352941176f, 1.0f },
+    { 0.709803922f, 1.0f, 0.4f, 1.0f },
+    { 0.725490196f, 1.0f, 0.42745098f, 1.0f },
+    { 0.745098039f, 1.0f, 0.474509804f, 1.0f },
+    { 0.768627451f, 1.0f, 0.521568627f, 1.0f },
+    { 0.784313725f, 1.0f, 0.552941176f, 1.0f },
+    { 0.803921569f, 1.0f, 0.6f, 1.0f },
+    { 0.819607843f, 1.0f, 0.62745098f, 1.0f },
+    { 0.843137255f, 1.0f, 0.674509804f, 1.0f },
+    { 0.858823529f, 1.0f, 0.705882353f, 1.0f },
+    { 0.878431373f, 1.0f, 0.752941176f, 1.0f },
+    { 0.901960784f, 1.0f, 0.8f, 1.0f },
+    { 0.917647059f, 1.0f, 0.82745098f, 1.0f },
+    { 0.937254902f, 1.0f, 0.874509804f, 1.0f },
+    { 0.952941176f, 1.0f, 0.905882353f, 1.0f },
+    { 0.976470588f, 1.0f, 0.952941176f, 1.0f },
+    { 1.0f, 1.0f, 1.0f, 1.0f },
+};
+
+static const float Python_Viridis_LUT[256][4] = {
+    { 0.267004f, 0.004874f, 0.329415f, 1.0f },
+    { 0.26851f, 0.009605f, 0.335427f, 1.0f },
+    { 0.269944f, 0.014625f, 0.341379f, 1.0f },
+    { 0.271305f, 0.019942f, 0.347269f, 1.0f },
+    { 0.272594f, 0.025563f, 0.353093f, 1.0f },
+    { 0.273809f, 0.031497f, 0.358853f, 1.0f },
+    { 0.274952f, 0.037752f, 0.364543f, 1.0f },
+    { 0.276022f, 0.044167f, 0.370164f, 1.0f },
+    { 0.277018f, 0.050344f, 0.375715f, 1.0f },
+    { 0.277941f, 0.056324f, 0.381191f, 1.0f },
+    { 0.278791f, 0.062145f, 0.386592f, 1.0f },
+    { 0.279566f, 0.067836f, 0.391917f, 1.0f },
+    { 0.280267f, 0.073417f, 0.397163f, 1.0f },
+    { 0.280894f, 0.078907f, 0.402329f, 1.0f },
+    { 0.281446f, 0.08432f, 0.407414f, 1.0f },
+    { 0.281924f, 0.089666f, 0.412415f, 1.0f },
+    { 0.282327f, 0.094955f, 0.417331f, 1.0f },
+    { 0.282656f, 0.100196f, 0.42216f, 1.0f },
+    { 0.28291f, 0.105393f, 0.426902f, 1.0f },
+    { 0.283091f, 0.110553f, 0.431554f, 1.0f },
+    { 0.283197f, 0.11568f, 0.436115f, 1.0f },
+    { 0.283229f, 0.120777f, 0.440584f, 1.0f },
+    { 0.283187f, 0.125848f, 0.44496f, 1.0f },
+    { 0.283072f, 0.130895f, 0.449241f, 1.0f },
+    { 0.282884f, 0.13592f, 0.453427f, 1.0f },
+    { 0.282623f, 0.140926f, 0.457517f, 1.0f },
+    { 0.28229f, 0.145912f, 0.46151f, 1.0f },
+    { 0.281887f, 0.150881f, 0.465405f, 1.0f },
+    { 0.281412f, 0.155834f, 0.469201f, 1.0f },
+    { 0.280868f, 0.160771f, 0.472899f, 1.0f },
+    { 0.280255f, 0.165693f, 0.476498f, 1.0f },
+    { 0.279574f, 0.170599f, 0.479997f, 1.0f },
+    { 0.278826f, 0.17549f, 0.483397f, 1.0f },
+    { 0.278012f, 0.180367f, 0.486697f, 1.0f },
+    { 0.277134f, 0.185228f, 0.489898f, 1.0f },
+    { 0.276194f, 0.190074f, 0.493001f, 1.0f },
+    { 0.275191f, 0.194905f, 0.496005f, 1.0f },
+    { 0.274128f, 0.199721f, 0.498911f, 1.0f },
+    { 0.273006f, 0.20452f, 0.501721f, 1.0f },
+    { 0.271828f, 0.209303f, 0.504434f, 1.0f },
+    { 0.270595f, 0.214069f, 0.507052f, 1.0f },
+    { 0.269308f, 0.218818f, 0.509577f, 1.0f },
+    { 0.267968f, 0.223549f, 0.512008f, 1.0f },
+    { 0.26658f, 0.228262f, 0.514349f, 1.0f },
+    { 0.265145f, 0.232956f, 0.516599f, 1.0f },
+    { 0.263663f, 0.237631f, 0.518762f, 1.0f },
+    { 0.262138f, 0.242286f, 0.520837f, 1.0f },
+    { 0.260571f, 0.246922f, 0.522828f, 1.0f },
+    { 0.258965f, 0.251537f, 0.524736f, 1.0f },
+    { 0.257322f, 0.25613f, 0.526563f, 1.0f },
+    { 0.255645f, 0.260703f, 0.528312f, 1.0f },
+    { 0.253935f, 0.265254f, 0.529983f, 1.0f },
+    { 0.252194f, 0.269783f, 0.531579f, 1.0f },
+    { 0.250425f, 0.27429f, 0.533103f, 1.0f },
+    { 0.248629f, 0.278775f, 0.534556f, 1.0f },
+    { 0.246811f, 0.283237f, 0.535941f, 1.0f },
+    { 0.244972f, 0.287675f, 0.53726f, 1.0f },
+    { 0.243113f, 0.292092f, 0.538516f, 1.0f },
+    { 0.241237f, 0.296485f, 0.539709f, 1.0f },
+    { 0.239346f, 0.300855f, 0.540844f, 1.0f },
+    { 0.237441f, 0.305202f, 0.541921f, 1.0f },
+    { 0.235526f, 0.309527f, 0.542944f, 1.0f },
+    { 0.233603f, 0.313828f, 0.543914f, 1.0f },
+    { 0.231674f, 0.318106f, 0.544834f, 1.0f },
+    { 0.229739f, 0.322361f, 0.545706f, 1.0f },
+    { 0.227802f, 0.326594f, 0.546532f, 1.0f },
+    { 0.225863f, 0.330805f, 0.547314f, 1.0f },
+    { 0.223925f, 0.334994f, 0.548053f, 1.0f },
+    { 0.221989f, 0.339161f, 0.548752f, 1.0f },
+    { 0.220057f, 0.343307f, 0.549413f, 1.0f },
+    { 0.21813f, 0.347432f, 0.550038f, 1.0f },
+    { 0.21621f, 0.351535f, 0.550627f, 1.0f },
+    { 0.214298f, 0.355619f, 0.551184f, 1.0f },
+    { 0.212395f, 0.359683f, 0.55171f, 1.0f },
+    { 0.210503f, 0.363727f, 0.552206f, 1.0f },
+    { 0.208623f, 0.367752f, 0.552675f, 1.0f },
+    { 0.206756f, 0.371758f, 0.553117f, 1.0f },
+    { 0.204903f, 0.375746f, 0.553533f, 1.0f },
+    { 0.203063f, 0.379716f, 0.553925f, 1.0f },
+    { 0.201239f, 0.38367f, 0.554294f, 1.0f },
+    { 0.19943f, 0.387607f, 0.554642f, 1.0f },
+    { 0.197636f, 0.391528f, 0.554969f, 1.0f },
+    { 0.19586f, 0.395433f, 0.555276f, 1.0f },
+    { 0.1941f, 0.399323f, 0.555565f, 1.0f },
+    { 0.192357f, 0.403199f, 0.555836f, 1.0f },
+    { 0.190631f, 0.407061f, 0.556089f, 1.0f },
+    { 0.188923f, 0.41091f, 0.556326f, 1.0f },
+    { 0.187231f, 0.414746f, 0.556547f, 1.0f },
+    { 0.185556f, 0.41857f, 0.556753f, 1.0f },
+    { 0.183898f, 0.422383f, 0.556944f, 1.0f },
+    { 0.182256f, 0.426184f, 0.55712f, 1.0f },
+    { 0.180629f, 0.429975f, 0.557282f, 1.0f },
+    { 0.179019f, 0.433756f, 0.55743f, 1.0f },
+    { 0.177423f, 0.437527f, 0.557565f, 1.0f },
+    { 0.175841f, 0.44129f, 0.557685f, 1.0f },
+    { 0.174274f, 0.445044f, 0.557792f, 1.0f },
+    { 0.172719f, 0.448791f, 0.557885f, 1.0f },
+    { 0.171176f, 0.45253f, 0.557965f, 1.0f },
+    { 0.169646f, 0.456262f, 0.55803f, 1.0f },
+    { 0.168126f, 0.459988f, 0.558082f, 1.0f },
+    { 0.166617f, 0.463708f, 0.558119f, 1.0f },
+    { 0.165117f, 0.467423f, 0.558141f, 1.0f },
+    { 0.163625f, 0.471133f, 0.558148f, 1.0f },
+    { 0.162142f, 0.474838f, 0.55814f, 1.0f },
+    { 0.160665f, 0.47854f, 0.558115f, 1.0f },
+    { 0.159194f, 0.482237f, 0.558073f, 1.0f },
+    { 0.157729f, 0.485932f, 0.558013f, 1.0f },
+    { 0.15627f, 0.489624f, 0.557936f, 1.0f },
+    { 0.154815f, 0.493313f, 0.55784f, 1.0f },
+    { 0.153364f, 0.497f, 0.557724f, 1.0f },
+    { 0.151918f, 0.500685f, 0.557587f, 1.0f },
+    { 0.150476f, 0.504369f, 0.55743f, 1.0f },
+    { 0.149039f, 0.508051f, 0.55725f, 1.0f },
+    { 0.147607f, 0.511733f, 0.557049f, 1.0f },
+    { 0.14618f, 0.515413f, 0.556823f, 1.0f },
+    { 0.144759f, 0.519093f, 0.556572f, 1.0f },
+    { 0.143343f, 0.522773f, 0.556295f, 1.0f },
+    { 0.141935f, 0.526453f, 0.555991f, 1.0f },
+    { 0.140536f, 0.530132f, 0.555659f, 1.0f },
+    { 0.139147f, 0.533812f, 0.555298f, 1.0f },
+    { 0.13777f, 0.537492f, 0.554906f, 1.0f },
+    { 0.136408f, 0.541173f, 0.554483f, 1.0f },
+    { 0.135066f, 0.544853f, 0.554029f, 1.0f },
+    { 0.133743f, 0.548535f, 0.553541f, 1.0f },
+    { 0.132444f, 0.552216f, 0.553018f, 1.0f },
+    { 0.131172f, 0.555899f, 0.552459f, 1.0f },
+    { 0.129933f, 0.559582f, 0.551864f, 1.0f },
+    { 0.128729f, 0.563265f, 0.551229f, 1.0f },
+    { 0.127568f, 0.566949f, 0.550556f, 1.0f },
+    { 0.126453f, 0.570633f, 0.549841f, 1.0f },
+    { 0.125394f, 0.574318f, 0.549086f, 1.0f },
+    { 0.124395f, 0.578002f, 0.548287f, 1.0f },
+    { 0.123463f, 0.581687f, 0.547445f, 1.0f },
+    { 0.122606f, 0.585371f, 0.546557f, 1.0f },
+    { 0.121831f, 0.589055f, 0.545623f, 1.0f },
+    { 0.121148f, 0.592739f, 0.544641f, 1.0f },
+    { 0.120565f, 0.596422f, 0.543611f, 1.0f },
+    { 0.120092f, 0.600104f, 0.54253f, 1.0f },
+    { 0.119738f, 0.603785f, 0.5414f, 1.0f },
+    { 0.119512f, 0.607464f, 0.540218f, 1.0f },
+    { 0.119423f, 0.611141f, 0.538982f, 1.0f },
+    { 0.119483f, 0.614817f, 0.537692f, 1.0f },
+    { 0.119699f, 0.61849f, 0.536347f, 1.0f },
+    { 0.120081f, 0.622161f, 0.534946f, 1.0f },
+    { 0.120638f, 0.625828f, 0.533488f, 1.0f },
+    { 0.12138f, 0.629492f, 0.531973f, 1.0f },
+    { 0.122312f, 0.633153f, 0.530398f, 1.0f },
+    { 0.123444f, 0.636809f, 0.528763f, 1.0f },
+    { 0.12478f, 0.640461f, 0.527068f, 1.0f },
+    { 0.126326f, 0.644107f, 0.525311f, 1.0f },
+    { 0.128087f, 0.647749f, 0.523491f, 1.0f },
+    { 0.130067f, 0.651384f, 0.521608f, 1.0f },
+    { 0.132268f, 0.655014f, 0.519661f, 1.0f },
+    { 0.134692f, 0.658636f, 0.517649f, 1.0f },
+    { 0.137339f, 0.662252f, 0.515571f, 1.0f },
+    { 0.14021f, 0.665859f, 0.513427f, 1.0f },
+    { 0.143303f, 0.669459f, 0.511215f, 1.0f },
+    { 0.146616f, 0.67305f, 0.508936f, 1.0f },
+    { 0.150148f, 0.676631f, 0.506589f, 1.0f },
+    { 0.153894f, 0.680203f, 0.504172f, 1.0f },
+    { 0.157851f, 0.683765f, 0.501686f, 1.0f },
+    { 0.162016f, 0.687316f, 0.499129f, 1.0f },
+    { 0.166383f, 0.690856f, 0.496502f, 1.0f },
+    { 0.170948f, 0.694384f, 0.493803f, 1.0f },
+    { 0.175707f, 0.6979f, 0.491033f, 1.0f },
+    { 0.180653f, 0.701402f, 0.488189f, 1.0f },
+    { 0.185783f, 0.704891f, 0.485273f, 1.0f },
+    { 0.19109f, 0.708366f, 0.482284f, 1.0f },
+    { 0.196571f, 0.711827f, 0.479221f, 1.0f },
+    { 0.202219f, 0.715272f, 0.476084f, 1.0f },
+    { 0.20803f, 0.718701f, 0.472873f, 1.0f },
+    { 0.214f, 0.722114f, 0.469588f, 1.0f },
+    { 0.220124f, 0.725509f, 0.466226f, 1.0f },
+    { 0.226397f, 0.728888f, 0.462789f, 1.0f },
+    { 0.232815f, 0.732247f, 0.459277f, 1.0f },
+    { 0.239374f, 0.735588f, 0.455688f, 1.0f },
+    { 0.24607f, 0.73891f, 0.452024f, 1.0f },
+    { 0.252899f, 0.742211f, 0.448284f, 1.0f },
+    { 0.259857f, 0.745492f, 0.444467f, 1.0f },
+    { 0.266941f, 0.748751f, 0.440573f, 1.0f },
+    { 0.274149f, 0.751988f, 0.436601f, 1.0f },
+    { 0.281477f, 0.755203f, 0.432552f, 1.0f },
+    { 0.288921f, 0.758394f, 0.428426f, 1.0f },
+    { 0.296479f, 0.761561f, 0.424223f, 1.0f },
+    { 0.304148f, 0.764704f, 0.419943f, 1.0f },
+    { 0.311925f, 0.767822f, 0.415586f, 1.0f },
+    { 0.319809f, 0.770914f, 0.411152f, 1.0f },
+    { 0.327796f, 0.77398f, 0.40664f, 1.0f },
+    { 0.335885f, 0.777018f, 0.402049f, 1.0f },
+    { 0.344074f, 0.780029f, 0.397381f, 1.0f },
+    { 0.35236f, 0.783011f, 0.392636f, 1.0f },
+    { 0.360741f, 0.785964f, 0.387814f, 1.0f },
+    { 0.369214f, 0.788888f, 0.382914f, 1.0f },
+    { 0.377779f, 0.791781f, 0.377939f, 1.0f },
+    { 0.386433f, 0.794644f, 0.372886f, 1.0f },
+    { 0.395174f, 0.797475f, 0.367757f, 1.0f },
+    { 0.404001f, 0.800275f, 0.362552f, 1.0f },
+    { 0.412913f, 0.803041f, 0.357269f, 1.0f },
+    { 0.421908f, 0.805774f, 0.35191f, 1.0f },
+    { 0.430983f, 0.808473f, 0.346476f, 1.0f },
+    { 0.440137f, 0.811138f, 0.340967f, 1.0f },
+    { 0.449368f, 0.813768f, 0.335384f, 1.0f },
+    { 0.458674f, 0.816363f, 0.329727f, 1.0f },
+    { 0.468053f, 0.818921f, 0.323998f, 1.0f },
+    { 0.477504f, 0.821444f, 0.318195f, 1.0f },
+    { 0.487026f, 0.823929f, 0.312321f, 1.0f },
+    { 0.496615f, 0.826376f, 0.306377f, 1.0f },
+    { 0.506271f, 0.828786f, 0.300362f, 1.0f },
+    { 0.515992f, 0.831158f, 0.294279f, 1.0f },
+    { 0.525776f, 0.833491f, 0.288127f, 1.0f },
+    { 0.535621f, 0.835785f, 0.281908f, 1.0f },
+    { 0.545524f, 0.838039f, 0.275626f, 1.0f },
+    { 0.555484f, 0.840254f, 0.269281f, 1.0f },
+    { 0.565498f, 0.84243f, 0.262877f, 1.0f },
+    { 0.575563f, 0.844566f, 0.256415f, 1.0f },
+    { 0.585678f, 0.846661f, 0.249897f, 1.0f },
+    { 0.595839f, 0.848717f, 0.243329f, 1.0f },
+    { 0.606045f, 0.850733f, 0.236712f, 1.0f },
+    { 0.616293f, 0.852709f, 0.230052f, 1.0f },
+    { 0.626579f, 0.854645f, 0.223353f, 1.0f },
+    { 0.636902f, 0.856542f, 0.21662f, 1.0f },
+    { 0.647257f, 0.8584f, 0.209861f, 1.0f },
+    { 0.657642f, 0.860219f, 0.203082f, 1.0f },
+    { 0.668054f, 0.861999f, 0.196293f, 1.0f },
+    { 0.678489f, 0.863742f, 0.189503f, 1.0f },
+    { 0.688944f, 0.865448f, 0.182725f, 1.0f },
+    { 0.699415f, 0.867117f, 0.175971f, 1.0f },
+    { 0.709898f, 0.868751f, 0.169257f, 1.0f },
+    { 0.720391f, 0.87035f, 0.162603f, 1.0f },
+    { 0.730889f, 0.871916f, 0.156029f, 1.0f },
+    { 0.741388f, 0.873449f, 0.149561f, 1.0f },
+    { 0.751884f, 0.874951f, 0.143228f, 1.0f },
+    { 0.762373f, 0.876424f, 0.137064f, 1.0f },
+    { 0.772852f, 0.877868f, 0.131109f, 1.0f },
+    { 0.783315f, 0.879285f, 0.125405f, 1.0f },
+    { 0.79376f, 0.880678f, 0.120005f, 1.0f },
+    { 0.804182f, 0.882046f, 0.114965f, 1.0f },
+    { 0.814576f, 0.883393f, 0.110347f, 1.0f },
+    { 0.82494f, 0.88472f, 0.106217f, 1.0f },
+    { 0.83527f, 0.886029f, 0.102646f, 1.0f },
+    { 0.845561f, 0.887322f, 0.099702f, 1.0f },
+    { 0.85581f, 0.888601f, 0.097452f, 1.0f },
+    { 0.866013f, 0.889868f, 0.095953f, 1.0f },
+    { 0.876168f, 0.891125f, 0.09525f, 1.0f },
+    { 0.886271f, 0.892374f, 0.095374f, 1.0f },
+    { 0.89632f, 0.893616f, 0.096335f, 1.0f },
+    { 0.906311f, 0.894855f, 0.098125f, 1.0f },
+    { 0.916242f, 0.896091f, 0.100717f, 1.0f },
+    { 0.926106f, 0.89733f, 0.104071f, 1.0f },
+    { 0.935904f, 0.89857f, 0.108131f, 1.0f },
+    { 0.945636f, 0.899815f, 0.112838f, 1.0f },
+    { 0.9553f, 0.901065f, 0.118128f, 1.0f },
+    { 0.964894f, 0.902323f, 0.123941f, 1.0f },
+    { 0.974417f, 0.90359f, 0.130215f, 1.0f },
+    { 0.983868f, 0.904867f, 0.136897f, 1.0f },
+    { 0.993248f, 0.906157f, 0.143936f, 1.0f },
+};
+
+static const float HEALPix_BGRY_LUT[100][4] = {
+    { 0.0f, 0.0f, 0.0f, 1.0f },
+    { 0.0f, 0.0f, 0.0156862745f, 1.0f },
+    { 0.0f, 0.0f, 0.0392156863f, 1.0f },
+    { 0.0f, 0.0f, 0.0549019608f, 1.0f },
+    { 0.0f, 0.0f, 0.0784313725f, 1.0f },
+    { 0.0f, 0.0f, 0.0980392157f, 1.0f },
+    { 0.0f, 0.0f, 0.121568627f, 1.0f },
+    { 0.0f, 0.0f, 0.145098039f, 1.0f },
+    { 0.0f, 0.0f, 0.160784314f, 1.0f },
+    { 0.0f, 0.0f, 0.184313725f, 1.0f },
+    { 0.0f, 0.0f, 0.203921569f, 1.0f },
+    { 0.0f, 0.0f, 0.22745098f, 1.0f },
+    { 0.0f, 0.0f, 0.243137255f, 1.0f },
+    { 0.0f, 0.0117647059f, 0.266666667f, 1.0f },
+    { 0.0f, 0.0470588235f, 0.294117647f, 1.0f },
+    { 0.0f, 0.0705882353f, 0.309803922f, 1.0f },
+    { 0.0f, 0.109803922f, 0.333333333f, 1.0f },
+    { 0.0f, 0.133333333f, 0.349019608f, 1.0f },
+    { 0.0f, 0.168627451f, 0.37254902f, 1.0f },
+    { 0.0f, 0.196078431f, 0.392156863f, 1.0f },
+    { 0.0f, 0.231372549f, 0.392156863f, 1.0f },
+    { 0.0f, 0.266666667f, 0.392156863f, 1.0f },
+    { 0.0f, 0.294117647f, 0.392156863f, 1.0f },
+    { 0.0f, 0.329411765f, 0.392156863f, 1.0f },
+    { 0.0f, 0.352941176f, 0.392156863f, 1.0f },
+    { 0.0f, 0.392156863f, 0.392156863f, 1.0f },
+    { 0.0f, 0.415686275f, 0.392156863f, 1.0f },
+    { 0.0f, 0.450980392f, 0.392156863f, 1.0f },
+    { 0.0f, 0.490196078f, 0.392156863f, 1.0f },
+    { 0.0f, 0.51372549f, 0.392156863f, 1.0f },
+    { 0.0f, 0.549019608f, 0.392156863f, 1.0f },
+    { 0.0f, 0.57254902f, 0.392156863f, 1.0f },
+    { 0.0f, 0.588235294f, 0.364705882f, 1.0f },
+    { 0.0f, 0.588235294f, 0.329411765f, 1.0f },
+    { 0.0f, 0.588235294f, 0.305882353f, 1.0f },
+    { 0.0f, 0.588235294f, 0.266666667f, 1.0f },
+    { 0.0f, 0.588235294f, 0.243137255f, 1.0f },
+    { 0.0f, 0.588235294f, 0.207843137f, 1.0f },
+    { 0.0f, 0.584313725f, 0.180392157f, 1.0f },
+    { 0.0f, 0.576470588f, 0.145098039f, 1.0f },
+    { 0.0f, 0.568627451f, 0.109803922f, 1.0f },
+    { 0.0f, 0.564705882f, 0.0823529412f, 1.0f },
+    { 0.0f, 0.556862745f, 0.0470588235f, 1.0f },
+    { 0.0f, 0.552941176f, 0.0235294118f, 1.0f },
+    { 0.0274509804f, 0.537254902f, 0.0f, 1.0f },
+    { 0.0862745098f, 0.517647059f, 0.0f, 1.0f },
+    { 0.176470588f, 0.490196078f, 0.0f, 1.0f },
+    { 0.262745098f, 0.458823529f, 0.0f, 1.0f },
+    { 0.321568627f, 0.439215686f, 0.0f, 1.0f },
+    { 0.411764706f, 0.411764706f, 0.0f, 1.0f },
+    { 0.470588235f, 0.392156863f, 0.0f, 1.0f },
+    { 0.529411765f, 0.317647059f, 0.0f, 1.0f },
+    { 0.568627451f, 0.266666667f, 0.0f, 1.0f },
+    { 0.62745098f, 0.196078431f, 0.0f, 1.0f },
+    { 0.68627451f, 0.121568627f, 0.0f, 1.0f },
+    { 0.725490196f, 0.0705882353f, 0.0f, 1.0f },
+    { 0.784313725f, 0.0f, 0.0f, 1.0f },
+    { 0.788235294f, 0.0156862745f, 0.0f, 1.0f },
+    { 0.792156863f, 0.0431372549f, 0.0f, 1.0f },
+    { 0.796078431f, 0.062745098f, 0.0f, 1.0f },
+    { 0.803921569f, 0.0901960784f, 0.0f, 1.0f },
+    { 0.807843137f, 0.11372549f, 0.0f, 1.0f },
+    { 0.811764706f, 0.133333333f, 0.0f, 1.0f },
+    { 0.819607843f, 0.160784314f, 0.0f, 1.0f },
+    { 0.823529412f, 0.180392157f, 0.0f, 1.0f },
+    { 0.82745098f, 0.207843137f, 0.0f, 1.0f },
+    { 0.835294118f, 0.231372549f, 0.0f, 1.0f },
+    { 0.839215686f, 0.250980392f, 0.0f, 1.0f },
+    { 0.843137255f, 0.278431373f, 0.0f, 1.0f },
+    { 0.847058824f, 0.298039216f, 0.0f, 1.0f },
+    { 0.854901961f, 0.325490196f, 0.0f, 1.0f },
+    { 0.858823529f, 0.341176471f, 0.0f, 1.0f },
+    { 0.862745098f, 0.368627451f, 0.0f, 1.0f },
+    { 0.870588235f, 0.396078431f, 0.0f, 1.0f },
+    { 0.874509804f, 0.415686275f, 0.0f, 1.0f },
+    { 0.878431373f, 0.443137255f, 0.0f, 1.0f },
+    { 0.882352941f, 0.458823529f, 0.0f, 1.0f },
+    { 0.890196078f, 0.48627451f, 0.0f, 1.0f },
+    { 0.894117647f, 0.505882353f, 0.0f, 1.0f },
+    { 0.898039216f, 0.533333333f, 0.0f, 1.0f },
+    { 0.905882353f, 0.556862745f, 0.0f, 1.0f },
+    { 0.909803922f, 0.576470588f, 0.0f, 1.0f },
+    { 0.91372549f, 0.603921569f, 0.0f, 1.0f },
+    { 0.917647059f, 0.623529412f, 0.0f, 1.0f },
+    { 0.925490196f, 0.650980392f, 0.0f, 1.0f },
+    { 0.929411765f, 0.666666667f, 0.0f, 1.0f },
+    { 0.933333333f, 0.694117647f, 0.0f, 1.0f },
+    { 0.941176471f, 0.721568627f, 0.0f, 1.0f },
+    { 0.945098039f, 0.741176471f, 0.0f, 1.0f },
+    { 0.949019608f, 0.768627451f, 0.0f, 1.0f },
+    { 0.952941176f, 0.784313725f, 0.0f, 1.0f },
+    { 0.960784314f, 0.811764706f, 0.0f, 1.0f },
+    { 0.964705882f, 0.831372549f, 0.0f, 1.0f },
+    { 0.968627451f, 0.858823529f, 0.0f, 1.0f },
+    { 0.976470588f, 0.88627451f, 0.0f, 1.0f },
+    { 0.980392157f, 0.901960784f, 0.0f, 1.0f },
+    { 0.984313725f, 0.929411765f, 0.0f, 1.0f },
+    { 0.988235294f, 0.949019608f, 0.0f, 1.0f },
+    { 0.996078431f, 0.976470588f, 0.0f, 1.0f },
+    { 1.0f, 1.0f, 0.0f, 1.0f },
+};
+
+static const float HEALPix_GRV_LUT[100][4] = {
+    { 0.0f, 0.0f, 0.0f, 1.0f },
+    { 0.0f, 0.282352941f, 0.0f, 1.0f },
+    { 0.0f, 0.321568627f, 0.0f, 1.0f },
+    { 0.0f, 0.352941176f, 0.0f, 1.0f },
+    { 0.0f, 0.392156863f, 0.0f, 1.0f },
+    { 0.0f, 0.423529412f, 0.0f, 1.0f },
+    { 0.0f, 0.529411765f, 0.0f, 1.0f },
+    { 0.0f, 0.635294118f, 0.0f, 1.0f },
+    { 0.0f, 0.705882353f, 0.0f, 1.0f },
+    { 0.0f, 0.811764706f, 0.0f, 1.0f },
+    { 0.0f, 0.882352941f, 0.0f, 1.0f },
+    { 0.0f, 0.988235294f, 0.0f, 1.0f },
+    { 0.0470588235f, 0.964705882f, 0.0f, 1.0f },
+    { 0.117647059f, 0.917647059f, 0.0f, 1.0f },
+    { 0.188235294f, 0.847058824f, 0.0f, 1.0f },
+    { 0.235294118f, 0.8f, 0.0f, 1.0f },
+    { 0.305882353f, 0.729411765f, 0.0f, 1.0f },
+    { 0.352941176f, 0.682352941f, 0.0f, 1.0f },
+    { 0.423529412f, 0.611764706f, 0.0f, 1.0f },
+    { 0.470588235f, 0.564705882f, 0.0f, 1.0f },
+    { 0.541176471f, 0.494117647f, 0.0f, 1.0f },
+    { 0.611764706f, 0.423529412f, 0.0f, 1.0f },
+    { 0.658823529f, 0.376470588f, 0.0f, 1.0f },
+    { 0.729411765f, 0.305882353f, 0.0f, 1.0f },
+    { 0.776470588f, 0.258823529f, 0.0f, 1.0f },
+    { 0.847058824f, 0.188235294f, 0.0f, 1.0f },
+    { 0.894117647f, 0.141176471f, 0.0f, 1.0f },
+    { 0.952941176f, 0.0705882353f, 0.0f, 1.0f },
+    { 0.988235294f, 0.0f, 0.0f, 1.0f },
+    { 0.988235294f, 0.0f, 0.0f, 1.0f },
+    { 0.984313725f, 0.0f, 0.0117647059f, 1.0f },
+    { 0.976470588f, 0.0f, 0.0274509804f, 1.0f },
+    { 0.97254902f, 0.0f, 0.0470588235f, 1.0f },
+    { 0.968627451f, 0.0f, 0.0705882353f, 1.0f },
+    { 0.960784314f, 0.0f, 0.0862745098f, 1.0f },
+    { 0.949019608f, 0.0f, 0.11372549f, 1.0f },
+    { 0.941176471f, 0.0f, 0.133333333f, 1.0f },
+    { 0.933333333f, 0.0f, 0.152941176f, 1.0f },
+    { 0.925490196f, 0.0f, 0.168627451f, 1.0f },
+    { 0.925490196f, 0.0f, 0.196078431f, 1.0f },
+    { 0.91372549f, 0.0f, 0.219607843f, 1.0f },
+    { 0.905882353f, 0.0f, 0.239215686f, 1.0f },
+    { 0.894117647f, 0.0f, 0.262745098f, 1.0f },
+    { 0.894117647f, 0.0f, 0.274509804f, 1.0f },
+    { 0.890196078f, 0.0f, 0.298039216f, 1.0f },
+    { 0.882352941f, 0.0f, 0.31372549f, 1.0f },
+    { 0.870588235f, 0.0f, 0.341176471f, 1.0f },
+    { 0.858823529f, 0.00392156863f, 0.368627451f, 1.0f },
+    { 0.850980392f, 0.00392156863f, 0.384313725f, 1.0f },
+    { 0.847058824f, 0.0f, 0.407843137f, 1.0f },
+    { 0.847058824f, 0.0f, 0.423529412f, 1.0f },
+    { 0.835294118f, 0.0f, 0.447058824f, 1.0f },
+    { 0.82745098f, 0.0f, 0.462745098f, 1.0f },
+    { 0.815686275f, 0.0f, 0.490196078f, 1.0f },
+    { 0.803921569f, 0.0f, 0.51372549f, 1.0f },
+    { 0.8f, 0.0f, 0.529411765f, 1.0f },
+    { 0.8f, 0.0f, 0.552941176f, 1.0f },
+    { 0.792156863f, 0.0f, 0.568627451f, 1.0f },
+    { 0.780392157f, 0.0f, 0.596078431f, 1.0f },
+    { 0.77254902f, 0.0f, 0.611764706f, 1.0f },
+    { 0.768627451f, 0.0f, 0.635294118f, 1.0f },
+    { 0.764705882f, 0.0f, 0.654901961f, 1.0f },
+    { 0.756862745f, 0.0f, 0.670588235f, 1.0f },
+    { 0.745098039f, 0.0f, 0.698039216f, 1.0f },
+    { 0.737254902f, 0.0f, 0.717647059f, 1.0f },
+    { 0.725490196f, 0.0f, 0.741176471f, 1.0f },
+    { 0.721568627f, 0.0f, 0.764705882f, 1.0f },
+    { 0.721568627f, 0.0f, 0.780392157f, 1.0f },
+    { 0.709803922f, 0.0f, 0.803921569f, 1.0f },
+    { 0.701960784f, 0.0f, 0.823529412f, 1.0f },
+    { 0.690196078f, 0.0f, 0.847058824f, 1.0f },
+    { 0.690196078f, 0.0f, 0.858823529f, 1.0f },
+    { 0.68627451f, 0.0f, 0.882352941f, 1.0f },
+    { 0.674509804f, 0.0f, 0.909803922f, 1.0f },
+    { 0.666666667f, 0.0f, 0.925490196f, 1.0f },
+    { 0.654901961f, 0.0f, 0.952941176f, 1.0f },
+    { 0.647058824f, 0.0f, 0.968627451f, 1.0f },
+    { 0.643137255f, 0.0f, 0.988235294f, 1.0f },
+    { 0.643137255f, 0.0f, 1.0f, 1.0f },
+    { 0.631372549f, 0.0f, 1.0f, 1.0f },
+    { 0.619607843f, 0.0f, 1.0f, 1.0f },
+    { 0.611764706f, 0.0f, 1.0f, 1.0f },
+    { 0.6f, 0.0f, 1.0f, 1.0f },
+    { 0.596078431f, 0.0f, 1.0f, 1.0f },
+    { 0.596078431f, 0.0f, 1.0f, 1.0f },
+    { 0.588235294f, 0.0f, 1.0f, 1.0f },
+    { 0.592156863f, 0.031372549f, 1.0f, 1.0f },
+    { 0.62745098f, 0.125490196f, 1.0f, 1.0f },
+    { 0.650980392f, 0.188235294f, 1.0f, 1.0f },
+    { 0.690196078f, 0.282352941f, 1.0f, 1.0f },
+    { 0.721568627f, 0.345098039f, 1.0f, 1.0f },
+    { 0.760784314f, 0.439215686f, 1.0f, 1.0f },
+    { 0.784313725f, 0.501960784f, 1.0f, 1.0f },
+    { 0.819607843f, 0.584313725f, 1.0f, 1.0f },
+    { 0.854901961f, 0.674509804f, 1.0f, 1.0f },
+    { 0.878431373f, 0.737254902f, 1.0f, 1.0f },
+    { 0.925490196f, 0.831372549f, 1.0f, 1.0f },
+    { 0.952941176f, 0.894117647f, 1.0f, 1.0f },
+    { 0.988235294f, 0.988235294f, 1.0f, 1.0f },
+    { 1.0f, 1.0f, 1.0f, 1.0f },
+};
+
+const struct palette palettes[] = {
+    { "Planck", sizeof(Planck_Parchment_LUT)/sizeof(float[4]), Planck_Parchment_LUT },
+    { "Faded", sizeof(Python_RdBu_LUT)/sizeof(float[4]), Python_RdBu_LUT },
+    { "Spectral", sizeof(Python_Spectral_LUT)/sizeof(float[4]), Python_Spectral_LUT },
+    { "HEALPix", sizeof(HEALPix_CMB_LUT)/sizeof(float[4]), HEALPix_CMB_LUT },
+    { "Seismic", sizeof(Python_Seismic_LUT)/sizeof(float[4]), Python_Seismic_LUT },
+    { "Difference", sizeof(Python_Difference_LUT)/sizeof(float[4]), Python_Difference_LUT },
+    { "Frequency", sizeof(Planck_FreqMap_LUT)/sizeof(float[4]), Planck_FreqMap_LUT },
+    { "Greyscale", sizeof(HEALPix_Grey_LUT)/sizeof(float[4]), HEALPix_Grey_LUT },
+    { "Hot", sizeof(HEALPix_Hot_LUT)/sizeof(float[4]), HEALPix_Hot_LUT },
+    { "Cold", sizeof(HEALPix_Cold_LUT)/sizeof(float[4]), HEALPix_Cold_LUT },
+    { "Lime", sizeof(HEALPix_Lime_LUT)/sizeof(float[4]), HEALPix_Lime_LUT },
+    { "Viridis", sizeof(Python_Viridis_LUT)/sizeof(float[4]), Python_Viridis_LUT },
+    { "BGRY", sizeof(HEALPix_BGRY_LUT)/sizeof(float[4]), HEALPix_BGRY_LUT },
+    { "GRV", sizeof(HEALPix_GRV_LUT)/sizeof(float[4]), HEALPix_GRV_LUT },
+};
+
+const int npalettes = sizeof(palettes)/sizeof(struct palette);
+
+const struct palette *find_palette(const char *name) {
+    for (int i = 0; i < npalettes; i++) { if (strcasecmp(palettes[i].name, name) == 0) return &palettes[i]; }
+    return NULL;
+}
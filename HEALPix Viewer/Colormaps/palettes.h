@@ -0,0 +1,25 @@
+//
+//  palettes.h
+//  HEALPix Viewer
+//
+//  Created by Andrei Frolov on 2026-10-17.
+//
+
+#ifndef palettes_h
+#define palettes_h
+
+// colormap LUT (straight alpha RGBA entries, sRGB encoded)
+struct palette {
+    const char *name;
+    int size;
+    const float (*lut)[4];
+};
+
+// built-in colormaps, named as color schemes in the app (generated by palettes.py)
+extern const struct palette palettes[];
+extern const int npalettes;
+
+// look colormap up by name (case insensitive), returning NULL if not found
+const struct palette *find_palette(const char *name);
+
+#endif /* palettes_h */
@@ -0,0 +1,55 @@
+#!/usr/bin/env python
+
+# import libraries
+import re
+
+# color schemes (as named in the app) and their LUT sources
+schemes = [
+	("Planck", "Planck Parchment"),
+	("Faded", "Python RdBu"),
+	("Spectral", "Python Spectral"),
+	("HEALPix", "HEALPix CMB"),
+	("Seismic", "Python Seismic"),
+	("Difference", "Python Difference"),
+	("Frequency", "Planck FreqMap"),
+	("Greyscale", "HEALPix Grey"),
+	("Hot", "HEALPix Hot"),
+	("Cold", "HEALPix Cold"),
+	("Lime", "HEALPix Lime"),
+	("Viridis", "Python Viridis"),
+	("BGRY", "HEALPix BGRY"),
+	("GRV", "HEALPix GRV"),
+]
+
+entry = re.compile(r"SIMD4<Float>\(([^)]*)\)")
+number = re.compile(r"^[0-9.]+(/[0-9.]+)?$")
+
+def component(x):
+	x = x.strip(); assert number.match(x)
+	return eval(x)
+
+def literal(x):
+	s = f"{x:.9g}"
+	return (s if ("." in s or "e" in s) else s + ".0") + "f"
+
+print("//\n//  palettes.c\n//  HEALPix Viewer\n//\n//  Generated by palettes.py from Swift colormap LUTs, do not edit.\n//\n")
+print("#include <stddef.h>\n#include <strings.h>\n#include \"palettes.h\"\n")
+
+for (name, source) in schemes:
+	lut = [list(map(component, m.group(1).split(","))) for m in entry.finditer(open(source + ".swift").read())]
+	print(f"static const float {source.replace(' ', '_')}_LUT[{len(lut)}][4] = {{")
+	for (r,g,b,a) in lut:
+		print("    { " + ", ".join(map(literal, (r,g,b,a))) + " },")
+	print("};\n")
+
+print("const struct palette palettes[] = {")
+for (name, source) in schemes:
+	print(f"    {{ \"{name}\", sizeof({source.replace(' ', '_')}_LUT)/sizeof(float[4]), {source.replace(' ', '_')}_LUT }},")
+print("};\n")
+
+print("const int npalettes = sizeof(palettes)/sizeof(struct palette);\n")
+
+print("const struct palette *find_palette(const char *name) {")
+print("    for (int i = 0; i < npalettes; i++) { if (strcasecmp(palettes[i].name, name) == 0) return &palettes[i]; }")
+print("    return NULL;")
+print("}")
@@ -8,57 +8,53 @@
 import SwiftUI
 import MetalKit
 
-// correlator computes average and covariance matrix
+// correlator computes average and covariance matrix (see correlate.h)
 struct Correlator {
-    // compute pipeline
-    let shader = MetalKernel(kernel: "covariance")
-    let buffer: (range: MTLBuffer, npix: MTLBuffer, cov: MTLBuffer, pts: MTLBuffer)
-    let threads: Int
+    // subsample stride (1 = every pixel, otherwise one random pixel out of each run of stride NESTED pixels)
+    var stride = 1
+    var seed = 0
     
-    init() {
-        // wider than this will break covariance kernel barriers
-        let threads = metal.device.maxThreadsPerThreadgroup.width
-        let options: MTLResourceOptions = [.cpuCacheModeWriteCombined, .storageModeShared]
-        guard let range = metal.device.makeBuffer(length: MemoryLayout<float2x3>.size, options: options),
-              let npix = metal.device.makeBuffer(length: MemoryLayout<uint2>.size, options: options),
-              let cov = metal.device.makeBuffer(length: MemoryLayout<float3x3>.size*threads),
-              let pts = metal.device.makeBuffer(length: MemoryLayout<uint>.size*threads)
-              else { fatalError("Could not allocate parameter buffers in correlator") }
+    // pixel data of maps to correlate and its size
+    typealias Pixels = (data: [UnsafePointer<Float>?], npix: Int)
+    
+    // sparse maps sharing a layout are correlated over their stored tiles (where unobserved pixels
+    // are NaN), other maps over full sky (which expands sparse maps, so call this on main actor)
+    static func pixels(_ maps: [Map]) -> Pixels? {
+        guard let nside = maps.first?.nside, maps.allSatisfy({ $0.nside == nside }) else { return nil }
+        let sparse = maps.compactMap { $0 as? SparseMap }
+        
+        if let layout = sparse.first?.layout, sparse.count == maps.count, sparse.allSatisfy({ $0.layout === layout }) {
+            return (sparse.map { $0.store }, layout.size)
+        }
         
-        self.threads = threads
-        self.buffer = (range, npix, cov, pts)
+        return (maps.map { $0.ptr }, 12*nside*nside)
     }
     
-    func correlate(_ x: Map, _ y: Map, _ z: Map) -> (avg: double3, cov: double3x3)? {
-        let nside = x.nside, npix = x.npix; guard (y.nside == nside && z.nside == nside) else { return nil }
+    // average and covariance matrix (row major) of any number of maps, over pixels where all are within data range
+    // (with pixel data looked up beforehand, this can run off main actor while maps are kept alive)
+    func covariance(_ maps: [Map], pixels: Pixels? = nil) -> (avg: [Double], cov: [Double], count: Int)? {
+        guard let pixels = pixels ?? Correlator.pixels(maps), pixels.data.count == maps.count else { return nil }
+        let trace = LoadTrace.begin("correlate"); defer { LoadTrace.end(trace, bytes: maps.count*pixels.npix*MemoryLayout<Float>.size/Swift.max(stride,1)) }
         
-        // limit covariance sampling to nside=1024 subset and data within range
-        let skip = max(2.0*log2(Double(nside)/1024.0), 0)
-        buffer.npix.contents().storeBytes(of: uint2(uint(npix),uint(skip)), as: uint2.self)
-        buffer.range.contents().storeBytes(of: float2x3(
-            float3(Float(x.min),Float(y.min),Float(z.min)),
-            float3(Float(x.max),Float(y.max),Float(z.max))), as: float2x3.self)
+        let n = maps.count, lo = maps.map { $0.min }, hi = maps.map { $0.max }
+        var avg = [Double](repeating: 0.0, count: n), cov = [Double](repeating: 0.0, count: n*n), count = 0
         
-        // initialize compute command buffer
-        guard let command = metal.queue.makeCommandBuffer() else { return nil }
+        correlate_threads(Int32(CpuThreads.value.count))
+        guard correlate_maps(pixels.data, Int32(n), pixels.npix, lo, hi, stride, UInt(truncatingIfNeeded: seed), &avg, &cov, &count) == 0, count > 0 else { return nil }
         
-        shader.encode(command: command, buffers: [x.buffer, y.buffer, z.buffer, buffer.range, buffer.npix, buffer.cov, buffer.pts],
-            textures: [], threadsPerGrid: MTLSize(width: threads, height: 1, depth: 1))
-        command.commit(); command.waitUntilCompleted()
-        
-        // read off accumulated values
-        let n = buffer.pts.contents().bindMemory(to: uint.self, capacity: threads)[0]
-        let S = buffer.cov.contents().bindMemory(to: float3x3.self, capacity: threads)[0]
-        let A = double3(S[0])/Double(n), B = double3(S[1])/Double(n), C = double3(S[2])/Double(n)
-        
-        // covariance via König's formula (not the best way, but good enough)
-        let cov = double3x3(
-            double3(B[0] - A.x*A.x, C[0] - A.x*A.y, C[1] - A.x*A.z),
-            double3(C[0] - A.y*A.x, B[1] - A.y*A.y, C[2] - A.y*A.z),
-            double3(C[1] - A.z*A.x, C[2] - A.z*A.y, B[2] - A.z*A.z)
-        )
-        
-        return (A, cov)
+        return (avg, cov, count)
+    }
+    
+    // average and covariance matrix of three maps
+    func correlate(_ x: Map, _ y: Map, _ z: Map, pixels: Pixels? = nil) -> (avg: double3, cov: double3x3)? {
+        guard let result = covariance([x, y, z], pixels: pixels) else { return nil }
+        let avg = result.avg, cov = result.cov
+        
+        return (double3(avg[0], avg[1], avg[2]), double3x3(
+            double3(cov[0], cov[1], cov[2]),
+            double3(cov[3], cov[4], cov[5]),
+            double3(cov[6], cov[7], cov[8])
+        ))
     }
 }
 
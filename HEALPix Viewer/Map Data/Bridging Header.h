@@ -3,4 +3,14 @@
 //
 
 #include "rawmap.h"
+#include "reorder.h"
 #include "ranking.h"
+#include "pyramid.h"
+#include "sparse.h"
+#include "trace.h"
+#include "evaluate.h"
+#include "lic.h"
+#include "neighbours.h"
+#include "sht.h"
+#include "smooth.h"
+#include "correlate.h"
@@ -41,3 +41,177 @@ enum Expression {
     indirect case project(Expression,Expression)
     indirect case orthogonal(Expression,Expression)
 }
+
+// MARK: expression evaluation on CPU
+extension Expression {
+    // operands of the expression
+    var operands: [Expression] {
+        switch self {
+            case .literal, .random, .map: return []
+            case .transform(let x, _), .valid(let x), .invalid(let x): return [x]
+            case .mask(let x, let y), .add(let x, let y), .subtract(let x, let y), .multiply(let x, let y), .divide(let x, let y), .power(let x, let y),
+                 .equal(let x, let y), .less(let x, let y), .greater(let x, let y), .ne(let x, let y), .le(let x, let y), .ge(let x, let y),
+                 .project(let x, let y), .orthogonal(let x, let y): return [x, y]
+        }
+    }
+    
+    // maps the expression refers to
+    var maps: [MapData] {
+        if case .map(let map) = self { return [map] }
+        return operands.flatMap { $0.maps }
+    }
+    
+    // evaluate expression into a new map, with random fields seeded in order of appearance
+    // (resolution has to be specified if expression does not refer to any maps)
+    func evaluate(nside: Int? = nil, seed: Int = 0) -> CpuMap? {
+        let sizes = Set(maps.map { $0.data.nside }); guard sizes.count <= 1 else { return nil }
+        guard let nside = sizes.first ?? nside else { return nil }
+        
+        evaluate_threads(Int32(CpuThreads.value.count))
+        var program = ExpressionProgram(nside: nside, seed: seed)
+        return program.run(self)
+    }
+}
+
+// program for fused evaluator (see evaluate.h), compiled from expression tree; pointwise operators
+// become instructions over chunk-sized registers allocated as a stack (so that expression result
+// ends up in register 0), while rank transforms (which need the entire map) and projections (which
+// need dot products over the entire map) are resolved by evaluating their operands beforehand
+private struct ExpressionProgram {
+    let nside: Int
+    var seed: Int
+    
+    // instructions, sources, and number of registers used
+    private var code = [evaluate_instruction]()
+    private var sources = [evaluate_source]()
+    private var registers = 1
+    
+    // maps computed while resolving the expression (kept alive for sources)
+    private var temporaries = [Map]()
+    
+    init(nside: Int, seed: Int) {
+        self.nside = nside
+        self.seed = seed
+    }
+    
+    // pointwise transform instructions
+    private static let transforms: [Function: evaluate_op] = [
+        .log: EVALUATE_LOG, .asinh: EVALUATE_ASINH, .atan: EVALUATE_ATAN,
+        .tanh: EVALUATE_TANH, .power: EVALUATE_POW, .exp: EVALUATE_EXP
+    ]
+    
+    // binary operator instructions
+    private static func binary(_ e: Expression) -> (Expression, Expression, evaluate_op)? {
+        switch e {
+            case .add(let x, let y):        return (x, y, EVALUATE_ADD)
+            case .subtract(let x, let y):   return (x, y, EVALUATE_SUBTRACT)
+            case .multiply(let x, let y):   return (x, y, EVALUATE_MULTIPLY)
+            case .divide(let x, let y):     return (x, y, EVALUATE_DIVIDE)
+            case .power(let x, let y):      return (x, y, EVALUATE_POWER)
+            case .equal(let x, let y):      return (x, y, EVALUATE_EQUAL)
+            case .less(let x, let y):       return (x, y, EVALUATE_LESS)
+            case .greater(let x, let y):    return (x, y, EVALUATE_GREATER)
+            case .ne(let x, let y):         return (x, y, EVALUATE_NE)
+            case .le(let x, let y):         return (x, y, EVALUATE_LE)
+            case .ge(let x, let y):         return (x, y, EVALUATE_GE)
+            case .mask(let x, let y):       return (x, y, EVALUATE_MASK)
+            default: return nil
+        }
+    }
+    
+    // evaluate expression into a new map
+    mutating func run(_ e: Expression) -> CpuMap? {
+        guard compile(e, into: 0) else { return nil }
+        
+        let npix = 12*nside*nside, output = UnsafeMutablePointer<Float>.allocate(capacity: npix); var minval = 0.0, maxval = 0.0
+        guard evaluate(code, Int32(code.count), sources, Int32(registers), output, npix, &minval, &maxval) == 0 else { output.deallocate(); return nil }
+        
+        return CpuMap(nside: nside, buffer: output, min: minval, max: maxval)
+    }
+    
+    // dot products (x,y) and (y,y) over pixels where both are finite, and random seed y started with
+    mutating func dot(_ x: Expression, _ y: Expression) -> (xy: Double, yy: Double, seed: Int)? {
+        guard compile(x, into: 0) else { return nil }; let start = seed
+        guard compile(y, into: 1) else { return nil }
+        
+        var xy = 0.0, yy = 0.0
+        guard evaluate_dot(code, Int32(code.count), sources, Int32(registers), 12*nside*nside, &xy, &yy) == 0 else { return nil }
+        
+        return (xy, yy, start)
+    }
+    
+    // append instruction writing register r
+    private mutating func emit(_ op: evaluate_op, _ r: Int32, _ a: Int32 = 0, _ b: Int32 = 0, x: Double = 0.0, y: Double = 0.0) {
+        code.append(evaluate_instruction(op: op, r: r, a: a, b: b, x: x, y: y))
+    }
+    
+    // append source, returning its operand reference
+    private mutating func source(map: UnsafePointer<Float>? = nil, value: Float = 0.0) -> Int32 {
+        sources.append(evaluate_source(map: map, value: value)); return -Int32(sources.count)
+    }
+    
+    // operand reference to expression, compiling it into register r unless it is a source
+    private mutating func operand(_ e: Expression, _ r: Int32) -> Int32? {
+        switch e {
+            case .literal(let value): return source(value: value)
+            case .map(let map): return source(map: map.data.ptr)
+            default: return compile(e, into: r) ? r : nil
+        }
+    }
+    
+    // ranked map of expression (using the one computed on analysis, if there is one)
+    private mutating func rank(_ e: Expression) -> Map? {
+        if case .map(let map) = e { let ranked = map.ranked ?? map.data.ranked(); temporaries.append(ranked); return ranked }
+        
+        var program = ExpressionProgram(nside: nside, seed: seed)
+        guard let map = program.run(e) else { return nil }; seed = program.seed
+        
+        let ranked = map.ranked(); temporaries.append(ranked); return ranked
+    }
+    
+    // compile expression into instructions leaving its value in register r (registers above r are scratch)
+    private mutating func compile(_ e: Expression, into r: Int32) -> Bool {
+        registers = Swift.max(registers, Int(r)+1)
+        
+        switch e {
+            case .literal, .map:
+                guard let a = operand(e, r) else { return false }
+                emit(EVALUATE_COPY, r, a)
+            case .random(let pdf):
+                emit((pdf == .uniform) ? EVALUATE_UNIFORM : EVALUATE_GAUSSIAN, r, x: Double(seed & 0xFFFFFFFF)); seed += 1
+            case .transform(let x, let t):
+                switch t.f {
+                    case .none: return compile(x, into: r)
+                    case .equalize, .normalize:
+                        guard let ranked = rank(x) else { return false }
+                        emit((t.f == .normalize) ? EVALUATE_NORMALIZE : EVALUATE_COPY, r, source(map: ranked.ptr))
+                    default:
+                        guard let op = Self.transforms[t.f], let a = operand(x, r) else { return false }
+                        emit(op, r, a, x: t.mu, y: exp(t.sigma))
+                }
+            case .valid(let x), .invalid(let x):
+                guard let a = operand(x, r) else { return false }
+                if case .valid = e { emit(EVALUATE_VALID, r, a) } else { emit(EVALUATE_INVALID, r, a) }
+            case .project(let x, let y), .orthogonal(let x, let y):
+                // projection coefficient, with random fields of operands seeded as in the main pass
+                var program = ExpressionProgram(nside: nside, seed: seed)
+                guard let (xy, yy, start) = program.dot(x, y) else { return false }
+                let c = source(value: (yy > 0.0) ? Float(xy/yy) : 0.0)
+                
+                if case .project = e {
+                    seed = start; guard let b = operand(y, r) else { return false }
+                    emit(EVALUATE_MULTIPLY, r, b, c)
+                } else {
+                    guard let a = operand(x, r) else { return false }; let s = (a == r) ? r+1 : r
+                    guard let b = operand(y, s) else { return false }
+                    emit(EVALUATE_MULTIPLY, s, b, c); emit(EVALUATE_SUBTRACT, r, a, s)
+                    registers = Swift.max(registers, Int(s)+1)
+                }
+            default:
+                guard let (x, y, op) = Self.binary(e), let a = operand(x, r), let b = operand(y, (a == r) ? r+1 : r) else { return false }
+                emit(op, r, a, b)
+        }
+        
+        return true
+    }
+}
@@ -249,6 +249,35 @@ private func read_format(_ fptr: UnsafeMutablePointer<fitsfile>?, metadata: Meta
     }
 }
 
+// MARK: load pipeline tracing (see trace.h)
+// enabled by HPX_TRACE environment variable naming Chrome trace file to write (relative to
+// temporary directory, as the app is sandboxed); stage summary of each load goes to console
+enum LoadTrace {
+    static let file: URL? = {
+        guard let name = ProcessInfo.processInfo.environment["HPX_TRACE"], !name.isEmpty else { return nil }
+        trace_enable(1); return URL(fileURLWithPath: name, relativeTo: FileManager.default.temporaryDirectory)
+    }()
+    
+    // begin a stage, returning its handle (-1 if tracing is disabled, stage name is not evaluated then)
+    static func begin(_ stage: @autoclosure () -> String) -> Int {
+        guard file != nil else { return -1 }
+        return trace_begin(stage())
+    }
+    
+    // end a stage, recording number of bytes it processed
+    static func end(_ stage: Int, bytes: @autoclosure () -> Int = 0) {
+        guard stage >= 0 else { return }
+        trace_end(stage, Double(bytes()))
+    }
+    
+    // print summary of stages recorded since the specified one, and write out the trace
+    static func report(since stage: Int) {
+        guard stage >= 0, let file = file else { return }
+        trace_summary(stdout, stage); fflush(stdout)
+        if (trace_write_json(file.path) != 0) { print("Could not write load trace to \(file.path)") }
+    }
+}
+
 // read BINTABLE content, returning data as raw byte arrays
 private func read_table(_ fptr: UnsafeMutablePointer<fitsfile>?, npix: Int, nmaps: Int, nrows: Int, type: [Int32]) -> [UnsafeRawPointer]? {
     var type = type, status: Int32 = 0, cleanup = true
@@ -266,15 +295,201 @@ private func read_table(_ fptr: UnsafeMutablePointer<fitsfile>?, npix: Int, nmap
     var cols = Array(1...Int32(nmaps))
     var nuls = [UnsafeMutableRawPointer?](repeating: nil, count: nmaps)
     
+    let trace = LoadTrace.begin("read_table"); defer { LoadTrace.end(trace, bytes: npix*type.reduce(0) { $0 + (sizeof[$1] ?? 0) }) }
     ffgcvn(fptr, Int32(nmaps), &type, &cols, 1, Int64(nrows), &nuls, &data, nil, &status)
     guard status == 0, data.allSatisfy({ $0 != nil }) else { return nil }
     
     cleanup = false; return data.map { UnsafeRawPointer($0!) }
 }
 
+// BINTABLE rows are streamed in chunks of (at most) this many bytes
+private let chunkSize = 1<<24
+
+// stream BINTABLE content in row chunks, passing each chunk (as raw byte arrays) to conversion
+// on a separate thread, so that reading the next chunk overlaps with converting the current one
+private func stream_table(_ fptr: UnsafeMutablePointer<fitsfile>?, npix: Int, nmaps: Int, nrows: Int, type: [Int32], convert: @escaping (_ data: [UnsafeRawPointer], _ offset: Int, _ count: Int) -> Bool) -> Bool {
+    var type = type, status: Int32 = 0, failed = false
+    guard nrows > 0, npix % nrows == 0 else { return false }
+    
+    // pixels per row and rows per chunk
+    let repeats = npix/nrows; var width = 0
+    for m in 0..<nmaps { guard let w = sizeof[type[m]] else { return false }; width += w*repeats }
+    let rows = Swift.max(chunkSize/width, 1)
+    
+    // allocate double buffer storage
+    let buffers = (0..<2).map { _ in (0..<nmaps).map { UnsafeMutableRawPointer.allocate(byteCount: rows*repeats*sizeof[type[$0]]!, alignment: 32) } }
+    defer { for b in buffers { for p in b { p.deallocate() } } }
+    
+    // conversion runs behind reading by at most one chunk
+    let queue = DispatchQueue(label: "convert", qos: .userInitiated)
+    let semaphore = DispatchSemaphore(value: buffers.count), group = DispatchGroup()
+    
+    var cols = Array(1...Int32(nmaps))
+    var nuls = [UnsafeMutableRawPointer?](repeating: nil, count: nmaps)
+    
+    for (k, first) in stride(from: 0, to: nrows, by: rows).enumerated() {
+        let n = Swift.min(rows, nrows-first), buffer = buffers[k % buffers.count]
+        var data = buffer.map { Optional($0) }
+        
+        // read next chunk in (once its buffer is released)
+        semaphore.wait()
+        let trace = LoadTrace.begin("read chunk")
+        ffgcvn(fptr, Int32(nmaps), &type, &cols, Int64(first+1), Int64(n), &nuls, &data, nil, &status)
+        LoadTrace.end(trace, bytes: n*width)
+        guard (status == 0) else { semaphore.signal(); break }
+        
+        queue.async(group: group) {
+            let trace = LoadTrace.begin("convert chunk")
+            if !failed { failed = !convert(buffer.map { UnsafeRawPointer($0) }, first*repeats, n*repeats) }
+            LoadTrace.end(trace, bytes: n*width); semaphore.signal()
+        }
+    }
+    
+    group.wait(); return (status == 0 && !failed)
+}
+
+// memory-mapped data section of an uncompressed BINTABLE, converted without intermediate copies
+private final class MappedTable {
+    let data: UnsafeRawPointer                                  // first table row
+    let stride: Int                                             // bytes per table row
+    let columns: [(type: Int32, offset: Int, repeats: Int)]     // storage type and position in a row
+    
+    // mapped file region
+    private let region: UnsafeMutableRawPointer
+    private let length: Int
+    
+    // map table in, if it is stored as plain fixed-width binary columns
+    init?(_ fptr: UnsafeMutablePointer<fitsfile>?, file: String, nmaps: Int, nrows: Int, npix: Int, sequential: Bool) {
+        var headstart: Int64 = 0, datastart: Int64 = 0, dataend: Int64 = 0, status: Int32 = 0
+        guard case let .int(stride) = HpxCard.naxis1.read(fptr) else { return nil }
+        
+        // tile-compressed tables store compressed bytes in the heap, not plain rows
+        var ztable: Int32 = 0
+        ffgkyl(fptr, "ZTABLE", &ztable, nil, &status); if (status == KEY_NO_EXIST) { status = 0 }
+        guard (status == 0), ztable == 0 else { return nil }
+        
+        // column storage types (scaled, bit, string and variable length columns are not eligible)
+        var columns = [(type: Int32, offset: Int, repeats: Int)](), offset = 0
+        
+        for m in 1...nmaps {
+            var typecode: Int32 = 0, repeat: Int64 = 0, size: Int64 = 0, scale = 1.0, zero = 0.0
+            ffgtclll(fptr, Int32(m), &typecode, &repeat, &size, &status)
+            ffgkyd(fptr, "TSCAL\(m)", &scale, nil, &status); if (status == KEY_NO_EXIST) { status = 0 }
+            ffgkyd(fptr, "TZERO\(m)", &zero, nil, &status); if (status == KEY_NO_EXIST) { status = 0 }
+            let repeats = Int(repeat), width = Int(size)
+            guard (status == 0), scale == 1.0, zero == 0.0, repeats*nrows == npix else { return nil }
+            
+            switch (typecode, width) {
+                case (TFLOAT, 4):                   columns.append((TFLOAT, offset, repeats))
+                case (TDOUBLE, 8):                  columns.append((TDOUBLE, offset, repeats))
+                case (TSHORT, 2):                   columns.append((TSHORT, offset, repeats))
+                case (TINT, 4), (TLONG, 4):         columns.append((TINT, offset, repeats))
+                case (TLONGLONG, 8):                columns.append((TLONGLONG, offset, repeats))
+                default: return nil
+            }
+            
+            offset += repeats*width
+        }
+        
+        guard offset == stride else { return nil }
+        
+        // data section location
+        ffghadll(fptr, &headstart, &datastart, &dataend, &status)
+        guard (status == 0), Int(datastart) + stride*nrows <= Int(dataend) else { return nil }
+        
+        // plain FITS files only (CFITSIO uncompresses anything else into memory)
+        let fd = open(file, O_RDONLY); guard fd >= 0 else { return nil }
+        defer { close(fd) }
+        
+        var magic = [UInt8](repeating: 0, count: 6)
+        guard pread(fd, &magic, magic.count, 0) == magic.count, magic == Array("SIMPLE".utf8) else { return nil }
+        
+        // map the data section in (offset has to be page-aligned)
+        let page = Int(getpagesize()), base = Int(datastart) & ~(page-1)
+        let length = Int(datastart) - base + stride*nrows
+        
+        // truncated files would fault on access past the end of file, not fail here
+        var st = stat(); guard fstat(fd, &st) == 0, base + length <= Int(st.st_size) else { return nil }
+        
+        guard let region = mmap(nil, length, PROT_READ, MAP_PRIVATE, fd, off_t(base)),
+              region != UnsafeMutableRawPointer(bitPattern: -1) else { return nil }
+        
+        // NESTED data is read through once, RING data is gathered all over the place
+        madvise(region, length, sequential ? MADV_SEQUENTIAL : MADV_WILLNEED)
+        
+        self.data = UnsafeRawPointer(region + (Int(datastart) - base))
+        self.stride = stride
+        self.columns = columns
+        self.region = region
+        self.length = length
+    }
+    
+    // clean up on deinitialization
+    deinit { munmap(region, length) }
+}
+
+// convert memory-mapped full-sky map data into canonical format (full-sky NESTED float)
+private func fits2map(_ table: MappedTable, column m: Int, nside: Int, order: String, flip: Bool = false, sketch: OpaquePointer? = nil) -> CpuMap? {
+    let npix = 12*nside*nside; var cleanup = true, minval = 0.0, maxval = 0.0, status: Int32 = -1
+    let ptr = table.data + table.columns[m].offset, repeats = table.columns[m].repeats, stride = table.stride
+    let trace = LoadTrace.begin("fits2map"); defer { LoadTrace.end(trace, bytes: npix*(sizeof[table.columns[m].type] ?? 0)) }
+    
+    // allocate output buffer
+    let output = UnsafeMutablePointer<Float>.allocate(capacity: npix)
+    defer { if (cleanup) { output.deallocate() } }
+    
+    switch table.columns[m].type {
+        case TFLOAT:
+            switch (order, flip) {
+                case (RING,   false): status = fits2map_frp(ptr, repeats, stride, output, nside, &minval, &maxval, sketch)
+                case (RING,   true ): status = fits2map_frn(ptr, repeats, stride, output, nside, &minval, &maxval, sketch)
+                case (NESTED, false): status = fits2map_fnp(ptr, repeats, stride, output, nside, &minval, &maxval, sketch)
+                case (NESTED, true ): status = fits2map_fnn(ptr, repeats, stride, output, nside, &minval, &maxval, sketch)
+                default: return nil
+            }
+        case TDOUBLE:
+            switch (order, flip) {
+                case (RING,   false): status = fits2map_drp(ptr, repeats, stride, output, nside, &minval, &maxval, sketch)
+                case (RING,   true ): status = fits2map_drn(ptr, repeats, stride, output, nside, &minval, &maxval, sketch)
+                case (NESTED, false): status = fits2map_dnp(ptr, repeats, stride, output, nside, &minval, &maxval, sketch)
+                case (NESTED, true ): status = fits2map_dnn(ptr, repeats, stride, output, nside, &minval, &maxval, sketch)
+                default: return nil
+            }
+        case TSHORT:
+            switch (order, flip) {
+                case (RING,   false): status = fits2map_srp(ptr, repeats, stride, output, nside, &minval, &maxval, sketch)
+                case (RING,   true ): status = fits2map_srn(ptr, repeats, stride, output, nside, &minval, &maxval, sketch)
+                case (NESTED, false): status = fits2map_snp(ptr, repeats, stride, output, nside, &minval, &maxval, sketch)
+                case (NESTED, true ): status = fits2map_snn(ptr, repeats, stride, output, nside, &minval, &maxval, sketch)
+                default: return nil
+            }
+        case TINT:
+            switch (order, flip) {
+                case (RING,   false): status = fits2map_irp(ptr, repeats, stride, output, nside, &minval, &maxval, sketch)
+                case (RING,   true ): status = fits2map_irn(ptr, repeats, stride, output, nside, &minval, &maxval, sketch)
+                case (NESTED, false): status = fits2map_inp(ptr, repeats, stride, output, nside, &minval, &maxval, sketch)
+                case (NESTED, true ): status = fits2map_inn(ptr, repeats, stride, output, nside, &minval, &maxval, sketch)
+                default: return nil
+            }
+        case TLONGLONG:
+            switch (order, flip) {
+                case (RING,   false): status = fits2map_xrp(ptr, repeats, stride, output, nside, &minval, &maxval, sketch)
+                case (RING,   true ): status = fits2map_xrn(ptr, repeats, stride, output, nside, &minval, &maxval, sketch)
+                case (NESTED, false): status = fits2map_xnp(ptr, repeats, stride, output, nside, &minval, &maxval, sketch)
+                case (NESTED, true ): status = fits2map_xnn(ptr, repeats, stride, output, nside, &minval, &maxval, sketch)
+                default: return nil
+            }
+        default: return nil
+    }
+    
+    guard (status == 0) else { return nil }
+    cleanup = false; return CpuMap(nside: nside, buffer: output, min: minval, max: maxval)
+}
+
 // convert raw full-sky map data into canonical format (full-sky NESTED float)
-private func raw2map(_ ptr: UnsafeRawPointer, nside: Int, type: Int32, order: String, flip: Bool = false) -> CpuMap? {
-    let npix = 12*nside*nside; var cleanup = true, minval = 0.0, maxval = 0.0
+private func raw2map(_ ptr: UnsafeRawPointer, nside: Int, type: Int32, order: String, flip: Bool = false, sketch: OpaquePointer? = nil) -> CpuMap? {
+    let npix = 12*nside*nside; var cleanup = true, minval = 0.0, maxval = 0.0, status: Int32 = -1
+    let trace = LoadTrace.begin("raw2map"); defer { LoadTrace.end(trace, bytes: npix*(sizeof[type] ?? 0)) }
     
     // allocate output buffer
     let output = UnsafeMutablePointer<Float>.allocate(capacity: npix)
@@ -283,141 +498,404 @@ private func raw2map(_ ptr: UnsafeRawPointer, nside: Int, type: Int32, order: St
     switch type {
         case TFLOAT: let buffer = ptr.bindMemory(to: Float.self, capacity: npix)
             switch (order, flip) {
-                case (RING,   false): raw2map_frp(buffer, output, nside, &minval, &maxval)
-                case (RING,   true ): raw2map_frn(buffer, output, nside, &minval, &maxval)
-                case (NESTED, false): raw2map_fnp(buffer, output, nside, &minval, &maxval)
-                case (NESTED, true ): raw2map_fnn(buffer, output, nside, &minval, &maxval)
+                case (RING,   false): status = raw2map_frp(buffer, output, nside, &minval, &maxval, sketch)
+                case (RING,   true ): status = raw2map_frn(buffer, output, nside, &minval, &maxval, sketch)
+                case (NESTED, false): status = raw2map_fnp(buffer, output, nside, &minval, &maxval, sketch)
+                case (NESTED, true ): status = raw2map_fnn(buffer, output, nside, &minval, &maxval, sketch)
                 default: return nil
             }
         case TDOUBLE: let buffer = ptr.bindMemory(to: Double.self, capacity: npix)
             switch (order, flip) {
-                case (RING,   false): raw2map_drp(buffer, output, nside, &minval, &maxval)
-                case (RING,   true ): raw2map_drn(buffer, output, nside, &minval, &maxval)
-                case (NESTED, false): raw2map_dnp(buffer, output, nside, &minval, &maxval)
-                case (NESTED, true ): raw2map_dnn(buffer, output, nside, &minval, &maxval)
+                case (RING,   false): status = raw2map_drp(buffer, output, nside, &minval, &maxval, sketch)
+                case (RING,   true ): status = raw2map_drn(buffer, output, nside, &minval, &maxval, sketch)
+                case (NESTED, false): status = raw2map_dnp(buffer, output, nside, &minval, &maxval, sketch)
+                case (NESTED, true ): status = raw2map_dnn(buffer, output, nside, &minval, &maxval, sketch)
                 default: return nil
             }
         case TSHORT: let buffer = ptr.bindMemory(to: Int16.self, capacity: npix)
             switch (order, flip) {
-                case (RING,   false): raw2map_srp(buffer, output, nside, &minval, &maxval)
-                case (RING,   true ): raw2map_srn(buffer, output, nside, &minval, &maxval)
-                case (NESTED, false): raw2map_snp(buffer, output, nside, &minval, &maxval)
-                case (NESTED, true ): raw2map_snn(buffer, output, nside, &minval, &maxval)
+                case (RING,   false): status = raw2map_srp(buffer, output, nside, &minval, &maxval, sketch)
+                case (RING,   true ): status = raw2map_srn(buffer, output, nside, &minval, &maxval, sketch)
+                case (NESTED, false): status = raw2map_snp(buffer, output, nside, &minval, &maxval, sketch)
+                case (NESTED, true ): status = raw2map_snn(buffer, output, nside, &minval, &maxval, sketch)
                 default: return nil
             }
         case TINT: let buffer = ptr.bindMemory(to: Int32.self, capacity: npix)
             switch (order, flip) {
-                case (RING,   false): raw2map_irp(buffer, output, nside, &minval, &maxval)
-                case (RING,   true ): raw2map_irn(buffer, output, nside, &minval, &maxval)
-                case (NESTED, false): raw2map_inp(buffer, output, nside, &minval, &maxval)
-                case (NESTED, true ): raw2map_inn(buffer, output, nside, &minval, &maxval)
+                case (RING,   false): status = raw2map_irp(buffer, output, nside, &minval, &maxval, sketch)
+                case (RING,   true ): status = raw2map_irn(buffer, output, nside, &minval, &maxval, sketch)
+                case (NESTED, false): status = raw2map_inp(buffer, output, nside, &minval, &maxval, sketch)
+                case (NESTED, true ): status = raw2map_inn(buffer, output, nside, &minval, &maxval, sketch)
                 default: return nil
             }
         case TLONG: let buffer = ptr.bindMemory(to: Int.self, capacity: npix)
             switch (order, flip) {
-                case (RING,   false): raw2map_lrp(buffer, output, nside, &minval, &maxval)
-                case (RING,   true ): raw2map_lrn(buffer, output, nside, &minval, &maxval)
-                case (NESTED, false): raw2map_lnp(buffer, output, nside, &minval, &maxval)
-                case (NESTED, true ): raw2map_lnn(buffer, output, nside, &minval, &maxval)
+                case (RING,   false): status = raw2map_lrp(buffer, output, nside, &minval, &maxval, sketch)
+                case (RING,   true ): status = raw2map_lrn(buffer, output, nside, &minval, &maxval, sketch)
+                case (NESTED, false): status = raw2map_lnp(buffer, output, nside, &minval, &maxval, sketch)
+                case (NESTED, true ): status = raw2map_lnn(buffer, output, nside, &minval, &maxval, sketch)
                 default: return nil
             }
         case TLONGLONG: let buffer = ptr.bindMemory(to: Int64.self, capacity: npix)
             switch (order, flip) {
-                case (RING,   false): raw2map_xrp(buffer, output, nside, &minval, &maxval)
-                case (RING,   true ): raw2map_xrn(buffer, output, nside, &minval, &maxval)
-                case (NESTED, false): raw2map_xnp(buffer, output, nside, &minval, &maxval)
-                case (NESTED, true ): raw2map_xnn(buffer, output, nside, &minval, &maxval)
+                case (RING,   false): status = raw2map_xrp(buffer, output, nside, &minval, &maxval, sketch)
+                case (RING,   true ): status = raw2map_xrn(buffer, output, nside, &minval, &maxval, sketch)
+                case (NESTED, false): status = raw2map_xnp(buffer, output, nside, &minval, &maxval, sketch)
+                case (NESTED, true ): status = raw2map_xnn(buffer, output, nside, &minval, &maxval, sketch)
                 default: return nil
             }
         default: return nil
     }
     
+    guard (status == 0) else { return nil }
     cleanup = false; return CpuMap(nside: nside, buffer: output, min: minval, max: maxval)
 }
 
 // convert indexed partial map data into canonical format (full-sky NESTED float)
-private func idx2map(_ idx: UnsafePointer<Int>, _ ptr: UnsafeRawPointer, nobs: Int, nside: Int, type: Int32, flip: Bool = false) -> CpuMap? {
-    let npix = 12*nside*nside; var cleanup = true, minval = 0.0, maxval = 0.0
+private func idx2map(_ idx: UnsafePointer<Int>, _ ptr: UnsafeRawPointer, nobs: Int, nside: Int, type: Int32, flip: Bool = false, sketch: OpaquePointer? = nil) -> CpuMap? {
+    let npix = 12*nside*nside; var cleanup = true
+    let trace = LoadTrace.begin("idx2map"); defer { LoadTrace.end(trace, bytes: nobs*(sizeof[type] ?? 0)) }
     
     // allocate output buffer (and initialize to NaN)
     let output = UnsafeMutablePointer<Float>.allocate(capacity: npix)
     output.initialize(repeating: .nan, count: npix)
     defer { if (cleanup) { output.deallocate() } }
     
+    guard let (minval, maxval) = idx2buf(idx, ptr, output, nobs: nobs, type: type, flip: flip, sketch: sketch) else { return nil }
+    
+    cleanup = false; return CpuMap(nside: nside, buffer: output, min: minval, max: maxval)
+}
+
+// indexed maps covering less than this fraction of the sky are stored sparse
+private let sparseCoverage = 0.25
+
+// pixel index of sparse maps, with positions of indexed pixels in stored data
+private final class SparseIndex {
+    let nobs: Int
+    let layout: SparseLayout
+    let idx: UnsafePointer<Int>
+    let pos: UnsafePointer<Int>
+    
+    // lay out sparse storage for validated pixel index (taking ownership of it)
+    init?(nside: Int, idx: UnsafePointer<Int>, nobs: Int) {
+        guard let layout = SparseLayout(nside: nside, idx: idx, nobs: nobs) else { return nil }
+        let pos = UnsafeMutablePointer<Int>.allocate(capacity: nobs)
+        sparse_pack(layout.ptr, idx, pos, nobs)
+        
+        self.nobs = nobs
+        self.layout = layout
+        self.idx = idx
+        self.pos = UnsafePointer(pos)
+    }
+    
+    deinit { idx.deallocate(); pos.deallocate() }
+}
+
+// read pixel index column in ahead of data and lay out sparse storage for it (if sky coverage is small)
+private func read_sparse(_ fptr: UnsafeMutablePointer<fitsfile>?, nobs: Int, nside: Int, nrows: Int, type: Int32, order: String) -> SparseIndex? {
+    guard Double(nobs) < sparseCoverage*Double(12*nside*nside) else { return nil }
+    let trace = LoadTrace.begin("read_sparse"); defer { LoadTrace.end(trace, bytes: nobs*(sizeof[type] ?? 0)) }
+    
+    guard let data = read_table(fptr, npix: nobs, nmaps: 1, nrows: nrows, type: [type]) else { return nil }
+    defer { for p in data { p.deallocate() } }
+    
+    guard let idx = reindex(data[0], nobs: nobs, nside: nside, type: type, order: order) else { return nil }
+    guard let sparse = SparseIndex(nside: nside, idx: idx, nobs: nobs) else { idx.deallocate(); return nil }
+    
+    return sparse
+}
+
+// convert indexed map data into sparse storage
+private func idx2map(_ sparse: SparseIndex, _ ptr: UnsafeRawPointer, nside: Int, type: Int32, flip: Bool = false, sketch: OpaquePointer? = nil) -> SparseMap? {
+    let size = sparse.layout.size; var cleanup = true
+    let trace = LoadTrace.begin("idx2map (sparse)"); defer { LoadTrace.end(trace, bytes: sparse.nobs*(sizeof[type] ?? 0)) }
+    
+    // allocate stored data buffer (and initialize to NaN)
+    let output = UnsafeMutablePointer<Float>.allocate(capacity: size)
+    output.initialize(repeating: .nan, count: size)
+    defer { if (cleanup) { output.deallocate() } }
+    
+    guard let (minval, maxval) = idx2buf(sparse.pos, ptr, output, nobs: sparse.nobs, type: type, flip: flip, sketch: sketch) else { return nil }
+    
+    cleanup = false; return SparseMap(nside: nside, layout: sparse.layout, buffer: output, min: minval, max: maxval)
+}
+
+// scatter indexed map data into preallocated canonical buffer, returning data bounds
+private func idx2buf(_ idx: UnsafePointer<Int>, _ ptr: UnsafeRawPointer, _ output: UnsafeMutablePointer<Float>, nobs: Int, type: Int32, flip: Bool = false, sketch: OpaquePointer? = nil) -> (min: Double, max: Double)? {
+    var minval = 0.0, maxval = 0.0, status: Int32 = -1
+    
     switch type {
         case TFLOAT: let buffer = ptr.bindMemory(to: Float.self, capacity: nobs)
             switch flip {
-                case false: idx2map_fp(idx, buffer, output, nobs, &minval, &maxval)
-                case true:  idx2map_fn(idx, buffer, output, nobs, &minval, &maxval)
+                case false: status = idx2map_fp(idx, buffer, output, nobs, &minval, &maxval, sketch)
+                case true:  status = idx2map_fn(idx, buffer, output, nobs, &minval, &maxval, sketch)
             }
         case TDOUBLE: let buffer = ptr.bindMemory(to: Double.self, capacity: nobs)
             switch flip {
-                case false: idx2map_dp(idx, buffer, output, nobs, &minval, &maxval)
-                case true:  idx2map_dn(idx, buffer, output, nobs, &minval, &maxval)
+                case false: status = idx2map_dp(idx, buffer, output, nobs, &minval, &maxval, sketch)
+                case true:  status = idx2map_dn(idx, buffer, output, nobs, &minval, &maxval, sketch)
             }
         case TSHORT: let buffer = ptr.bindMemory(to: Int16.self, capacity: nobs)
             switch flip {
-                case false: idx2map_sp(idx, buffer, output, nobs, &minval, &maxval)
-                case true:  idx2map_sn(idx, buffer, output, nobs, &minval, &maxval)
+                case false: status = idx2map_sp(idx, buffer, output, nobs, &minval, &maxval, sketch)
+                case true:  status = idx2map_sn(idx, buffer, output, nobs, &minval, &maxval, sketch)
             }
         case TINT: let buffer = ptr.bindMemory(to: Int32.self, capacity: nobs)
             switch flip {
-                case false: idx2map_ip(idx, buffer, output, nobs, &minval, &maxval)
-                case true:  idx2map_in(idx, buffer, output, nobs, &minval, &maxval)
+                case false: status = idx2map_ip(idx, buffer, output, nobs, &minval, &maxval, sketch)
+                case true:  status = idx2map_in(idx, buffer, output, nobs, &minval, &maxval, sketch)
             }
         case TLONG: let buffer = ptr.bindMemory(to: Int.self, capacity: nobs)
             switch flip {
-                case false: idx2map_lp(idx, buffer, output, nobs, &minval, &maxval)
-                case true:  idx2map_ln(idx, buffer, output, nobs, &minval, &maxval)
+                case false: status = idx2map_lp(idx, buffer, output, nobs, &minval, &maxval, sketch)
+                case true:  status = idx2map_ln(idx, buffer, output, nobs, &minval, &maxval, sketch)
             }
         case TLONGLONG: let buffer = ptr.bindMemory(to: Int64.self, capacity: nobs)
             switch flip {
-                case false: idx2map_xp(idx, buffer, output, nobs, &minval, &maxval)
-                case true:  idx2map_xn(idx, buffer, output, nobs, &minval, &maxval)
+                case false: status = idx2map_xp(idx, buffer, output, nobs, &minval, &maxval, sketch)
+                case true:  status = idx2map_xn(idx, buffer, output, nobs, &minval, &maxval, sketch)
             }
         default: return nil
     }
     
-    cleanup = false; return CpuMap(nside: nside, buffer: output, min: minval, max: maxval)
+    return (status == 0) ? (minval, maxval) : nil
+}
+
+// convert a contiguous run of NESTED pixels into preallocated canonical buffer, returning data bounds
+private func seg2buf(_ ptr: UnsafeRawPointer, _ output: UnsafeMutablePointer<Float>, count: Int, type: Int32, flip: Bool = false, sketch: OpaquePointer? = nil) -> (min: Double, max: Double)? {
+    var minval = 0.0, maxval = 0.0, status: Int32 = -1
+    
+    switch type {
+        case TFLOAT: let buffer = ptr.bindMemory(to: Float.self, capacity: count)
+            switch flip {
+                case false: status = seg2map_fp(buffer, output, count, &minval, &maxval, sketch)
+                case true:  status = seg2map_fn(buffer, output, count, &minval, &maxval, sketch)
+            }
+        case TDOUBLE: let buffer = ptr.bindMemory(to: Double.self, capacity: count)
+            switch flip {
+                case false: status = seg2map_dp(buffer, output, count, &minval, &maxval, sketch)
+                case true:  status = seg2map_dn(buffer, output, count, &minval, &maxval, sketch)
+            }
+        case TSHORT: let buffer = ptr.bindMemory(to: Int16.self, capacity: count)
+            switch flip {
+                case false: status = seg2map_sp(buffer, output, count, &minval, &maxval, sketch)
+                case true:  status = seg2map_sn(buffer, output, count, &minval, &maxval, sketch)
+            }
+        case TINT: let buffer = ptr.bindMemory(to: Int32.self, capacity: count)
+            switch flip {
+                case false: status = seg2map_ip(buffer, output, count, &minval, &maxval, sketch)
+                case true:  status = seg2map_in(buffer, output, count, &minval, &maxval, sketch)
+            }
+        case TLONG: let buffer = ptr.bindMemory(to: Int.self, capacity: count)
+            switch flip {
+                case false: status = seg2map_lp(buffer, output, count, &minval, &maxval, sketch)
+                case true:  status = seg2map_ln(buffer, output, count, &minval, &maxval, sketch)
+            }
+        case TLONGLONG: let buffer = ptr.bindMemory(to: Int64.self, capacity: count)
+            switch flip {
+                case false: status = seg2map_xp(buffer, output, count, &minval, &maxval, sketch)
+                case true:  status = seg2map_xn(buffer, output, count, &minval, &maxval, sketch)
+            }
+        default: return nil
+    }
+    
+    return (status == 0) ? (minval, maxval) : nil
 }
 
 // validate and convert pixel index into canonical format (NESTED Int)
 private func reindex(_ ptr: UnsafeRawPointer, nobs: Int, nside: Int, type: Int32, order: String) -> UnsafePointer<Int>? {
     var cleanup = true
+    let trace = LoadTrace.begin("reindex"); defer { LoadTrace.end(trace, bytes: nobs*(sizeof[type] ?? 0)) }
     
     // allocate pixel index LUT
     let idx = UnsafeMutablePointer<Int>.allocate(capacity: nobs)
     defer { if (cleanup) { idx.deallocate() } }
     
+    guard reindex(ptr, idx, nobs: nobs, nside: nside, type: type, order: order) else { return nil }
+    
+    cleanup = false; return UnsafePointer(idx)
+}
+
+// validate and convert pixel index into preallocated LUT (reusing RING lookup tables, if passed in)
+private func reindex(_ ptr: UnsafeRawPointer, _ idx: UnsafeMutablePointer<Int>, nobs: Int, nside: Int, type: Int32, order: String, lut: UnsafePointer<ring_lut>? = nil) -> Bool {
+    if let lut = lut, order == RING {
+        guard reindex(ptr, idx, nobs: nobs, nside: nside, type: type, order: NESTED) else { return false }
+        ring2nest_bulk(lut, idx, nobs, idx); return true
+    }
+    
     switch type {
         case TSHORT: let buffer = ptr.bindMemory(to: Int16.self, capacity: nobs)
             switch order {
-                case RING:   guard reindex_sr(buffer, idx, nobs, nside) == 0 else { return nil }
-                case NESTED: guard reindex_sn(buffer, idx, nobs, nside) == 0 else { return nil }
-                default: return nil
+                case RING:   return reindex_sr(buffer, idx, nobs, nside) == 0
+                case NESTED: return reindex_sn(buffer, idx, nobs, nside) == 0
+                default: return false
             }
         case TINT: let buffer = ptr.bindMemory(to: Int32.self, capacity: nobs)
             switch order {
-                case RING:   guard reindex_ir(buffer, idx, nobs, nside) == 0 else { return nil }
-                case NESTED: guard reindex_in(buffer, idx, nobs, nside) == 0 else { return nil }
-                default: return nil
+                case RING:   return reindex_ir(buffer, idx, nobs, nside) == 0
+                case NESTED: return reindex_in(buffer, idx, nobs, nside) == 0
+                default: return false
             }
         case TLONG: let buffer = ptr.bindMemory(to: Int.self, capacity: nobs)
             switch order {
-                case RING:   guard reindex_lr(buffer, idx, nobs, nside) == 0 else { return nil }
-                case NESTED: guard reindex_ln(buffer, idx, nobs, nside) == 0 else { return nil }
-                default: return nil
+                case RING:   return reindex_lr(buffer, idx, nobs, nside) == 0
+                case NESTED: return reindex_ln(buffer, idx, nobs, nside) == 0
+                default: return false
             }
         case TLONGLONG: let buffer = ptr.bindMemory(to: Int64.self, capacity: nobs)
             switch order {
-                case RING:   guard reindex_xr(buffer, idx, nobs, nside) == 0 else { return nil }
-                case NESTED: guard reindex_xn(buffer, idx, nobs, nside) == 0 else { return nil }
-                default: return nil
+                case RING:   return reindex_xr(buffer, idx, nobs, nside) == 0
+                case NESTED: return reindex_xn(buffer, idx, nobs, nside) == 0
+                default: return false
             }
-        default: return nil
+        default: return false
+    }
+}
+
+// progressive loading callback, receiving fraction of data loaded so far, coarse preview of maps
+// (created once, so that the same textures are reused in each step), and their current data
+typealias LoadProgress = (_ fraction: Double, _ preview: [MapData], _ maps: [Map]) -> Void
+
+// coarse preview of maps being loaded, degraded from converted chunks as they come in
+private final class Preview {
+    let nside: Int
+    let block: Int
+    
+    // accumulated sums and counts of coarse pixels
+    private let sum: [UnsafeMutablePointer<Double>]
+    private let cnt: [UnsafeMutablePointer<Double>]
+    
+    // preview is published in steps, as each fraction of data gets loaded
+    private let steps = 16; private var reported = 0
+    private let publish: (_ fraction: Double, _ maps: [CpuMap]) -> Void
+    
+    init(nside: Int, nmaps: Int, publish: @escaping (_ fraction: Double, _ maps: [CpuMap]) -> Void) {
+        self.nside = Swift.min(nside, 128)
+        self.block = (nside/self.nside)*(nside/self.nside)
+        self.publish = publish
+        
+        let npix = 12*self.nside*self.nside
+        sum = (0..<nmaps).map { _ in let p = UnsafeMutablePointer<Double>.allocate(capacity: npix); p.initialize(repeating: 0.0, count: npix); return p }
+        cnt = (0..<nmaps).map { _ in let p = UnsafeMutablePointer<Double>.allocate(capacity: npix); p.initialize(repeating: 0.0, count: npix); return p }
     }
     
-    cleanup = false; return UnsafePointer(idx)
+    deinit { for p in sum { p.deallocate() }; for p in cnt { p.deallocate() } }
+    
+    // accumulate contiguous run of converted pixels
+    func add(_ m: Int, _ map: UnsafePointer<Float>, first: Int, count: Int) {
+        pyramid_accumulate(map, nil, nil, first, count, block, sum[m], cnt[m])
+    }
+    
+    // accumulate scattered converted pixels (stored at given positions of sparse map data)
+    func add(_ m: Int, _ map: UnsafePointer<Float>, idx: UnsafePointer<Int>, pos: UnsafePointer<Int>? = nil, count: Int) {
+        pyramid_accumulate(map, pos, idx, 0, count, block, sum[m], cnt[m])
+    }
+    
+    // publish coarse maps if another step of data has been loaded
+    func update(_ fraction: Double) {
+        let step = Int(fraction*Double(steps)); guard step > reported else { return }; reported = step
+        
+        let npix = 12*nside*nside
+        let maps = (0..<sum.count).map { m -> CpuMap in
+            let out = UnsafeMutablePointer<Float>.allocate(capacity: npix); var minval = 0.0, maxval = 0.0
+            pyramid_average(sum[m], cnt[m], out, npix, &minval, &maxval)
+            return CpuMap(nside: nside, buffer: out, min: minval, max: maxval)
+        }
+        
+        publish(fraction, maps)
+    }
+}
+
+// stream full-sky map data, converting chunks straight into canonical format
+private func stream_fullsky(_ fptr: UnsafeMutablePointer<fitsfile>?, nside: Int, nmaps: Int, nrows: Int, type: [Int32], order: String, flip: [Bool], sketch: [OpaquePointer?], preview: Preview? = nil) -> [CpuMap]? {
+    let npix = 12*nside*nside, ring = (order == RING); var cleanup = true
+    guard ring || order == NESTED else { return nil }
+    
+    // allocate output buffers (RING chunks are scattered, so initialize to NaN)
+    let output = (0..<nmaps).map { _ in UnsafeMutablePointer<Float>.allocate(capacity: npix) }
+    if (ring) { for p in output { p.initialize(repeating: .nan, count: npix) } }
+    defer { if (cleanup) { for p in output { p.deallocate() } } }
+    
+    // RING pixel index of current chunk, reused across chunks
+    let idx = UnsafeMutablePointer<Int>.allocate(capacity: ring ? Swift.min(npix, Swift.max(chunkSize, npix/nrows)) : 0)
+    defer { idx.deallocate() }
+    
+    // RING ordering lookup tables, built once for all chunks
+    let lut = ring ? make_ring_lut(nside) : nil; defer { free_ring_lut(lut) }
+    guard !ring || lut != nil else { return nil }
+    
+    // data bounds accumulated over chunks
+    var minval = [Double](repeating: Double(Float.greatestFiniteMagnitude), count: nmaps)
+    var maxval = [Double](repeating: -Double(Float.greatestFiniteMagnitude), count: nmaps)
+    
+    let streamed = stream_table(fptr, npix: npix, nmaps: nmaps, nrows: nrows, type: type) { data, offset, count in
+        if (ring) {
+            for i in 0..<count { idx[i] = offset + i }
+            ring2nest_bulk(lut, idx, count, idx)
+        }
+        
+        for m in 0..<nmaps {
+            let bounds = ring ? idx2buf(idx, data[m], output[m], nobs: count, type: type[m], flip: flip[m], sketch: sketch[m])
+                              : seg2buf(data[m], output[m] + offset, count: count, type: type[m], flip: flip[m], sketch: sketch[m])
+            guard let (a, b) = bounds else { return false }
+            minval[m] = Swift.min(minval[m], a); maxval[m] = Swift.max(maxval[m], b)
+            
+            if let preview = preview {
+                if (ring) { preview.add(m, output[m], idx: idx, count: count) } else { preview.add(m, output[m], first: offset, count: count) }
+            }
+        }
+        
+        preview?.update(Double(offset+count)/Double(npix))
+        return true
+    }
+    
+    guard streamed else { return nil }
+    
+    cleanup = false; return (0..<nmaps).map { CpuMap(nside: nside, buffer: output[$0], min: minval[$0], max: maxval[$0]) }
+}
+
+// stream indexed map data (first column contains pixel index), scattering chunks into canonical format
+// (or into sparse storage, if pixel index was read in ahead and laid out for it)
+private func stream_indexed(_ fptr: UnsafeMutablePointer<fitsfile>?, nobs: Int, nside: Int, nmaps: Int, nrows: Int, type: [Int32], order: String, flip: [Bool], sketch: [OpaquePointer?], sparse: SparseIndex? = nil, preview: Preview? = nil) -> [Map]? {
+    let size = sparse?.layout.size ?? 12*nside*nside; var cleanup = true
+    
+    // allocate output buffers (and initialize to NaN)
+    let output = (1..<nmaps).map { _ in UnsafeMutablePointer<Float>.allocate(capacity: size) }
+    for p in output { p.initialize(repeating: .nan, count: size) }
+    defer { if (cleanup) { for p in output { p.deallocate() } } }
+    
+    // canonical pixel index of current chunk, reused across chunks
+    let idx = UnsafeMutablePointer<Int>.allocate(capacity: (sparse == nil) ? Swift.min(nobs, Swift.max(chunkSize, nobs/nrows)) : 0)
+    defer { idx.deallocate() }
+    
+    // RING ordering lookup tables, built once for all chunks
+    let ring = (sparse == nil && order == RING), lut = ring ? make_ring_lut(nside) : nil; defer { free_ring_lut(lut) }
+    guard !ring || lut != nil else { return nil }
+    
+    // data bounds accumulated over chunks
+    var minval = [Double](repeating: Double(Float.greatestFiniteMagnitude), count: nmaps-1)
+    var maxval = [Double](repeating: -Double(Float.greatestFiniteMagnitude), count: nmaps-1)
+    
+    let streamed = stream_table(fptr, npix: nobs, nmaps: nmaps, nrows: nrows, type: type) { data, offset, count in
+        let pix = sparse.map { $0.idx + offset } ?? UnsafePointer(idx), pos = sparse.map { $0.pos + offset }
+        guard sparse != nil || reindex(data[0], idx, nobs: count, nside: nside, type: type[0], order: order, lut: lut) else { return false }
+        
+        for m in 1..<nmaps {
+            guard let (a, b) = idx2buf(pos ?? pix, data[m], output[m-1], nobs: count, type: type[m], flip: flip[m], sketch: sketch[m]) else { return false }
+            minval[m-1] = Swift.min(minval[m-1], a); maxval[m-1] = Swift.max(maxval[m-1], b)
+            preview?.add(m-1, output[m-1], idx: pix, pos: pos, count: count)
+        }
+        
+        preview?.update(Double(offset+count)/Double(nobs))
+        return true
+    }
+    
+    guard streamed else { return nil }
+    
+    cleanup = false; return (0..<nmaps-1).map {
+        if let sparse = sparse { return SparseMap(nside: nside, layout: sparse.layout, buffer: output[$0], min: minval[$0], max: maxval[$0]) }
+        return CpuMap(nside: nside, buffer: output[$0], min: minval[$0], max: maxval[$0])
+    }
 }
 
 // structure encapsulating contents of HEALPix file
@@ -429,14 +907,14 @@ struct HpxFile {
     let header: String
     let parsed: Cards
     
-    let data: [CpuMap]
+    let data: [Map]
     let list: [MapData]
     let metadata: Metadata
     let channel: [DataSource: Int]
     
     // map indexing
-    subscript(index: Int) -> CpuMap { return data[index] }
-    subscript(source: DataSource) -> CpuMap? {
+    subscript(index: Int) -> Map { return data[index] }
+    subscript(source: DataSource) -> Map? {
         if let c = channel[source] { return data[c] } else { return nil }
     }
     
@@ -444,11 +922,35 @@ struct HpxFile {
     var bookmark: Data? { try? url.bookmarkData(options: [.withSecurityScope, .securityScopeAllowOnlyReadAccess]) }
 }
 
-// read entire contents of HEALPix file
-func read_hpxfile(url: URL) -> HpxFile? {
+// approximate CDF from sketch of converted map values (see rawmap.h for error bounds)
+private func sketch2cdf(_ sketch: OpaquePointer?, intervals n: Int = 1<<12) -> [Double]? {
+    guard let sketch = sketch else { return nil }
+    let trace = LoadTrace.begin("sketch2cdf"); defer { LoadTrace.end(trace) }
+    
+    var cdf = [Double](repeating: 0.0, count: n+1)
+    return (rawmap_quantiles(sketch, Int32(n), &cdf) < 1.0) ? cdf : nil
+}
+
+// exact moments from sketch of converted map values
+private func sketch2moments(_ sketch: OpaquePointer?) -> Moments? {
+    guard let sketch = sketch else { return nil }
+    let trace = LoadTrace.begin("sketch2moments"); defer { LoadTrace.end(trace) }
+    
+    var stats = rawmap_stats(); rawmap_statistics(sketch, &stats); guard stats.finite > 0 else { return nil }
+    
+    return Moments(finite: stats.finite, nan: stats.nan, bad: stats.bad, mean: stats.mean, m2: stats.m2, m3: stats.m3, m4: stats.m4)
+}
+
+// read entire contents of HEALPix file (mapping uncompressed table in, streaming it in chunks, or reading it all at once),
+// publishing coarse preview of maps as data gets loaded if progress callback is specified
+func read_hpxfile(url: URL, mapping: Bool = true, streaming: Bool = true, progress: LoadProgress? = nil) -> HpxFile? {
     guard url.isFileURL else { return nil }
     let file = url.path, name = url.lastPathComponent
     
+    // whole load is traced, with stage summary reported at the end
+    let trace = LoadTrace.begin("load \(name)")
+    defer { LoadTrace.end(trace, bytes: (try? FileManager.default.attributesOfItem(atPath: file)[.size] as? Int) ?? 0); LoadTrace.report(since: trace) }
+    
     var fptr: UnsafeMutablePointer<fitsfile>? = nil
     var header: UnsafeMutablePointer<CChar>? = nil
     var hdu: Int32 = 0, nkeys: Int32 = 0, status: Int32 = 0
@@ -460,12 +962,14 @@ func read_hpxfile(url: URL) -> HpxFile? {
     }
     
     // open FITS file and move to first table HDU
+    let opening = LoadTrace.begin("open and parse header")
     fftopn(&fptr, file, READONLY, &status)
     guard (status == 0) else { return nil }
     
     // check the number of the current HDU (should not be primary)
     ffghdn(fptr, &hdu)
     guard (hdu > 1) else { return nil }
+    let table = Int(hdu)
     
     // check the type of the current HDU (should be BINARY_TBL)
     ffghdt(fptr, &hdu, &status)
@@ -489,12 +993,55 @@ func read_hpxfile(url: URL) -> HpxFile? {
     
     // process metadata for all maps
     var metadata = (1...nmaps).map { MapCard.parse(fptr, map: $0) }
+    LoadTrace.end(opening, bytes: strlen(header))
     
     // maps contained in the file (we will own their UnsafeBuffers!)
     let type = read_format(fptr, metadata: metadata)
-    var maps = [CpuMap](); maps.reserveCapacity(nmaps)
+    let threads = Int32(CpuThreads.value.count)
+    rawmap_threads(threads); ranking_threads(threads); pyramid_threads(threads)
+    var maps = [Map](); maps.reserveCapacity(nmaps)
     var list = [MapData](); list.reserveCapacity(nmaps)
     
+    // sketch distribution of map values while converting them (for approximate CDF)
+    let sketches = (0..<nmaps).map { _ in make_sketch() }; var sketch = sketches
+    defer { for s in sketches { free_sketch(s) } }
+    
+    // map name and unit from metadata
+    func label(_ m: Int) -> (name: String, unit: String) {
+        var desc = "CHANNEL \(m)"; if let t = metadata[m]?[.type], case let .string(s) = t { desc = s }
+        var unit = "UNKNOWN";      if let u = metadata[m]?[.unit], case let .string(s) = u { unit = s }
+        
+        return (desc, unit)
+    }
+    
+    // coarse preview of maps being loaded (first column of indexed map is pixel index)
+    let indexed = (card[.indexing] == .string("EXPLICIT") || card[.indexing] == .string("PARTIAL")) ? 1 : 0
+    let preview = progress.map { callback in
+        var coarse = [MapData]()
+        
+        return Preview(nside: nside, nmaps: nmaps-indexed) { fraction, maps in
+            if (coarse.isEmpty) {
+                coarse = maps.enumerated().map { m, map in
+                    let (desc, unit) = label(m+indexed)
+                    return MapData(file: name, info: info, parsed: card, name: desc, unit: unit, channel: m, data: map)
+                }
+            }
+            
+            callback(fraction, coarse, maps)
+        }
+    }
+    
+    // maps converted earlier are mapped in from cache, if all of them are there
+    let keys = mapCache.keys(url: url, hdu: table, columns: (indexed+1)..<(nmaps+1))
+    let lookup = LoadTrace.begin("cache load"); let cached = mapCache.load(keys, nside: nside)
+    LoadTrace.end(lookup, bytes: (cached ?? []).reduce(0) { $0 + (($1 as? SparseMap)?.layout.size ?? $1.npix)*MemoryLayout<Float>.size })
+    
+    // cached maps (already in canonical format)
+    if let cached = cached {
+        print("Cached sky map (nside = \(nside), nmaps = \(nmaps-indexed))")
+        
+        maps = cached; metadata.removeFirst(indexed); sketch.removeFirst(indexed); nmaps -= indexed
+    } else
     // full sky map (without pixel index)
     if card[.indexing] == .string("IMPLICIT") || card[.indexing] == .string("FULLSKY") {
         if let object = card[.object] { guard object == .string("FULLSKY") else { return nil } }
@@ -505,15 +1052,35 @@ func read_hpxfile(url: URL) -> HpxFile? {
         // diagnostic output
         print("Full sky map (nside = \(nside), nmaps = \(nmaps), \(order) ordering), \(npix) pixels")
         
-        // read in raw HEALPix data (we own these UnsafeBuffers!)
-        guard let data = read_table(fptr, npix: npix, nmaps: nmaps, nrows: nrows, type: type) else { return nil }
-        defer { for p in data { p.deallocate() } }
-        
-        // convert to canonical map format
-        for m in 0..<nmaps {
-            let flip = iau && (MapCard.type(metadata[m]?[.type]) == .u)
+        // map uncompressed HEALPix data in, converting it to canonical map format in place
+        if mapping, let table = MappedTable(fptr, file: file, nmaps: nmaps, nrows: nrows, npix: npix, sequential: order == NESTED) {
+            for m in 0..<nmaps {
+                let flip = iau && (MapCard.type(metadata[m]?[.type]) == .u)
+                
+                if let c = fits2map(table, column: m, nside: nside, order: order, flip: flip, sketch: sketch[m]) { maps.append(c) } else { return nil }
+                
+                preview?.add(m, maps[m].ptr, first: 0, count: npix); preview?.update(Double(m+1)/Double(nmaps))
+            }
+        } else
+        // stream raw HEALPix data straight into canonical map format
+        if (streaming) {
+            let flip = (0..<nmaps).map { iau && (MapCard.type(metadata[$0]?[.type]) == .u) }
             
-            if let c = raw2map(data[m], nside: nside, type: type[m], order: order, flip: flip) { maps.append(c) } else { return nil }
+            let trace = LoadTrace.begin("stream_fullsky"); defer { LoadTrace.end(trace, bytes: npix*type.reduce(0) { $0 + (sizeof[$1] ?? 0) }) }
+            if let c = stream_fullsky(fptr, nside: nside, nmaps: nmaps, nrows: nrows, type: type, order: order, flip: flip, sketch: sketch, preview: preview) { maps = c } else { return nil }
+        } else {
+            // read in raw HEALPix data (we own these UnsafeBuffers!)
+            guard let data = read_table(fptr, npix: npix, nmaps: nmaps, nrows: nrows, type: type) else { return nil }
+            defer { for p in data { p.deallocate() } }
+            
+            // convert to canonical map format
+            for m in 0..<nmaps {
+                let flip = iau && (MapCard.type(metadata[m]?[.type]) == .u)
+                
+                if let c = raw2map(data[m], nside: nside, type: type[m], order: order, flip: flip, sketch: sketch[m]) { maps.append(c) } else { return nil }
+                
+                preview?.add(m, maps[m].ptr, first: 0, count: npix); preview?.update(Double(m+1)/Double(nmaps))
+            }
         }
     }
     else
@@ -526,33 +1093,62 @@ func read_hpxfile(url: URL) -> HpxFile? {
         // diagnostic output
         print("Indexed sky map (nside = \(nside), nmaps = \(nmaps-1), \(order) ordering), \(nobs) pixels")
         
-        // read in raw HEALPix data (we own these UnsafeBuffers!)
-        guard let data = read_table(fptr, npix: nobs, nmaps: nmaps, nrows: nrows, type: type) else { return nil }
-        defer { for p in data { p.deallocate() } }
-        
-        // reindex pixels to canonical ordering (we own this UnsafeBuffer!)
-        guard let idx = reindex(data[0], nobs: nobs, nside: nside, type: type[0], order: order) else { return nil }
-        defer { idx.deallocate() }
-        
-        // convert to canonical map format
-        for m in 1..<nmaps {
-            let flip = iau && (MapCard.type(metadata[m]?[.type]) == .u)
+        // stream raw HEALPix data, scattering it into canonical map format
+        if (streaming) {
+            let flip = (0..<nmaps).map { iau && (MapCard.type(metadata[$0]?[.type]) == .u) }
+            
+            let sparse = read_sparse(fptr, nobs: nobs, nside: nside, nrows: nrows, type: type[0], order: order)
+            
+            let trace = LoadTrace.begin("stream_indexed"); defer { LoadTrace.end(trace, bytes: nobs*type.reduce(0) { $0 + (sizeof[$1] ?? 0) }) }
+            if let c = stream_indexed(fptr, nobs: nobs, nside: nside, nmaps: nmaps, nrows: nrows, type: type, order: order, flip: flip, sketch: sketch, sparse: sparse, preview: preview) { maps = c } else { return nil }
+        } else {
+            // read in raw HEALPix data (we own these UnsafeBuffers!)
+            guard let data = read_table(fptr, npix: nobs, nmaps: nmaps, nrows: nrows, type: type) else { return nil }
+            defer { for p in data { p.deallocate() } }
             
-            if let c = idx2map(idx, data[m], nobs: nobs, nside: nside, type: type[m], flip: flip) { maps.append(c) } else { return nil }
+            // reindex pixels to canonical ordering (we own this UnsafeBuffer, unless sparse index takes it over!)
+            guard let idx = reindex(data[0], nobs: nobs, nside: nside, type: type[0], order: order) else { return nil }
+            let sparse = (Double(nobs) < sparseCoverage*Double(12*nside*nside)) ? SparseIndex(nside: nside, idx: idx, nobs: nobs) : nil
+            defer { if (sparse == nil) { idx.deallocate() } }
+            
+            // convert to canonical map format (or sparse storage)
+            for m in 1..<nmaps {
+                let flip = iau && (MapCard.type(metadata[m]?[.type]) == .u)
+                
+                if let sparse = sparse {
+                    guard let c = idx2map(sparse, data[m], nside: nside, type: type[m], flip: flip, sketch: sketch[m]) else { return nil }
+                    maps.append(c); preview?.add(m-1, c.store, idx: idx, pos: sparse.pos, count: nobs)
+                } else {
+                    guard let c = idx2map(idx, data[m], nobs: nobs, nside: nside, type: type[m], flip: flip, sketch: sketch[m]) else { return nil }
+                    maps.append(c); preview?.add(m-1, c.ptr, idx: idx, count: nobs)
+                }
+                
+                preview?.update(Double(m)/Double(nmaps-1))
+            }
         }
         
-        metadata.removeFirst(); nmaps -= 1
+        metadata.removeFirst(); sketch.removeFirst(); nmaps -= 1
     } else { return nil }
     
+    // approximate CDF and exact moments right away, exact CDF is computed when map gets indexed
+    if (cached == nil) {
+        for m in 0..<nmaps {
+            maps[m].cdf = sketch2cdf(sketch[m])
+            maps[m].moments = sketch2moments(sketch[m])
+        }
+        
+        let trace = LoadTrace.begin("cache store"); mapCache.store(maps, keys); LoadTrace.end(trace)
+    }
+    
     // index named data channels
     var index = [DataSource: Int]()
     
     for m in 0..<nmaps {
         if let t = metadata[m]?[.type], let type = MapCard.type(t) { index[type] = m }
-        var desc = "CHANNEL \(m)"; if let t = metadata[m]?[.type], case let .string(s) = t { desc = s }
-        var unit = "UNKNOWN";      if let u = metadata[m]?[.unit], case let .string(s) = u { unit = s }
+        let (desc, unit) = label(m)
         
-        list.append(MapData(file: name, info: info, parsed: card, name: desc, unit: unit, channel: m, data: maps[m]))
+        let data = MapData(file: name, info: info, parsed: card, name: desc, unit: unit, channel: m, data: maps[m])
+        data.cache = keys?[m]; list.append(data)
     }
     
     return HpxFile(url: url, name: name, nmaps: nmaps, header: info, parsed: card, data: maps, list: list, metadata: metadata, channel: index)
@@ -0,0 +1,98 @@
+//
+//  Harmonics.swift
+//  HEALPix Viewer
+//
+//  Created by Andrei Frolov on 2026-10-17.
+//
+
+import Foundation
+
+// spherical harmonic coefficients a_lm of a map (see sht.h)
+final class Harmonics {
+    let lmax: Int
+    let mmax: Int
+    
+    // coefficients stored as interleaved complex doubles, in healpy order
+    let ptr: UnsafeMutablePointer<Double>
+    var count: Int { sht_alm_size(Int32(lmax), Int32(mmax)) }
+    
+    // default band limit for a map (as in HEALPix)
+    static func lmax(nside: Int) -> Int { 3*nside - 1 }
+    
+    // transform map, refining quadrature with Jacobi iterations
+    init?(_ map: Map, lmax: Int? = nil, mmax: Int? = nil, iterations: Int = 3) {
+        let trace = LoadTrace.begin("map2alm"); defer { LoadTrace.end(trace, bytes: map.size) }
+        
+        self.lmax = lmax ?? Harmonics.lmax(nside: map.nside); self.mmax = Swift.min(mmax ?? self.lmax, self.lmax)
+        ptr = UnsafeMutablePointer<Double>.allocate(capacity: 2*sht_alm_size(Int32(self.lmax), Int32(self.mmax)))
+        
+        sht_threads(Int32(CpuThreads.value.count))
+        guard sht_map2alm(map.ptr, map.nside, Int32(self.lmax), Int32(self.mmax), Int32(iterations), ptr) == 0 else { ptr.deallocate(); return nil }
+    }
+    
+    // clean up on deinitialization
+    deinit { ptr.deallocate() }
+    
+    // coefficient a_lm for m >= 0 (a_l,-m is (-1)^m times its conjugate)
+    subscript(l: Int, m: Int) -> (re: Double, im: Double) {
+        let i = 2*sht_alm_index(Int32(lmax), Int32(l), Int32(m))
+        return (ptr[i], ptr[i+1])
+    }
+    
+    // angular power spectrum C_l
+    var spectrum: [Double] {
+        var cl = [Double](repeating: 0.0, count: lmax+1)
+        sht_alm2cl(ptr, Int32(lmax), Int32(mmax), &cl); return cl
+    }
+    
+    // multiply coefficients by filter f_l (missing entries are taken as zero)
+    func filter(_ fl: [Double]) {
+        let fl = (0...lmax).map { $0 < fl.count ? fl[$0] : 0.0 }
+        sht_almxfl(ptr, Int32(lmax), Int32(mmax), fl)
+    }
+    
+    // multiply coefficients by Gaussian beam of specified FWHM (in radians)
+    func smooth(fwhm: Double) {
+        var bl = [Double](repeating: 0.0, count: lmax+1)
+        sht_gaussian_beam(fwhm, Int32(lmax), &bl); sht_almxfl(ptr, Int32(lmax), Int32(mmax), bl)
+    }
+    
+    // synthesize map at resolution nside
+    func map(nside: Int) -> CpuMap? {
+        let trace = LoadTrace.begin("alm2map"); defer { LoadTrace.end(trace, bytes: 12*nside*nside*MemoryLayout<Float>.size) }
+        let output = UnsafeMutablePointer<Float>.allocate(capacity: 12*nside*nside); var minval = 0.0, maxval = 0.0
+        
+        sht_threads(Int32(CpuThreads.value.count))
+        guard sht_alm2map(ptr, Int32(lmax), Int32(mmax), output, nside, &minval, &maxval) == 0 else { output.deallocate(); return nil }
+        
+        return CpuMap(nside: nside, buffer: output, min: minval, max: maxval)
+    }
+}
+
+// harmonic space operations on maps
+extension Map {
+    // angular power spectrum C_l up to lmax
+    func spectrum(lmax: Int? = nil, iterations: Int = 3) -> [Double]? {
+        Harmonics(self, lmax: lmax, iterations: iterations)?.spectrum
+    }
+    
+    // map filtered by f_l in harmonic space (missing pixels stay missing)
+    func filtered(_ fl: [Double], lmax: Int? = nil, iterations: Int = 3) -> CpuMap? {
+        let trace = LoadTrace.begin("sht_filter"); defer { LoadTrace.end(trace, bytes: size) }
+        let lmax = lmax ?? Harmonics.lmax(nside: nside), fl = (0...lmax).map { $0 < fl.count ? fl[$0] : 0.0 }
+        let output = UnsafeMutablePointer<Float>.allocate(capacity: npix); var minval = 0.0, maxval = 0.0
+        
+        sht_threads(Int32(CpuThreads.value.count))
+        guard sht_filter(ptr, nside, Int32(lmax), Int32(iterations), fl, output, &minval, &maxval) == 0 else { output.deallocate(); return nil }
+        
+        return CpuMap(nside: nside, buffer: output, min: minval, max: maxval)
+    }
+    
+    // map smoothed by Gaussian beam of specified FWHM (in radians)
+    func smoothed(fwhm: Double, lmax: Int? = nil, iterations: Int = 3) -> CpuMap? {
+        let lmax = lmax ?? Harmonics.lmax(nside: nside)
+        var bl = [Double](repeating: 0.0, count: lmax+1); sht_gaussian_beam(fwhm, Int32(lmax), &bl)
+        
+        return filtered(bl, lmax: lmax, iterations: iterations)
+    }
+}
@@ -28,9 +28,11 @@ protocol Map {
     var copy: Self { get }
     
     // data indexing
-    var idx: UnsafeBufferPointer<Int32> { get }
-    var cdf: [Double]? { get }
+    var idx: MapIndex { get }
+    var cdf: [Double]? { get set }
+    var moments: Moments? { get set }
     func index()
+    func ranked() -> CpuMap
 }
 
 extension Map {
@@ -38,19 +40,28 @@ extension Map {
     var npix: Int { return 12*nside*nside }
     var size: Int { npix * MemoryLayout<Float>.size }
     
-    // create index of map values (32-bit for performance, good to nside = 8192)
-    func makeidx() -> UnsafeBufferPointer<Int32> {
-        let idx = UnsafeMutablePointer<Int32>.allocate(capacity: npix)
-        var nobs: Int32 = 0; index_map(ptr, Int32(npix), idx, &nobs)
-        return UnsafeBufferPointer(start: idx, count: Int(nobs))
+    // create index of map values (32-bit for performance up to nside = 8192, 64-bit beyond)
+    func makeidx() -> MapIndex {
+        let trace = LoadTrace.begin("makeidx"); defer { LoadTrace.end(trace, bytes: size) }
+        
+        if (npix <= Int(Int32.max)) {
+            let idx = UnsafeMutablePointer<Int32>.allocate(capacity: npix)
+            var nobs: Int32 = 0; index_map(ptr, Int32(npix), idx, &nobs)
+            return .int32(UnsafeBufferPointer(start: idx, count: Int(nobs)))
+        } else {
+            let idx = UnsafeMutablePointer<Int>.allocate(capacity: npix)
+            var nobs: Int = 0; index_map64(ptr, npix, idx, &nobs)
+            return .int64(UnsafeBufferPointer(start: idx, count: nobs))
+        }
     }
     
     // decimate index to produce light-weight CDF representation
     func makecdf(intervals n: Int) -> [Double]? {
+        let trace = LoadTrace.begin("makecdf"); defer { LoadTrace.end(trace) }
         var cdf = [Double](); cdf.reserveCapacity(n+1)
         
         for i in stride(from: 0, through: idx.count, by: Swift.max(idx.count/n,1)) {
-            let j = Swift.min(i,idx.count-1), x = (ptr + Int(idx[j])).pointee
+            let j = Swift.min(i,idx.count-1), x = (ptr + idx[j]).pointee
             if (x.isFinite) { cdf.append(Double(x)) }
         }
         
@@ -59,13 +70,79 @@ extension Map {
     
     // ranked map (i.e. PDF equalization)
     func ranked() -> CpuMap {
+        let trace = LoadTrace.begin("rank_map"); defer { LoadTrace.end(trace, bytes: size) }
         let ranked = UnsafeMutablePointer<Float>.allocate(capacity: npix)
         ranked.initialize(repeating: .nan, count: npix)
-        rank_map(ptr, idx.baseAddress, Int32(idx.count), ranked)
+        switch idx {
+            case .int32(let idx): rank_map(ptr, idx.baseAddress, Int32(idx.count), ranked)
+            case .int64(let idx): rank_map64(ptr, idx.baseAddress, idx.count, ranked)
+        }
+        return CpuMap(nside: nside, buffer: ranked, min: 0.0, max: 1.0)
+    }
+    
+    // approximate ranked map, interpolated in CDF (stands in until map gets indexed)
+    func ranked(cdf: [Double]) -> CpuMap? {
+        guard cdf.count > 1 else { return nil }
+        let trace = LoadTrace.begin("rank_cdf"); defer { LoadTrace.end(trace, bytes: size) }
+        let ranked = UnsafeMutablePointer<Float>.allocate(capacity: npix)
+        rank_cdf(ptr, npix, cdf, Int32(cdf.count-1), ranked)
         return CpuMap(nside: nside, buffer: ranked, min: 0.0, max: 1.0)
     }
 }
 
+// index of map values, sorted in ascending order (pixels with non-finite values are left out)
+enum MapIndex {
+    case int32(UnsafeBufferPointer<Int32>)
+    case int64(UnsafeBufferPointer<Int>)
+    
+    // number of indexed pixels
+    var count: Int {
+        switch self {
+            case .int32(let idx): return idx.count
+            case .int64(let idx): return idx.count
+        }
+    }
+    
+    // pixel of k-th smallest map value
+    subscript(k: Int) -> Int {
+        switch self {
+            case .int32(let idx): return Int(idx[k])
+            case .int64(let idx): return idx[k]
+        }
+    }
+    
+    // release index storage
+    func deallocate() {
+        switch self {
+            case .int32(let idx): idx.deallocate()
+            case .int64(let idx): idx.deallocate()
+        }
+    }
+}
+
+// multi-resolution representation of a map, degraded down to nside = 1
+final class MapPyramid {
+    // degraded maps, nside is halved with each level
+    let levels: [CpuMap]
+    
+    // build all levels of a NESTED map in a single pass (there are no levels if that failed,
+    // so that requests are served at full resolution)
+    init(_ map: Map) {
+        let n = map.nside.trailingZeroBitCount
+        var out = (0..<n).map { k -> UnsafeMutablePointer<Float>? in let nside = map.nside >> (k+1); return .allocate(capacity: 12*nside*nside) }
+        var min = [Double](repeating: 0.0, count: n), max = [Double](repeating: 0.0, count: n)
+        
+        guard pyramid_build(map.ptr, map.nside, &out, &min, &max) == 0 else { for p in out { p?.deallocate() }; levels = []; return }
+        levels = (0..<n).map { k in CpuMap(nside: map.nside >> (k+1), buffer: out[k]!, min: min[k], max: max[k]) }
+    }
+    
+    // coarsest level at or above requested resolution (nil if it is finer than any level)
+    subscript(nside nside: Int) -> CpuMap? { levels.last(where: { $0.nside >= nside }) }
+    
+    // coarsest level having at least requested number of pixels (e.g. to fill a thumbnail)
+    subscript(npix npix: Int) -> CpuMap? { levels.last(where: { $0.npix >= npix }) }
+}
+
 // HEALPix map texture array
 func HPXTexture(nside: Int, format: MTLPixelFormat? = nil, mipmapped: Bool = true) -> MTLTexture {
     // texture format
@@ -109,9 +186,10 @@ final class BaseMap: Map {
     let min: Double
     let max: Double
     var cdf: [Double]? = nil
+    var moments: Moments? = nil
     
     // data representations
-    lazy var idx: UnsafeBufferPointer<Int32> = { indexed = true; return makeidx() }()
+    lazy var idx: MapIndex = { indexed = true; return makeidx() }()
     lazy var ptr: UnsafePointer<Float> = { data.withUnsafeBufferPointer { $0.baseAddress! } }()
     
     // Metal buffer containing map data
@@ -152,10 +230,12 @@ final class CpuMap: Map {
     let min: Double
     let max: Double
     var cdf: [Double]? = nil
+    var moments: Moments? = nil
     
     // data representations
-    lazy var idx: UnsafeBufferPointer<Int32> = { indexed = true; return makeidx() }()
+    lazy var idx: MapIndex = { indexed = true; return makeidx() }()
     lazy var data: [Float] = { Array(UnsafeBufferPointer(start: ptr, count: npix)) }()
+    lazy var pyramid: MapPyramid = { MapPyramid(self) }()
     
     // Metal buffer containing map data
     lazy var buffer: MTLBuffer = {
@@ -174,6 +254,12 @@ final class CpuMap: Map {
         self.max = max
     }
     
+    // initialize map from cache entry mapped into memory
+    convenience init(nside: Int, mapped region: MappedRegion, offset: Int, min: Double, max: Double) {
+        self.init(nside: nside, buffer: (region.base + offset).assumingMemoryBound(to: Float.self), min: min, max: max)
+        self.mapped = [region]; self.owned = false
+    }
+    
     // map copy
     var copy: Self {
         let copy = UnsafeMutablePointer<Float>.allocate(capacity: npix)
@@ -181,12 +267,180 @@ final class CpuMap: Map {
         return Self(nside: nside, buffer: copy, min: min, max: max)
     }
     
-    // clean up on deinitialization (we own passed pointer)
-    private var indexed = false
-    deinit { ptr.deallocate(); if indexed { idx.deallocate() } }
+    // attach sorted index of map values from cache entry mapped into memory (unless map is already indexed)
+    func attach(index region: MappedRegion, offset: Int, count: Int) {
+        guard !indexed else { return }
+        let base = region.base + offset; mapped.append(region)
+        
+        if (npix <= Int(Int32.max)) { idx = .int32(UnsafeBufferPointer(start: base.assumingMemoryBound(to: Int32.self), count: count)) }
+        else { idx = .int64(UnsafeBufferPointer(start: base.assumingMemoryBound(to: Int.self), count: count)) }
+    }
+    
+    // clean up on deinitialization (we own passed pointer, unless it is mapped in from cache; attached index is always mapped)
+    private var indexed = false, owned = true, mapped = [MappedRegion]()
+    deinit { if owned { ptr.deallocate() }; if indexed { idx.deallocate() } }
     
     // index map (i.e. compute CDF)
     func index() { cdf = makecdf(intervals: 1<<12) }
+    
+    // map degraded to requested resolution (served from cached pyramid)
+    func degraded(nside: Int) -> CpuMap { (nside < self.nside) ? (pyramid[nside: nside] ?? self) : self }
+    
+    // average of finite map values over NESTED pixel p at lower resolution nside
+    func average(_ p: Int, nside: Int) -> Double { Double(degraded(nside: nside).ptr[p]) }
+}
+
+// storage layout shared by sparse maps read from the same file
+final class SparseLayout {
+    let ptr: UnsafeMutablePointer<sparse_layout>
+    
+    // layout covering observed NESTED pixels
+    init?(nside: Int, idx: UnsafePointer<Int>, nobs: Int) {
+        guard let layout = make_sparse_layout(nside, idx, nobs) else { return nil }
+        self.ptr = layout
+    }
+    
+    // layout storing given tiles (e.g. table of stored tiles read from cache)
+    init?(nside: Int, tiles: UnsafePointer<Int>, count: Int) {
+        guard let layout = make_sparse_layout_tiles(nside, tiles, count) else { return nil }
+        self.ptr = layout
+    }
+    
+    deinit { free_sparse_layout(ptr) }
+    
+    // size of map data stored in layout
+    var size: Int { sparse_size(ptr) }
+    
+    // table of stored tiles
+    var tiles: UnsafeBufferPointer<Int> { UnsafeBufferPointer(start: ptr.pointee.tile, count: ptr.pointee.filled) }
+    
+    // check if layout stores the same tiles
+    func stores(_ tiles: UnsafePointer<Int>, count: Int) -> Bool {
+        count == ptr.pointee.filled && memcmp(ptr.pointee.tile, tiles, count*MemoryLayout<Int>.size) == 0
+    }
+}
+
+// HEALPix map representation for partial sky coverage, storing observed tiles only
+final class SparseMap: Map {
+    // primary data
+    let nside: Int
+    let layout: SparseLayout
+    let store: UnsafePointer<Float>
+    
+    // data bounds
+    let min: Double
+    let max: Double
+    var cdf: [Double]? = nil
+    var moments: Moments? = nil
+    
+    // data representations (full sky map is materialized on demand only)
+    lazy var idx: MapIndex = { indexed = true; return makeidx() }()
+    lazy var ptr: UnsafePointer<Float> = { expanded = true; return UnsafePointer(expand()) }()
+    lazy var data: [Float] = { Array(UnsafeBufferPointer(start: ptr, count: npix)) }()
+    
+    // Metal buffer containing map data (expanded in place)
+    lazy var buffer: MTLBuffer = {
+        guard let buffer = metal.device.makeBuffer(length: size)
+              else { fatalError("Could not allocate map buffer") }
+        
+        sparse_expand(layout.ptr, store, buffer.contents().bindMemory(to: Float.self, capacity: npix))
+        return buffer
+    }()
+    
+    // initialize map from stored data buffer
+    init(nside: Int, layout: SparseLayout, buffer: UnsafePointer<Float>, min: Double, max: Double) {
+        self.nside = nside
+        self.layout = layout
+        self.store = buffer
+        
+        self.min = min
+        self.max = max
+    }
+    
+    // initialize map from cache entry mapped into memory
+    convenience init(nside: Int, layout: SparseLayout, mapped region: MappedRegion, offset: Int, min: Double, max: Double) {
+        self.init(nside: nside, layout: layout, buffer: (region.base + offset).assumingMemoryBound(to: Float.self), min: min, max: max)
+        self.mapped = [region]; self.owned = false
+    }
+    
+    // map copy
+    var copy: Self {
+        let copy = UnsafeMutablePointer<Float>.allocate(capacity: layout.size)
+        copy.initialize(from: store, count: layout.size)
+        return Self(nside: nside, layout: layout, buffer: copy, min: min, max: max)
+    }
+    
+    // attach sorted index of map values from cache entry mapped into memory (unless map is already indexed)
+    func attach(index region: MappedRegion, offset: Int, count: Int) {
+        guard !indexed else { return }
+        let base = region.base + offset; mapped.append(region)
+        
+        if (npix <= Int(Int32.max)) { idx = .int32(UnsafeBufferPointer(start: base.assumingMemoryBound(to: Int32.self), count: count)) }
+        else { idx = .int64(UnsafeBufferPointer(start: base.assumingMemoryBound(to: Int.self), count: count)) }
+    }
+    
+    // clean up on deinitialization (we own passed pointer, unless it is mapped in from cache; attached index is always mapped)
+    private var indexed = false, expanded = false, owned = true, mapped = [MappedRegion]()
+    deinit { if owned { store.deallocate() }; if expanded { ptr.deallocate() }; if indexed { idx.deallocate() } }
+    
+    // map value at NESTED pixel p
+    subscript(p: Int) -> Float { sparse_value(layout.ptr, store, p) }
+    
+    // expand stored data into full sky map (caller owns returned buffer)
+    func expand() -> UnsafeMutablePointer<Float> {
+        let output = UnsafeMutablePointer<Float>.allocate(capacity: npix)
+        sparse_expand(layout.ptr, store, output); return output
+    }
+    
+    // create index of map values, sorting stored data and translating positions to pixels
+    func makeidx() -> MapIndex {
+        let trace = LoadTrace.begin("makeidx (sparse)"); defer { LoadTrace.end(trace, bytes: layout.size*MemoryLayout<Float>.size) }
+        
+        if (npix <= Int(Int32.max)) {
+            let idx = UnsafeMutablePointer<Int32>.allocate(capacity: layout.size)
+            var nobs: Int32 = 0; index_map(store, Int32(layout.size), idx, &nobs)
+            sparse_unpack32(layout.ptr, idx, idx, Int(nobs))
+            return .int32(UnsafeBufferPointer(start: idx, count: Int(nobs)))
+        } else {
+            let idx = UnsafeMutablePointer<Int>.allocate(capacity: layout.size)
+            var nobs: Int = 0; index_map64(store, layout.size, idx, &nobs)
+            sparse_unpack(layout.ptr, idx, idx, nobs)
+            return .int64(UnsafeBufferPointer(start: idx, count: nobs))
+        }
+    }
+    
+    // index map (i.e. compute CDF), looking values up in stored data
+    func index() {
+        let trace = LoadTrace.begin("makecdf (sparse)"); defer { LoadTrace.end(trace) }
+        var cdf = [Double](); let n = 1<<12; cdf.reserveCapacity(n+1)
+        
+        for i in stride(from: 0, through: idx.count, by: Swift.max(idx.count/n,1)) {
+            let x = self[idx[Swift.min(i,idx.count-1)]]
+            if (x.isFinite) { cdf.append(Double(x)) }
+        }
+        
+        self.cdf = cdf
+    }
+    
+    // ranked map, equalized in stored layout and expanded
+    func ranked() -> CpuMap {
+        let ranked = UnsafeMutablePointer<Float>.allocate(capacity: layout.size)
+        ranked.initialize(repeating: .nan, count: layout.size)
+        defer { ranked.deallocate() }
+        
+        switch idx {
+            case .int32(let idx):
+                let pos = UnsafeMutablePointer<Int32>.allocate(capacity: idx.count); defer { pos.deallocate() }
+                sparse_pack32(layout.ptr, idx.baseAddress, pos, idx.count); rank_map(store, pos, Int32(idx.count), ranked)
+            case .int64(let idx):
+                let pos = UnsafeMutablePointer<Int>.allocate(capacity: idx.count); defer { pos.deallocate() }
+                sparse_pack(layout.ptr, idx.baseAddress, pos, idx.count); rank_map64(store, pos, idx.count, ranked)
+        }
+        
+        let output = UnsafeMutablePointer<Float>.allocate(capacity: npix)
+        sparse_expand(layout.ptr, ranked, output)
+        return CpuMap(nside: nside, buffer: output, min: 0.0, max: 1.0)
+    }
 }
 
 // HEALPix map representation, based on GPU-side data
@@ -199,11 +453,12 @@ final class GpuMap: Map {
     var min: Double
     var max: Double
     var cdf: [Double]? = nil
+    var moments: Moments? = nil
     
     // data representations
     lazy var ptr: UnsafePointer<Float> = { UnsafePointer(buffer.contents().bindMemory(to: Float.self, capacity: npix)) }()
     lazy var data: [Float] = { Array(UnsafeBufferPointer(start: ptr, count: npix)) }()
-    lazy var idx: UnsafeBufferPointer<Int32> = { indexed = true; return makeidx() }()
+    lazy var idx: MapIndex = { indexed = true; return makeidx() }()
     
     // initialize map from buffer
     init(nside: Int, buffer: MTLBuffer, min: Double, max: Double) {
@@ -241,10 +496,14 @@ final class MapData: Identifiable, ObservableObject {
     let channel: Int
     
     // map data and caches
-    let data: Map
+    private(set) var data: Map
     var ranked: CpuMap? = nil
+    var estimate: CpuMap? = nil     // approximate ranks, shown until map gets indexed
     var buffer: GpuMap? = nil
     
+    // on-disk cache entry of map data
+    var cache: CacheKey? = nil
+    
     // analysis state
     var analyzed = false
     
@@ -252,7 +511,7 @@ final class MapData: Identifiable, ObservableObject {
     subscript(f: Function) -> Map? {
         switch f {
             case .none: return data
-            case .equalize: return ranked
+            case .equalize: return ranked ?? estimate
             default: return buffer
         }
     }
@@ -301,6 +560,11 @@ final class MapData: Identifiable, ObservableObject {
     var snapshot: Self { Self(file: file, info: info, parsed: card, name: transform.annotate(name), unit: unit, channel: channel, data: available.copy) }
     var duplicate: Self { Self(file: file, info: info, parsed: card, name: name, unit: unit, channel: channel, data: data, ranked: ranked) }
     
+    // replace data of coarse preview shown while map is being loaded
+    func update(_ map: Map) {
+        data = map; ranked = nil; estimate = nil; state = MapState()
+    }
+    
     // signal that map state changed
     func refresh() { self.objectWillChange.send() }
 }
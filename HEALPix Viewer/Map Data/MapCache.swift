@@ -0,0 +1,338 @@
+//
+//  MapCache.swift
+//  HEALPix Viewer
+//
+//  Created by Andrei Frolov on 2026-10-17.
+//
+
+import Foundation
+
+// on-disk cache of converted maps: canonical NESTED data of each column is written out
+// along with its bounds, moments and CDF, and is mapped back in when the file is reopened,
+// bypassing FITS decoding, reordering and BAD_DATA masking entirely; partial sky maps are
+// written in their sparse storage layout, followed by the table of stored tiles; sorted
+// index of map values (and exact CDF) is kept in a separate entry, written once the map
+// gets indexed
+let mapCache = MapCache()
+
+// cache entries are written in background
+private let cacheQueue = DispatchQueue(label: "cache", qos: .utility)
+
+// source of cached map: file version and table column
+struct CacheKey: Equatable {
+    let path: String
+    let size: Int
+    let mtime: Double
+    let hdu: Int
+    let column: Int
+    
+    // key serialized into entry header
+    var string: String { "\(path)\n\(size)\n\(mtime)\n\(hdu)\n\(column)" }
+    
+    // entry name (the same for all versions of the file, so that stale entries get replaced)
+    var name: String { String(format: "%016llx-%d-%d", fnv1a(path), hdu, column) }
+}
+
+// 64-bit FNV-1a hash of a string
+private func fnv1a(_ string: String) -> UInt64 {
+    var hash: UInt64 = 0xcbf29ce484222325
+    for byte in string.utf8 { hash = (hash ^ UInt64(byte)) &* 0x100000001b3 }
+    return hash
+}
+
+// read-only file mapped into memory (unmapped when released)
+final class MappedRegion {
+    let base: UnsafeRawPointer
+    let length: Int
+    
+    // map the entire file in
+    init?(path: String) {
+        let fd = open(path, O_RDONLY); guard fd >= 0 else { return nil }
+        defer { close(fd) }
+        
+        var info = stat(); guard fstat(fd, &info) == 0, info.st_size > 0 else { return nil }
+        let length = Int(info.st_size)
+        
+        guard let region = mmap(nil, length, PROT_READ, MAP_PRIVATE, fd, 0),
+              region != UnsafeMutableRawPointer(bitPattern: -1) else { return nil }
+        
+        self.base = UnsafeRawPointer(region)
+        self.length = length
+    }
+    
+    deinit { munmap(UnsafeMutableRawPointer(mutating: base), length) }
+}
+
+// entry header, followed by key (padded to 8 bytes) and trailing doubles, with data starting on page boundary
+// (consecutive data arrays are padded to 8 bytes as well)
+private protocol Entry {
+    static var magic: UInt64 { get }
+    var key: Int { get set }
+    var offset: Int { get set }
+}
+
+// map entry, trailed by CDF
+private struct MapEntry: Entry {
+    static let magic: UInt64 = 0x3330_5041_4d58_5048   // "HPXMAP03"
+    
+    var magic = Self.magic, key = 0, offset = 0
+    var nside = 0, min = 0.0, max = 0.0
+    var finite = 0, nan = 0, bad = 0
+    var moments = SIMD4<Double>()
+    var cdf = 0                             // CDF samples (moments are there if finite > 0)
+    var stored = 0, tiles = 0               // stored pixels and tiles of partial sky map (zero for full sky map)
+}
+
+// size of data array padded to 8 bytes
+private func padded(_ length: Int) -> Int { (length + 7) & ~7 }
+
+// padding bytes
+private let zeros = [UInt8](repeating: 0, count: 8)
+
+// index entry, trailed by exact CDF
+private struct IndexEntry: Entry {
+    static let magic: UInt64 = 0x3130_5844_4958_5048   // "HPXIDX01"
+    
+    var magic = Self.magic, key = 0, offset = 0
+    var count = 0, width = 0, cdf = 0
+}
+
+// cache of converted maps, capped in size and evicting least recently used entries
+final class MapCache {
+    // cache location
+    let directory: URL = {
+        let caches = FileManager.default.urls(for: .cachesDirectory, in: .userDomainMask)[0]
+        return caches.appendingPathComponent(Bundle.main.bundleIdentifier ?? "HEALPix Viewer").appendingPathComponent("Maps")
+    }()
+    
+    // size cap in bytes (zero if cache is disabled)
+    var capacity: Int { CacheSize.value.bytes }
+    
+    // entry locations
+    private func path(_ key: CacheKey, _ ext: String) -> String { directory.appendingPathComponent(key.name).appendingPathExtension(ext).path }
+    
+    // cache keys of table columns in current version of the file (nil if cache is disabled)
+    func keys(url: URL, hdu: Int, columns: Range<Int>) -> [CacheKey]? {
+        guard capacity > 0, let attributes = try? FileManager.default.attributesOfItem(atPath: url.path),
+              let size = attributes[.size] as? Int, let mtime = attributes[.modificationDate] as? Date else { return nil }
+        
+        return columns.map { CacheKey(path: url.path, size: size, mtime: mtime.timeIntervalSinceReferenceDate, hdu: hdu, column: $0) }
+    }
+    
+    // MARK: reading entries
+    
+    // map cached maps in (all or nothing), partial sky maps of the file sharing their layout
+    func load(_ keys: [CacheKey]?, nside: Int) -> [Map]? {
+        guard let keys = keys, keys.count > 0 else { return nil }
+        
+        var maps = [Map](), layout: SparseLayout? = nil; maps.reserveCapacity(keys.count)
+        for key in keys { if let map = load(key, layout: &layout), map.nside == nside { maps.append(map) } else { return nil } }
+        
+        return maps
+    }
+    
+    // map cached map in, attaching cached index if there is one (layout of partial sky map is reused if it stores the same tiles)
+    private func load(_ key: CacheKey, layout: inout SparseLayout?) -> Map? {
+        let file = path(key, "map"); guard let region = MappedRegion(path: file) else { return nil }
+        guard let (header, doubles) = parse(region, key, as: MapEntry.self) else { remove(key); return nil }
+        
+        let npix = 12*header.nside*header.nside, sparse = (header.tiles > 0)
+        guard header.nside > 0, header.stored >= 0, header.stored <= npix, header.tiles >= 0, header.tiles <= npix else { remove(key); return nil }
+        
+        let length = sparse ? padded(header.stored*MemoryLayout<Float>.size) + header.tiles*MemoryLayout<Int>.size : npix*MemoryLayout<Float>.size
+        guard header.offset + length == region.length else { remove(key); return nil }
+        
+        guard header.cdf >= 0, header.cdf <= (header.offset - MemoryLayout<MapEntry>.size)/MemoryLayout<Double>.size else { remove(key); return nil }
+        
+        var map: Map
+        
+        if (sparse) {
+            let tiles = (region.base + header.offset + padded(header.stored*MemoryLayout<Float>.size)).assumingMemoryBound(to: Int.self)
+            if !(layout?.stores(tiles, count: header.tiles) ?? false) { layout = SparseLayout(nside: header.nside, tiles: tiles, count: header.tiles) }
+            guard let layout = layout, layout.size == header.stored else { remove(key); return nil }
+            
+            map = SparseMap(nside: header.nside, layout: layout, mapped: region, offset: header.offset, min: header.min, max: header.max)
+        } else {
+            map = CpuMap(nside: header.nside, mapped: region, offset: header.offset, min: header.min, max: header.max)
+        }
+        
+        if (header.finite > 0) { map.moments = Moments(finite: header.finite, nan: header.nan, bad: header.bad, moments: header.moments) }
+        if (header.cdf > 0) { map.cdf = Array(UnsafeBufferPointer(start: doubles, count: header.cdf)) }
+        
+        // sorted index and exact CDF
+        if let region = MappedRegion(path: path(key, "idx")) {
+            if let (header, doubles) = parse(region, key, as: IndexEntry.self),
+               header.offset + header.count*header.width == region.length, header.count <= npix,
+               header.cdf <= (header.offset - MemoryLayout<IndexEntry>.size)/MemoryLayout<Double>.size,
+               header.width == ((npix <= Int(Int32.max)) ? MemoryLayout<Int32>.size : MemoryLayout<Int>.size) {
+                switch map {
+                    case let map as CpuMap: map.attach(index: region, offset: header.offset, count: header.count)
+                    case let map as SparseMap: map.attach(index: region, offset: header.offset, count: header.count)
+                    default: break
+                }
+                
+                if (header.cdf > 0) { map.cdf = Array(UnsafeBufferPointer(start: doubles, count: header.cdf)) }
+            } else { try? FileManager.default.removeItem(atPath: path(key, "idx")) }
+        }
+        
+        touch(key); return map
+    }
+    
+    // validate entry header and key, returning header and pointer to doubles trailing the key
+    private func parse<T: Entry>(_ region: MappedRegion, _ key: CacheKey, as type: T.Type) -> (T, UnsafePointer<Double>)? {
+        let size = MemoryLayout<T>.size, string = Array(key.string.utf8), padded = (string.count + 7) & ~7
+        guard region.length >= size + padded, region.base.load(as: UInt64.self) == T.magic else { return nil }
+        
+        let header = region.base.load(as: T.self), bytes = region.base + size
+        guard header.key == string.count, memcmp(bytes, string, string.count) == 0,
+              header.offset >= size + padded, header.offset <= region.length else { return nil }
+        
+        return (header, (bytes + padded).assumingMemoryBound(to: Double.self))
+    }
+    
+    // MARK: writing entries
+    
+    // write converted maps out in background
+    func store(_ maps: [Map], _ keys: [CacheKey]?) {
+        guard let keys = keys, keys.count == maps.count else { return }
+        
+        // snapshot of map statistics, taken before analysis gets to update them
+        let entries = maps.map { map -> (MapEntry, [Double]) in
+            var header = MapEntry(); header.nside = map.nside; header.min = map.min; header.max = map.max
+            var trailer = [Double]()
+            
+            if let moments = map.moments {
+                header.finite = moments.finite; header.nan = moments.nan; header.bad = moments.bad
+                header.moments = moments.moments
+            }
+            
+            if let cdf = map.cdf { header.cdf = cdf.count; trailer += cdf }
+            
+            return (header, trailer)
+        }
+        
+        cacheQueue.async { [self] in
+            for ((map, key), (header, trailer)) in zip(zip(maps, keys), entries) {
+                var header = header
+                
+                // partial sky map is written as stored, followed by its table of stored tiles
+                if let map = map as? SparseMap {
+                    let tiles = map.layout.tiles; header.stored = map.layout.size; header.tiles = tiles.count
+                    write(key, "map", header: &header, trailer: trailer, data: [(UnsafeRawPointer(map.store), header.stored*MemoryLayout<Float>.size),
+                                                                                (UnsafeRawPointer(tiles.baseAddress!), tiles.count*MemoryLayout<Int>.size)])
+                } else {
+                    write(key, "map", header: &header, trailer: trailer, data: [(UnsafeRawPointer(map.ptr), map.npix*MemoryLayout<Float>.size)])
+                }
+            }
+            
+            trim()
+        }
+    }
+    
+    // write sorted index and exact CDF of indexed map out in background (unless they are there already)
+    func store(index map: Map, _ key: CacheKey) {
+        guard capacity > 0 else { return }; let cdf = map.cdf ?? []
+        
+        cacheQueue.async { [self] in
+            guard !FileManager.default.fileExists(atPath: path(key, "idx")),
+                  FileManager.default.fileExists(atPath: path(key, "map")) else { return }
+            
+            var header = IndexEntry(), data: UnsafeRawPointer
+            
+            switch map.idx {
+                case .int32(let idx): header.count = idx.count; header.width = MemoryLayout<Int32>.size; data = UnsafeRawPointer(idx.baseAddress!)
+                case .int64(let idx): header.count = idx.count; header.width = MemoryLayout<Int>.size; data = UnsafeRawPointer(idx.baseAddress!)
+            }
+            
+            header.cdf = cdf.count
+            write(key, "idx", header: &header, trailer: cdf, data: [(data, header.count*header.width)])
+            
+            trim()
+        }
+    }
+    
+    // write entry into temporary file and move it into place
+    private func write<T: Entry>(_ key: CacheKey, _ ext: String, header: inout T, trailer: [Double], data: [(UnsafeRawPointer, Int)]) {
+        try? FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+        
+        let string = Array(key.string.utf8), padded = (string.count + 7) & ~7, page = Int(getpagesize())
+        let head = MemoryLayout<T>.size + padded + trailer.count*MemoryLayout<Double>.size
+        header.key = string.count; header.offset = (head + page-1) & ~(page-1)
+        
+        var bytes = Data(capacity: header.offset)
+        withUnsafeBytes(of: &header) { bytes.append(contentsOf: $0) }
+        bytes.append(contentsOf: string); bytes.append(Data(count: padded - string.count))
+        trailer.withUnsafeBytes { bytes.append(contentsOf: $0) }
+        bytes.append(Data(count: header.offset - head))
+        
+        let file = path(key, ext), temp = file + ".tmp"
+        let fd = open(temp, O_WRONLY|O_CREAT|O_TRUNC, 0o644); guard fd >= 0 else { return }
+        
+        var written = bytes.withUnsafeBytes { all(fd, $0.baseAddress!, $0.count) }
+        
+        for (k, (ptr, length)) in data.enumerated() where written {
+            let pad = (k < data.count-1) ? padded(length) - length : 0
+            written = all(fd, ptr, length) && all(fd, zeros, pad)
+        }
+        
+        close(fd)
+        
+        if (written && rename(temp, file) == 0) { return }
+        unlink(temp)
+    }
+    
+    // write all bytes out
+    private func all(_ fd: Int32, _ ptr: UnsafeRawPointer, _ count: Int) -> Bool {
+        var done = 0
+        
+        while (done < count) {
+            let n = Darwin.write(fd, ptr + done, Swift.min(count - done, 1<<30))
+            guard n > 0 else { return false }; done += n
+        }
+        
+        return true
+    }
+    
+    // MARK: eviction and invalidation
+    
+    // mark entries as recently used
+    private func touch(_ key: CacheKey) {
+        let now = [FileAttributeKey.modificationDate: Date()]
+        for ext in ["map", "idx"] { try? FileManager.default.setAttributes(now, ofItemAtPath: path(key, ext)) }
+    }
+    
+    // remove entries of the key (e.g. stale or damaged ones)
+    private func remove(_ key: CacheKey) {
+        for ext in ["map", "idx"] { try? FileManager.default.removeItem(atPath: path(key, ext)) }
+    }
+    
+    // evict least recently used entries until cache fits under its cap
+    private func trim() {
+        let keys: [URLResourceKey] = [.totalFileAllocatedSizeKey, .contentModificationDateKey]
+        guard let files = try? FileManager.default.contentsOfDirectory(at: directory, includingPropertiesForKeys: keys) else { return }
+        
+        // group map and index entries of the same column together
+        var entries = [String: (size: Int, used: Date, files: [URL])]()
+        
+        for file in files {
+            guard let values = try? file.resourceValues(forKeys: Set(keys)) else { continue }
+            let name = file.deletingPathExtension().lastPathComponent, size = values.totalFileAllocatedSize ?? 0
+            let used = values.contentModificationDate ?? .distantPast
+            
+            let entry = entries[name] ?? (0, .distantPast, [])
+            entries[name] = (entry.size + size, Swift.max(entry.used, used), entry.files + [file])
+        }
+        
+        var total = entries.values.reduce(0) { $0 + $1.size }
+        
+        for entry in entries.values.sorted(by: { $0.used < $1.used }) {
+            guard total > capacity else { break }
+            for file in entry.files { try? FileManager.default.removeItem(at: file) }; total -= entry.size
+        }
+    }
+    
+    // drop all cached maps
+    func clear() {
+        cacheQueue.async { [self] in try? FileManager.default.removeItem(at: directory) }
+    }
+}
@@ -0,0 +1,32 @@
+//
+//  Smoothing.swift
+//  HEALPix Viewer
+//
+//  Created by Andrei Frolov on 2026-10-17.
+//
+
+import Foundation
+
+// pixel space Gaussian smoothing (see smooth.h), an approximate but much
+// faster alternative to harmonic smoothing for interactive use
+struct Smoothing: Equatable, Codable {
+    var fwhm: Double = 0.0      // beam FWHM, in radians
+    
+    // smoothing beam in arc minutes
+    var arcmin: Double {
+        get { fwhm*10800.0/Double.pi }
+        set { fwhm = newValue*Double.pi/10800.0 }
+    }
+    
+    // smooth map, optionally producing a quick preview at lower resolution nside
+    func apply(map: Map, nside: Int? = nil) -> CpuMap? {
+        let nout = Swift.min(nside ?? map.nside, map.nside)
+        let trace = LoadTrace.begin("smooth"); defer { LoadTrace.end(trace, bytes: 12*nout*nout*MemoryLayout<Float>.size) }
+        let output = UnsafeMutablePointer<Float>.allocate(capacity: 12*nout*nout); var minval = 0.0, maxval = 0.0
+        
+        smooth_threads(Int32(CpuThreads.value.count))
+        guard smooth_gaussian(map.ptr, map.nside, fwhm, nout, output, &minval, &maxval) == 0 else { output.deallocate(); return nil }
+        
+        return CpuMap(nside: nout, buffer: output, min: minval, max: maxval)
+    }
+}
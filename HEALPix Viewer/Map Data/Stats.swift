@@ -87,6 +87,49 @@ enum Distribution: CaseIterable {
     func draw(count: Int) -> [Double] { return (0..<count).map { _ in sample } }
 }
 
+// exact moments of map values, accumulated during conversion
+struct Moments {
+    // pixel counts
+    let finite: Int
+    let nan: Int
+    let bad: Int
+    
+    // distribution parameters
+    let mean: Double
+    let sigma: Double
+    let skewness: Double
+    let kurtosis: Double
+    
+    // initialize from pixel counts and sums of central moments
+    init(finite: Int, nan: Int, bad: Int, mean: Double, m2: Double, m3: Double, m4: Double) {
+        let n = Double(finite), sigma = sqrt(m2/n)
+        
+        self.finite = finite
+        self.nan = nan
+        self.bad = bad
+        
+        self.mean = mean
+        self.sigma = sigma
+        self.skewness = (m3/n)/pow(sigma,3)
+        self.kurtosis = (m4/n)/pow(sigma,4)
+    }
+    
+    // initialize from pixel counts and distribution parameters (e.g. restored from cache)
+    init(finite: Int, nan: Int, bad: Int, moments: SIMD4<Double>) {
+        self.finite = finite
+        self.nan = nan
+        self.bad = bad
+        
+        self.mean = moments[0]
+        self.sigma = moments[1]
+        self.skewness = moments[2]
+        self.kurtosis = moments[3]
+    }
+    
+    // distribution mean, sigma, skewness, and kurtosis
+    var moments: SIMD4<Double> { SIMD4<Double>(mean, sigma, skewness, kurtosis) }
+}
+
 // light-weight CDF representation (sampled on Chebyshev grid)
 struct CDF {
     let n: Int
@@ -118,7 +161,7 @@ struct CDF {
     }
     
     // initialize from indexed data
-    init(_ data: UnsafePointer<Float>, index idx: UnsafeBufferPointer<Int32>, count n: Int) {
+    init(_ data: UnsafePointer<Float>, index idx: MapIndex, count n: Int) {
         let dt = halfpi/Double(n), nobs = idx.count
         
         // sampling arrays
@@ -130,7 +173,7 @@ struct CDF {
         for i in 0..<n {
             let t = (Double(i)+0.5)*dt, z = sin(t), r = Double(nobs)*z*z - 0.5
             let k = min(max(Int(floor(r)),0),nobs-2), alpha = r - Double(k)
-            let a = Double(data[Int(idx[k])]), b = Double(data[Int(idx[k+1])])
+            let a = Double(data[idx[k]]), b = Double(data[idx[k+1]])
             F[i] = z*z; x[i] = (1.0-alpha)*a + alpha*b; w[i] = sin(2.0*t)*dt
         }
         
@@ -0,0 +1,187 @@
+//
+//  correlate.c
+//  HEALPix Viewer
+//
+//  Created by Andrei Frolov on 2026-10-17.
+//
+
+#include <math.h>
+#include <float.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <dispatch/dispatch.h>
+#include "correlate.h"
+
+// moments of a set of pixels are kept as a vector of 1+n+n*n doubles: pixel count,
+// mean of each channel, and co-moments (sums of products of deviations from the
+// mean, upper triangle only until the very end); chunk moments are computed in two
+// passes over gathered values, and merged into block moments, which are in turn
+// merged pairwise in a binary tree
+
+// valid pixels gathered before being reduced to moments
+#define CHUNK 256
+
+// candidate pixels reduced to one set of moments (fixed, so merge order is too)
+#define BLOCK (1L<<16)
+
+// maps with fewer pixels than this are correlated on a single thread
+#define SERIAL_PIXELS (1L<<14)
+
+// number of worker threads (0 = one per active CPU core)
+static int correlate_nthreads = 0;
+
+void correlate_threads(int threads) { correlate_nthreads = (threads > 0) ? threads : 0; }
+
+// MARK: subsampling
+
+// splitmix64 finalizer
+static inline uint64_t hash(uint64_t x) {
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+// pixel sampled from i-th run of stride pixels (every pixel if stride is 1)
+static inline long candidate(long i, long stride, long npix, unsigned long seed) {
+    if (stride < 2) { return i; }
+    
+    const long first = i*stride, run = (npix - first < stride) ? npix - first : stride;
+    return first + (long)(hash((uint64_t) i + 0x9e3779b97f4a7c15ULL*(seed+1)) % (uint64_t) run);
+}
+
+// MARK: moments
+
+// merge moments b into a (Chan, Golub & LeVeque pairwise update)
+static void merge(int n, double *a, const double *b) {
+    const double na = a[0], nb = b[0], nab = na + nb;
+    if (nb == 0.0) { return; }
+    if (na == 0.0) { memcpy(a, b, (1+n+n*n)*sizeof(double)); return; }
+    
+    double *ma = a+1, *ca = a+1+n; const double *mb = b+1, *cb = b+1+n;
+    const double f = na*nb/nab;
+    
+    for (int i = 0; i < n; i++) {
+        const double di = mb[i] - ma[i];
+        for (int j = i; j < n; j++) { ca[i*n+j] += cb[i*n+j] + f*di*(mb[j] - ma[j]); }
+    }
+    
+    for (int i = 0; i < n; i++) { ma[i] += (mb[i] - ma[i])*(nb/nab); }
+    a[0] = nab;
+}
+
+// moments of m gathered values x[i*CHUNK+k] (centered in place)
+static void reduce(int n, long m, double *x, double *moments) {
+    double *mean = moments+1, *comoment = moments+1+n;
+    moments[0] = m;
+    
+    for (int i = 0; i < n; i++) {
+        double *xi = x + i*CHUNK, s = 0.0;
+        for (long k = 0; k < m; k++) { s += xi[k]; }
+        
+        mean[i] = s/m; for (long k = 0; k < m; k++) { xi[k] -= mean[i]; }
+    }
+    
+    for (int i = 0; i < n; i++) {
+        const double *xi = x + i*CHUNK;
+        
+        for (int j = i; j < n; j++) {
+            const double *xj = x + j*CHUNK; double s = 0.0;
+            for (long k = 0; k < m; k++) { s += xi[k]*xj[k]; }
+            comoment[i*n+j] = s;
+        }
+    }
+}
+
+// MARK: parallel correlation
+// blocks are dealt out to threads round robin, each thread gathering valid
+// pixels of a block into its own scratch buffer chunk by chunk
+
+struct correlate_job {
+    const float *const *maps;           // input maps
+    int n; long npix;                   // number of maps and their size
+    const float *lo, *hi;               // data bounds of each map
+    long stride; unsigned long seed;    // subsampling
+    long candidates, blocks;            // candidate pixels, and blocks of them
+    double *moments;                    // moments of each block
+    double *scratch;                    // gathered values and chunk moments of each slice
+    long slices;                        // number of slices
+};
+
+static void correlate_slice(void *context, size_t s) {
+    const struct correlate_job *job = context;
+    const int n = job->n; const long size = 1+n+n*n;
+    double *x = job->scratch + s*(n*CHUNK + size), *chunk = x + n*CHUNK;
+    
+    for (long b = s; b < job->blocks; b += job->slices) {
+        double *moments = job->moments + b*size; long m = 0;
+        const long from = b*BLOCK, to = (from + BLOCK < job->candidates) ? from + BLOCK : job->candidates;
+        
+        memset(moments, 0, size*sizeof(double));
+        
+        for (long i = from; i < to; i++) {
+            const long p = candidate(i, job->stride, job->npix, job->seed);
+            int valid = 1;
+            
+            // NaN fails both comparisons, and infinities are outside of any bounds
+            for (int c = 0; c < n; c++) {
+                const float v = job->maps[c][p];
+                if (!(v >= job->lo[c] && v <= job->hi[c])) { valid = 0; break; }
+            }
+            
+            if (!valid) { continue; }
+            for (int c = 0; c < n; c++) { x[c*CHUNK + m] = job->maps[c][p]; }
+            
+            if (++m == CHUNK) { reduce(n, m, x, chunk); merge(n, moments, chunk); m = 0; }
+        }
+        
+        if (m) { reduce(n, m, x, chunk); merge(n, moments, chunk); }
+    }
+}
+
+int correlate_maps(const float *const *maps, int n, long npix, const double *lo, const double *hi,
+                   long stride, unsigned long seed, double *mean, double *cov, long *count) {
+    if (n < 1 || npix < 1) { return -1; }
+    
+    const long size = 1+n+n*n; if (stride < 1) { stride = 1; }
+    const long candidates = (npix + stride-1)/stride, blocks = (candidates + BLOCK-1)/BLOCK;
+    long slices = correlate_nthreads ? correlate_nthreads : sysconf(_SC_NPROCESSORS_ONLN);
+    if (candidates < SERIAL_PIXELS || slices < 2) { slices = 1; }
+    if (slices > blocks) { slices = blocks; }
+    
+    float *bounds = malloc(2*n*sizeof(float));
+    double *moments = malloc(blocks*size*sizeof(double));
+    double *scratch = malloc(slices*(n*CHUNK + size)*sizeof(double));
+    
+    if (!bounds || !moments || !scratch) { free(bounds); free(moments); free(scratch); return -1; }
+    
+    // bounds are compared in single precision, as data is
+    for (int c = 0; c < n; c++) { bounds[c] = lo ? (float) lo[c] : -FLT_MAX; bounds[n+c] = hi ? (float) hi[c] : FLT_MAX; }
+    
+    struct correlate_job job = { maps, n, npix, bounds, bounds+n, stride, seed, candidates, blocks, moments, scratch, slices };
+    
+    if (slices > 1) { dispatch_apply_f(slices, DISPATCH_APPLY_AUTO, &job, correlate_slice); }
+    else { correlate_slice(&job, 0); }
+    
+    // pairwise merge of block moments in fixed order
+    for (long step = 1; step < blocks; step *= 2) {
+        for (long b = 0; b + step < blocks; b += 2*step) { merge(n, moments + b*size, moments + (b+step)*size); }
+    }
+    
+    // mean and symmetric covariance matrix
+    const double total = moments[0], *comoment = moments+1+n;
+    
+    for (int i = 0; i < n; i++) {
+        mean[i] = total ? moments[1+i] : 0.0;
+        
+        for (int j = i; j < n; j++) {
+            cov[i*n+j] = cov[j*n+i] = total ? comoment[i*n+j]/total : 0.0;
+        }
+    }
+    
+    *count = (long) total;
+    
+    free(bounds); free(moments); free(scratch);
+    return 0;
+}
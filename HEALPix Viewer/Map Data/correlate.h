@@ -0,0 +1,28 @@
+//
+//  correlate.h
+//  HEALPix Viewer
+//
+//  Created by Andrei Frolov on 2026-10-17.
+//
+
+#ifndef correlate_h
+#define correlate_h
+
+// mean and covariance of several maps, streamed in chunks: each chunk is reduced
+// to centered co-moments in double precision, and chunks are merged pairwise
+// (Chan et al. update), so that no raw sums of squares are ever formed; the order
+// of merges is fixed, and results do not depend on the number of threads
+
+// number of threads used by correlator (0 = one per active CPU core)
+void correlate_threads(int threads);
+
+// mean (n values) and covariance matrix (n x n, normalized by pixel count) of n maps
+// of npix pixels each, over pixels where all maps are finite and within [lo, hi]
+// (either may be NULL for no bounds); stride > 1 takes a stratified subsample, one
+// pixel at random position (fixed by seed) from each run of stride pixels, which in
+// NESTED ordering are compact patches of sky; count receives the number of pixels
+// used; returns 0 on success, -1 if buffers could not be allocated
+int correlate_maps(const float *const *maps, int n, long npix, const double *lo, const double *hi,
+                   long stride, unsigned long seed, double *mean, double *cov, long *count);
+
+#endif /* correlate_h */
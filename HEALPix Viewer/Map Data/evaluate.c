@@ -0,0 +1,251 @@
+//
+//  evaluate.c
+//  HEALPix Viewer
+//
+//  Created by Andrei Frolov on 2026-10-17.
+//
+
+#include <math.h>
+#include <float.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <dispatch/dispatch.h>
+#include "evaluate.h"
+
+// Random123 library [https://github.com/DEShawResearch/random123]
+#include "../../random123/include/Random123/threefry.h"
+
+// programs are interpreted one instruction at a time over a chunk of pixels, so that
+// dispatch overhead is amortized over a loop that vectorizes, while registers stay
+// in cache; chunks are split into contiguous slices processed by libdispatch workers
+
+// MARK: special functions
+
+// erfinv from Mike Giles (as in Transforms.metal)
+static inline float erfinv(float x) {
+    float w = -logf((1.0f-x)*(1.0f+x)), p;
+    
+    if (w < 5.0f) {
+        w = w - 2.5f;
+        p =  2.81022636e-08f;
+        p =  3.43273939e-07f + p*w;
+        p = -3.5233877e-06f  + p*w;
+        p = -4.39150654e-06f + p*w;
+        p =  0.00021858087f  + p*w;
+        p = -0.00125372503f  + p*w;
+        p = -0.00417768164f  + p*w;
+        p =  0.246640727f    + p*w;
+        p =  1.50140941f     + p*w;
+    } else {
+        w = sqrtf(w) - 3.0f;
+        p = -0.000200214257f;
+        p =  0.000100950558f + p*w;
+        p =  0.00134934322f  + p*w;
+        p = -0.00367342844f  + p*w;
+        p =  0.00573950773f  + p*w;
+        p = -0.0076224613f   + p*w;
+        p =  0.00943887047f  + p*w;
+        p =  1.00167406f     + p*w;
+        p =  2.83297682f     + p*w;
+    }
+    
+    return p*x;
+}
+
+// fill pixels offset..offset+n-1 with random field (as Random.metal, where
+// each thread generates a group of four consecutive pixels)
+static void random_field(float *r, long offset, long n, uint32_t seed, int gaussian) {
+    const float twopi = 6.28318530717958647692f;
+    
+    for (long g = offset >> 2; 4*g < offset+n; g++) {
+        threefry4x32_key_t k = {{(uint32_t) g, 0xdecafbad, 0xfacebead, 0x12345678}};
+        threefry4x32_ctr_t c = {{seed, 0xf00dcafe, 0xdeadbeef, 0xbeeff00d}};
+        threefry4x32_ctr_t u = threefry4x32(c, k);
+        float v[4];
+        
+        for (int i = 0; i < 4; i++) { v[i] = (float) u.v[i]/((float) UINT32_MAX); }
+        
+        if (gaussian) {
+            const float a[2] = { sqrtf(-2.0f*logf(v[0])), sqrtf(-2.0f*logf(v[2])) }, theta[2] = { twopi*v[1], twopi*v[3] };
+            v[0] = a[0]*cosf(theta[0]); v[1] = a[1]*cosf(theta[1]);
+            v[2] = a[0]*sinf(theta[0]); v[3] = a[1]*sinf(theta[1]);
+        }
+        
+        for (int i = 0; i < 4; i++) { const long p = 4*g+i - offset; if (p >= 0 && p < n) { r[p] = v[i]; } }
+    }
+}
+
+// MARK: interpreter
+
+// pixels processed by an instruction at a time (registers are this many floats)
+#define CHUNK 1024
+
+// run a single instruction over n pixels starting at offset
+static void execute(const struct evaluate_instruction *op, float *r, const float *a, const float *b, long offset, long n) {
+    const float x = op->x, y = op->y;
+    
+    #define LOOP(expr) for (long i = 0; i < n; i++) { r[i] = (expr); } break;
+    #define COMPARE(expr) LOOP(isunordered(a[i], b[i]) ? NAN : ((expr) ? 1.0f : 0.0f))
+    
+    switch (op->op) {
+        case EVALUATE_COPY:         if (r != a) { memcpy(r, a, n*sizeof(float)); } break;
+        
+        case EVALUATE_ADD:          LOOP(a[i] + b[i])
+        case EVALUATE_SUBTRACT:     LOOP(a[i] - b[i])
+        case EVALUATE_MULTIPLY:     LOOP(a[i] * b[i])
+        case EVALUATE_DIVIDE:       LOOP(a[i] / b[i])
+        case EVALUATE_POWER:        LOOP(powf(a[i], b[i]))
+        
+        case EVALUATE_EQUAL:        COMPARE(a[i] == b[i])
+        case EVALUATE_LESS:         COMPARE(a[i] < b[i])
+        case EVALUATE_GREATER:      COMPARE(a[i] > b[i])
+        case EVALUATE_NE:           COMPARE(a[i] != b[i])
+        case EVALUATE_LE:           COMPARE(a[i] <= b[i])
+        case EVALUATE_GE:           COMPARE(a[i] >= b[i])
+        
+        case EVALUATE_VALID:        LOOP((fabsf(a[i]) <= FLT_MAX) ? 1.0f : 0.0f)
+        case EVALUATE_INVALID:      LOOP((fabsf(a[i]) <= FLT_MAX) ? 0.0f : 1.0f)
+        case EVALUATE_MASK:         for (long i = 0; i < n; i++) { const float v = a[i], m = b[i]; r[i] = (fabsf(m) <= FLT_MAX && m != 0.0f) ? v : NAN; } break;
+        
+        case EVALUATE_LOG:          LOOP(logf(a[i] - x))
+        case EVALUATE_ASINH:        LOOP(asinhf((a[i] - x)/y))
+        case EVALUATE_ATAN:         LOOP(atanf((a[i] - x)/y))
+        case EVALUATE_TANH:         LOOP(tanhf((a[i] - x)/y))
+        case EVALUATE_POW:          LOOP(copysignf(powf(fabsf(a[i] - x), y), a[i] - x))
+        case EVALUATE_EXP:          LOOP(expf((a[i] - x)/y))
+        case EVALUATE_NORMALIZE:    LOOP(sqrtf(2.0f) * erfinv(2.0f*a[i] - 1.0f))
+        
+        case EVALUATE_UNIFORM:      random_field(r, offset, n, (uint32_t) op->x, 0); break;
+        case EVALUATE_GAUSSIAN:     random_field(r, offset, n, (uint32_t) op->x, 1); break;
+    }
+    
+    #undef COMPARE
+    #undef LOOP
+}
+
+// MARK: parallel evaluation
+
+// maps with fewer pixels than this are evaluated on a single thread
+#define SERIAL_PIXELS (1L<<16)
+
+// number of worker threads (0 = one per active CPU core)
+static int evaluate_nthreads = 0;
+
+void evaluate_threads(int threads) { evaluate_nthreads = (threads > 0) ? threads : 0; }
+
+// parallel evaluation job (out is NULL for dot products)
+struct evaluate_job {
+    const struct evaluate_instruction *code; int n;
+    const struct evaluate_source *src; int nsrc, nreg;
+    float *out; long npix, slices;
+    double (*result)[2];                // per slice bounds or dot products
+    int failed;
+};
+
+// evaluate program over a contiguous slice of chunks
+static void evaluate_slice(void *context, size_t s) {
+    struct evaluate_job *job = context;
+    const long chunks = (job->npix + CHUNK-1)/CHUNK;
+    const long first = chunks*s/job->slices*CHUNK, last = chunks*(s+1)/job->slices*CHUNK;
+    
+    // chunk-sized registers and constant sources
+    float *scratch = malloc((job->nreg + job->nsrc)*CHUNK*sizeof(float)), *reg[job->nreg], *constant[job->nsrc];
+    if (!scratch) { job->failed = 1; return; }
+    
+    for (int k = 0; k < job->nreg; k++) { reg[k] = scratch + k*CHUNK; }
+    for (int k = 0; k < job->nsrc; k++) {
+        constant[k] = scratch + (job->nreg+k)*CHUNK;
+        if (!job->src[k].map) { for (long i = 0; i < CHUNK; i++) { constant[k][i] = job->src[k].value; } }
+    }
+    
+    float minval = FLT_MAX, maxval = -FLT_MAX; double ab = 0.0, bb = 0.0;
+    
+    for (long offset = first; offset < last && offset < job->npix; offset += CHUNK) {
+        const long n = (offset+CHUNK < job->npix) ? CHUNK : job->npix-offset;
+        if (job->out) { reg[0] = job->out + offset; }
+        
+        // operands refer to registers, or to sources at current chunk
+        #define OPERAND(k) (((k) >= 0) ? reg[k] : job->src[-1-(k)].map ? job->src[-1-(k)].map + offset : constant[-1-(k)])
+        
+        for (int i = 0; i < job->n; i++) {
+            const struct evaluate_instruction *op = job->code + i;
+            execute(op, reg[op->r], OPERAND(op->a), OPERAND(op->b), offset, n);
+        }
+        
+        #undef OPERAND
+        
+        // data bounds of finite values, or dot products of registers 0 and 1
+        if (job->out) {
+            const float *r = reg[0];
+            for (long i = 0; i < n; i++) {
+                const int finite = (fabsf(r[i]) <= FLT_MAX);
+                const float lo = finite ? r[i] : FLT_MAX, hi = finite ? r[i] : -FLT_MAX;
+                minval = (lo < minval) ? lo : minval;
+                maxval = (hi > maxval) ? hi : maxval;
+            }
+        } else {
+            const float *a = reg[0], *b = reg[1]; double sab = 0.0, sbb = 0.0;
+            for (long i = 0; i < n; i++) {
+                const float x = a[i], y = b[i]; const int finite = (fabsf(x) <= FLT_MAX && fabsf(y) <= FLT_MAX);
+                sab += finite ? (double) x*y : 0.0;
+                sbb += finite ? (double) y*y : 0.0;
+            }
+            ab += sab; bb += sbb;
+        }
+    }
+    
+    if (job->out) { job->result[s][0] = minval; job->result[s][1] = maxval; }
+    else { job->result[s][0] = ab; job->result[s][1] = bb; }
+    
+    free(scratch);
+}
+
+// run the job on slices of chunks, leaving per slice results in job
+static int evaluate_run(struct evaluate_job *job) {
+    long slices = evaluate_nthreads ? evaluate_nthreads : sysconf(_SC_NPROCESSORS_ONLN);
+    if (job->npix < SERIAL_PIXELS || slices < 2) { slices = 1; }
+    
+    // source count is that of the most negative operand
+    for (int i = 0; i < job->n; i++) {
+        const int a = job->code[i].a, b = job->code[i].b;
+        if (-a > job->nsrc) { job->nsrc = -a; }
+        if (-b > job->nsrc) { job->nsrc = -b; }
+    }
+    
+    job->slices = slices; job->result = calloc(slices, sizeof(double[2]));
+    if (!job->result) { return -1; }
+    
+    if (slices > 1) { dispatch_apply_f(slices, DISPATCH_APPLY_AUTO, job, evaluate_slice); }
+    else { evaluate_slice(job, 0); }
+    
+    return job->failed ? -1 : 0;
+}
+
+int evaluate(const struct evaluate_instruction *code, int n, const struct evaluate_source *src, int nreg,
+             float *out, long npix, double *min, double *max) {
+    struct evaluate_job job = { code, n, src, 0, (nreg > 0) ? nreg : 1, out, npix, 1, NULL, 0 };
+    int status = evaluate_run(&job); double minval = FLT_MAX, maxval = -FLT_MAX;
+    
+    for (long s = 0; !status && s < job.slices; s++) {
+        if (job.result[s][0] < minval) { minval = job.result[s][0]; }
+        if (job.result[s][1] > maxval) { maxval = job.result[s][1]; }
+    }
+    
+    // maps without finite values get degenerate bounds
+    if (minval > maxval) { minval = maxval = 0.0; }
+    
+    *min = minval; *max = maxval;
+    free(job.result); return status;
+}
+
+int evaluate_dot(const struct evaluate_instruction *code, int n, const struct evaluate_source *src, int nreg,
+                 long npix, double *ab, double *bb) {
+    struct evaluate_job job = { code, n, src, 0, (nreg > 1) ? nreg : 2, NULL, npix, 1, NULL, 0 };
+    int status = evaluate_run(&job); *ab = 0.0; *bb = 0.0;
+    
+    for (long s = 0; !status && s < job.slices; s++) { *ab += job.result[s][0]; *bb += job.result[s][1]; }
+    
+    free(job.result); return status;
+}
@@ -0,0 +1,81 @@
+//
+//  evaluate.h
+//  HEALPix Viewer
+//
+//  Created by Andrei Frolov on 2026-10-17.
+//
+
+#ifndef evaluate_h
+#define evaluate_h
+
+// map arithmetic (see Expression.swift) is compiled into a short program of
+// pointwise instructions, which is run over cache-sized chunks of NESTED pixels,
+// so that intermediate results never exceed a few chunk-sized registers
+
+// instruction opcodes
+enum evaluate_op {
+    EVALUATE_COPY = 0,                  // r = a
+    
+    // arithmetic operators (NaN propagates)
+    EVALUATE_ADD,                       // r = a + b
+    EVALUATE_SUBTRACT,                  // r = a - b
+    EVALUATE_MULTIPLY,                  // r = a * b
+    EVALUATE_DIVIDE,                    // r = a / b
+    EVALUATE_POWER,                     // r = a ^ b
+    
+    // comparison operators (1 if true, 0 if false, NaN if either operand is NaN)
+    EVALUATE_EQUAL,
+    EVALUATE_LESS,
+    EVALUATE_GREATER,
+    EVALUATE_NE,
+    EVALUATE_LE,
+    EVALUATE_GE,
+    
+    // masking operators
+    EVALUATE_VALID,                     // r = 1 if a is finite, 0 otherwise
+    EVALUATE_INVALID,                   // r = 0 if a is finite, 1 otherwise
+    EVALUATE_MASK,                      // r = a where b is finite and non-zero, NaN elsewhere
+    
+    // pointwise transforms with offset x and scale y (as Transforms.metal)
+    EVALUATE_LOG,
+    EVALUATE_ASINH,
+    EVALUATE_ATAN,
+    EVALUATE_TANH,
+    EVALUATE_POW,
+    EVALUATE_EXP,
+    EVALUATE_NORMALIZE,                 // r = sqrt(2) erfinv(2a-1), for ranked a
+    
+    // random fields with seed x (same values as Random.metal)
+    EVALUATE_UNIFORM,
+    EVALUATE_GAUSSIAN
+};
+
+// instruction writes register r, reading operands a and b, which refer to
+// registers if non-negative, and to sources -1-a and -1-b if negative
+struct evaluate_instruction {
+    enum evaluate_op op;
+    int r, a, b;
+    double x, y;
+};
+
+// program source is either a full-sky map, or a constant (if map is NULL)
+struct evaluate_source {
+    const float *map;
+    float value;
+};
+
+// number of threads used by evaluation (0 = one per active CPU core)
+void evaluate_threads(int threads);
+
+// run program of n instructions using nreg registers over npix pixels, storing
+// register 0 into out, and returning bounds of its finite values; both return
+// 0 on success and -1 if scratch registers could not be allocated
+int evaluate(const struct evaluate_instruction *code, int n, const struct evaluate_source *src, int nreg,
+             float *out, long npix, double *min, double *max);
+
+// run program over npix pixels, accumulating sums of products of registers 0 and 1
+// (ab = sum a*b, bb = sum b*b) over pixels where both are finite
+int evaluate_dot(const struct evaluate_instruction *code, int n, const struct evaluate_source *src, int nreg,
+                 long npix, double *ab, double *bb);
+
+#endif /* evaluate_h */
@@ -0,0 +1,71 @@
+//
+//  healpix.h
+//  HEALPix Viewer
+//
+//  Created by Andrei Frolov on 2026-10-17.
+//  Pixel arithmetic adopted from HEALPix (chealpix.c)
+//  Copyright (C) 1997-2016 Krzysztof M. Gorski, Eric Hivon, Martin Reinecke,
+//                          Benjamin D. Wandelt, Anthony J. Banday,
+//                          Matthias Bartelmann, Reza Ansari & Kenneth M. Ganga
+//
+
+#ifndef healpix_h
+#define healpix_h
+
+#include <math.h>
+
+// NESTED pixel arithmetic shared by CPU kernels (inlined, so that it vectorizes
+// in the loops it is used in): index within a face interleaves x (even bits)
+// and y (odd bits) face coordinates, and faces are laid out by base tables
+
+// ring and phase offsets of face corners
+static const int jrll[12] = { 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4 };
+static const int jpll[12] = { 1, 3, 5, 7, 0, 2, 4, 6, 1, 3, 5, 7 };
+
+// spread lower 32 bits of x into even bit positions
+static inline unsigned long spread(unsigned long x) {
+    x &= 0xFFFFFFFFUL;
+    x = (x | (x << 16)) & 0x0000FFFF0000FFFFUL;
+    x = (x | (x <<  8)) & 0x00FF00FF00FF00FFUL;
+    x = (x | (x <<  4)) & 0x0F0F0F0F0F0F0F0FUL;
+    x = (x | (x <<  2)) & 0x3333333333333333UL;
+    x = (x | (x <<  1)) & 0x5555555555555555UL;
+    return x;
+}
+
+// compress even bits of x into lower 32 bits
+static inline unsigned long compress(unsigned long x) {
+    x &= 0x5555555555555555UL;
+    x = (x | (x >>  1)) & 0x3333333333333333UL;
+    x = (x | (x >>  2)) & 0x0F0F0F0F0F0F0F0FUL;
+    x = (x | (x >>  4)) & 0x00FF00FF00FF00FFUL;
+    x = (x | (x >>  8)) & 0x0000FFFF0000FFFFUL;
+    x = (x | (x >> 16)) & 0x00000000FFFFFFFFUL;
+    return x;
+}
+
+// NESTED index of pixel (x,y) in face, for nside = 2^order (shifts instead of products vectorize)
+static inline long xyf2nest(long order, long x, long y, long face) {
+    return (face << 2*order) | (long)(spread(x) | (spread(y) << 1));
+}
+
+// unit vector to center of NESTED pixel p
+static inline void nest2vec(long nside, long p, double *v) {
+    const long face = p/(nside*nside), q = p - face*nside*nside;
+    const long ix = compress(q), iy = compress(q >> 1), jr = jrll[face]*nside - ix - iy - 1;
+    const double fact2 = 4.0/(12.0*nside*nside);
+    long nr, kshift; double z;
+    
+    if (jr < nside) { nr = jr; z = 1.0 - nr*nr*fact2; kshift = 0; }
+    else if (jr > 3*nside) { nr = 4*nside - jr; z = nr*nr*fact2 - 1.0; kshift = 0; }
+    else { nr = nside; z = (2*nside - jr)*2.0*nside*fact2; kshift = (jr - nside) & 1; }
+    
+    long jp = (jpll[face]*nr + ix - iy + 1 + kshift)/2;
+    if (jp > 4*nside) { jp -= 4*nside; }
+    if (jp < 1) { jp += 4*nside; }
+    
+    const double phi = (jp - 0.5*(kshift+1))*M_PI_2/nr, s = sqrt((1.0-z)*(1.0+z));
+    v[0] = s*cos(phi); v[1] = s*sin(phi); v[2] = z;
+}
+
+#endif /* healpix_h */
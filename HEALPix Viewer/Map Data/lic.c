@@ -0,0 +1,254 @@
+//
+//  lic.c
+//  HEALPix Viewer
+//
+//  Created by Andrei Frolov on 2026-10-17.
+//  Pixel lookup adopted from HEALPix (chealpix.c)
+//  Copyright (C) 1997-2016 Krzysztof M. Gorski, Eric Hivon, Martin Reinecke,
+//                          Benjamin D. Wandelt, Anthony J. Banday,
+//                          Matthias Bartelmann, Reza Ansari & Kenneth M. Ganga
+//
+
+#include <math.h>
+#include <float.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <dispatch/dispatch.h>
+#include "healpix.h"
+#include "lic.h"
+
+// streamlines are integrated with Euler steps of great circle arcs, using the
+// direction of the pixel the current point falls into, expressed in the local
+// (e_theta, e_phi) basis at that point; every output pixel is computed from
+// its own streamline only, so results do not depend on how work is split
+
+static const float halfpi = 1.570796326794896619231321691639751442098584699688f;
+
+// number of pixels traced in lockstep (each has a forward and a backward lane)
+#define BATCH 16
+#define LANES (2*BATCH)
+
+// MARK: HEALPix pixel lookup
+
+// polynomial approximation of atan2(y,x)/halfpi, accurate to 2e-6 radian (a small
+// fraction of a pixel even at nside = 8192), and much cheaper than atan2f
+static inline float quarters(float y, float x) {
+    const float ax = fabsf(x), ay = fabsf(y), lo = (ax < ay) ? ax : ay, hi = (ax < ay) ? ay : ax, z = lo/((hi > 0.0f) ? hi : 1.0f), z2 = z*z;
+    float a = z*(0.99997726f + z2*(-0.33262347f + z2*(0.19354346f + z2*(-0.11643287f + z2*(0.05265332f + z2*(-0.01172120f))))));
+    
+    a = (ay > ax) ? halfpi - a : a; a = (x < 0.0f) ? 2.0f*halfpi - a : a;
+    return ((y < 0.0f) ? -a : a)/halfpi;
+}
+
+// NESTED pixels q containing unit vectors v of all lanes (as vec2nest in project.c, but
+// branch-free and in 32-bit face coordinates, so that it vectorizes for nside < 2^28)
+static void vec2nest(long nside, float v[3][LANES], long *q) {
+    const int order = __builtin_ctzl(nside), mask = (int) nside-1; const float n = nside;
+    
+    for (int l = 0; l < LANES; l++) {
+        const float z = v[2][l], za = fabsf(z), t = quarters(v[1][l],v[0][l]), u = (t < 0.0f) ? t+4.0f : t;
+        const float tt = (u < 4.0f) ? u : 0.0f; /* in [0,4), as t+4 rounds up to 4 for tiny negative t */
+        
+        /* Equatorial region */
+        const float temp1 = n*(0.5f+tt), temp2 = n*(z*0.75f);
+        const int jp = (int)(temp1-temp2), ifp = jp >> order; /* index of  ascending edge line */
+        const int jm = (int)(temp1+temp2), ifm = jm >> order; /* index of descending edge line */
+        const int fe = (ifp == ifm) ? (ifp|4) : ((ifp < ifm) ? ifp : ifm+8), xe = jm & mask, ye = mask - (jp & mask);
+        
+        /* polar region, za > 2/3 */
+        const int ntt = ((int)tt < 3) ? (int)tt : 3;
+        const float tp = tt-ntt, tmp = n*sqrtf(3.0f*(1.0f-za));
+        const int kp = ((int)(tp*tmp) < mask) ? (int)(tp*tmp) : mask; /* increasing edge line index */
+        const int km = ((int)((1.0f-tp)*tmp) < mask) ? (int)((1.0f-tp)*tmp) : mask; /* decreasing edge line index */
+        const int fp = (z >= 0.0f) ? ntt : ntt+8, xp = (z >= 0.0f) ? mask-km : kp, yp = (z >= 0.0f) ? mask-kp : km;
+        
+        const int equatorial = (za <= 2.0f/3.0f), face = equatorial ? fe : fp, x = equatorial ? xe : xp, y = equatorial ? ye : yp;
+        q[l] = xyf2nest(order, x, y, face);
+    }
+}
+
+// MARK: noise
+
+// splitmix64 finalizer
+static inline uint64_t hash(uint64_t x) {
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+float lic_noise(long p, unsigned long seed) {
+    return (float)(hash((uint64_t) p + 0x9e3779b97f4a7c15ULL*(seed+1)) >> 40) * 0x1.0p-24f;
+}
+
+// MARK: parallel convolution
+// each thread traces streamlines of a run of pixels in lockstep, forward and
+// backward lanes side by side, one stage at a time over arrays, so that field
+// arithmetic vectorizes and independent pixel lookups overlap
+
+// maps with fewer pixels than this are convolved on a single thread
+#define SERIAL_PIXELS (1L<<14)
+
+// pixels in a block of work (blocks are dealt out round robin, since
+// streamlines are cut short in masked regions and near singular points)
+#define BLOCK 4096
+
+// number of worker threads (0 = one per active CPU core)
+static int lic_nthreads = 0;
+
+void lic_threads(int threads) { lic_nthreads = (threads > 0) ? threads : 0; }
+
+// parallel convolution job
+struct lic_job {
+    const float *x, *y, *noise; long nside;
+    enum lic_field field; unsigned long seed;
+    int steps; float h, window[LIC_MAX_STEPS+1];
+    float *out; long blocks, slices;
+    double (*bounds)[2];
+};
+
+// field values and noise in pixels q of all lanes
+static void lookup(const struct lic_job *job, const long *q, float *a, float *b, float *n) {
+    for (int l = 0; l < LANES; l++) { a[l] = job->x[q[l]]; b[l] = job->y[q[l]]; }
+    
+    if (job->noise) { for (int l = 0; l < LANES; l++) { n[l] = job->noise[q[l]]; } }
+    else { for (int l = 0; l < LANES; l++) { n[l] = lic_noise(q[l], job->seed); } }
+}
+
+// unit tangent directions e of field values (a,b) at points v, flagging lanes where they are undefined
+// (polarization direction is at half the angle of (Q,U); local basis is degenerate at the poles)
+static void tangent(enum lic_field field, const float *a, const float *b, float v[3][LANES], float e[3][LANES], int *valid) {
+    const int polarization = (field == LIC_POLARIZATION);
+    
+    for (int l = 0; l < LANES; l++) {
+        const float P = sqrtf(a[l]*a[l] + b[l]*b[l]), c = a[l]/P, s = b[l]/P, r = sqrtf(v[0][l]*v[0][l] + v[1][l]*v[1][l]);
+        const float cc = 0.5f*(1.0f+c), ss = 0.5f*(1.0f-c);
+        const float ch = sqrtf((cc > 0.0f) ? cc : 0.0f), sh = copysignf(sqrtf((ss > 0.0f) ? ss : 0.0f), s);
+        const float ca = polarization ? ch : c, sa = polarization ? sh : s;
+        
+        valid[l] = (P > 0.0f) & (P <= FLT_MAX) & (r >= 1.0e-6f);
+        e[0][l] = (ca*v[2][l]*v[0][l] - sa*v[1][l])/r;
+        e[1][l] = (ca*v[2][l]*v[1][l] + sa*v[0][l])/r;
+        e[2][l] = -ca*r;
+    }
+}
+
+// convolve a run of n <= BATCH pixels starting at NESTED pixel first
+static void convolve_batch(const struct lic_job *job, long first, int n, float *out) {
+    float v[3][LANES], d[3][LANES], e[3][LANES], a[LANES], b[LANES], noise[LANES], sum[LANES], norm[LANES], s[LANES];
+    long q[LANES]; int live[LANES], valid[LANES], start[BATCH];
+    
+    // lanes start at pixel centers, forward lanes first (unused lanes idle at the north pole)
+    for (int i = 0; i < BATCH; i++) {
+        double c[3] = { 0.0, 0.0, 1.0 }; if (i < n) { nest2vec(job->nside, first+i, c); }
+        
+        for (int r = 0; r < 3; r++) { v[r][i] = v[r][BATCH+i] = (float) c[r]; }
+        q[i] = q[BATCH+i] = (i < n) ? first+i : first;
+        s[i] = 1.0f; s[BATCH+i] = -1.0f;
+    }
+    
+    lookup(job, q, a, b, noise);
+    tangent(job->field, a, b, v, e, valid);
+    
+    for (int l = 0; l < LANES; l++) {
+        live[l] = valid[l] && (l % BATCH < n);
+        for (int r = 0; r < 3; r++) { d[r][l] = live[l] ? s[l]*e[r][l] : 0.0f; }
+        
+        const float w = (live[l] && l < BATCH && !isnan(noise[l])) ? job->window[0] : 0.0f;
+        sum[l] = (w > 0.0f) ? w*noise[l] : 0.0f; norm[l] = w;
+    }
+    
+    for (int i = 0; i < BATCH; i++) { start[i] = live[i]; }
+    
+    // trace streamlines, keeping headless directions aligned with the previous step
+    for (int k = 1; k <= job->steps; k++) {
+        int alive = 0; for (int l = 0; l < LANES; l++) { alive |= live[l]; }
+        if (!alive) { break; }
+        
+        for (int l = 0; l < LANES; l++) {
+            for (int r = 0; r < 3; r++) { v[r][l] += job->h*d[r][l]; }
+            const float scale = 1.0f/sqrtf(v[0][l]*v[0][l] + v[1][l]*v[1][l] + v[2][l]*v[2][l]);
+            for (int r = 0; r < 3; r++) { v[r][l] *= scale; }
+        }
+        
+        vec2nest(job->nside, v, q);
+        
+        lookup(job, q, a, b, noise);
+        tangent(job->field, a, b, v, e, valid);
+        
+        for (int l = 0; l < LANES; l++) {
+            const float dot = e[0][l]*d[0][l] + e[1][l]*d[1][l] + e[2][l]*d[2][l];
+            const float sign = (job->field == LIC_POLARIZATION) ? ((dot < 0.0f) ? -1.0f : 1.0f) : s[l];
+            
+            live[l] &= valid[l];
+            for (int r = 0; r < 3; r++) { d[r][l] = live[l] ? sign*e[r][l] : 0.0f; }
+            
+            const float w = (live[l] & (noise[l] == noise[l])) ? job->window[k] : 0.0f;
+            sum[l] += (w > 0.0f) ? w*noise[l] : 0.0f; norm[l] += w;
+        }
+    }
+    
+    // pixels with undefined field at the center are left out
+    for (int i = 0; i < n; i++) {
+        const float w = norm[i] + norm[BATCH+i];
+        out[i] = (start[i] && w > 0.0f) ? (sum[i] + sum[BATCH+i])/w : NAN;
+    }
+}
+
+// convolve blocks of a single slice of the job, recording bounds of its finite results
+static void lic_slice(void *context, size_t s) {
+    const struct lic_job *job = context;
+    const long npix = 12*job->nside*job->nside;
+    float minval = FLT_MAX, maxval = -FLT_MAX;
+    
+    for (long b = s; b < job->blocks; b += job->slices) {
+        const long first = b*BLOCK, last = (first+BLOCK < npix) ? first+BLOCK : npix;
+        
+        for (long p = first; p < last; p += BATCH) {
+            const int n = (p+BATCH < last) ? BATCH : (int)(last-p); convolve_batch(job, p, n, job->out + p);
+            
+            for (int i = 0; i < n; i++) {
+                const float v = job->out[p+i];
+                if (v < minval) { minval = v; }
+                if (v > maxval) { maxval = v; }
+            }
+        }
+    }
+    
+    job->bounds[s][0] = minval; job->bounds[s][1] = maxval;
+}
+
+int lic_convolve(const float *x, const float *y, const float *noise, long nside, enum lic_field field, double length, unsigned long seed,
+                 float *out, double *min, double *max) {
+    const long npix = 12*nside*nside, blocks = (npix + BLOCK-1)/BLOCK;
+    long slices = lic_nthreads ? lic_nthreads : sysconf(_SC_NPROCESSORS_ONLN);
+    if (npix < SERIAL_PIXELS || slices < 2) { slices = 1; }
+    if (slices > blocks) { slices = blocks; }
+    
+    struct lic_job job = { x, y, noise, nside, field, seed, 0, 0.0f, {0}, out, blocks, slices, NULL };
+    
+    // about a step per pixel, with Hann window tapering to zero past the last step
+    const double pixel = sqrt(M_PI/3.0)/nside, steps = ceil(fmax(length, 0.0)/pixel);
+    job.steps = (steps < LIC_MAX_STEPS) ? (int) steps : LIC_MAX_STEPS;
+    job.h = (job.steps > 0) ? length/job.steps : 0.0f;
+    
+    for (int k = 0; k <= job.steps; k++) { job.window[k] = 0.5*(1.0 + cos(M_PI*k/(job.steps+1))); }
+    
+    job.bounds = calloc(slices, sizeof(double[2])); if (!job.bounds) { return -1; }
+    
+    if (slices > 1) { dispatch_apply_f(slices, DISPATCH_APPLY_AUTO, &job, lic_slice); }
+    else { lic_slice(&job, 0); }
+    
+    double minval = FLT_MAX, maxval = -FLT_MAX;
+    
+    for (long s = 0; s < slices; s++) {
+        if (job.bounds[s][0] < minval) { minval = job.bounds[s][0]; }
+        if (job.bounds[s][1] > maxval) { maxval = job.bounds[s][1]; }
+    }
+    
+    // maps without finite values get degenerate bounds
+    if (minval > maxval) { minval = maxval = 0.0; }
+    
+    *min = minval; *max = maxval;
+    free(job.bounds); return 0;
+}
@@ -0,0 +1,41 @@
+//
+//  lic.h
+//  HEALPix Viewer
+//
+//  Created by Andrei Frolov on 2026-10-17.
+//
+
+#ifndef lic_h
+#define lic_h
+
+// line integral convolution on NESTED grid: noise is averaged along streamlines
+// of a direction field traced both ways from each pixel center, with streamlines
+// stepping on the sphere (so they cross face boundaries seamlessly) and looking
+// up the field and noise in pixels they pass through
+
+// field type (in the same order as LineConvolution enum in the app)
+enum lic_field {
+    LIC_VECTOR = 1,                     // (x,y) are vector components along (e_theta, e_phi)
+    LIC_POLARIZATION                    // (x,y) are Stokes Q and U in HEALPix convention, i.e. headless
+                                        // direction at angle psi = atan2(U,Q)/2 from e_theta towards e_phi
+};
+
+// longest streamline traced in each direction, in steps
+#define LIC_MAX_STEPS 256
+
+// number of threads used by convolution (0 = one per active CPU core)
+void lic_threads(int threads);
+
+// deterministic white noise in [0,1) assigned to NESTED pixel p
+float lic_noise(long p, unsigned long seed);
+
+// convolve noise map (or noise generated by lic_noise if it is NULL) along field given
+// by a pair of maps, tracing streamlines of specified length (in radians) each way with
+// a Hann window, about a step per pixel; pixels where the field is missing or vanishes
+// get NaN value, and min, max receive bounds of finite results; returns 0 on success
+// and -1 if per thread results could not be allocated (for a quick preview, pass field
+// maps degraded to lower resolution, leaving the length the same)
+int lic_convolve(const float *x, const float *y, const float *noise, long nside, enum lic_field field, double length, unsigned long seed,
+                 float *out, double *min, double *max);
+
+#endif /* lic_h */
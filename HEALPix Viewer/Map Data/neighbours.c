@@ -0,0 +1,200 @@
+//
+//  neighbours.c
+//  HEALPix Viewer
+//
+//  Created by Andrei Frolov on 2026-10-17.
+//  Neighbour lookup adopted from HEALPix (healpix_base.cc)
+//  Copyright (C) 2003-2016 Max-Planck-Society, Martin Reinecke
+//
+
+#include <stdlib.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <dispatch/dispatch.h>
+#include "healpix.h"
+#include "neighbours.h"
+
+// NESTED index within a face interleaves x (even bits) and y (odd bits), so a step
+// in x or y is a carry-propagating increment or decrement restricted to its bits;
+// edge pixels are indexed by face, then by position k along face perimeter, going
+// over y = 0 (k = x), x = nside-1 (k = nside-1 + y), y = nside-1 (k = 3(nside-1) - x)
+// and x = 0 (k = 4(nside-1) - y)
+
+// neighbour offsets in face coordinates (in enum neighbour order)
+static const int xoffset[8] = { -1,-1, 0, 1, 1, 1, 0,-1 };
+static const int yoffset[8] = {  0, 1, 1, 1, 0,-1,-1,-1 };
+
+// face containing neighbour across face edge (by face and direction), and how face
+// coordinates transform going there (bit 0: flip x, bit 1: flip y, bit 2: swap x and y)
+static const int facearray[9][12] = {
+    {  8, 9,10,11,-1,-1,-1,-1,10,11, 8, 9 },   // S
+    {  5, 6, 7, 4, 8, 9,10,11, 9,10,11, 8 },   // SE
+    { -1,-1,-1,-1, 5, 6, 7, 4,-1,-1,-1,-1 },   // E
+    {  4, 5, 6, 7,11, 8, 9,10,11, 8, 9,10 },   // SW
+    {  0, 1, 2, 3, 4, 5, 6, 7, 8, 9,10,11 },   // center
+    {  1, 2, 3, 0, 0, 1, 2, 3, 5, 6, 7, 4 },   // NE
+    { -1,-1,-1,-1, 7, 4, 5, 6,-1,-1,-1,-1 },   // W
+    {  3, 0, 1, 2, 3, 0, 1, 2, 4, 5, 6, 7 },   // NW
+    {  2, 3, 0, 1,-1,-1,-1,-1, 0, 1, 2, 3 }    // N
+};
+
+static const int swaparray[9][3] = {
+    { 0,0,3 },   // S
+    { 0,0,6 },   // SE
+    { 0,0,0 },   // E
+    { 0,0,5 },   // SW
+    { 0,0,0 },   // center
+    { 5,0,0 },   // NE
+    { 0,0,0 },   // W
+    { 6,0,0 },   // NW
+    { 3,0,0 }    // N
+};
+
+// MARK: face coordinates
+
+// position of face edge pixel (x,y) along face perimeter
+static inline long perimeter(long nside, long x, long y) {
+    const long n = nside-1;
+    
+    if (y == 0) { return x; }
+    if (x == n) { return n + y; }
+    if (y == n) { return 3*n - x; }
+    return 4*n - y;
+}
+
+// edge pixel at position k along face perimeter
+static inline void edge_pixel(long nside, long k, long *x, long *y) {
+    const long n = nside-1;
+    
+    if (k <= n) { *x = k; *y = 0; }
+    else if (k <= 2*n) { *x = n; *y = k - n; }
+    else if (k <= 3*n) { *x = 3*n - k; *y = n; }
+    else { *x = 0; *y = 4*n - k; }
+}
+
+// neighbours of face edge pixel (x,y), crossing over to adjacent faces
+static void edge_neighbours(long nside, long order, long x0, long y0, long face, long *nb) {
+    for (int i = 0; i < 8; i++) {
+        long x = x0 + xoffset[i], y = y0 + yoffset[i]; int k = 4;
+        
+        if (x < 0) { x += nside; k -= 1; } else if (x >= nside) { x -= nside; k += 1; }
+        if (y < 0) { y += nside; k -= 3; } else if (y >= nside) { y -= nside; k += 3; }
+        
+        const int f = facearray[k][face]; if (f < 0) { nb[i] = -1; continue; }
+        const int bits = swaparray[k][face >> 2];
+        
+        if (bits & 1) { x = nside - x - 1; }
+        if (bits & 2) { y = nside - y - 1; }
+        if (bits & 4) { const long t = x; x = y; y = t; }
+        
+        nb[i] = xyf2nest(order, x, y, f);
+    }
+}
+
+// MARK: table construction
+
+// tables larger than this many edge pixels are built on multiple threads
+#define SERIAL_PIXELS (1L<<14)
+
+// number of worker threads (0 = one per active CPU core)
+static int neighbours_nthreads = 0;
+
+void neighbours_threads(int threads) { neighbours_nthreads = (threads > 0) ? threads : 0; }
+
+// fill neighbours of edge pixels of a single face
+static void build_face(void *context, size_t face) {
+    const neighbour_table *t = context;
+    
+    for (long k = 0; k < t->edge; k++) {
+        long x, y; edge_pixel(t->nside, k, &x, &y);
+        edge_neighbours(t->nside, t->order, x, y, face, t->table + 8*(face*t->edge + k));
+    }
+}
+
+static neighbour_table *make_neighbour_table(long order) {
+    neighbour_table *t = calloc(1, sizeof(neighbour_table)); if (!t) { return NULL; }
+    
+    t->order = order; t->nside = 1L << order;
+    t->edge = (t->nside > 1) ? 4*(t->nside-1) : 1;
+    t->table = malloc(12*t->edge*8*sizeof(long));
+    
+    if (!t->table) { free(t); return NULL; }
+    
+    const long threads = neighbours_nthreads ? neighbours_nthreads : sysconf(_SC_NPROCESSORS_ONLN);
+    if (12*t->edge < SERIAL_PIXELS || threads < 2) { for (long f = 0; f < 12; f++) { build_face(t, f); } }
+    else { dispatch_apply_f(12, DISPATCH_APPLY_AUTO, t, build_face); }
+    
+    return t;
+}
+
+// tables built so far (one per nside, kept for the lifetime of the process)
+static neighbour_table *cache[30] = { NULL };
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+
+const neighbour_table *neighbours_for(long nside) {
+    long order = 0; while (order < 29 && (1L << order) < nside) { order++; }
+    if ((1L << order) != nside) { return NULL; }
+    
+    pthread_mutex_lock(&lock);
+    if (!cache[order]) { cache[order] = make_neighbour_table(order); }
+    neighbour_table *t = cache[order];
+    pthread_mutex_unlock(&lock);
+    
+    return t;
+}
+
+// MARK: queries
+
+void neighbours(const neighbour_table *t, long p, long nb[8]) {
+    const long face = p >> 2*t->order, base = face << 2*t->order, local = p - base;
+    const long even = (long)(0x5555555555555555UL & ((1UL << 2*t->order) - 1)), odd = even << 1;
+    const long xm = local & even, ym = local & odd;
+    
+    // face edge pixels are looked up in the table
+    if (xm == 0 || xm == even || ym == 0 || ym == odd) {
+        const long *e = t->table + 8*(face*t->edge + ((t->nside > 1) ? perimeter(t->nside, compress(local), compress(local >> 1)) : 0));
+        for (int i = 0; i < 8; i++) { nb[i] = e[i]; }
+        return;
+    }
+    
+    // interior pixels step in interleaved coordinates
+    const long xinc = ((xm | odd) + 1) & even, xdec = (xm - 1) & even;
+    const long yinc = ((ym | even) + 2) & odd, ydec = (ym - 2) & odd;
+    
+    nb[NEIGHBOUR_SW] = base | xdec | ym;
+    nb[NEIGHBOUR_W]  = base | xdec | yinc;
+    nb[NEIGHBOUR_NW] = base | xm   | yinc;
+    nb[NEIGHBOUR_N]  = base | xinc | yinc;
+    nb[NEIGHBOUR_NE] = base | xinc | ym;
+    nb[NEIGHBOUR_E]  = base | xinc | ydec;
+    nb[NEIGHBOUR_SE] = base | xm   | ydec;
+    nb[NEIGHBOUR_S]  = base | xdec | ydec;
+}
+
+// queries larger than this are answered on multiple threads
+#define SERIAL_QUERY (1L<<16)
+
+// parallel batch query
+struct neighbours_job {
+    const neighbour_table *table;
+    const long *idx; long first, count;
+    long *nb, slices;
+};
+
+static void neighbours_slice(void *context, size_t s) {
+    const struct neighbours_job *job = context;
+    const long from = job->count*s/job->slices, to = job->count*(s+1)/job->slices;
+    
+    if (job->idx) { for (long i = from; i < to; i++) { neighbours(job->table, job->idx[i], job->nb + 8*i); } }
+    else { for (long i = from; i < to; i++) { neighbours(job->table, job->first + i, job->nb + 8*i); } }
+}
+
+void neighbours_batch(const neighbour_table *table, const long *idx, long first, long count, long *nb) {
+    long slices = neighbours_nthreads ? neighbours_nthreads : sysconf(_SC_NPROCESSORS_ONLN);
+    if (count < SERIAL_QUERY || slices < 2) { slices = 1; }
+    
+    struct neighbours_job job = { table, idx, first, count, nb, slices };
+    
+    if (slices > 1) { dispatch_apply_f(slices, DISPATCH_APPLY_AUTO, &job, neighbours_slice); }
+    else { neighbours_slice(&job, 0); }
+}
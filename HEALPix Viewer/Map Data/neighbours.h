@@ -0,0 +1,42 @@
+//
+//  neighbours.h
+//  HEALPix Viewer
+//
+//  Created by Andrei Frolov on 2026-10-17.
+//
+
+#ifndef neighbours_h
+#define neighbours_h
+
+// neighbours of NESTED pixels: within a face, neighbours of interior pixels follow
+// from bit arithmetic on interleaved face coordinates, so only pixels on face edges
+// (4*(nside-1) per face) have their neighbours stored, which takes 3 MB at nside 1024
+// and 25 MB at nside 8192; tables are cached per nside and shared by all maps
+
+// neighbour order (as in HEALPix), with -1 where a pixel has only 7 neighbours
+enum neighbour {
+    NEIGHBOUR_SW = 0, NEIGHBOUR_W, NEIGHBOUR_NW, NEIGHBOUR_N,
+    NEIGHBOUR_NE, NEIGHBOUR_E, NEIGHBOUR_SE, NEIGHBOUR_S
+};
+
+// neighbours of face edge pixels at resolution nside
+typedef struct {
+    long nside, order;          // map resolution (nside = 2^order)
+    long edge;                  // edge pixels per face
+    long *table;                // 8 neighbours of each edge pixel, by face and position along face perimeter
+} neighbour_table;
+
+// number of threads used by table construction and batch queries (0 = one per active CPU core)
+void neighbours_threads(int threads);
+
+// shared table for nside, built on first use (NULL if it could not be allocated)
+const neighbour_table *neighbours_for(long nside);
+
+// 8 neighbours of NESTED pixel p
+void neighbours(const neighbour_table *table, long p, long nb[8]);
+
+// 8 neighbours of each of NESTED pixels first..first+count-1 (or pixels idx[0..count)
+// if idx is not NULL), stored consecutively in nb[0..8*count)
+void neighbours_batch(const neighbour_table *table, const long *idx, long first, long count, long *nb);
+
+#endif /* neighbours_h */
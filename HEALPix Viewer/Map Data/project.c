@@ -0,0 +1,367 @@
+//
+//  project.c
+//  HEALPix Viewer
+//
+//  Created by Andrei Frolov on 2026-10-17.
+//  Pixel lookup adopted from HEALPix (chealpix.c)
+//  Copyright (C) 1997-2016 Krzysztof M. Gorski, Eric Hivon, Martin Reinecke,
+//                          Benjamin D. Wandelt, Anthony J. Banday,
+//                          Matthias Bartelmann, Reza Ansari & Kenneth M. Ganga
+//
+
+#include <math.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <dispatch/dispatch.h>
+#include "healpix.h"
+#include "project.h"
+
+// CPU counterpart of projection kernels in Shaders.metal: each image pixel is
+// mapped to projection plane by affine transform, inverse projection gives a
+// direction on the sphere (Projections.metal), which is rotated to the view
+// and looked up in NESTED map (Healpix.metal); arithmetic is kept in single
+// precision like on the GPU, so that both paths render the same pixels
+
+static const float pi = 3.141592653589793238462643383279502884197169399375f;
+static const float halfpi = 1.570796326794896619231321691639751442098584699688f;
+
+// MARK: projection metadata
+
+const char *projection_name(enum projection projection) {
+    static const char *names[PROJECTIONS] = {
+        "mollweide", "aitoff", "hammer", "lambert", "equidistant", "orthographic",
+        "stereographic", "gnomonic", "mercator", "cartesian", "werner"
+    };
+    
+    return (projection >= 0 && projection < PROJECTIONS) ? names[projection] : NULL;
+}
+
+void projection_extent(enum projection projection, double *x, double *y) {
+    switch (projection) {
+        case PROJECT_MOLLWEIDE:     *x = 2.0; *y = 1.0; break;
+        case PROJECT_AITOFF:
+        case PROJECT_CARTESIAN:     *x = M_PI; *y = M_PI/2.0; break;
+        case PROJECT_HAMMER:        *x = sqrt(8.0); *y = sqrt(2.0); break;
+        case PROJECT_EQUIDISTANT:   *x = M_PI; *y = M_PI; break;
+        case PROJECT_LAMBERT:
+        case PROJECT_STEREOGRAPHIC:
+        case PROJECT_GNOMONIC:      *x = 2.0; *y = 2.0; break;
+        case PROJECT_MERCATOR:      *x = M_PI; *y = 2.0; break;
+        case PROJECT_WERNER:        *x = 2.021610497; *y = 2.029609241; break;
+        default:                    *x = 1.0; *y = 1.0; break;
+    }
+}
+
+// MARK: view transforms
+
+// affine transform mapping image pixels to projection plane (column-major 3x2 matrix)
+void project_transform(enum projection projection, long width, long height, double padding, int flipx, float transform[6]) {
+    double x, y; projection_extent(projection, &x, &y);
+    
+    const double w = width, h = height, s = 2.0*(1.0+padding)*fmax(x/w, y/h);
+    const double x0 = -s*w/2.0, y0 = -s*h/2.0;
+    
+    transform[0] = flipx ? -s : s; transform[1] = 0.0;
+    transform[2] = 0.0; transform[3] = -s;
+    transform[4] = flipx ? -x0 : x0; transform[5] = -y0;
+}
+
+// 3x3 matrix product (column-major)
+static void matmul(const float *a, const float *b, float *c) {
+    for (int j = 0; j < 3; j++) for (int i = 0; i < 3; i++) {
+        c[3*j+i] = a[i]*b[3*j] + a[3+i]*b[3*j+1] + a[6+i]*b[3*j+2];
+    }
+}
+
+// rotation matrix turning view center to latitude, longitude and azimuth (column-major)
+void project_rotation(double lat, double lon, double az, float rotation[9]) {
+    const double radian = M_PI/180.0;
+    const float ct = cos(lat*radian), st = sin(lat*radian);
+    const float cp = cos(lon*radian), sp = sin(lon*radian);
+    const float ca = cos(-az*radian), sa = sin(-az*radian);
+    
+    const float xz[9] = { ct,0,st, 0,1,0, -st,0,ct };
+    const float xy[9] = { cp,sp,0, -sp,cp,0, 0,0,1 };
+    const float yz[9] = { 1,0,0, 0,ca,sa, 0,-sa,ca };
+    
+    float t[9]; matmul(xy, xz, t); matmul(t, yz, rotation);
+}
+
+// MARK: inverse projections (returning 0 if point is out of bounds)
+
+// convert polar coordinates to 3-vector on a sphere
+static inline void ang2vec(float theta, float phi, float *v) {
+    const float z = cosf(theta), r = sinf(theta);
+    v[0] = r*cosf(phi); v[1] = r*sinf(phi); v[2] = z;
+}
+
+static inline int mollweide(float x, float y, float *v) {
+    const float psi = asinf(y), phi = halfpi*x/cosf(psi), theta = acosf((2.0f*psi + sinf(2.0f*psi))/pi);
+    ang2vec(theta, phi, v); return !(y < -1.0f || y > 1.0f || phi < -pi || phi > pi);
+}
+
+static inline int hammer(float x, float y, float *v) {
+    const float p = x*x/4.0f + y*y, q = 1.0f - p/4.0f, z = sqrtf(q);
+    const float theta = acosf(z*y), phi = 2.0f*atanf(z*x/(2.0f*q-1.0f)/2.0f);
+    ang2vec(theta, phi, v); return !(p > 2.0f);
+}
+
+static inline int aitoff(float x, float y, float *v) {
+    const float a = sqrtf(x*x/4.0f + y*y), sinc = a > 0.0f ? sinf(a)/a : 1.0f;
+    const float z = y*sinc, r = sqrtf(1.0f-z*z), phi = 2.0f*asinf(0.5f*x*sinc/r);
+    v[0] = r*cosf(phi); v[1] = r*sinf(phi); v[2] = z; return !(a > pi/2.0f);
+}
+
+static inline int lambert(float x, float y, float *v) {
+    const float q = 1.0f - (x*x + y*y)/4.0f;
+    v[0] = 2.0f*q-1.0f; v[1] = sqrtf(q)*x; v[2] = sqrtf(q)*y; return !(q < 0.0f);
+}
+
+static inline int equidistant(float x, float y, float *v) {
+    const float theta = sqrtf(x*x + y*y), phi = atan2f(x,y); float u[3];
+    ang2vec(theta, phi, u); v[0] = u[2]; v[1] = u[1]; v[2] = u[0]; return !(theta > pi);
+}
+
+static inline int orthographic(float x, float y, float *v) {
+    const float q = 1.0f - (x*x + y*y);
+    v[0] = sqrtf(q); v[1] = x; v[2] = y; return !(q < 0.0f);
+}
+
+static inline int stereographic(float x, float y, float *v) {
+    const float s = 4.0f/(4.0f+x*x+y*y);
+    v[0] = 2.0f*s - 1.0f; v[1] = s*x; v[2] = s*y; return 1;
+}
+
+static inline int gnomonic(float x, float y, float *v) {
+    const float r = 1.0f/sqrtf(1.0f+x*x+y*y);
+    v[0] = r; v[1] = r*x; v[2] = r*y; return 1;
+}
+
+static inline int mercator(float x, float y, float *v) {
+    const float phi = x, theta = halfpi - atanf(sinhf(y));
+    ang2vec(theta, phi, v); return !(phi < -pi || phi > pi);
+}
+
+static inline int cartesian(float x, float y, float *v) {
+    const float phi = x, theta = halfpi - y;
+    ang2vec(theta, phi, v); return !(phi < -pi || phi > pi || theta < 0.0f || theta > pi);
+}
+
+static inline int werner(float x, float y, float *v) {
+    const float ux = x, uy = y - 1.111983413f;
+    const float theta = sqrtf(ux*ux + uy*uy), phi = theta/sinf(theta)*atan2f(ux,-uy);
+    ang2vec(theta, phi, v); return !(theta > pi || phi < -pi || phi > pi);
+}
+
+// MARK: HEALPix pixel lookup
+
+// NESTED pixel containing unit vector v
+static inline long vec2nest(long nside, const float *v) {
+    const long order = __builtin_ctzl(nside), mask = nside-1;
+    const float za = fabsf(v[2]), t = atan2f(v[1],v[0])/halfpi, u = (t < 0.0f) ? t+4.0f : t;
+    const float tt = (u < 4.0f) ? u : 0.0f; /* in [0,4), as t+4 rounds up to 4 for tiny negative t */
+    
+    if (za <= 2.0f/3.0f) /* Equatorial region */
+    {
+        const float temp1 = nside*(0.5f+tt), temp2 = nside*(v[2]*0.75f);
+        const long jp = (long)(temp1-temp2), ifp = jp/nside; /* index of  ascending edge line */
+        const long jm = (long)(temp1+temp2), ifm = jm/nside; /* index of descending edge line */
+        const long face = (ifp == ifm) ? (ifp|4) : ((ifp < ifm) ? ifp : ifm+8);
+        
+        return xyf2nest(order, jm & mask, nside - (jp & mask) - 1, face);
+    }
+    else /* polar region, za > 2/3 */
+    {
+        const long ntt = ((long)tt < 3) ? (long)tt : 3;
+        const float tp = tt-ntt, tmp = nside*sqrtf(3.0f*(1.0f-za));
+        const long jp = ((long)(tp*tmp) < mask) ? (long)(tp*tmp) : mask; /* increasing edge line index */
+        const long jm = ((long)((1.0f-tp)*tmp) < mask) ? (long)((1.0f-tp)*tmp) : mask; /* decreasing edge line index */
+        
+        return (v[2] >= 0.0f) ? xyf2nest(order, mask-jm, mask-jp, ntt) : xyf2nest(order, jp, jm, ntt+8);
+    }
+}
+
+// face coordinates of unit vector v, continuous in [0,nside] (pixel (x,y) covers [x,x+1)x[y,y+1))
+static inline long vec2xyf(long nside, const float *v, float *x, float *y) {
+    const float za = fabsf(v[2]), t = atan2f(v[1],v[0])/halfpi, u = (t < 0.0f) ? t+4.0f : t;
+    const float tt = (u < 4.0f) ? u : 0.0f; /* in [0,4), as t+4 rounds up to 4 for tiny negative t */
+    const float n = nside; long face;
+    
+    if (za <= 2.0f/3.0f) /* Equatorial region */
+    {
+        const float temp1 = n*(0.5f+tt), temp2 = n*(v[2]*0.75f);
+        const long ifp = (long)(temp1-temp2)/nside, ifm = (long)(temp1+temp2)/nside;
+        
+        face = (ifp == ifm) ? (ifp|4) : ((ifp < ifm) ? ifp : ifm+8);
+        *x = temp1+temp2 - n*ifm; *y = n - (temp1-temp2 - n*ifp);
+    }
+    else /* polar region, za > 2/3 */
+    {
+        const long ntt = ((long)tt < 3) ? (long)tt : 3;
+        const float tp = tt-ntt, tmp = n*sqrtf(3.0f*(1.0f-za));
+        
+        if (v[2] >= 0.0f) { face = ntt; *x = n - (1.0f-tp)*tmp; *y = n - tp*tmp; }
+        else { face = ntt+8; *x = tp*tmp; *y = (1.0f-tp)*tmp; }
+    }
+    
+    *x = fminf(fmaxf(*x, 0.0f), n); *y = fminf(fmaxf(*y, 0.0f), n);
+    return face;
+}
+
+// bilinear interpolation between pixel centers within a face, clamped at face
+// edges like a texture sampler with clamp to edge addressing; missing (NaN)
+// neighbours are dropped and remaining weights renormalized
+static inline float bilinear(const float *map, long nside, const float *v) {
+    float x, y; const long face = vec2xyf(nside, v, &x, &y), order = __builtin_ctzl(nside);
+    const float sx = x - 0.5f, sy = y - 0.5f, fx = floorf(sx), fy = floorf(sy), wx = sx - fx, wy = sy - fy;
+    const long x0 = (fx < 0.0f) ? 0 : (long)fx, y0 = (fy < 0.0f) ? 0 : (long)fy;
+    const long x1 = (x0+1 < nside && sx >= 0.0f) ? x0+1 : x0, y1 = (y0+1 < nside && sy >= 0.0f) ? y0+1 : y0;
+    
+    const float a[4] = { map[xyf2nest(order, x0, y0, face)], map[xyf2nest(order, x1, y0, face)], map[xyf2nest(order, x0, y1, face)], map[xyf2nest(order, x1, y1, face)] };
+    const float w[4] = { (1.0f-wx)*(1.0f-wy), wx*(1.0f-wy), (1.0f-wx)*wy, wx*wy };
+    float sum = 0.0f, norm = 0.0f;
+    
+    for (int k = 0; k < 4; k++) { if (!isnan(a[k])) { sum += w[k]*a[k]; norm += w[k]; } }
+    
+    return (norm > 0.0f) ? sum/norm : NAN;
+}
+
+// MARK: antialiasing
+
+// projection scale correction (as Projection.lod in the app)
+static double projection_lod(enum projection projection) {
+    switch (projection) {
+        case PROJECT_MOLLWEIDE:
+        case PROJECT_ORTHOGRAPHIC:
+        case PROJECT_STEREOGRAPHIC:
+        case PROJECT_WERNER:        return 0.625;
+        case PROJECT_AITOFF:
+        case PROJECT_MERCATOR:      return 0.875;
+        case PROJECT_HAMMER:
+        case PROJECT_EQUIDISTANT:   return 0.750;
+        case PROJECT_LAMBERT:       return 0.500;
+        case PROJECT_GNOMONIC:      return 1.750;
+        default:                    return 0.0;
+    }
+}
+
+// pyramid level matching image resolution (as MapView.lod), limited to texture mipmaps
+int project_lod(enum projection projection, const float transform[6], long nside, enum antialiasing antialiasing) {
+    const double det = (double) transform[0]*transform[3] - (double) transform[1]*transform[2];
+    const int lod = (int)(log2(sqrt(fabs(det))*nside) - projection_lod(projection) + 0.5);
+    int levels = 0; while ((nside >> levels) > 16) { levels++; }
+    
+    switch (antialiasing) {
+        case ANTIALIAS_NONE: return 0;
+        case ANTIALIAS_LESS: return (lod-1 < 0) ? 0 : ((lod-1 < levels) ? lod-1 : levels);
+        case ANTIALIAS_MORE: return (lod+1 < 0) ? 0 : ((lod+1 < levels) ? lod+1 : levels);
+        default:             return 0;
+    }
+}
+
+// MARK: parallel projection
+// image is split into square tiles (so that neighbouring pixels hit the same map
+// regions in cache), which are rendered concurrently by libdispatch workers; each
+// tile row is evaluated in batches of pixels, one stage at a time over arrays,
+// so that the affine transform, rotation and lookup loops vectorize
+
+// images with fewer pixels than this are projected on a single thread
+#define SERIAL_PIXELS (1L<<16)
+
+// tile size (in pixels) and number of pixels evaluated in a batch
+#define TILE  64
+#define BATCH 16
+
+// number of worker threads (0 = one per active CPU core)
+static int project_nthreads = 0;
+
+void project_threads(int threads) { project_nthreads = (threads > 0) ? threads : 0; }
+
+// parallel projection job
+struct project_job {
+    const float *map; long nside;
+    enum projection projection;
+    enum interpolation interpolation;
+    const float *transform, *rotation;
+    float *out; unsigned char *inside;
+    long width, height, tiles, slices;
+};
+
+// inverse projection of a batch, with projection switch hoisted out of the loop
+static void unproject_batch(enum projection projection, const float *x, const float *y, float u[3][BATCH], int *in, int n) {
+    #define UNPROJECT(f) for (int k = 0; k < n; k++) { float v[3]; in[k] = f(x[k], y[k], v); u[0][k] = v[0]; u[1][k] = v[1]; u[2][k] = v[2]; } break;
+    
+    switch (projection) {
+        case PROJECT_MOLLWEIDE:     UNPROJECT(mollweide)
+        case PROJECT_AITOFF:        UNPROJECT(aitoff)
+        case PROJECT_HAMMER:        UNPROJECT(hammer)
+        case PROJECT_LAMBERT:       UNPROJECT(lambert)
+        case PROJECT_EQUIDISTANT:   UNPROJECT(equidistant)
+        case PROJECT_ORTHOGRAPHIC:  UNPROJECT(orthographic)
+        case PROJECT_STEREOGRAPHIC: UNPROJECT(stereographic)
+        case PROJECT_GNOMONIC:      UNPROJECT(gnomonic)
+        case PROJECT_MERCATOR:      UNPROJECT(mercator)
+        case PROJECT_CARTESIAN:     UNPROJECT(cartesian)
+        case PROJECT_WERNER:        UNPROJECT(werner)
+        default:                    for (int k = 0; k < n; k++) { in[k] = 0; u[0][k] = u[1][k] = u[2][k] = 0.0f; } break;
+    }
+    
+    #undef UNPROJECT
+}
+
+// project a run of n <= BATCH pixels in image row j, starting at column i
+static void project_batch(const struct project_job *job, long i, long j, int n, float *out, unsigned char *inside) {
+    const float *t = job->transform, *R = job->rotation;
+    float x[BATCH], y[BATCH], u[3][BATCH], v[3][BATCH]; int in[BATCH];
+    
+    // image pixels to projection plane
+    for (int k = 0; k < n; k++) { x[k] = t[0]*(i+k) + t[2]*j + t[4]; y[k] = t[1]*(i+k) + t[3]*j + t[5]; }
+    
+    // projection plane to sphere, rotated to the view
+    unproject_batch(job->projection, x, y, u, in, n);
+    
+    for (int r = 0; r < 3; r++) for (int k = 0; k < n; k++) {
+        v[r][k] = R[r]*u[0][k] + R[3+r]*u[1][k] + R[6+r]*u[2][k];
+    }
+    
+    // map lookup; degenerate points (e.g. Hammer projection pole) are treated as missing data
+    for (int k = 0; k < n; k++) {
+        const float w[3] = { v[0][k], v[1][k], v[2][k] };
+        
+        if (!in[k] || !isfinite(w[0]+w[1]+w[2])) { out[k] = NAN; }
+        else if (job->interpolation == PROJECT_BILINEAR) { out[k] = bilinear(job->map, job->nside, w); }
+        else { out[k] = job->map[vec2nest(job->nside, w)]; }
+    }
+    
+    if (inside) { for (int k = 0; k < n; k++) { inside[k] = in[k]; } }
+}
+
+// project tiles of a single slice of the job (tiles are dealt out round robin)
+static void project_slice(void *context, size_t s) {
+    const struct project_job *job = context;
+    const long columns = (job->width + TILE-1)/TILE;
+    
+    for (long k = s; k < job->tiles; k += job->slices) {
+        const long i0 = (k % columns)*TILE, j0 = (k / columns)*TILE;
+        const long i1 = (i0+TILE < job->width) ? i0+TILE : job->width, j1 = (j0+TILE < job->height) ? j0+TILE : job->height;
+        
+        for (long j = j0; j < j1; j++) for (long i = i0; i < i1; i += BATCH) {
+            const long offset = j*job->width + i; const int n = (i+BATCH < i1) ? BATCH : (int)(i1-i);
+            project_batch(job, i, j, n, job->out + offset, job->inside ? job->inside + offset : NULL);
+        }
+    }
+}
+
+// project NESTED map onto image
+void project_map(const float *map, long nside, enum projection projection, enum interpolation interpolation, const float transform[6], const float rotation[9],
+                 float *out, unsigned char *inside, long width, long height) {
+    const long tiles = ((width + TILE-1)/TILE) * ((height + TILE-1)/TILE);
+    long slices = project_nthreads ? project_nthreads : sysconf(_SC_NPROCESSORS_ONLN);
+    if (width*height < SERIAL_PIXELS || slices < 2) { slices = 1; }
+    if (slices > tiles) { slices = tiles; }
+    
+    struct project_job job = { map, nside, projection, interpolation, transform, rotation, out, inside, width, height, tiles, slices };
+    
+    if (slices > 1) { dispatch_apply_f(slices, DISPATCH_APPLY_AUTO, &job, project_slice); }
+    else { project_slice(&job, 0); }
+}
@@ -0,0 +1,65 @@
+//
+//  project.h
+//  HEALPix Viewer
+//
+//  Created by Andrei Frolov on 2026-10-17.
+//
+
+#ifndef project_h
+#define project_h
+
+// map projections (in the same order as Projection enum in the app)
+enum projection {
+    PROJECT_MOLLWEIDE = 0,
+    PROJECT_AITOFF,
+    PROJECT_HAMMER,
+    PROJECT_LAMBERT,
+    PROJECT_EQUIDISTANT,
+    PROJECT_ORTHOGRAPHIC,
+    PROJECT_STEREOGRAPHIC,
+    PROJECT_GNOMONIC,
+    PROJECT_MERCATOR,
+    PROJECT_CARTESIAN,
+    PROJECT_WERNER,
+    PROJECTIONS
+};
+
+// map interpolation (nearest pixel, as on the GPU, or bilinear between pixel centers)
+enum interpolation {
+    PROJECT_NEAREST = 0,
+    PROJECT_BILINEAR
+};
+
+// antialiasing (in the same order as AntiAliasing enum in the app)
+enum antialiasing {
+    ANTIALIAS_NONE = 0,
+    ANTIALIAS_LESS,
+    ANTIALIAS_MORE
+};
+
+// projection names and bounds of projection plane (x and y extent)
+const char *projection_name(enum projection projection);
+void projection_extent(enum projection projection, double *x, double *y);
+
+// number of threads used by projection (0 = one per active CPU core)
+void project_threads(int threads);
+
+// affine transform mapping image pixels to projection plane, fitting projection
+// into width x height image with relative padding around it (rows go from top to
+// bottom, flipx mirrors the image as seen from inside the sphere)
+void project_transform(enum projection projection, long width, long height, double padding, int flipx, float transform[6]);
+
+// rotation matrix turning view center to latitude, longitude and azimuth (in degrees)
+void project_rotation(double lat, double lon, double az, float rotation[9]);
+
+// level of detail to sample for given image transform, as chosen by the app: level
+// k > 0 is a map degraded to nside/2^k (level k-1 of pyramid_build output), down to
+// the coarsest texture mipmap at nside = 16
+int project_lod(enum projection projection, const float transform[6], long nside, enum antialiasing antialiasing);
+
+// project NESTED map onto width x height image (rows stored contiguously); pixels
+// outside of projection get NaN value, and are flagged in inside mask if it is not NULL
+void project_map(const float *map, long nside, enum projection projection, enum interpolation interpolation, const float transform[6], const float rotation[9],
+                 float *out, unsigned char *inside, long width, long height);
+
+#endif /* project_h */
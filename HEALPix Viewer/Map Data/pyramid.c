@@ -0,0 +1,242 @@
+//
+//  pyramid.c
+//  HEALPix Viewer
+//
+//  Created by Andrei Frolov on 2026-10-17.
+//
+
+#include <math.h>
+#include <float.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <dispatch/dispatch.h>
+#include "pyramid.h"
+
+// multi-resolution pyramid of a NESTED map: children of a pixel are four
+// consecutive pixels, so each degrade step is a contiguous 4-to-1 reduction;
+// sums and counts of finite values are carried from level to level, so that
+// every level is an exact average of the full resolution pixels it covers
+
+// MARK: vectorized 4-to-1 reduction
+// LANES groups of four are deinterleaved by a shuffle tree and summed at once,
+// non-finite values are masked out of sums and counts without branching; map
+// values are widened to double before the first sum, so sums and counts of
+// all levels are carried in double precision
+
+#define LANES 4
+
+typedef float  vfloat  __attribute__((vector_size(LANES*sizeof(float))));
+typedef double vdouble __attribute__((vector_size(LANES*sizeof(double))));
+typedef int    vmask   __attribute__((vector_size(LANES*sizeof(int))));
+
+// sums of adjacent pairs of 2*LANES values
+static inline vdouble pairs(vdouble a, vdouble b) {
+    return __builtin_shufflevector(a, b, 0, 2, 4, 6) + __builtin_shufflevector(a, b, 1, 3, 5, 7);
+}
+
+// sums of groups of four among 4*LANES values
+static inline vdouble quads(const vdouble *v) { return pairs(pairs(v[0], v[1]), pairs(v[2], v[3])); }
+
+// store LANES group sums, counts and averages, updating average bounds
+static inline void store(vdouble vs, vdouble vc, double *s, double *c, float *avg, vfloat *vmin, vfloat *vmax) {
+    const vfloat v = __builtin_convertvector(vs/vc, vfloat);
+    memcpy(s, &vs, sizeof(vs)); memcpy(c, &vc, sizeof(vc)); memcpy(avg, &v, sizeof(v));
+    
+    const vmask lt = (v < *vmin), gt = (v > *vmax);
+    *vmin = (vfloat)(((vmask)v & lt) | ((vmask)*vmin & ~lt));
+    *vmax = (vfloat)(((vmask)v & gt) | ((vmask)*vmax & ~gt));
+}
+
+// store a single group sum, count and average, updating average bounds
+static inline void store1(double vs, double vc, double *s, double *c, float *avg, float *min, float *max) {
+    const float v = vs/vc; *s = vs; *c = vc; *avg = v;
+    
+    if (v < *min) { *min = v; }
+    if (v > *max) { *max = v; }
+}
+
+// fold vector bounds into scalar ones
+static inline void bounds(vfloat vmin, vfloat vmax, float *min, float *max) {
+    for (int k = 0; k < LANES; k++) {
+        if (vmin[k] < *min) { *min = vmin[k]; }
+        if (vmax[k] > *max) { *max = vmax[k]; }
+    }
+}
+
+// reduce n groups of four map values, storing group sums, counts, and averages
+static void reduce_map(const float *in, double *s, double *c, float *avg, long n, float *min, float *max) {
+    const vfloat zero = {}, one = zero + 1.0f;
+    vfloat vmin = zero + *min, vmax = zero + *max;
+    long i = 0;
+    
+    for (; i + LANES <= n; i += LANES) {
+        vfloat x[4]; vdouble xs[4], ws[4]; memcpy(x, in + 4*i, sizeof(x));
+        
+        for (int k = 0; k < 4; k++) {
+            const vmask finite = (x[k] - x[k] == zero);
+            xs[k] = __builtin_convertvector((vfloat)((vmask)x[k] & finite), vdouble);
+            ws[k] = __builtin_convertvector((vfloat)((vmask)one & finite), vdouble);
+        }
+        
+        store(quads(xs), quads(ws), s+i, c+i, avg+i, &vmin, &vmax);
+    }
+    
+    bounds(vmin, vmax, min, max);
+    
+    for (; i < n; i++) {
+        double vs = 0.0, vc = 0.0;
+        for (int k = 0; k < 4; k++) { const float x = in[4*i+k]; if (isfinite(x)) { vs += x; vc += 1.0; } }
+        store1(vs, vc, s+i, c+i, avg+i, min, max);
+    }
+}
+
+// reduce n groups of four sums and counts, storing group sums, counts, and
+// averages (output sums and counts may overwrite input)
+static void reduce_sums(const double *sum, const double *cnt, double *s, double *c, float *avg, long n, float *min, float *max) {
+    const vfloat zero = {};
+    vfloat vmin = zero + *min, vmax = zero + *max;
+    long i = 0;
+    
+    for (; i + LANES <= n; i += LANES) {
+        vdouble x[4], w[4]; memcpy(x, sum + 4*i, sizeof(x)); memcpy(w, cnt + 4*i, sizeof(w));
+        store(quads(x), quads(w), s+i, c+i, avg+i, &vmin, &vmax);
+    }
+    
+    bounds(vmin, vmax, min, max);
+    
+    for (; i < n; i++) {
+        double vs = 0.0, vc = 0.0;
+        for (int k = 0; k < 4; k++) { vs += sum[4*i+k]; vc += cnt[4*i+k]; }
+        store1(vs, vc, s+i, c+i, avg+i, min, max);
+    }
+}
+
+// MARK: parallel pyramid construction
+// map is split into chunks of full resolution pixels degraded down to a single
+// pixel while they are still in cache, chunks are processed concurrently by
+// libdispatch workers, and the remaining coarse levels are reduced at the end
+
+// full resolution pixels in a chunk (4^CHUNK_ORDER at most)
+#define CHUNK_ORDER 8
+
+// maps with fewer pixels than this are degraded on a single thread
+#define SERIAL_NPIX (1L<<20)
+
+// number of worker threads (0 = one per active CPU core)
+static int pyramid_nthreads = 0;
+
+void pyramid_threads(int threads) { pyramid_nthreads = (threads > 0) ? threads : 0; }
+
+// parallel pyramid job
+struct pyramid_job {
+    const float *in; float **out;
+    long chunk, chunks, slices;
+    int depth, levels;
+    double *sum, *cnt;
+    double *scratch;
+    float *min, *max;
+};
+
+// degrade chunks of a single slice of the job
+static void pyramid_slice(void *context, size_t k) {
+    const struct pyramid_job *job = context;
+    const long first = job->chunks*k/job->slices, last = job->chunks*(k+1)/job->slices, half = job->chunk/4;
+    float *minval = job->min + k*job->levels, *maxval = job->max + k*job->levels;
+    
+    // ping-pong buffers for sums and counts of intermediate levels
+    double *buffer = job->scratch + 4*half*k;
+    double *s[2] = { buffer, buffer + half }, *c[2] = { buffer + 2*half, buffer + 3*half };
+    
+    for (int l = 0; l < job->levels; l++) { minval[l] = FLT_MAX; maxval[l] = -FLT_MAX; }
+    
+    for (long j = first; j < last; j++) {
+        const double *sum = NULL, *cnt = NULL;
+        
+        for (long l = 0, n = half; l < job->depth; l++, n /= 4) {
+            double *ps = (l < job->depth-1) ? s[l&1] : job->sum + j;
+            double *pc = (l < job->depth-1) ? c[l&1] : job->cnt + j;
+            
+            if (l == 0) { reduce_map(job->in + j*job->chunk, ps, pc, job->out[l] + j*n, n, minval+l, maxval+l); }
+            else { reduce_sums(sum, cnt, ps, pc, job->out[l] + j*n, n, minval+l, maxval+l); }
+            
+            sum = ps; cnt = pc;
+        }
+    }
+}
+
+// degrade NESTED map to all lower resolutions
+int pyramid_build(const float *in, long nside, float **out, double *min, double *max) {
+    int levels = 0; while ((1L << levels) < nside) { levels++; }
+    if (levels == 0) { return 0; }
+    
+    const int depth = (levels < CHUNK_ORDER) ? levels : CHUNK_ORDER;
+    const long npix = 12*nside*nside, chunk = 1L << (2*depth), chunks = npix/chunk;
+    
+    long slices = pyramid_nthreads ? pyramid_nthreads : sysconf(_SC_NPROCESSORS_ONLN);
+    if (npix < SERIAL_NPIX || slices < 2) { slices = 1; }
+    if (slices > chunks) { slices = chunks; }
+    
+    double *sum = malloc(2*chunks*sizeof(double)), *cnt = sum + chunks;
+    double *scratch = malloc(slices*chunk*sizeof(double));
+    float *minval = malloc(2*slices*levels*sizeof(float)), *maxval = minval + slices*levels;
+    if (!sum || !scratch || !minval) { free(sum); free(scratch); free(minval); return -1; }
+    
+    struct pyramid_job job = { in, out, chunk, chunks, slices, depth, levels, sum, cnt, scratch, minval, maxval };
+    
+    if (slices > 1) { dispatch_apply_f(slices, DISPATCH_APPLY_AUTO, &job, pyramid_slice); }
+    else { pyramid_slice(&job, 0); }
+    
+    for (long k = 1; k < slices; k++) {
+        for (int l = 0; l < depth; l++) {
+            if (minval[k*levels+l] < minval[l]) { minval[l] = minval[k*levels+l]; }
+            if (maxval[k*levels+l] > maxval[l]) { maxval[l] = maxval[k*levels+l]; }
+        }
+    }
+    
+    // coarse levels are reduced in place from chunk totals
+    for (long l = depth, n = chunks/4; l < levels; l++, n /= 4) {
+        reduce_sums(sum, cnt, sum, cnt, out[l], n, minval+l, maxval+l);
+    }
+    
+    for (int l = 0; l < levels; l++) {
+        min[l] = (minval[l] <= maxval[l]) ? minval[l] : NAN;
+        max[l] = (minval[l] <= maxval[l]) ? maxval[l] : NAN;
+    }
+    
+    free(minval);
+    free(scratch);
+    free(sum);
+    
+    return 0;
+}
+
+// MARK: coarse preview of streamed maps
+// converted pixels are accumulated into sums and counts of coarse pixels as they
+// arrive (in any order), so that a preview can be averaged out at any moment
+
+// accumulate finite pixels first..first+count-1 (or idx[0..count) if idx is not NULL),
+// stored at positions pos[0..count) of map data (or at pixel index if pos is NULL)
+void pyramid_accumulate(const float *map, const long *pos, const long *idx, long first, long count, long block, double *sum, double *cnt) {
+    const int shift = __builtin_ctzl(block);
+    
+    for (long i = 0; i < count; i++) {
+        const long p = idx ? idx[i] : first+i; const float v = map[pos ? pos[i] : p];
+        if (isfinite(v)) { sum[p >> shift] += v; cnt[p >> shift] += 1.0; }
+    }
+}
+
+// average accumulated sums into coarse map (NaN where nothing was accumulated yet)
+void pyramid_average(const double *sum, const double *cnt, float *out, long npix, double *min, double *max) {
+    float minval = FLT_MAX, maxval = -FLT_MAX;
+    
+    for (long i = 0; i < npix; i++) {
+        const float v = (cnt[i] > 0.0) ? sum[i]/cnt[i] : NAN; out[i] = v;
+        
+        if (v < minval) { minval = v; }
+        if (v > maxval) { maxval = v; }
+    }
+    
+    *min = (minval <= maxval) ? minval : NAN;
+    *max = (minval <= maxval) ? maxval : NAN;
+}
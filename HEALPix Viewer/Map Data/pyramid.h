@@ -0,0 +1,30 @@
+//
+//  pyramid.h
+//  HEALPix Viewer
+//
+//  Created by Andrei Frolov on 2026-10-17.
+//
+
+#ifndef pyramid_h
+#define pyramid_h
+
+// number of threads used by pyramid construction (0 = one per active CPU core)
+void pyramid_threads(int threads);
+
+// degrade NESTED map to all lower resolutions in a single pass; out[k] receives
+// level k = 0..log2(nside)-1 at resolution nside/2^(k+1), each pixel being the
+// average of finite full resolution pixels it covers (NaN if there are none),
+// and min[k], max[k] receive data bounds of the level; returns 0 on success,
+// -1 if working buffers could not be allocated
+int pyramid_build(const float *in, long nside, float **out, double *min, double *max);
+
+// accumulate finite NESTED pixels first..first+count-1 of a map being converted
+// (or pixels idx[0..count) if idx is not NULL) into sums and counts of coarse
+// pixels, each covering block (a power of 4) full resolution pixels; pixel
+// values are read at positions pos[0..count) of sparse map data if pos is not NULL
+void pyramid_accumulate(const float *map, const long *pos, const long *idx, long first, long count, long block, double *sum, double *cnt);
+
+// average accumulated sums into coarse map of npix pixels, returning its data bounds
+void pyramid_average(const double *sum, const double *cnt, float *out, long npix, double *min, double *max);
+
+#endif /* pyramid_h */
@@ -147,7 +147,7 @@ typedef const float CMPDATA;
 #define FUNC(NAME) NAME##64
 #define STRUCT(NAME) struct NAME##64
 
-//#include "quadsort.c"
+#include "quadsort.c"
 
 //////////////////////////////////////////////////////////
 //┌────────────────────────────────────────────────────┐//
@@ -200,8 +200,8 @@ void quadsort(void *array, size_t nmemb, size_t size, CMPDATA *data)
 		case sizeof(int):
 			return quadsort32(array, nmemb, data);
 
-		//case sizeof(long long):
-		//	return quadsort64(array, nmemb, data);
+		case sizeof(long long):
+			return quadsort64(array, nmemb, data);
 
 		//case sizeof(long double):
 		//	return quadsort128(array, nmemb, data);
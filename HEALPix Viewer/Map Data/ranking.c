@@ -7,22 +7,207 @@
 
 #include <math.h>
 #include <float.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <dispatch/dispatch.h>
 #include "ranking.h"
 #include "quadsort.h"
 
-// build index of regular map values
-void index_map(const float *data, const int npix, int *index, int *nobs) {
-    register int k = 0; for (int i = 0; i < npix; i++) { if (isfinite(data[i])) { index[k] = i; k++; } }
-    *nobs = k; quadsort(index, *nobs, sizeof(int), data);
+// map indexing backends, instantiated from ranking.tmpl for 32-bit pixel
+// indices (good to nside = 8192, half the memory) and 64-bit ones (beyond);
+// index_map?? sorts finite pixels by map value, rank_map?? equalizes map
+
+// MARK: parallel sort of map index
+// large indices are split into partitions which are quadsorted concurrently,
+// and then merged pairwise; each merge is itself split into equal output
+// slices by co-ranking, so all threads stay busy until the very last pass
+// (merges take from the left run on ties, so the result is identical to
+// the serial quadsort, which is stable)
+
+// indices shorter than this are sorted serially
+#define SERIAL_NOBS (1<<20)
+
+// number of threads used by index sort (0 = one per active CPU core)
+static int ranking_nthreads = 0;
+
+void ranking_threads(int threads) { ranking_nthreads = threads; }
+
+// threads actually used: splitting work beyond active cores only adds merge passes
+static long ranking_workers(void) {
+    const long ncpu = sysconf(_SC_NPROCESSORS_ONLN), threads = ranking_nthreads > 0 ? ranking_nthreads : ncpu;
+    return (threads < ncpu) ? threads : (ncpu > 0 ? ncpu : 1);
+}
+
+// MARK: radix sort of map index
+// (map value, pixel) pairs are packed into 64-bit words, with float bits flipped
+// so that unsigned order matches float order, and sorted by LSD radix passes
+// over the value half only; pixels enter in ascending order and passes are
+// stable, so ties come out exactly as from the stable quadsort (-0 and +0
+// compare equal there, so negative zero is folded into positive one)
+
+// radix digit width and number of passes over 32-bit keys
+#define RADIX_BITS 11
+#define RADIX_SIZE (1<<RADIX_BITS)
+#define RADIX_PASSES ((32 + RADIX_BITS - 1)/RADIX_BITS)
+
+// indices shorter than this are quadsorted
+#define RADIX_NOBS (1<<16)
+
+// sorting backend used by index_map
+static enum ranking_backend ranking_sorter = RANKING_AUTO;
+
+void ranking_backend(enum ranking_backend backend) { ranking_sorter = backend; }
+
+// parallel job description
+struct radix_job {
+    const float *data;
+    void *index;
+    uint64_t *from, *to;
+    long nobs, slices, pass;
+    long *count;
+};
+
+// order-preserving unsigned key of a finite float value
+static inline uint32_t radix_key(float v) {
+    uint32_t u; v += 0.0f; memcpy(&u, &v, sizeof(u));
+    return (u & 0x80000000) ? ~u : (u | 0x80000000);
 }
 
-// rank unique map values (i.e. equalize map)
-void rank_map(const float *data, const int *index, const int nobs, float *ranked) {
-    register float v = NAN;
-    for (int i = 0, j = 0; i < nobs; i++) {
-        const register int k = index[i];
-        const register float u = data[k];
-        if (u != v) { v = u; j = i; }
-        ranked[k] = (j+0.5)/nobs;
+// count current digits in a slice of pairs
+static void radix_count(void *context, size_t k) {
+    const struct radix_job *job = context; const int shift = 32 + job->pass*RADIX_BITS;
+    const long from = job->nobs*k/job->slices, to = job->nobs*(k+1)/job->slices;
+    long *count = job->count + k*RADIX_SIZE;
+    
+    memset(count, 0, RADIX_SIZE*sizeof(long));
+    for (long i = from; i < to; i++) { count[(job->from[i] >> shift) & (RADIX_SIZE-1)]++; }
+}
+
+// scatter a slice of pairs by current digit (offsets are precomputed per slice)
+static void radix_scatter(void *context, size_t k) {
+    const struct radix_job *job = context; const int shift = 32 + job->pass*RADIX_BITS;
+    const long from = job->nobs*k/job->slices, to = job->nobs*(k+1)/job->slices;
+    long *offset = job->count + k*RADIX_SIZE;
+    
+    for (long i = from; i < to; i++) {
+        const uint64_t x = job->from[i];
+        job->to[offset[(x >> shift) & (RADIX_SIZE-1)]++] = x;
+    }
+}
+
+// sort packed pairs by value in radix passes, returning 0 if there is not enough memory
+static int radix_sort(struct radix_job *job, void (*pack)(void *, size_t), void (*unpack)(void *, size_t)) {
+    const long nobs = job->nobs, threads = ranking_workers();
+    const long slices = (nobs < SERIAL_NOBS || threads < 2) ? 1 : threads;
+    
+    // pair buffers should not take more than a quarter of physical memory
+    const long memory = sysconf(_SC_PHYS_PAGES)*sysconf(_SC_PAGESIZE);
+    if (memory > 0 && 2*nobs*(long) sizeof(uint64_t) > memory/4) { return 0; }
+    
+    uint64_t *from = malloc(nobs*sizeof(uint64_t)), *to = malloc(nobs*sizeof(uint64_t));
+    long *count = malloc(slices*RADIX_SIZE*sizeof(long));
+    if (!from || !to || !count) { free(from); free(to); free(count); return 0; }
+    
+    job->from = from; job->to = to; job->slices = slices; job->count = count;
+    dispatch_apply_f(slices, DISPATCH_APPLY_AUTO, job, pack);
+    
+    for (job->pass = 0; job->pass < RADIX_PASSES; job->pass++) {
+        long total = 0, trivial = 0;
+        
+        dispatch_apply_f(slices, DISPATCH_APPLY_AUTO, job, radix_count);
+        
+        // turn digit counts into slice offsets (digit-major, so scatter is stable)
+        for (long d = 0; d < RADIX_SIZE; d++) {
+            long sum = 0;
+            
+            for (long k = 0; k < slices; k++) {
+                long *c = count + k*RADIX_SIZE + d;
+                const long n = *c; *c = total; total += n; sum += n;
+            }
+            
+            if (sum == nobs) { trivial = 1; }
+        }
+        
+        // skip passes where all values share the digit
+        if (trivial) { continue; }
+        
+        dispatch_apply_f(slices, DISPATCH_APPLY_AUTO, job, radix_scatter);
+        uint64_t *t = job->from; job->from = job->to; job->to = t;
     }
+    
+    dispatch_apply_f(slices, DISPATCH_APPLY_AUTO, job, unpack);
+    free(from); free(to); free(count);
+    
+    return 1;
 }
+
+// MARK: approximate map ranking
+// ranks are interpolated in CDF sampled at equally spaced ranks (such as
+// quantiles of the sketch taken while map was loaded), so that equalized map
+// can be shown before the exact index is sorted; tied values get the rank
+// of the first CDF sample they match, as rank_map gives them the first rank
+
+// parallel job description
+struct cdf_job {
+    const float *data; float *ranked;
+    const double *cdf; int n;
+    long npix, slices;
+};
+
+// rank a slice of map values
+static void rank_cdf_slice(void *context, size_t k) {
+    const struct cdf_job *job = context; const double *cdf = job->cdf; const int n = job->n;
+    const long from = job->npix*k/job->slices, to = job->npix*(k+1)/job->slices;
+    
+    for (long i = from; i < to; i++) {
+        const double v = job->data[i];
+        
+        if (!isfinite(v)) { job->ranked[i] = NAN; continue; }
+        if (v <= cdf[0]) { job->ranked[i] = 0.0; continue; }
+        if (v > cdf[n]) { job->ranked[i] = 1.0; continue; }
+        
+        // bracket value so that cdf[lo] < v <= cdf[lo+1]
+        int lo = 0, hi = n;
+        while (hi - lo > 1) { const int mid = (lo+hi)/2; if (cdf[mid] < v) { lo = mid; } else { hi = mid; } }
+        
+        job->ranked[i] = (lo + (v - cdf[lo])/(cdf[hi] - cdf[lo]))/n;
+    }
+}
+
+void rank_cdf(const float *data, long npix, const double *cdf, int n, float *ranked) {
+    const long threads = ranking_workers(), slices = (npix < SERIAL_NOBS || threads < 2) ? 1 : threads;
+    struct cdf_job job = { data, ranked, cdf, n, npix, slices };
+    
+    if (n < 1) { for (long i = 0; i < npix; i++) { ranked[i] = NAN; } return; }
+    dispatch_apply_f(slices, DISPATCH_APPLY_AUTO, &job, rank_cdf_slice);
+}
+
+// MARK: map ranking, 32-bit pixel index
+#define INDEX  int
+#define RANK(name) name##32
+#define SORT   quadsort32
+#define INDEX_MAP void index_map(const float *data, const int npix, int *index, int *nobs)
+#define RANK_MAP  void rank_map(const float *data, const int *index, const int nobs, float *ranked)
+#include "ranking.tmpl"
+#undef INDEX
+#undef RANK
+#undef SORT
+#undef INDEX_MAP
+#undef RANK_MAP
+
+// MARK: map ranking, 64-bit pixel index
+// (index is long to match Swift Int, quadsort64 sorts long long of the same width)
+_Static_assert(sizeof(long) == sizeof(long long), "64-bit pixel index has to be LP64");
+#define INDEX  long
+#define RANK(name) name##64
+#define SORT(array, nmemb, data) quadsort64((long long *) (array), nmemb, data)
+#define INDEX_MAP void index_map64(const float *data, const long npix, long *index, long *nobs)
+#define RANK_MAP  void rank_map64(const float *data, const long *index, const long nobs, float *ranked)
+#define WIDE_INDEX /* pixel index may not fit in 32 bits */
+#include "ranking.tmpl"
+#undef INDEX
+#undef RANK
+#undef SORT
+#undef INDEX_MAP
+#undef RANK_MAP
+#undef WIDE_INDEX
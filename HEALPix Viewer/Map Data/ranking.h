@@ -8,7 +8,22 @@
 #ifndef ranking_h
 #define ranking_h
 
+// number of threads used by index sort (0 = one per active CPU core, capped at that too)
+void ranking_threads(int threads);
+
+// sorting backend used by index_map (radix sort falls back to quadsort if memory is tight)
+enum ranking_backend { RANKING_AUTO = 0, RANKING_QUADSORT, RANKING_RADIX };
+void ranking_backend(enum ranking_backend backend);
+
+// 32-bit pixel index (good to nside = 8192)
 void index_map(const float *data, const int npix, int *index, int *nobs);
 void rank_map(const float *data, const int *index, const int nobs, float *ranked);
 
+// 64-bit pixel index (nside = 16384 and larger)
+void index_map64(const float *data, const long npix, long *index, long *nobs);
+void rank_map64(const float *data, const long *index, const long nobs, float *ranked);
+
+// approximate ranks of map values, interpolated in CDF sampled at n+1 equally spaced ranks
+void rank_cdf(const float *data, long npix, const double *cdf, int n, float *ranked);
+
 #endif /* ranking_h */
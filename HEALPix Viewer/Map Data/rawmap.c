@@ -7,8 +7,13 @@
 
 #include <math.h>
 #include <float.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <dispatch/dispatch.h>
 #include "rawmap.h"
-#include "../../cfitsio/healpix/chealpix.h"
+#include "reorder.h"
 
 // low-level backends to bring the HEALPix map into canonical form,
 // namely NESTED float single-precision data suitable for GPU and Metal
@@ -16,115 +21,494 @@
 //   f = float data, d = double data, s = 16-bit int, i = 32-bit int, l/x = 64-bit int
 //   r = 'RING' ordering, n = 'NESTED' ordering
 //   p = no sign flip, n = sign flip (for IAU polarization convention)
+// segment primitives are named seg2map_??, converting a contiguous run of
+// NESTED pixels (e.g. a chunk of a streamed table), with two letters as in idx2map
 // indexed primitives are named idx2map_??, with two letters corresponding to
 //   f = float data, d = double data, s = 16-bit int, i = 32-bit int, l/x = 64-bit int
 //   p = no sign flip, n = sign flip (for IAU polarization convention)
+// memory-mapped table primitives are named fits2map_???, with letters as in raw2map,
+//   reading big-endian column data interleaved in FITS table rows of given stride
 // pixel index validators are named reindex_??, with two letters corresponding to
 //   s = 16-bit int, i = 32-bit int, l/x = 64-bit int
 //   r = 'RING' ordering, n = 'NESTED' ordering
 
+// MARK: runtime instruction set selection
+// NESTED buffers are converted by vectorized kernels, which are compiled
+// for each instruction set available on the architecture (see simdmap.tmpl);
+// the widest one supported by the CPU is picked when the binary is loaded
+
+// supported instruction sets
+enum rawmap_isa { SIMD_NONE = 0, SIMD_SSE4, SIMD_AVX2, SIMD_AVX512, SIMD_NEON };
+
+// instruction set used by vectorized kernels
+static enum rawmap_isa rawmap_simd = SIMD_NONE;
+
+// CPU feature detection
+__attribute__((constructor)) static void rawmap_cpuid(void) {
+#if defined(__x86_64__)
+    __builtin_cpu_init();
+    
+    if (__builtin_cpu_supports("sse4.1")) { rawmap_simd = SIMD_SSE4; }
+    if (__builtin_cpu_supports("avx2")) { rawmap_simd = SIMD_AVX2; }
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq") &&
+        __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512vl")) { rawmap_simd = SIMD_AVX512; }
+#elif defined(__aarch64__)
+    rawmap_simd = SIMD_NEON;
+#endif
+}
+
+// token pasting for template instantiation
+#define PASTE(a,b) PASTE_(a,b)
+#define PASTE_(a,b) a##b
+
+// pick vectorized kernel for detected instruction set, or scalar fallback
+#if defined(__x86_64__)
+#define VECTORIZED(name,scalar) ( \
+    (rawmap_simd == SIMD_AVX512) ? KERNEL(PASTE(name,_avx512)) : \
+    (rawmap_simd == SIMD_AVX2)   ? KERNEL(PASTE(name,_avx2))   : \
+    (rawmap_simd == SIMD_SSE4)   ? KERNEL(PASTE(name,_sse4))   : KERNEL(scalar))
+#elif defined(__aarch64__)
+#define VECTORIZED(name,scalar) KERNEL(PASTE(name,_neon))
+#else
+#define VECTORIZED(name,scalar) KERNEL(scalar)
+#endif
+
+// MARK: quantile sketch of converted values
+// values are counted in a fixed grid of buckets over order-preserving float
+// bits (sign, exponent, and top mantissa bits), which is cheap enough to be
+// done right behind the conversion while the block is still in cache, and
+// is trivially mergeable across slices and streamed chunks
+
+// sketch buckets (bucket is top SKETCH_BITS of order-preserving key)
+#define SKETCH_BITS 16
+#define SKETCH_SIZE (1L<<SKETCH_BITS)
+
+// pixels converted in a block before it is counted
+#define SKETCH_BLOCK (1L<<14)
+
+struct rawmap_sketch {
+    long count[SKETCH_SIZE];
+    long *slice, slices;    // per-slice counts, reused by all converted chunks
+    long nobs; float min, max;
+    rawmap_stats stats;
+};
+
+rawmap_sketch *make_sketch(void) {
+    rawmap_sketch *sketch = calloc(1, sizeof(rawmap_sketch));
+    if (sketch) { sketch->min = FLT_MAX; sketch->max = -FLT_MAX; }
+    
+    return sketch;
+}
+
+void free_sketch(rawmap_sketch *sketch) { if (sketch) { free(sketch->slice); } free(sketch); }
+
+// per-slice counts for n slices, allocated once for all chunks converted into the sketch
+static long *sketch_slices(rawmap_sketch *sketch, long n) {
+    if (n > sketch->slices) {
+        long *slice = realloc(sketch->slice, n*SKETCH_SIZE*sizeof(long)); if (!slice) { return NULL; }
+        memset(slice + sketch->slices*SKETCH_SIZE, 0, (n - sketch->slices)*SKETCH_SIZE*sizeof(long));
+        sketch->slice = slice; sketch->slices = n;
+    }
+    
+    return sketch->slice;
+}
+
+// merge per-slice counts into sketch buckets, releasing them
+static void sketch_merge(rawmap_sketch *sketch) {
+    for (long k = 0; k < sketch->slices; k++) {
+        const long *count = sketch->slice + k*SKETCH_SIZE;
+        for (long b = 0; b < SKETCH_SIZE; b++) { sketch->count[b] += count[b]; sketch->nobs += count[b]; }
+    }
+    
+    free(sketch->slice); sketch->slice = NULL; sketch->slices = 0;
+}
+
+// order-preserving unsigned key of a float value
+static inline uint32_t sketch_key(float v) {
+    uint32_t u; memcpy(&u, &v, sizeof(u));
+    return (u & 0x80000000) ? ~u : (u | 0x80000000);
+}
+
+// float value of order-preserving key
+static inline float sketch_value(uint32_t key) {
+    uint32_t u = (key & 0x80000000) ? (key & 0x7FFFFFFF) : ~key; float v;
+    memcpy(&v, &u, sizeof(v)); return v;
+}
+
+// quantiles at n+1 equally spaced ranks, interpolated within buckets
+double rawmap_quantiles(rawmap_sketch *sketch, int n, double *x) {
+    sketch_merge(sketch);
+    
+    const long nobs = sketch->nobs; long b = 0, below = 0, heaviest = 0;
+    if (nobs == 0 || n < 1) { return 1.0; }
+    
+    for (long k = 0; k < SKETCH_SIZE; k++) { if (sketch->count[k] > heaviest) { heaviest = sketch->count[k]; } }
+    
+    for (int i = 0; i <= n; i++) {
+        const double r = (double) (nobs-1)*i/n;
+        while (below + sketch->count[b] <= r) { below += sketch->count[b]; b++; }
+        
+        const double lo = sketch_value(b << (32-SKETCH_BITS)), hi = sketch_value(((b+1) << (32-SKETCH_BITS)) - 1);
+        const double v = lo + (hi-lo)*(r - below + 0.5)/sketch->count[b];
+        x[i] = v < sketch->min ? sketch->min : (v > sketch->max ? sketch->max : v);
+    }
+    
+    x[0] = sketch->min;
+    x[n] = sketch->max;
+    
+    return (double) heaviest/nobs;
+}
+
+// MARK: mergeable moments of converted values
+// central moment sums are computed exactly for each block while it is still in
+// cache, and combined pairwise with the update formulas of Chan et al. and
+// Pebay (Sandia report SAND2008-6212), which are stable in any merge order
+
+// combine moment sums of b into a
+static void rawmap_merge(rawmap_stats *a, const rawmap_stats *b) {
+    const double na = a->finite, nb = b->finite, n = na + nb;
+    a->nan += b->nan; a->bad += b->bad; if (b->finite == 0) { return; }
+    if (a->finite == 0) { a->finite = b->finite; a->mean = b->mean; a->m2 = b->m2; a->m3 = b->m3; a->m4 = b->m4; return; }
+    
+    const double d = b->mean - a->mean, d2 = d*d, d3 = d2*d, d4 = d2*d2, w = na*nb/n;
+    
+    a->m4 += b->m4 + d4*w*(na*na - na*nb + nb*nb)/(n*n) + 6.0*d2*(na*na*b->m2 + nb*nb*a->m2)/(n*n) + 4.0*d*(na*b->m3 - nb*a->m3)/n;
+    a->m3 += b->m3 + d3*w*(na-nb)/n + 3.0*d*(na*b->m2 - nb*a->m2)/n;
+    a->m2 += b->m2 + d2*w;
+    a->mean += d*nb/n;
+    a->finite += b->finite;
+}
+
+// moment sums of the converted pixels of a sketch
+void rawmap_statistics(const rawmap_sketch *sketch, rawmap_stats *stats) { *stats = sketch->stats; }
+
+// MARK: parallel execution of conversion kernels
+// each primitive is a thin wrapper around a kernel converting a range of pixels,
+// the range is split into contiguous slices converted concurrently by libdispatch
+// workers, and per-slice data bounds are reduced once all slices are done
+
+// conversion kernel, processing pixels in range [from,to); lookup table
+// is pixel index for indexed buffers and ring geometry for RING buffers
+typedef void (*rawmap_kernel)(const void *in, const void *lut, float *out, long nside, long from, long to, float *min, float *max, long *bad);
+
+// maps with fewer pixels than this are converted on a single thread
+#define SERIAL_NPIX (1L<<20)
+
+// number of worker threads (0 = one per active CPU core)
+static int rawmap_nthreads = 0;
+
+void rawmap_threads(int threads) { rawmap_nthreads = (threads > 0) ? threads : 0; }
+
+// parallel conversion job
+struct rawmap_job {
+    rawmap_kernel kernel;
+    const void *in; const void *lut; const long *scatter; float *out;
+    long nside, npix, slices;
+    float *min, *max;
+    long *count;
+    rawmap_stats *stats;
+};
+
+// i-th converted value of the job (scattered into output for indexed buffers)
+static inline float rawmap_value(const struct rawmap_job *job, long i) { return job->scatter ? job->out[job->scatter[i]] : job->out[i]; }
+
+// count a block of converted values into slice sketch and moment sums
+static void rawmap_count(const struct rawmap_job *job, long *count, rawmap_stats *stats, long from, long to, long bad) {
+    rawmap_stats block = { 0, 0, bad, 0.0, 0.0, 0.0, 0.0 };
+    double sum = 0.0;
+    
+    for (long i = from; i < to; i++) { const float v = rawmap_value(job, i); if (isfinite(v)) { count[sketch_key(v) >> (32-SKETCH_BITS)]++; sum += v; block.finite++; } }
+    
+    if (block.finite) {
+        const double mean = sum/block.finite; double m2 = 0.0, m3 = 0.0, m4 = 0.0;
+        
+        for (long i = from; i < to; i++) {
+            const float v = rawmap_value(job, i); if (!isfinite(v)) { continue; }
+            const double d = v - mean, d2 = d*d; m2 += d2; m3 += d2*d; m4 += d2*d2;
+        }
+        
+        block.mean = mean; block.m2 = m2; block.m3 = m3; block.m4 = m4;
+    }
+    
+    block.nan = (to-from) - block.finite - bad;
+    rawmap_merge(stats, &block);
+}
+
+// convert a single slice of the job
+static void rawmap_slice(void *context, size_t k) {
+    const struct rawmap_job *job = context; long bad;
+    const long from = job->npix*k/job->slices, to = job->npix*(k+1)/job->slices;
+    
+    if (!job->count) { job->kernel(job->in, job->lut, job->out, job->nside, from, to, job->min+k, job->max+k, &bad); return; }
+    
+    // convert in blocks, counting each one while it is still in cache
+    float minval = FLT_MAX, maxval = -FLT_MAX, a, b;
+    
+    for (long i = from, n = 0; i < to; i += n) {
+        n = (to-i < SKETCH_BLOCK) ? to-i : SKETCH_BLOCK;
+        
+        job->kernel(job->in, job->lut, job->out, job->nside, i, i+n, &a, &b, &bad);
+        rawmap_count(job, job->count + k*SKETCH_SIZE, job->stats+k, i, i+n, bad);
+        
+        if (a < minval) { minval = a; }
+        if (b > maxval) { maxval = b; }
+    }
+    
+    job->min[k] = minval;
+    job->max[k] = maxval;
+}
+
+// run conversion kernel over npix pixels, reducing data bounds (and sketch, if not NULL);
+// returns 0 on success, -1 if sketch buffers could not be allocated
+static int rawmap_convert(rawmap_kernel kernel, const void *in, const void *lut, const long *scatter, float *out, long nside, long npix, double *min, double *max, rawmap_sketch *sketch) {
+    long slices = rawmap_nthreads ? rawmap_nthreads : sysconf(_SC_NPROCESSORS_ONLN);
+    if (npix < SERIAL_NPIX || slices < 2) { slices = 1; }
+    
+    long *count = sketch ? sketch_slices(sketch, slices) : NULL;
+    if (sketch && !count) { return -1; }
+    
+    float minval[slices], maxval[slices]; rawmap_stats stats[slices]; memset(stats, 0, sizeof(stats));
+    struct rawmap_job job = { kernel, in, lut, scatter, out, nside, npix, slices, minval, maxval, count, stats };
+    
+    if (slices > 1) { dispatch_apply_f(slices, DISPATCH_APPLY_AUTO, &job, rawmap_slice); }
+    else { rawmap_slice(&job, 0); }
+    
+    for (long k = 1; k < slices; k++) {
+        if (minval[k] < minval[0]) { minval[0] = minval[k]; }
+        if (maxval[k] > maxval[0]) { maxval[0] = maxval[k]; }
+    }
+    
+    // merge slice moments into sketch (slice counts stay in place until quantiles are asked for)
+    if (count) {
+        for (long k = 0; k < slices; k++) { rawmap_merge(&sketch->stats, stats+k); }
+        
+        if (minval[0] < sketch->min) { sketch->min = minval[0]; }
+        if (maxval[0] > sketch->max) { sketch->max = maxval[0]; }
+    }
+    
+    *min = minval[0];
+    *max = maxval[0];
+    
+    return 0;
+}
+
+// MARK: memory-mapped FITS table access
+// column data is stored big-endian, with repeat values per row of stride bytes;
+// conversion kernels byteswap, deinterleave and widen it on the fly
+
+// column layout passed to kernels (along with RING ordering LUT if needed)
+typedef struct { const ring_lut *lut; long repeat, stride; } fits_layout;
+
 // MARK: full-sky conversion primitives, single precision float
-#define RAW_RP void raw2map_frp(const float *in, float *out, long nside, double *min, double *max)
-#define RAW_RN void raw2map_frn(const float *in, float *out, long nside, double *min, double *max)
-#define RAW_NP void raw2map_fnp(const float *in, float *out, long nside, double *min, double *max)
-#define RAW_NN void raw2map_fnn(const float *in, float *out, long nside, double *min, double *max)
-#define IDX_P  void idx2map_fp(const long *idx, const float *in, float *out, long nobs, double *min, double *max)
-#define IDX_N  void idx2map_fn(const long *idx, const float *in, float *out, long nobs, double *min, double *max)
+#define DATA   float
+#define KERNEL(name) PASTE(name,_f)
+#define RAW_RP int raw2map_frp(const float *in, float *out, long nside, double *min, double *max, rawmap_sketch *sketch)
+#define RAW_RN int raw2map_frn(const float *in, float *out, long nside, double *min, double *max, rawmap_sketch *sketch)
+#define RAW_NP int raw2map_fnp(const float *in, float *out, long nside, double *min, double *max, rawmap_sketch *sketch)
+#define RAW_NN int raw2map_fnn(const float *in, float *out, long nside, double *min, double *max, rawmap_sketch *sketch)
+#define IDX_P  int idx2map_fp(const long *idx, const float *in, float *out, long nobs, double *min, double *max, rawmap_sketch *sketch)
+#define IDX_N  int idx2map_fn(const long *idx, const float *in, float *out, long nobs, double *min, double *max, rawmap_sketch *sketch)
+#define SEG_P  int seg2map_fp(const float *in, float *out, long npix, double *min, double *max, rawmap_sketch *sketch)
+#define SEG_N  int seg2map_fn(const float *in, float *out, long npix, double *min, double *max, rawmap_sketch *sketch)
+#define WORD   uint32_t
+#define BSWAP  __builtin_bswap32
+#define FITS_RP int fits2map_frp(const void *in, long repeat, long stride, float *out, long nside, double *min, double *max, rawmap_sketch *sketch)
+#define FITS_RN int fits2map_frn(const void *in, long repeat, long stride, float *out, long nside, double *min, double *max, rawmap_sketch *sketch)
+#define FITS_NP int fits2map_fnp(const void *in, long repeat, long stride, float *out, long nside, double *min, double *max, rawmap_sketch *sketch)
+#define FITS_NN int fits2map_fnn(const void *in, long repeat, long stride, float *out, long nside, double *min, double *max, rawmap_sketch *sketch)
 #include "rawmap.tmpl"
+#undef DATA
+#undef KERNEL
 #undef RAW_RP
 #undef RAW_RN
 #undef RAW_NP
 #undef RAW_NN
 #undef IDX_P
 #undef IDX_N
+#undef SEG_P
+#undef SEG_N
+#undef WORD
+#undef BSWAP
+#undef FITS_RP
+#undef FITS_RN
+#undef FITS_NP
+#undef FITS_NN
 
 // MARK: full-sky conversion primitives, double precision float
-#define RAW_RP void raw2map_drp(const double *in, float *out, long nside, double *min, double *max)
-#define RAW_RN void raw2map_drn(const double *in, float *out, long nside, double *min, double *max)
-#define RAW_NP void raw2map_dnp(const double *in, float *out, long nside, double *min, double *max)
-#define RAW_NN void raw2map_dnn(const double *in, float *out, long nside, double *min, double *max)
-#define IDX_P  void idx2map_dp(const long *idx, const double *in, float *out, long nobs, double *min, double *max)
-#define IDX_N  void idx2map_dn(const long *idx, const double *in, float *out, long nobs, double *min, double *max)
+#define DATA   double
+#define KERNEL(name) PASTE(name,_d)
+#define RAW_RP int raw2map_drp(const double *in, float *out, long nside, double *min, double *max, rawmap_sketch *sketch)
+#define RAW_RN int raw2map_drn(const double *in, float *out, long nside, double *min, double *max, rawmap_sketch *sketch)
+#define RAW_NP int raw2map_dnp(const double *in, float *out, long nside, double *min, double *max, rawmap_sketch *sketch)
+#define RAW_NN int raw2map_dnn(const double *in, float *out, long nside, double *min, double *max, rawmap_sketch *sketch)
+#define IDX_P  int idx2map_dp(const long *idx, const double *in, float *out, long nobs, double *min, double *max, rawmap_sketch *sketch)
+#define IDX_N  int idx2map_dn(const long *idx, const double *in, float *out, long nobs, double *min, double *max, rawmap_sketch *sketch)
+#define SEG_P  int seg2map_dp(const double *in, float *out, long npix, double *min, double *max, rawmap_sketch *sketch)
+#define SEG_N  int seg2map_dn(const double *in, float *out, long npix, double *min, double *max, rawmap_sketch *sketch)
+#define WORD   uint64_t
+#define BSWAP  __builtin_bswap64
+#define FITS_RP int fits2map_drp(const void *in, long repeat, long stride, float *out, long nside, double *min, double *max, rawmap_sketch *sketch)
+#define FITS_RN int fits2map_drn(const void *in, long repeat, long stride, float *out, long nside, double *min, double *max, rawmap_sketch *sketch)
+#define FITS_NP int fits2map_dnp(const void *in, long repeat, long stride, float *out, long nside, double *min, double *max, rawmap_sketch *sketch)
+#define FITS_NN int fits2map_dnn(const void *in, long repeat, long stride, float *out, long nside, double *min, double *max, rawmap_sketch *sketch)
 #include "rawmap.tmpl"
+#undef DATA
+#undef KERNEL
 #undef RAW_RP
 #undef RAW_RN
 #undef RAW_NP
 #undef RAW_NN
 #undef IDX_P
 #undef IDX_N
+#undef SEG_P
+#undef SEG_N
+#undef WORD
+#undef BSWAP
+#undef FITS_RP
+#undef FITS_RN
+#undef FITS_NP
+#undef FITS_NN
 
 // MARK: full-sky conversion primitives, signed 16-bit integer
-#define RAW_RP void raw2map_srp(const short *in, float *out, long nside, double *min, double *max)
-#define RAW_RN void raw2map_srn(const short *in, float *out, long nside, double *min, double *max)
-#define RAW_NP void raw2map_snp(const short *in, float *out, long nside, double *min, double *max)
-#define RAW_NN void raw2map_snn(const short *in, float *out, long nside, double *min, double *max)
-#define IDX_P  void idx2map_sp(const long *idx, const short *in, float *out, long nobs, double *min, double *max)
-#define IDX_N  void idx2map_sn(const long *idx, const short *in, float *out, long nobs, double *min, double *max)
+#define DATA   short
+#define KERNEL(name) PASTE(name,_s)
+#define RAW_RP int raw2map_srp(const short *in, float *out, long nside, double *min, double *max, rawmap_sketch *sketch)
+#define RAW_RN int raw2map_srn(const short *in, float *out, long nside, double *min, double *max, rawmap_sketch *sketch)
+#define RAW_NP int raw2map_snp(const short *in, float *out, long nside, double *min, double *max, rawmap_sketch *sketch)
+#define RAW_NN int raw2map_snn(const short *in, float *out, long nside, double *min, double *max, rawmap_sketch *sketch)
+#define IDX_P  int idx2map_sp(const long *idx, const short *in, float *out, long nobs, double *min, double *max, rawmap_sketch *sketch)
+#define IDX_N  int idx2map_sn(const long *idx, const short *in, float *out, long nobs, double *min, double *max, rawmap_sketch *sketch)
+#define SEG_P  int seg2map_sp(const short *in, float *out, long npix, double *min, double *max, rawmap_sketch *sketch)
+#define SEG_N  int seg2map_sn(const short *in, float *out, long npix, double *min, double *max, rawmap_sketch *sketch)
+#define WORD   uint16_t
+#define BSWAP  __builtin_bswap16
+#define FITS_RP int fits2map_srp(const void *in, long repeat, long stride, float *out, long nside, double *min, double *max, rawmap_sketch *sketch)
+#define FITS_RN int fits2map_srn(const void *in, long repeat, long stride, float *out, long nside, double *min, double *max, rawmap_sketch *sketch)
+#define FITS_NP int fits2map_snp(const void *in, long repeat, long stride, float *out, long nside, double *min, double *max, rawmap_sketch *sketch)
+#define FITS_NN int fits2map_snn(const void *in, long repeat, long stride, float *out, long nside, double *min, double *max, rawmap_sketch *sketch)
 #define MAP_R  long reindex_sr(const short *in, long *idx, long nobs, long nside)
 #define MAP_N  long reindex_sn(const short *in, long *idx, long nobs, long nside)
 #include "rawmap.tmpl"
+#undef DATA
+#undef KERNEL
 #undef RAW_RP
 #undef RAW_RN
 #undef RAW_NP
 #undef RAW_NN
 #undef IDX_P
 #undef IDX_N
+#undef SEG_P
+#undef SEG_N
+#undef WORD
+#undef BSWAP
+#undef FITS_RP
+#undef FITS_RN
+#undef FITS_NP
+#undef FITS_NN
 #undef MAP_R
 #undef MAP_N
 
 // MARK: full-sky conversion primitives, signed 32-bit integer
-#define RAW_RP void raw2map_irp(const int *in, float *out, long nside, double *min, double *max)
-#define RAW_RN void raw2map_irn(const int *in, float *out, long nside, double *min, double *max)
-#define RAW_NP void raw2map_inp(const int *in, float *out, long nside, double *min, double *max)
-#define RAW_NN void raw2map_inn(const int *in, float *out, long nside, double *min, double *max)
-#define IDX_P  void idx2map_ip(const long *idx, const int *in, float *out, long nobs, double *min, double *max)
-#define IDX_N  void idx2map_in(const long *idx, const int *in, float *out, long nobs, double *min, double *max)
+#define DATA   int
+#define KERNEL(name) PASTE(name,_i)
+#define RAW_RP int raw2map_irp(const int *in, float *out, long nside, double *min, double *max, rawmap_sketch *sketch)
+#define RAW_RN int raw2map_irn(const int *in, float *out, long nside, double *min, double *max, rawmap_sketch *sketch)
+#define RAW_NP int raw2map_inp(const int *in, float *out, long nside, double *min, double *max, rawmap_sketch *sketch)
+#define RAW_NN int raw2map_inn(const int *in, float *out, long nside, double *min, double *max, rawmap_sketch *sketch)
+#define IDX_P  int idx2map_ip(const long *idx, const int *in, float *out, long nobs, double *min, double *max, rawmap_sketch *sketch)
+#define IDX_N  int idx2map_in(const long *idx, const int *in, float *out, long nobs, double *min, double *max, rawmap_sketch *sketch)
+#define SEG_P  int seg2map_ip(const int *in, float *out, long npix, double *min, double *max, rawmap_sketch *sketch)
+#define SEG_N  int seg2map_in(const int *in, float *out, long npix, double *min, double *max, rawmap_sketch *sketch)
+#define WORD   uint32_t
+#define BSWAP  __builtin_bswap32
+#define FITS_RP int fits2map_irp(const void *in, long repeat, long stride, float *out, long nside, double *min, double *max, rawmap_sketch *sketch)
+#define FITS_RN int fits2map_irn(const void *in, long repeat, long stride, float *out, long nside, double *min, double *max, rawmap_sketch *sketch)
+#define FITS_NP int fits2map_inp(const void *in, long repeat, long stride, float *out, long nside, double *min, double *max, rawmap_sketch *sketch)
+#define FITS_NN int fits2map_inn(const void *in, long repeat, long stride, float *out, long nside, double *min, double *max, rawmap_sketch *sketch)
 #define MAP_R  long reindex_ir(const int *in, long *idx, long nobs, long nside)
 #define MAP_N  long reindex_in(const int *in, long *idx, long nobs, long nside)
 #include "rawmap.tmpl"
+#undef DATA
+#undef KERNEL
 #undef RAW_RP
 #undef RAW_RN
 #undef RAW_NP
 #undef RAW_NN
 #undef IDX_P
 #undef IDX_N
+#undef SEG_P
+#undef SEG_N
+#undef WORD
+#undef BSWAP
+#undef FITS_RP
+#undef FITS_RN
+#undef FITS_NP
+#undef FITS_NN
 #undef MAP_R
 #undef MAP_N
 
 // MARK: full-sky conversion primitives, signed 64-bit integer
-#define RAW_RP void raw2map_lrp(const long *in, float *out, long nside, double *min, double *max)
-#define RAW_RN void raw2map_lrn(const long *in, float *out, long nside, double *min, double *max)
-#define RAW_NP void raw2map_lnp(const long *in, float *out, long nside, double *min, double *max)
-#define RAW_NN void raw2map_lnn(const long *in, float *out, long nside, double *min, double *max)
-#define IDX_P  void idx2map_lp(const long *idx, const long *in, float *out, long nobs, double *min, double *max)
-#define IDX_N  void idx2map_ln(const long *idx, const long *in, float *out, long nobs, double *min, double *max)
+#define DATA   long
+#define KERNEL(name) PASTE(name,_l)
+#define RAW_RP int raw2map_lrp(const long *in, float *out, long nside, double *min, double *max, rawmap_sketch *sketch)
+#define RAW_RN int raw2map_lrn(const long *in, float *out, long nside, double *min, double *max, rawmap_sketch *sketch)
+#define RAW_NP int raw2map_lnp(const long *in, float *out, long nside, double *min, double *max, rawmap_sketch *sketch)
+#define RAW_NN int raw2map_lnn(const long *in, float *out, long nside, double *min, double *max, rawmap_sketch *sketch)
+#define IDX_P  int idx2map_lp(const long *idx, const long *in, float *out, long nobs, double *min, double *max, rawmap_sketch *sketch)
+#define IDX_N  int idx2map_ln(const long *idx, const long *in, float *out, long nobs, double *min, double *max, rawmap_sketch *sketch)
+#define SEG_P  int seg2map_lp(const long *in, float *out, long npix, double *min, double *max, rawmap_sketch *sketch)
+#define SEG_N  int seg2map_ln(const long *in, float *out, long npix, double *min, double *max, rawmap_sketch *sketch)
 #define MAP_R  long reindex_lr(const long *in, long *idx, long nobs, long nside)
 #define MAP_N  long reindex_ln(const long *in, long *idx, long nobs, long nside)
 #include "rawmap.tmpl"
+#undef DATA
+#undef KERNEL
 #undef RAW_RP
 #undef RAW_RN
 #undef RAW_NP
 #undef RAW_NN
 #undef IDX_P
 #undef IDX_N
+#undef SEG_P
+#undef SEG_N
 #undef MAP_R
 #undef MAP_N
 
 // MARK: full-sky conversion primitives, signed 64-bit integer
-#define RAW_RP void raw2map_xrp(const long long *in, float *out, long nside, double *min, double *max)
-#define RAW_RN void raw2map_xrn(const long long *in, float *out, long nside, double *min, double *max)
-#define RAW_NP void raw2map_xnp(const long long *in, float *out, long nside, double *min, double *max)
-#define RAW_NN void raw2map_xnn(const long long *in, float *out, long nside, double *min, double *max)
-#define IDX_P  void idx2map_xp(const long *idx, const long long *in, float *out, long nobs, double *min, double *max)
-#define IDX_N  void idx2map_xn(const long *idx, const long long *in, float *out, long nobs, double *min, double *max)
+#define DATA   long long
+#define KERNEL(name) PASTE(name,_x)
+#define RAW_RP int raw2map_xrp(const long long *in, float *out, long nside, double *min, double *max, rawmap_sketch *sketch)
+#define RAW_RN int raw2map_xrn(const long long *in, float *out, long nside, double *min, double *max, rawmap_sketch *sketch)
+#define RAW_NP int raw2map_xnp(const long long *in, float *out, long nside, double *min, double *max, rawmap_sketch *sketch)
+#define RAW_NN int raw2map_xnn(const long long *in, float *out, long nside, double *min, double *max, rawmap_sketch *sketch)
+#define IDX_P  int idx2map_xp(const long *idx, const long long *in, float *out, long nobs, double *min, double *max, rawmap_sketch *sketch)
+#define IDX_N  int idx2map_xn(const long *idx, const long long *in, float *out, long nobs, double *min, double *max, rawmap_sketch *sketch)
+#define SEG_P  int seg2map_xp(const long long *in, float *out, long npix, double *min, double *max, rawmap_sketch *sketch)
+#define SEG_N  int seg2map_xn(const long long *in, float *out, long npix, double *min, double *max, rawmap_sketch *sketch)
+#define WORD   uint64_t
+#define BSWAP  __builtin_bswap64
+#define FITS_RP int fits2map_xrp(const void *in, long repeat, long stride, float *out, long nside, double *min, double *max, rawmap_sketch *sketch)
+#define FITS_RN int fits2map_xrn(const void *in, long repeat, long stride, float *out, long nside, double *min, double *max, rawmap_sketch *sketch)
+#define FITS_NP int fits2map_xnp(const void *in, long repeat, long stride, float *out, long nside, double *min, double *max, rawmap_sketch *sketch)
+#define FITS_NN int fits2map_xnn(const void *in, long repeat, long stride, float *out, long nside, double *min, double *max, rawmap_sketch *sketch)
 #define MAP_R  long reindex_xr(const long long *in, long *idx, long nobs, long nside)
 #define MAP_N  long reindex_xn(const long long *in, long *idx, long nobs, long nside)
 #include "rawmap.tmpl"
+#undef DATA
+#undef KERNEL
 #undef RAW_RP
 #undef RAW_RN
 #undef RAW_NP
 #undef RAW_NN
 #undef IDX_P
 #undef IDX_N
+#undef SEG_P
+#undef SEG_N
+#undef WORD
+#undef BSWAP
+#undef FITS_RP
+#undef FITS_RN
+#undef FITS_NP
+#undef FITS_NN
 #undef MAP_R
 #undef MAP_N
@@ -10,59 +10,125 @@
 
 #define BAD_DATA -1.6375000E+30F
 
+// number of threads used by conversion primitives (0 = one per active CPU core)
+void rawmap_threads(int threads);
+
+// moment sums of converted map values: pixel counts by kind, mean, and
+// sums of 2nd, 3rd and 4th powers of deviations from the mean of finite values
+typedef struct {
+    long finite, nan, bad;
+    double mean, m2, m3, m4;
+} rawmap_stats;
+
+// approximate distribution of converted map values, mergeable across conversions;
+// values are counted in 2^16 buckets (sign, exponent, and top 7 mantissa bits),
+// a deterministic relative-error sketch rather than a rank-error one like KLL:
+// a quantile is never off by more than 2^-7 of its value, and its rank is off
+// by at most the population of its bucket, which is the rank error bound
+// returned by rawmap_quantiles (exact for maps with few distinct values, but
+// as bad as a single bucket for maps piled up within 1% of one value)
+typedef struct rawmap_sketch rawmap_sketch;
+
+rawmap_sketch *make_sketch(void);
+void free_sketch(rawmap_sketch *sketch);
+
+// quantiles at n+1 equally spaced ranks, returning rank error bound (as a fraction of pixels);
+// per-slice counts kept across conversions are merged into the sketch (and released) first
+double rawmap_quantiles(rawmap_sketch *sketch, int n, double *x);
+
+// exact moment sums, accumulated alongside the sketch
+void rawmap_statistics(const rawmap_sketch *sketch, rawmap_stats *stats);
+
+// conversion primitives accumulate converted values into sketch (unless it is NULL;
+// concurrent conversions should use separate sketches), and return 0 on success,
+// -1 if working buffers (RING lookup tables, sketch counts) could not be allocated;
+// pixel index validators return -1 on invalid pixel index as well
+
 // full-sky conversion primitives, single precision float
-void raw2map_frp(const float *in, float *out, long nside, double *min, double *max);
-void raw2map_frn(const float *in, float *out, long nside, double *min, double *max);
-void raw2map_fnp(const float *in, float *out, long nside, double *min, double *max);
-void raw2map_fnn(const float *in, float *out, long nside, double *min, double *max);
-void idx2map_fp(const long *idx, const float *in, float *out, long nobs, double *min, double *max);
-void idx2map_fn(const long *idx, const float *in, float *out, long nobs, double *min, double *max);
+int raw2map_frp(const float *in, float *out, long nside, double *min, double *max, rawmap_sketch *sketch);
+int raw2map_frn(const float *in, float *out, long nside, double *min, double *max, rawmap_sketch *sketch);
+int raw2map_fnp(const float *in, float *out, long nside, double *min, double *max, rawmap_sketch *sketch);
+int raw2map_fnn(const float *in, float *out, long nside, double *min, double *max, rawmap_sketch *sketch);
+int idx2map_fp(const long *idx, const float *in, float *out, long nobs, double *min, double *max, rawmap_sketch *sketch);
+int idx2map_fn(const long *idx, const float *in, float *out, long nobs, double *min, double *max, rawmap_sketch *sketch);
+int seg2map_fp(const float *in, float *out, long npix, double *min, double *max, rawmap_sketch *sketch);
+int seg2map_fn(const float *in, float *out, long npix, double *min, double *max, rawmap_sketch *sketch);
+int fits2map_frp(const void *in, long repeat, long stride, float *out, long nside, double *min, double *max, rawmap_sketch *sketch);
+int fits2map_frn(const void *in, long repeat, long stride, float *out, long nside, double *min, double *max, rawmap_sketch *sketch);
+int fits2map_fnp(const void *in, long repeat, long stride, float *out, long nside, double *min, double *max, rawmap_sketch *sketch);
+int fits2map_fnn(const void *in, long repeat, long stride, float *out, long nside, double *min, double *max, rawmap_sketch *sketch);
 
 // full-sky conversion primitives, double precision float
-void raw2map_drp(const double *in, float *out, long nside, double *min, double *max);
-void raw2map_drn(const double *in, float *out, long nside, double *min, double *max);
-void raw2map_dnp(const double *in, float *out, long nside, double *min, double *max);
-void raw2map_dnn(const double *in, float *out, long nside, double *min, double *max);
-void idx2map_dp(const long *idx, const double *in, float *out, long nobs, double *min, double *max);
-void idx2map_dn(const long *idx, const double *in, float *out, long nobs, double *min, double *max);
+int raw2map_drp(const double *in, float *out, long nside, double *min, double *max, rawmap_sketch *sketch);
+int raw2map_drn(const double *in, float *out, long nside, double *min, double *max, rawmap_sketch *sketch);
+int raw2map_dnp(const double *in, float *out, long nside, double *min, double *max, rawmap_sketch *sketch);
+int raw2map_dnn(const double *in, float *out, long nside, double *min, double *max, rawmap_sketch *sketch);
+int idx2map_dp(const long *idx, const double *in, float *out, long nobs, double *min, double *max, rawmap_sketch *sketch);
+int idx2map_dn(const long *idx, const double *in, float *out, long nobs, double *min, double *max, rawmap_sketch *sketch);
+int seg2map_dp(const double *in, float *out, long npix, double *min, double *max, rawmap_sketch *sketch);
+int seg2map_dn(const double *in, float *out, long npix, double *min, double *max, rawmap_sketch *sketch);
+int fits2map_drp(const void *in, long repeat, long stride, float *out, long nside, double *min, double *max, rawmap_sketch *sketch);
+int fits2map_drn(const void *in, long repeat, long stride, float *out, long nside, double *min, double *max, rawmap_sketch *sketch);
+int fits2map_dnp(const void *in, long repeat, long stride, float *out, long nside, double *min, double *max, rawmap_sketch *sketch);
+int fits2map_dnn(const void *in, long repeat, long stride, float *out, long nside, double *min, double *max, rawmap_sketch *sketch);
 
 // full-sky conversion primitives, signed 16-bit integer
-void raw2map_srp(const short *in, float *out, long nside, double *min, double *max);
-void raw2map_srn(const short *in, float *out, long nside, double *min, double *max);
-void raw2map_snp(const short *in, float *out, long nside, double *min, double *max);
-void raw2map_snn(const short *in, float *out, long nside, double *min, double *max);
-void idx2map_sp(const long *idx, const short *in, float *out, long nobs, double *min, double *max);
-void idx2map_sn(const long *idx, const short *in, float *out, long nobs, double *min, double *max);
+int raw2map_srp(const short *in, float *out, long nside, double *min, double *max, rawmap_sketch *sketch);
+int raw2map_srn(const short *in, float *out, long nside, double *min, double *max, rawmap_sketch *sketch);
+int raw2map_snp(const short *in, float *out, long nside, double *min, double *max, rawmap_sketch *sketch);
+int raw2map_snn(const short *in, float *out, long nside, double *min, double *max, rawmap_sketch *sketch);
+int idx2map_sp(const long *idx, const short *in, float *out, long nobs, double *min, double *max, rawmap_sketch *sketch);
+int idx2map_sn(const long *idx, const short *in, float *out, long nobs, double *min, double *max, rawmap_sketch *sketch);
+int seg2map_sp(const short *in, float *out, long npix, double *min, double *max, rawmap_sketch *sketch);
+int seg2map_sn(const short *in, float *out, long npix, double *min, double *max, rawmap_sketch *sketch);
+int fits2map_srp(const void *in, long repeat, long stride, float *out, long nside, double *min, double *max, rawmap_sketch *sketch);
+int fits2map_srn(const void *in, long repeat, long stride, float *out, long nside, double *min, double *max, rawmap_sketch *sketch);
+int fits2map_snp(const void *in, long repeat, long stride, float *out, long nside, double *min, double *max, rawmap_sketch *sketch);
+int fits2map_snn(const void *in, long repeat, long stride, float *out, long nside, double *min, double *max, rawmap_sketch *sketch);
 long reindex_sr(const short *in, long *idx, long nobs, long nside);
 long reindex_sn(const short *in, long *idx, long nobs, long nside);
 
 // full-sky conversion primitives, signed 32-bit integer
-void raw2map_irp(const int *in, float *out, long nside, double *min, double *max);
-void raw2map_irn(const int *in, float *out, long nside, double *min, double *max);
-void raw2map_inp(const int *in, float *out, long nside, double *min, double *max);
-void raw2map_inn(const int *in, float *out, long nside, double *min, double *max);
-void idx2map_ip(const long *idx, const int *in, float *out, long nobs, double *min, double *max);
-void idx2map_in(const long *idx, const int *in, float *out, long nobs, double *min, double *max);
+int raw2map_irp(const int *in, float *out, long nside, double *min, double *max, rawmap_sketch *sketch);
+int raw2map_irn(const int *in, float *out, long nside, double *min, double *max, rawmap_sketch *sketch);
+int raw2map_inp(const int *in, float *out, long nside, double *min, double *max, rawmap_sketch *sketch);
+int raw2map_inn(const int *in, float *out, long nside, double *min, double *max, rawmap_sketch *sketch);
+int idx2map_ip(const long *idx, const int *in, float *out, long nobs, double *min, double *max, rawmap_sketch *sketch);
+int idx2map_in(const long *idx, const int *in, float *out, long nobs, double *min, double *max, rawmap_sketch *sketch);
+int seg2map_ip(const int *in, float *out, long npix, double *min, double *max, rawmap_sketch *sketch);
+int seg2map_in(const int *in, float *out, long npix, double *min, double *max, rawmap_sketch *sketch);
+int fits2map_irp(const void *in, long repeat, long stride, float *out, long nside, double *min, double *max, rawmap_sketch *sketch);
+int fits2map_irn(const void *in, long repeat, long stride, float *out, long nside, double *min, double *max, rawmap_sketch *sketch);
+int fits2map_inp(const void *in, long repeat, long stride, float *out, long nside, double *min, double *max, rawmap_sketch *sketch);
+int fits2map_inn(const void *in, long repeat, long stride, float *out, long nside, double *min, double *max, rawmap_sketch *sketch);
 long reindex_ir(const int *in, long *idx, long nobs, long nside);
 long reindex_in(const int *in, long *idx, long nobs, long nside);
 
 // full-sky conversion primitives, signed 64-bit integer
-void raw2map_lrp(const long *in, float *out, long nside, double *min, double *max);
-void raw2map_lrn(const long *in, float *out, long nside, double *min, double *max);
-void raw2map_lnp(const long *in, float *out, long nside, double *min, double *max);
-void raw2map_lnn(const long *in, float *out, long nside, double *min, double *max);
-void idx2map_lp(const long *idx, const long *in, float *out, long nobs, double *min, double *max);
-void idx2map_ln(const long *idx, const long *in, float *out, long nobs, double *min, double *max);
+int raw2map_lrp(const long *in, float *out, long nside, double *min, double *max, rawmap_sketch *sketch);
+int raw2map_lrn(const long *in, float *out, long nside, double *min, double *max, rawmap_sketch *sketch);
+int raw2map_lnp(const long *in, float *out, long nside, double *min, double *max, rawmap_sketch *sketch);
+int raw2map_lnn(const long *in, float *out, long nside, double *min, double *max, rawmap_sketch *sketch);
+int idx2map_lp(const long *idx, const long *in, float *out, long nobs, double *min, double *max, rawmap_sketch *sketch);
+int idx2map_ln(const long *idx, const long *in, float *out, long nobs, double *min, double *max, rawmap_sketch *sketch);
+int seg2map_lp(const long *in, float *out, long npix, double *min, double *max, rawmap_sketch *sketch);
+int seg2map_ln(const long *in, float *out, long npix, double *min, double *max, rawmap_sketch *sketch);
 long reindex_lr(const long *in, long *idx, long nobs, long nside);
 long reindex_ln(const long *in, long *idx, long nobs, long nside);
 
 // full-sky conversion primitives, signed 64-bit integer
-void raw2map_xrp(const long long *in, float *out, long nside, double *min, double *max);
-void raw2map_xrn(const long long *in, float *out, long nside, double *min, double *max);
-void raw2map_xnp(const long long *in, float *out, long nside, double *min, double *max);
-void raw2map_xnn(const long long *in, float *out, long nside, double *min, double *max);
-void idx2map_xp(const long *idx, const long long *in, float *out, long nobs, double *min, double *max);
-void idx2map_xn(const long *idx, const long long *in, float *out, long nobs, double *min, double *max);
+int raw2map_xrp(const long long *in, float *out, long nside, double *min, double *max, rawmap_sketch *sketch);
+int raw2map_xrn(const long long *in, float *out, long nside, double *min, double *max, rawmap_sketch *sketch);
+int raw2map_xnp(const long long *in, float *out, long nside, double *min, double *max, rawmap_sketch *sketch);
+int raw2map_xnn(const long long *in, float *out, long nside, double *min, double *max, rawmap_sketch *sketch);
+int idx2map_xp(const long *idx, const long long *in, float *out, long nobs, double *min, double *max, rawmap_sketch *sketch);
+int idx2map_xn(const long *idx, const long long *in, float *out, long nobs, double *min, double *max, rawmap_sketch *sketch);
+int seg2map_xp(const long long *in, float *out, long npix, double *min, double *max, rawmap_sketch *sketch);
+int seg2map_xn(const long long *in, float *out, long npix, double *min, double *max, rawmap_sketch *sketch);
+int fits2map_xrp(const void *in, long repeat, long stride, float *out, long nside, double *min, double *max, rawmap_sketch *sketch);
+int fits2map_xrn(const void *in, long repeat, long stride, float *out, long nside, double *min, double *max, rawmap_sketch *sketch);
+int fits2map_xnp(const void *in, long repeat, long stride, float *out, long nside, double *min, double *max, rawmap_sketch *sketch);
+int fits2map_xnn(const void *in, long repeat, long stride, float *out, long nside, double *min, double *max, rawmap_sketch *sketch);
 long reindex_xr(const long long *in, long *idx, long nobs, long nside);
 long reindex_xn(const long long *in, long *idx, long nobs, long nside);
 
@@ -0,0 +1,116 @@
+//
+//  reorder.c
+//  HEALPix Viewer
+//
+//  Created by Andrei Frolov on 2026-10-17.
+//
+
+#include <math.h>
+#include <stdlib.h>
+#include "healpix.h"
+#include "reorder.h"
+
+// RING <-> NESTED reordering engine, replacing per-pixel nest2ring() calls;
+// NESTED pixels are walked in aligned blocks covering a square patch of a face,
+// pixel offsets within a block come from a small table, and ring number, phase,
+// and ring start are looked up from per-ring tables instead of being recomputed
+
+// build lookup tables for given nside
+ring_lut *make_ring_lut(long nside) {
+    ring_lut *lut = malloc(sizeof(ring_lut)); if (!lut) { return NULL; }
+    
+    lut->nside = nside; lut->block = 1;
+    while (lut->block < REORDER_BLOCK && lut->block < nside*nside) { lut->block <<= 2; }
+    
+    lut->start = malloc(4*nside*sizeof(long));
+    lut->length = malloc(4*nside*sizeof(int));
+    lut->shift = malloc(4*nside*sizeof(int));
+    lut->dx = malloc(lut->block);
+    lut->dy = malloc(lut->block);
+    
+    if (!lut->start || !lut->length || !lut->shift || !lut->dx || !lut->dy) { free_ring_lut(lut); return NULL; }
+    
+    // ring geometry, rings numbered 1..4*nside-1 from north pole
+    for (long r = 1, start = 0; r < 4*nside; r++) {
+        const long nr = (r < nside) ? r : ((r > 3*nside) ? 4*nside-r : nside);
+        
+        lut->start[r] = start;
+        lut->length[r] = (int) nr;
+        lut->shift[r] = (r < nside || r > 3*nside) ? 0 : (int) ((r-nside) & 1);
+        
+        start += 4*nr;
+    }
+    
+    // pixel offsets within a block
+    for (long p = 0; p < lut->block; p++) {
+        lut->dx[p] = (unsigned char) compress(p);
+        lut->dy[p] = (unsigned char) compress(p >> 1);
+    }
+    
+    return lut;
+}
+
+// release lookup tables
+void free_ring_lut(ring_lut *lut) {
+    if (!lut) { return; }
+    
+    free(lut->start); free(lut->length); free(lut->shift);
+    free(lut->dx); free(lut->dy); free(lut);
+}
+
+// RING indices of NESTED pixels starting at first, up to the end of enclosing block
+// (returns the number of pixels converted, which never exceeds count or REORDER_BLOCK)
+long nest2ring_block(const ring_lut *lut, long first, long count, long *ring) {
+    const long nside = lut->nside, npface = nside*nside, nl4 = 4*nside, mask = lut->block-1;
+    const long face = first/npface, base = (first % npface) & ~mask, offset = first & mask;
+    const long ix0 = compress(base), iy0 = compress(base >> 1), jr0 = jrll[face]*nside - 1, jp0 = jpll[face];
+    
+    long n = lut->block - offset; if (n > count) { n = count; }
+    
+    for (long k = 0; k < n; k++) {
+        const long ix = ix0 + lut->dx[offset+k], iy = iy0 + lut->dy[offset+k], r = jr0 - ix - iy;
+        const long nr = lut->length[r];
+        
+        long jp = (jp0*nr + ix - iy + 1 + lut->shift[r]) >> 1;
+        if (jp > nl4) { jp -= nl4; } else if (jp < 1) { jp += nl4; }
+        
+        ring[k] = lut->start[r] + jp - 1;
+    }
+    
+    return n;
+}
+
+// NESTED indices of arbitrary RING pixels (which must be valid)
+void ring2nest_bulk(const ring_lut *lut, const long *ring, long count, long *nest) {
+    const long nside = lut->nside, npface = nside*nside, nl2 = 2*nside, nl4 = 4*nside;
+    const long ncap = 2*nside*(nside-1), npix = 12*npface;
+    
+    for (long k = 0; k < count; k++) {
+        const long p = ring[k]; long r, face;
+        
+        // ring number (square root in polar caps is guarded against rounding)
+        if (p < ncap) { r = (1 + (long) sqrt(1 + 2*p)) >> 1; }
+        else if (p < npix-ncap) { r = (p-ncap)/nl4 + nside; }
+        else { r = nl4 - ((1 + (long) sqrt(2*(npix-p) - 1)) >> 1); }
+        
+        while (r > 1 && lut->start[r] > p) { r--; }
+        while (r+1 < nl4 && lut->start[r+1] <= p) { r++; }
+        
+        const long nr = lut->length[r], kshift = lut->shift[r], iphi = p - lut->start[r] + 1;
+        
+        // base pixel containing this pixel
+        if (r < nside) { face = (iphi-1)/nr; }
+        else if (r <= 3*nside) {
+            const long ire = r - nside + 1, irm = nl2 + 2 - ire;
+            const long ifm = (iphi - ire/2 + nside - 1)/nside, ifp = (iphi - irm/2 + nside - 1)/nside;
+            face = (ifp == ifm) ? (ifp | 4) : ((ifp < ifm) ? ifp : (ifm + 8));
+        }
+        else { face = 8 + (iphi-1)/nr; }
+        
+        // position within the base pixel
+        const long irt = r - jrll[face]*nside + 1; long ipt = 2*iphi - jpll[face]*nr - kshift - 1;
+        if (ipt >= nl2) { ipt -= 8*nside; }
+        
+        nest[k] = face*npface + spread((ipt-irt) >> 1) + (spread((-(ipt+irt)) >> 1) << 1);
+    }
+}
@@ -0,0 +1,30 @@
+//
+//  reorder.h
+//  HEALPix Viewer
+//
+//  Created by Andrei Frolov on 2026-10-17.
+//
+
+#ifndef reorder_h
+#define reorder_h
+
+// NESTED pixels are reordered in blocks of (at most) this many pixels
+#define REORDER_BLOCK 1024
+
+// ring geometry lookup tables for a given nside
+typedef struct {
+    long nside, block;          // map resolution and block size (power of 4)
+    long *start;                // index of first pixel in ring 1..4*nside-1
+    int *length;                // number of pixels in ring quadrant
+    int *shift;                 // ring phase offset (0 or 1)
+    unsigned char *dx, *dy;     // pixel offsets within NESTED block
+} ring_lut;
+
+ring_lut *make_ring_lut(long nside);
+void free_ring_lut(ring_lut *lut);
+
+// bulk index conversion primitives
+long nest2ring_block(const ring_lut *lut, long first, long count, long *ring);
+void ring2nest_bulk(const ring_lut *lut, const long *ring, long count, long *nest);
+
+#endif /* reorder_h */
@@ -0,0 +1,576 @@
+//
+//  sht.c
+//  HEALPix Viewer
+//
+//  Created by Andrei Frolov on 2026-10-17.
+//  Ring geometry adopted from HEALPix (healpix_base.cc)
+//  Copyright (C) 2003-2016 Max-Planck-Society, Martin Reinecke
+//
+
+#include <math.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <dispatch/dispatch.h>
+#include "healpix.h"
+#include "sht.h"
+
+// rings are processed in chunks of north-south pairs, so that Fourier coefficients
+// of only a chunk of rings are kept at a time; analysis Fourier transforms rings
+// and then accumulates a_lm for each m, synthesis goes the other way around, and
+// in both stages each thread owns distinct rings (or distinct m), so results do not
+// depend on how work is split; mirror rings share Legendre functions, which are
+// even or odd in z = cos(theta) as l-m is even or odd
+
+static const double pi = 3.14159265358979323846264338327950288419716939937510;
+
+// ring pairs processed per chunk
+#define CHUNK 128
+
+// ring pairs whose Legendre recursions run in lockstep
+#define LANES 8
+
+// Legendre functions too small for double precision start as mantissa times 2^-SCALE_BITS
+// per unit of scale, and are rescaled when mantissa outgrows 2^RESCALE_BITS
+#define SCALE_BITS 512
+#define RESCALE_BITS 400
+
+// maps smaller than this are transformed on a single thread
+#define SERIAL_PIXELS (1L<<14)
+
+// number of worker threads (0 = one per active CPU core)
+static int sht_nthreads = 0;
+
+void sht_threads(int threads) { sht_nthreads = (threads > 0) ? threads : 0; }
+
+// MARK: coefficient storage
+
+long sht_alm_size(int lmax, int mmax) { return (long)(mmax+1)*(2*lmax+2-mmax)/2; }
+
+long sht_alm_index(int lmax, int l, int m) { return (long)m*(2*lmax+1-m)/2 + l; }
+
+void sht_alm2cl(const double *alm, int lmax, int mmax, double *cl) {
+    for (int l = 0; l <= lmax; l++) {
+        double s = 0.0; const int mm = (l < mmax) ? l : mmax;
+        
+        for (int m = 0; m <= mm; m++) {
+            const double *a = alm + 2*sht_alm_index(lmax, l, m);
+            s += ((m > 0) ? 2.0 : 1.0) * (a[0]*a[0] + a[1]*a[1]);
+        }
+        
+        cl[l] = s/(2*l+1);
+    }
+}
+
+void sht_almxfl(double *alm, int lmax, int mmax, const double *fl) {
+    for (int m = 0; m <= mmax; m++) {
+        double *a = alm + 2*sht_alm_index(lmax, 0, m);
+        for (int l = m; l <= lmax; l++) { a[2*l] *= fl[l]; a[2*l+1] *= fl[l]; }
+    }
+}
+
+void sht_gaussian_beam(double fwhm, int lmax, double *bl) {
+    const double sigma = fwhm/sqrt(8.0*log(2.0));
+    for (int l = 0; l <= lmax; l++) { bl[l] = exp(-0.5*l*(l+1.0)*sigma*sigma); }
+}
+
+// MARK: ring geometry
+
+// iso-latitude ring (pixels first..first+nphi-1 in RING ordering, at phi0 + 2 pi j/nphi)
+struct ring { long index, first, nphi; double z, sth, phi0; };
+
+static void ring_info(long nside, long i, struct ring *r) {
+    const long north = (i <= 2*nside) ? i : 4*nside - i;
+    
+    r->index = i;
+    
+    if (north < nside) {
+        const double t = (double)north*north/(3.0*nside*nside);
+        r->first = 2*north*(north-1); r->nphi = 4*north;
+        r->z = 1.0 - t; r->sth = sqrt(t*(2.0-t)); r->phi0 = pi/(4*north);
+    } else {
+        r->first = 2*nside*(nside-1) + (north-nside)*4*nside; r->nphi = 4*nside;
+        r->z = (2*nside - north)*2.0/(3.0*nside); r->sth = sqrt((1.0-r->z)*(1.0+r->z));
+        r->phi0 = ((north-nside) & 1) ? 0.0 : pi/(4*nside);
+    }
+    
+    if (i > north) { r->first = 12*nside*nside - r->first - r->nphi; r->z = -r->z; }
+}
+
+// NESTED index of pixel j on ring i
+static long ring_nest(long nside, long order, long i, long j) {
+    long nr = nside, kshift = 0, face;
+    const long iphi = j+1;
+    
+    if (i < nside) { nr = i; face = j/nr; }
+    else if (i > 3*nside) { nr = 4*nside - i; face = j/nr + 8; }
+    else {
+        const long ire = i - nside + 1, irm = 2*nside + 2 - ire;
+        const long ifm = (iphi - ire/2 + nside - 1) >> order, ifp = (iphi - irm/2 + nside - 1) >> order;
+        
+        kshift = (i + nside) & 1;
+        face = (ifp == ifm) ? (ifp | 4) : ((ifp < ifm) ? ifp : ifm + 8);
+    }
+    
+    const long irt = i - jrll[face]*nside + 1;
+    long ipt = 2*iphi - jpll[face]*nr - kshift - 1;
+    if (ipt >= 2*nside) { ipt -= 8*nside; }
+    
+    return (face << 2*order) | (long)(spread((ipt - irt) >> 1) | (spread((-ipt - irt) >> 1) << 1));
+}
+
+// MARK: ring Fourier transforms
+
+// in-place radix-2 FFT of m = 2^k complex values, with twiddles tw[j] = exp(-2 pi i j/M)
+// for j < M/2, where M is a multiple of m
+static void fft2(double *x, long m, const double *tw, long M, int inverse) {
+    for (long i = 1, j = 0; i < m; i++) {
+        long bit = m >> 1; for (; j & bit; bit >>= 1) { j ^= bit; } j ^= bit;
+        if (i < j) { const double r = x[2*i], s = x[2*i+1]; x[2*i] = x[2*j]; x[2*i+1] = x[2*j+1]; x[2*j] = r; x[2*j+1] = s; }
+    }
+    
+    const double sign = inverse ? -1.0 : 1.0;
+    
+    for (long len = 2; len <= m; len <<= 1) {
+        const long half = len >> 1, step = M/len;
+        
+        for (long k = 0; k < half; k++) {
+            const double wr = tw[2*k*step], wi = sign*tw[2*k*step+1];
+            
+            for (long i = k; i < m; i += len) {
+                double *a = x + 2*i, *b = x + 2*(i+half);
+                const double tr = b[0]*wr - b[1]*wi, ti = b[0]*wi + b[1]*wr;
+                b[0] = a[0] - tr; b[1] = a[1] - ti; a[0] += tr; a[1] += ti;
+            }
+        }
+    }
+}
+
+// DFT of length n (arbitrary for polar rings) done by Bluestein's algorithm as
+// a convolution with chirp exp(-i pi k^2/n) of padded power of 2 length m
+struct dft { long n, m; double *chirp, *kernel, *work; };
+
+static void dft_plan(struct dft *d, long n, const double *tw, long M) {
+    d->n = d->m = n; if (!(n & (n-1))) { return; }
+    
+    long m = 1; while (m < 2*n-1) { m <<= 1; } d->m = m;
+    
+    for (long k = 0; k < n; k++) {
+        const double a = pi*((k*k) % (2*n))/n;
+        d->chirp[2*k] = cos(a); d->chirp[2*k+1] = -sin(a);
+    }
+    
+    memset(d->kernel, 0, 2*m*sizeof(double));
+    for (long k = 0; k < n; k++) { d->kernel[2*k] = d->chirp[2*k]; d->kernel[2*k+1] = -d->chirp[2*k+1]; }
+    for (long k = 1; k < n; k++) { d->kernel[2*(m-k)] = d->chirp[2*k]; d->kernel[2*(m-k)+1] = -d->chirp[2*k+1]; }
+    
+    fft2(d->kernel, m, tw, M, 0);
+}
+
+// in-place DFT of n complex values, X_k = sum_j x_j exp(-+2 pi i jk/n)
+static void dft(const struct dft *d, double *x, const double *tw, long M, int inverse) {
+    const long n = d->n, m = d->m;
+    if (m == n) { fft2(x, n, tw, M, inverse); return; }
+    
+    // inverse transform is a conjugated forward one
+    const double sign = inverse ? -1.0 : 1.0, norm = 1.0/m;
+    double *w = d->work;
+    
+    for (long k = 0; k < n; k++) {
+        const double xr = x[2*k], xi = sign*x[2*k+1], cr = d->chirp[2*k], ci = d->chirp[2*k+1];
+        w[2*k] = xr*cr - xi*ci; w[2*k+1] = xr*ci + xi*cr;
+    }
+    
+    memset(w + 2*n, 0, 2*(m-n)*sizeof(double));
+    fft2(w, m, tw, M, 0);
+    
+    for (long k = 0; k < m; k++) {
+        const double wr = w[2*k], wi = w[2*k+1], kr = d->kernel[2*k], ki = d->kernel[2*k+1];
+        w[2*k] = wr*kr - wi*ki; w[2*k+1] = wr*ki + wi*kr;
+    }
+    
+    fft2(w, m, tw, M, 1);
+    
+    for (long k = 0; k < n; k++) {
+        const double wr = w[2*k]*norm, wi = w[2*k+1]*norm, cr = d->chirp[2*k], ci = d->chirp[2*k+1];
+        x[2*k] = wr*cr - wi*ci; x[2*k+1] = sign*(wr*ci + wi*cr);
+    }
+}
+
+// MARK: transform job
+
+struct sht_job {
+    long nside, order; int lmax, mmax;
+    const double *lognorm;              // log2(lambda_mm/sin^m theta)
+    const double *tw; long M;           // twiddles for longest padded ring transform
+    
+    long pairs; struct ring ring[2*CHUNK];  // rings of current chunk (north and south ring of each pair, south nphi = 0 on equator)
+    double *phase;                      // ring Fourier coefficients, 2*(mmax+1) doubles per ring
+    
+    const float *map; double weight;   // analysis input and quadrature weight
+    float *out;                         // synthesis output
+    double *alm;                        // coefficients (accumulated by analysis)
+    
+    double *scratch; long size, slices; // per slice work buffers
+};
+
+// ring Fourier coefficients F_m = w sum_j f_j exp(-i m phi_j) for m <= mmax
+static void analysis_rings(void *context, size_t s) {
+    const struct sht_job *job = context;
+    double *x = job->scratch + s*job->size, *phase;
+    struct dft d = { 0, 0, x + 8*job->nside, x + 16*job->nside, x + 32*job->nside };
+    
+    for (long r = s; r < 2*job->pairs; r += job->slices) {
+        const struct ring *ring = job->ring + r; const long n = ring->nphi; if (!n) { continue; }
+        
+        for (long j = 0; j < n; j++) {
+            const float v = job->map[ring_nest(job->nside, job->order, ring->index, j)];
+            x[2*j] = isnan(v) ? 0.0 : v; x[2*j+1] = 0.0;
+        }
+        
+        dft_plan(&d, n, job->tw, job->M); dft(&d, x, job->tw, job->M, 0);
+        
+        // shift to first pixel longitude by exp(-i m phi0) rotation
+        const double cr = cos(ring->phi0), ci = -sin(ring->phi0);
+        double er = job->weight, ei = 0.0; phase = job->phase + 2*r*(job->mmax+1);
+        
+        for (long m = 0, k = 0; m <= job->mmax; m++) {
+            const double xr = x[2*k], xi = x[2*k+1];
+            phase[2*m] = xr*er - xi*ei; phase[2*m+1] = xr*ei + xi*er;
+            
+            const double t = er*cr - ei*ci; ei = er*ci + ei*cr; er = t;
+            if (++k == n) { k = 0; }
+        }
+    }
+}
+
+// ring values f_j = sum_m F_m exp(i m phi_j) over -mmax <= m <= mmax, with F_-m = conj(F_m)
+static void synthesis_rings(void *context, size_t s) {
+    const struct sht_job *job = context;
+    double *x = job->scratch + s*job->size;
+    struct dft d = { 0, 0, x + 8*job->nside, x + 16*job->nside, x + 32*job->nside };
+    
+    for (long r = s; r < 2*job->pairs; r += job->slices) {
+        const struct ring *ring = job->ring + r; const long n = ring->nphi; if (!n) { continue; }
+        const double *phase = job->phase + 2*r*(job->mmax+1);
+        
+        // fold aliased frequencies into n bins, rotating by exp(i m phi0)
+        const double cr = cos(ring->phi0), ci = sin(ring->phi0);
+        double er = 1.0, ei = 0.0;
+        
+        memset(x, 0, 2*n*sizeof(double));
+        
+        for (long m = 0, k = 0; m <= job->mmax; m++) {
+            const double fr = phase[2*m]*er - phase[2*m+1]*ei, fi = phase[2*m]*ei + phase[2*m+1]*er;
+            
+            x[2*k] += fr; x[2*k+1] += fi;
+            if (m > 0) { const long q = k ? n-k : 0; x[2*q] += fr; x[2*q+1] -= fi; }
+            
+            const double t = er*cr - ei*ci; ei = er*ci + ei*cr; er = t;
+            if (++k == n) { k = 0; }
+        }
+        
+        dft_plan(&d, n, job->tw, job->M); dft(&d, x, job->tw, job->M, 1);
+        
+        for (long j = 0; j < n; j++) { job->out[ring_nest(job->nside, job->order, ring->index, j)] = (float)x[2*j]; }
+    }
+}
+
+// MARK: Legendre recursion
+
+// recursion lambda_lm = alpha_l (z lambda_l-1,m - beta_l lambda_l-2,m) for orthonormal
+// associated Legendre functions, starting from lambda_m-1,m = 0 (alpha, beta have lmax+2
+// entries, last one zero, so that recursion can run one step past lmax)
+static void recursion(int m, int lmax, double *alpha, double *beta) {
+    for (int l = m+1; l <= lmax; l++) {
+        const double l2 = (double)l*l, k2 = (double)(l-1)*(l-1), m2 = (double)m*m;
+        alpha[l] = sqrt((4.0*l2 - 1.0)/(l2 - m2)); beta[l] = sqrt((k2 - m2)/(4.0*k2 - 1.0));
+    }
+    
+    alpha[lmax+1] = beta[lmax+1] = 0.0;
+}
+
+// first l where lambda_lm(z) is not negligible, with lambda_l-1,m and lambda_lm there;
+// starting value lambda_mm = (-1)^m 2^lognorm sin^m theta is tracked in scaled form while it
+// is out of double range, and lmax+1 is returned if it never gets into range
+static int recursion_start(int m, int lmax, double z, double sth, double lognorm, const double *alpha, const double *beta, double *prev, double *cur) {
+    const double lg = lognorm + m*log2(sth), sign = (m & 1) ? -1.0 : 1.0;
+    
+    if (lg > -1000.0) { *prev = 0.0; *cur = sign*exp2(lg); return m; }
+    
+    int scale = (int)ceil((-lg - 200.0)/SCALE_BITS);
+    double p = 0.0, c = sign*exp2(lg + (double)scale*SCALE_BITS);
+    const double limit = exp2(RESCALE_BITS), rescale = exp2(-SCALE_BITS);
+    
+    for (int l = m+1; l <= lmax; l++) {
+        const double t = alpha[l]*(z*c - beta[l]*p); p = c; c = t;
+        
+        if (fabs(c) > limit) {
+            p *= rescale; c *= rescale;
+            if (--scale == 0) { *prev = p; *cur = c; return l; }
+        }
+    }
+    
+    return lmax+1;
+}
+
+// starting points of recursion for a batch of ring pairs (with recursion state there in
+// p0, c0, and current state set up for the lanes starting first), returning smallest l
+static int batch_start(const struct sht_job *job, int m, long pair, const double *alpha, const double *beta, double z[LANES],
+                       int start[LANES], double p0[LANES], double c0[LANES], double prev[LANES], double cur[LANES]) {
+    int lmin = job->lmax+1;
+    
+    for (int k = 0; k < LANES; k++) {
+        z[k] = 0.0; start[k] = job->lmax+1; p0[k] = c0[k] = 0.0;
+        if (pair+k >= job->pairs) { continue; }
+        
+        const struct ring *ring = job->ring + 2*(pair+k); z[k] = ring->z;
+        start[k] = recursion_start(m, job->lmax, ring->z, ring->sth, job->lognorm[m], alpha, beta, p0+k, c0+k);
+        if (start[k] < lmin) { lmin = start[k]; }
+    }
+    
+    for (int k = 0; k < LANES; k++) { prev[k] = (start[k] == lmin) ? p0[k] : 0.0; cur[k] = (start[k] == lmin) ? c0[k] : 0.0; }
+    
+    return lmin;
+}
+
+// next starting point after l
+static inline int next_start(const int start[LANES], int l) {
+    int next = 1<<30; for (int k = 0; k < LANES; k++) { if (start[k] > l && start[k] < next) { next = start[k]; } }
+    return next;
+}
+
+// a_lm += sum over rings lambda_lm(z) F_m for each m assigned to the slice
+static void analysis_legendre(void *context, size_t s) {
+    const struct sht_job *job = context;
+    const int lmax = job->lmax;
+    double *alpha = job->scratch + s*job->size, *beta = alpha + lmax+2, *acc = beta + lmax+2;
+    
+    for (int m = (int)s; m <= job->mmax; m += (int)job->slices) {
+        recursion(m, lmax, alpha, beta);
+        memset(acc + 2*LANES*m, 0, 2*LANES*(lmax+1-m)*sizeof(double));
+        
+        for (long pair = 0; pair < job->pairs; pair += LANES) {
+            double z[LANES], p0[LANES], c0[LANES], prev[LANES], cur[LANES], sym[2][2][LANES]; int start[LANES];
+            int l = batch_start(job, m, pair, alpha, beta, z, start, p0, c0, prev, cur); if (l > lmax) { continue; }
+            
+            // symmetric and antisymmetric combinations of mirror ring coefficients
+            for (int k = 0; k < LANES; k++) {
+                double a[2] = { 0.0, 0.0 }, b[2] = { 0.0, 0.0 };
+                
+                if (pair+k < job->pairs) {
+                    const double *n = job->phase + 2*(2*(pair+k))*(job->mmax+1) + 2*m, *t = n + 2*(job->mmax+1);
+                    a[0] = n[0]; a[1] = n[1]; if (job->ring[2*(pair+k)+1].nphi) { b[0] = t[0]; b[1] = t[1]; }
+                }
+                
+                for (int c = 0; c < 2; c++) { sym[0][c][k] = a[c] + b[c]; sym[1][c][k] = a[c] - b[c]; }
+            }
+            
+            for (int next = next_start(start, l); l <= lmax; l++) {
+                if (l == next) {
+                    for (int k = 0; k < LANES; k++) { if (start[k] == l) { prev[k] = p0[k]; cur[k] = c0[k]; } }
+                    next = next_start(start, l);
+                }
+                
+                const double (*f)[LANES] = sym[(l-m) & 1], al = alpha[l+1], be = beta[l+1];
+                double *a = acc + 2*LANES*l;
+                
+                for (int k = 0; k < LANES; k++) {
+                    a[k] += cur[k]*f[0][k]; a[LANES+k] += cur[k]*f[1][k];
+                    const double t = al*(z[k]*cur[k] - be*prev[k]); prev[k] = cur[k]; cur[k] = t;
+                }
+            }
+        }
+        
+        double *alm = job->alm + 2*sht_alm_index(lmax, 0, m);
+        
+        for (int l = m; l <= lmax; l++) {
+            const double *a = acc + 2*LANES*l; double re = 0.0, im = 0.0;
+            for (int k = 0; k < LANES; k++) { re += a[k]; im += a[LANES+k]; }
+            alm[2*l] += re; alm[2*l+1] += im;
+        }
+    }
+}
+
+// F_m = sum_l a_lm lambda_lm(z) for each m assigned to the slice
+static void synthesis_legendre(void *context, size_t s) {
+    const struct sht_job *job = context;
+    const int lmax = job->lmax;
+    double *alpha = job->scratch + s*job->size, *beta = alpha + lmax+2;
+    
+    for (int m = (int)s; m <= job->mmax; m += (int)job->slices) {
+        const double *alm = job->alm + 2*sht_alm_index(lmax, 0, m);
+        recursion(m, lmax, alpha, beta);
+        
+        for (long pair = 0; pair < job->pairs; pair += LANES) {
+            double z[LANES], p0[LANES], c0[LANES], prev[LANES], cur[LANES], sym[2][2][LANES] = {{{0}}}; int start[LANES];
+            int l = batch_start(job, m, pair, alpha, beta, z, start, p0, c0, prev, cur);
+            
+            for (int next = next_start(start, l); l <= lmax; l++) {
+                if (l == next) {
+                    for (int k = 0; k < LANES; k++) { if (start[k] == l) { prev[k] = p0[k]; cur[k] = c0[k]; } }
+                    next = next_start(start, l);
+                }
+                
+                double (*f)[LANES] = sym[(l-m) & 1]; const double ar = alm[2*l], ai = alm[2*l+1], al = alpha[l+1], be = beta[l+1];
+                
+                for (int k = 0; k < LANES; k++) {
+                    f[0][k] += cur[k]*ar; f[1][k] += cur[k]*ai;
+                    const double t = al*(z[k]*cur[k] - be*prev[k]); prev[k] = cur[k]; cur[k] = t;
+                }
+            }
+            
+            for (int k = 0; k < LANES && pair+k < job->pairs; k++) {
+                double *n = job->phase + 2*(2*(pair+k))*(job->mmax+1) + 2*m, *t = n + 2*(job->mmax+1);
+                
+                for (int c = 0; c < 2; c++) {
+                    n[c] = sym[0][c][k] + sym[1][c][k]; t[c] = sym[0][c][k] - sym[1][c][k];
+                }
+            }
+        }
+    }
+}
+
+// MARK: transforms
+
+// set up job for a transform, returning 0 on success and -1 if buffers could not be allocated
+static int sht_setup(struct sht_job *job, long nside, int lmax, int mmax) {
+    memset(job, 0, sizeof(struct sht_job));
+    
+    long order = 0; while (order < 29 && (1L << order) < nside) { order++; }
+    if ((1L << order) != nside || lmax < 0 || mmax < 0 || mmax > lmax) { return -1; }
+    
+    long slices = sht_nthreads ? sht_nthreads : sysconf(_SC_NPROCESSORS_ONLN);
+    if (12*nside*nside < SERIAL_PIXELS || slices < 2) { slices = 1; }
+    
+    job->nside = nside; job->order = order; job->lmax = lmax; job->mmax = mmax;
+    job->M = 8*nside; job->slices = slices;
+    
+    // ring transforms need 48*nside doubles, Legendre stage 2*(lmax+2) + 2*LANES*(lmax+1)
+    const long fft = 48*nside, legendre = 2*(lmax+2) + 2*LANES*(lmax+1);
+    job->size = (fft > legendre) ? fft : legendre;
+    
+    double *lognorm = malloc((mmax+1)*sizeof(double)), *tw = malloc(job->M*sizeof(double));
+    job->phase = malloc(2*CHUNK*2*(mmax+1)*sizeof(double));
+    job->scratch = malloc(slices*job->size*sizeof(double));
+    job->lognorm = lognorm; job->tw = tw;
+    
+    if (!lognorm || !tw || !job->phase || !job->scratch) { return -1; }
+    
+    lognorm[0] = -0.5*log2(4.0*pi);
+    for (int m = 1; m <= mmax; m++) { lognorm[m] = lognorm[m-1] + 0.5*log2((2.0*m+1.0)/(2.0*m)); }
+    
+    for (long j = 0; j < job->M/2; j++) { tw[2*j] = cos(2.0*pi*j/job->M); tw[2*j+1] = -sin(2.0*pi*j/job->M); }
+    
+    return 0;
+}
+
+static void sht_cleanup(struct sht_job *job) {
+    free((void *)job->lognorm); free((void *)job->tw); free(job->phase); free(job->scratch);
+}
+
+// run stage on all slices
+static void sht_stage(struct sht_job *job, void (*stage)(void *, size_t)) {
+    if (job->slices > 1) { dispatch_apply_f(job->slices, DISPATCH_APPLY_AUTO, job, stage); }
+    else { stage(job, 0); }
+}
+
+// set up rings of chunk starting at ring pair first (pairs are indexed from 0)
+static void sht_chunk(struct sht_job *job, long first) {
+    const long nside = job->nside, pairs = 2*nside - first;
+    job->pairs = (pairs < CHUNK) ? pairs : CHUNK;
+    
+    for (long q = 0; q < job->pairs; q++) {
+        const long i = first + q + 1;
+        ring_info(nside, i, job->ring + 2*q); ring_info(nside, 4*nside - i, job->ring + 2*q+1);
+        if (i == 2*nside) { job->ring[2*q+1].nphi = 0; }
+    }
+}
+
+// accumulate a_lm of map into job->alm
+static void sht_analysis(struct sht_job *job, const float *map) {
+    job->map = map; job->weight = pi/(3.0*job->nside*job->nside);
+    
+    for (long first = 0; first < 2*job->nside; first += CHUNK) {
+        sht_chunk(job, first);
+        sht_stage(job, analysis_rings);
+        sht_stage(job, analysis_legendre);
+    }
+}
+
+// synthesize map of job->alm
+static void sht_synthesis(struct sht_job *job, float *out) {
+    job->out = out;
+    
+    for (long first = 0; first < 2*job->nside; first += CHUNK) {
+        sht_chunk(job, first);
+        sht_stage(job, synthesis_legendre);
+        sht_stage(job, synthesis_rings);
+    }
+}
+
+// bounds of finite values in map (zero if there are none)
+static void sht_bounds(const float *map, long npix, double *min, double *max) {
+    float lo = INFINITY, hi = -INFINITY;
+    
+    for (long p = 0; p < npix; p++) {
+        const float v = map[p]; if (!isfinite(v)) { continue; }
+        if (v < lo) { lo = v; } if (v > hi) { hi = v; }
+    }
+    
+    if (lo > hi) { lo = hi = 0.0f; }
+    
+    if (min) { *min = lo; } if (max) { *max = hi; }
+}
+
+// a_lm of map, refined by Jacobi iterations a_lm += A(map - S(a_lm))
+static int sht_iterate(struct sht_job *job, const float *map, int iterations) {
+    const long npix = 12*job->nside*job->nside;
+    
+    memset(job->alm, 0, 2*sht_alm_size(job->lmax, job->mmax)*sizeof(double));
+    sht_analysis(job, map); if (iterations < 1) { return 0; }
+    
+    float *residual = malloc(npix*sizeof(float)); if (!residual) { return -1; }
+    
+    for (int i = 0; i < iterations; i++) {
+        sht_synthesis(job, residual);
+        for (long p = 0; p < npix; p++) { residual[p] = map[p] - residual[p]; }
+        sht_analysis(job, residual);
+    }
+    
+    free(residual); return 0;
+}
+
+int sht_map2alm(const float *map, long nside, int lmax, int mmax, int iterations, double *alm) {
+    struct sht_job job; int status = sht_setup(&job, nside, lmax, mmax);
+    
+    if (status == 0) { job.alm = alm; status = sht_iterate(&job, map, iterations); }
+    
+    sht_cleanup(&job); return status;
+}
+
+int sht_alm2map(const double *alm, int lmax, int mmax, float *map, long nside, double *min, double *max) {
+    struct sht_job job; int status = sht_setup(&job, nside, lmax, mmax);
+    
+    if (status == 0) { job.alm = (double *)alm; sht_synthesis(&job, map); sht_bounds(map, 12*nside*nside, min, max); }
+    
+    sht_cleanup(&job); return status;
+}
+
+int sht_filter(const float *map, long nside, int lmax, int iterations, const double *fl, float *out, double *min, double *max) {
+    struct sht_job job; int status = sht_setup(&job, nside, lmax, lmax);
+    const long npix = 12*nside*nside;
+    
+    if (status == 0) {
+        job.alm = malloc(2*sht_alm_size(lmax, lmax)*sizeof(double));
+        status = job.alm ? sht_iterate(&job, map, iterations) : -1;
+    }
+    
+    if (status == 0) {
+        sht_almxfl(job.alm, lmax, lmax, fl); sht_synthesis(&job, out);
+        for (long p = 0; p < npix; p++) { if (isnan(map[p])) { out[p] = NAN; } }
+        sht_bounds(out, npix, min, max);
+    }
+    
+    free(job.alm); sht_cleanup(&job); return status;
+}
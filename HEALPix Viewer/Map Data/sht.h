@@ -0,0 +1,47 @@
+//
+//  sht.h
+//  HEALPix Viewer
+//
+//  Created by Andrei Frolov on 2026-10-17.
+//
+
+#ifndef sht_h
+#define sht_h
+
+// spherical harmonic transforms of NESTED maps: maps are viewed as iso-latitude
+// rings, which are Fourier transformed one at a time, while associated Legendre
+// functions are evaluated by recursion in l for each m, over several rings at once;
+// coefficients a_lm (orthonormal spherical harmonics with Condon-Shortley phase, as
+// in HEALPix) are stored for m >= 0 as interleaved complex doubles in healpy order
+
+// number of threads used by transforms (0 = one per active CPU core)
+void sht_threads(int threads);
+
+// number of coefficients a_lm for l <= lmax, m <= mmax, and index of a_lm among them
+// (which does not depend on mmax, as coefficients are stored in order of m)
+long sht_alm_size(int lmax, int mmax);
+long sht_alm_index(int lmax, int l, int m);
+
+// coefficients of map, with missing (NaN) pixels taken as zero; quadrature with
+// pixel area weights is refined by specified number of Jacobi iterations (as in
+// healpy, 3 is usually enough; round trip through a map is exact to single precision
+// for lmax <= 2*nside only); returns 0 on success, -1 on failure
+int sht_map2alm(const float *map, long nside, int lmax, int mmax, int iterations, double *alm);
+
+// map synthesized from coefficients, returning its data bounds; returns 0 on success, -1 on failure
+int sht_alm2map(const double *alm, int lmax, int mmax, float *map, long nside, double *min, double *max);
+
+// angular power spectrum estimate C_l = (|a_l0|^2 + 2 sum_m>0 |a_lm|^2)/(2l+1), for l <= lmax
+void sht_alm2cl(const double *alm, int lmax, int mmax, double *cl);
+
+// multiply coefficients by filter f_l
+void sht_almxfl(double *alm, int lmax, int mmax, const double *fl);
+
+// Gaussian beam window b_l = exp(-l(l+1) sigma^2/2) of specified FWHM (in radians)
+void sht_gaussian_beam(double fwhm, int lmax, double *bl);
+
+// filter map by f_l up to lmax in harmonic space (missing pixels stay missing in
+// the output), returning data bounds of the result; returns 0 on success, -1 on failure
+int sht_filter(const float *map, long nside, int lmax, int iterations, const double *fl, float *out, double *min, double *max);
+
+#endif /* sht_h */
@@ -0,0 +1,388 @@
+//
+//  smooth.c
+//  HEALPix Viewer
+//
+//  Created by Andrei Frolov on 2026-10-17.
+//  Pixel centers adopted from HEALPix (chealpix.c)
+//  Copyright (C) 1997-2016 Krzysztof M. Gorski, Eric Hivon, Martin Reinecke,
+//                          Benjamin D. Wandelt, Anthony J. Banday,
+//                          Matthias Bartelmann, Reza Ansari & Kenneth M. Ganga
+//
+
+#include <math.h>
+#include <float.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <dispatch/dispatch.h>
+#include "healpix.h"
+#include "neighbours.h"
+#include "smooth.h"
+
+// every level carries numerator (sum of values times weights) and denominator (sum of
+// weights) of a normalized convolution, with weights starting as the fraction of observed
+// pixels in a coarse pixel; a pass of the stencil adds (per axis) variance V(t) h^2 for
+// pixel spacing h and stencil width t h, each degrading step adds 3h^2/4 of the finer
+// level and each upgrade h^2/6 of the coarser one (low frequency response of the
+// filters involved), and the passes make up the rest
+
+// variance of a pass never exceeds this fraction of h^2 (which keeps stencil compact)
+#define PASS_VARIANCE 0.5
+
+// coarse level has at least this many pixels per sigma
+#define SAMPLING 2.0
+
+// coarse level is never below this resolution
+#define COARSEST 8
+
+// maps with fewer pixels than this are smoothed on a single thread
+#define SERIAL_PIXELS (1L<<14)
+
+// number of worker threads (0 = one per active CPU core)
+static int smooth_nthreads = 0;
+
+void smooth_threads(int threads) { smooth_nthreads = (threads > 0) ? threads : 0; }
+
+// MARK: stencil
+
+// per axis variance of Gaussian stencil of width t on a unit square grid, in units of h^2
+static double stencil_variance(double t) {
+    const double e = exp(-0.5/(t*t)), d = e*e;
+    return (2.0*e + 4.0*d)/(1.0 + 4.0*e + 4.0*d);
+}
+
+// stencil width giving per axis variance v < 2/3 (by bisection, as variance grows with width)
+static double stencil_width(double v) {
+    double lo = 0.0, hi = 100.0;
+    
+    for (int i = 0; i < 100; i++) {
+        const double t = 0.5*(lo + hi);
+        if (stencil_variance(t) < v) { lo = t; } else { hi = t; }
+    }
+    
+    return 0.5*(lo + hi);
+}
+
+// MARK: parallel stages
+
+struct smooth_job {
+    const float *map; long nside;       // input map
+    long level;                         // resolution of the level being computed
+    const neighbour_table *table;       // neighbours at resolution of the level it is computed from
+    const float *sum, *wgt;             // numerator and denominator of the level it is computed from
+    float *nsum, *nwgt;                 // numerator and denominator of the level being computed
+    float *stencil;                     // stencil weights (center and 8 neighbours) of coarse pixels
+    double width, variance;             // Gaussian stencil width (in radians) and per axis variance of a pass
+    float *out; double (*bounds)[2];    // output and per slice bounds
+    long slices;
+};
+
+// pixels of current level handled by slice s
+static inline void slice_range(const struct smooth_job *job, size_t s, long *from, long *to) {
+    const long npix = 12*job->level*job->level;
+    *from = npix*s/job->slices; *to = npix*(s+1)/job->slices;
+}
+
+// fine pixels around children of a parent, as neighbours of its children (so that faces are
+// crossed correctly) with bilinear weights (in 1/64), making up a 4x4 block together with children
+static const struct { int child, neighbour, weight; } surrounding[12] = {
+    { 0, NEIGHBOUR_SW, 3 }, { 0, NEIGHBOUR_S, 1 }, { 0, NEIGHBOUR_SE, 3 },
+    { 1, NEIGHBOUR_SE, 3 }, { 1, NEIGHBOUR_E, 1 }, { 1, NEIGHBOUR_NE, 3 },
+    { 2, NEIGHBOUR_SW, 3 }, { 2, NEIGHBOUR_W, 1 }, { 2, NEIGHBOUR_NW, 3 },
+    { 3, NEIGHBOUR_NE, 3 }, { 3, NEIGHBOUR_N, 1 }, { 3, NEIGHBOUR_NW, 3 }
+};
+
+// numerator and denominator of fine pixel p (read from input map at the finest level)
+static inline void fine_pixel(const struct smooth_job *job, long p, float *sum, float *wgt) {
+    if (job->sum) { *sum = job->sum[p]; *wgt = job->wgt[p]; return; }
+    
+    const float v = job->map[p], observed = isfinite(v);
+    *sum = observed ? v : 0.0f; *wgt = observed;
+}
+
+// degrade to next coarser level, averaging 4x4 block of fine pixels around children with
+// weights [1 3 3 1]/8 along each axis (box filter followed by [1 2 1]/4, which curbs aliasing
+// of structure finer than the coarse level)
+static void degrade_slice(void *context, size_t s) {
+    const struct smooth_job *job = context;
+    long from, to; slice_range(job, s, &from, &to);
+    
+    for (long q = from; q < to; q++) {
+        long nb[4][8]; float sum = 0.0f, wgt = 0.0f, v, w;
+        
+        for (int c = 0; c < 4; c++) {
+            neighbours(job->table, 4*q+c, nb[c]);
+            fine_pixel(job, 4*q+c, &v, &w); sum += 9.0f*v; wgt += 9.0f*w;
+        }
+        
+        for (int i = 0; i < 12; i++) {
+            const long n = nb[surrounding[i].child][surrounding[i].neighbour]; if (n < 0) { continue; }
+            fine_pixel(job, n, &v, &w); sum += surrounding[i].weight*v; wgt += surrounding[i].weight*w;
+        }
+        
+        job->nsum[q] = sum/64.0f; job->nwgt[q] = wgt/64.0f;
+    }
+}
+
+// numerator and denominator of input map (when smoothing at full resolution)
+static void copy_slice(void *context, size_t s) {
+    const struct smooth_job *job = context;
+    long from, to; slice_range(job, s, &from, &to);
+    
+    for (long q = from; q < to; q++) { fine_pixel(job, q, job->nsum + q, job->nwgt + q); }
+}
+
+// solve n x n linear system a x = b in place (Gaussian elimination with partial pivoting),
+// returning 0 on success and -1 if the system is singular
+static int solve(int n, double *a, double *b) {
+    for (int c = 0; c < n; c++) {
+        int p = c; for (int r = c+1; r < n; r++) { if (fabs(a[r*n+c]) > fabs(a[p*n+c])) { p = r; } }
+        if (a[p*n+c] == 0.0) { return -1; }
+        
+        if (p != c) {
+            for (int k = 0; k < n; k++) { const double t = a[c*n+k]; a[c*n+k] = a[p*n+k]; a[p*n+k] = t; }
+            const double t = b[c]; b[c] = b[p]; b[p] = t;
+        }
+        
+        for (int r = c+1; r < n; r++) {
+            const double f = a[r*n+c]/a[c*n+c];
+            for (int k = c; k < n; k++) { a[r*n+k] -= f*a[c*n+k]; } b[r] -= f*b[c];
+        }
+    }
+    
+    for (int c = n-1; c >= 0; c--) {
+        for (int k = c+1; k < n; k++) { b[c] -= a[c*n+k]*b[k]; } b[c] /= a[c*n+c];
+    }
+    
+    return 0;
+}
+
+// stencil weights, starting from Gaussian ones g_i in distance to neighbours and corrected to
+// w_i = g_i P(x_i,y_i), with P quadratic in tangent plane coordinates, so that the pass has zero
+// mean displacement and isotropic covariance of prescribed variance; pixel neighbourhoods are
+// distorted across the sphere, and even slight bias of a pass adds up over many passes
+static void stencil_slice(void *context, size_t s) {
+    const struct smooth_job *job = context;
+    const double scale = -0.5/(job->width*job->width);
+    long from, to; slice_range(job, s, &from, &to);
+    
+    for (long q = from; q < to; q++) {
+        long nb[8]; double v[3], u[3], e[2][3], x[9] = {0.0}, y[9] = {0.0}, g[9] = {1.0};
+        float *w = job->stencil + 9*q;
+        
+        neighbours(job->table, q, nb); nest2vec(job->level, q, v);
+        
+        // orthonormal basis of tangent plane
+        const double r = sqrt(v[0]*v[0] + v[1]*v[1]);
+        e[0][0] = -v[1]/r; e[0][1] = v[0]/r; e[0][2] = 0.0;
+        e[1][0] = v[1]*e[0][2] - v[2]*e[0][1]; e[1][1] = v[2]*e[0][0] - v[0]*e[0][2]; e[1][2] = v[0]*e[0][1] - v[1]*e[0][0];
+        
+        for (int i = 1; i < 9; i++) {
+            if (nb[i-1] < 0) { g[i] = 0.0; continue; }
+            
+            nest2vec(job->level, nb[i-1], u);
+            const double d[3] = { u[0]-v[0], u[1]-v[1], u[2]-v[2] };
+            
+            x[i] = d[0]*e[0][0] + d[1]*e[0][1] + d[2]*e[0][2];
+            y[i] = d[0]*e[1][0] + d[1]*e[1][1] + d[2]*e[1][2];
+            g[i] = exp(scale*(d[0]*d[0] + d[1]*d[1] + d[2]*d[2]));
+        }
+        
+        // moments 1, x, y, x^2, y^2, xy of the weights are to be 1, 0, 0, variance, variance, 0
+        double f[6][9], a[36], m[6] = { 1.0, 0.0, 0.0, job->variance, job->variance, 0.0 };
+        
+        for (int i = 0; i < 9; i++) {
+            f[0][i] = 1.0; f[1][i] = x[i]; f[2][i] = y[i];
+            f[3][i] = x[i]*x[i]; f[4][i] = y[i]*y[i]; f[5][i] = x[i]*y[i];
+        }
+        
+        for (int j = 0; j < 6; j++) {
+            for (int k = 0; k < 6; k++) { double t = 0.0; for (int i = 0; i < 9; i++) { t += g[i]*f[j][i]*f[k][i]; } a[6*j+k] = t; }
+        }
+        
+        // fall back to normalized Gaussian weights if constraints cannot be met
+        if (solve(6, a, m) == 0) {
+            for (int i = 0; i < 9; i++) { double t = 0.0; for (int k = 0; k < 6; k++) { t += m[k]*f[k][i]; } w[i] = g[i]*t; }
+        } else {
+            double total = 0.0; for (int i = 0; i < 9; i++) { total += g[i]; }
+            for (int i = 0; i < 9; i++) { w[i] = g[i]/total; }
+        }
+    }
+}
+
+// single stencil pass at coarse level
+static void pass_slice(void *context, size_t s) {
+    const struct smooth_job *job = context;
+    long from, to; slice_range(job, s, &from, &to);
+    
+    for (long q = from; q < to; q++) {
+        long nb[8]; const float *w = job->stencil + 9*q;
+        float sum = w[0]*job->sum[q], wgt = w[0]*job->wgt[q];
+        
+        neighbours(job->table, q, nb);
+        
+        for (int i = 0; i < 8; i++) {
+            const long n = (nb[i] < 0) ? q : nb[i];
+            sum += w[i+1]*job->sum[n]; wgt += w[i+1]*job->wgt[n];
+        }
+        
+        job->nsum[q] = sum; job->nwgt[q] = wgt;
+    }
+}
+
+// neighbours of parent towards a child: child bit 0 steps in x, bit 1 in y (bilinear weights 3/16,
+// 3/16, 1/16 for neighbours along x, along y and diagonally, and 9/16 for parent itself)
+static const int towards[4][3] = {
+    { NEIGHBOUR_SW, NEIGHBOUR_SE, NEIGHBOUR_S },
+    { NEIGHBOUR_NE, NEIGHBOUR_SE, NEIGHBOUR_E },
+    { NEIGHBOUR_SW, NEIGHBOUR_NW, NEIGHBOUR_W },
+    { NEIGHBOUR_NE, NEIGHBOUR_NW, NEIGHBOUR_N }
+};
+
+// bilinear interpolation of numerator and denominator at child p
+static inline void interpolate(const struct smooth_job *job, long p, float *sum, float *wgt) {
+    static const float b[3] = { 3.0f/16.0f, 3.0f/16.0f, 1.0f/16.0f };
+    const long q = p >> 2; const int *k = towards[p & 3]; long nb[8];
+    float s = 9.0f/16.0f*job->sum[q], w = 9.0f/16.0f*job->wgt[q];
+    
+    neighbours(job->table, q, nb);
+    
+    for (int i = 0; i < 3; i++) {
+        const long n = nb[k[i]]; if (n < 0) { continue; }
+        s += b[i]*job->sum[n]; w += b[i]*job->wgt[n];
+    }
+    
+    *sum = s; *wgt = w;
+}
+
+// upgrade to next finer level
+static void upgrade_slice(void *context, size_t s) {
+    const struct smooth_job *job = context;
+    long from, to; slice_range(job, s, &from, &to);
+    
+    for (long p = from; p < to; p++) { interpolate(job, p, job->nsum + p, job->nwgt + p); }
+}
+
+// output level, interpolated from the one before (or taken as is if there is no table)
+static void output_slice(void *context, size_t s) {
+    const struct smooth_job *job = context;
+    const long block = (job->nside/job->level)*(job->nside/job->level);
+    float minval = FLT_MAX, maxval = -FLT_MAX;
+    long from, to; slice_range(job, s, &from, &to);
+    
+    for (long p = from; p < to; p++) {
+        const float *in = job->map + p*block; long observed = 0;
+        for (long i = 0; i < block && !observed; i++) { observed = isfinite(in[i]); }
+        
+        float sum = 0.0f, wgt = 0.0f;
+        if (!observed) { job->out[p] = NAN; continue; }
+        
+        if (job->table) { interpolate(job, p, &sum, &wgt); } else { sum = job->sum[p]; wgt = job->wgt[p]; }
+        
+        const float v = (wgt > 0.0f) ? sum/wgt : NAN; job->out[p] = v;
+        if (v < minval) { minval = v; }
+        if (v > maxval) { maxval = v; }
+    }
+    
+    job->bounds[s][0] = minval; job->bounds[s][1] = maxval;
+}
+
+// run stage over pixels of level nside on all slices
+static void smooth_stage(struct smooth_job *job, long level, void (*stage)(void *, size_t)) {
+    long slices = smooth_nthreads ? smooth_nthreads : sysconf(_SC_NPROCESSORS_ONLN);
+    if (12*level*level < SERIAL_PIXELS || slices < 2) { slices = 1; }
+    
+    job->level = level; job->slices = slices;
+    
+    if (slices > 1) { dispatch_apply_f(slices, DISPATCH_APPLY_AUTO, job, stage); }
+    else { stage(job, 0); }
+}
+
+// MARK: smoothing
+
+// degrade to coarse level, run stencil passes there and upgrade to output level
+static int smooth_levels(struct smooth_job *job, float *sum[2], float *wgt[2], long coarse, long nout, long passes) {
+    int k = 0;
+    
+    for (long level = job->nside; level > coarse; level /= 2) {
+        job->table = neighbours_for(level); if (!job->table) { return -1; }
+        job->sum = (level < job->nside) ? sum[k] : NULL; job->wgt = (level < job->nside) ? wgt[k] : NULL;
+        if (level < job->nside) { k ^= 1; } job->nsum = sum[k]; job->nwgt = wgt[k];
+        smooth_stage(job, level/2, degrade_slice);
+    }
+    
+    job->table = neighbours_for(coarse); if (!job->table) { return -1; }
+    
+    // at full resolution, stencil passes start from the input map
+    if (coarse == job->nside) {
+        job->nsum = sum[k]; job->nwgt = wgt[k]; job->sum = NULL;
+        smooth_stage(job, coarse, copy_slice);
+    }
+    
+    if (passes) { smooth_stage(job, coarse, stencil_slice); }
+    
+    for (long i = 0; i < passes; i++) {
+        job->sum = sum[k]; job->wgt = wgt[k]; k ^= 1; job->nsum = sum[k]; job->nwgt = wgt[k];
+        smooth_stage(job, coarse, pass_slice);
+    }
+    
+    for (long level = coarse; level < nout/2; level *= 2) {
+        job->table = neighbours_for(level); if (!job->table) { return -1; }
+        job->sum = sum[k]; job->wgt = wgt[k]; k ^= 1; job->nsum = sum[k]; job->nwgt = wgt[k];
+        smooth_stage(job, 2*level, upgrade_slice);
+    }
+    
+    job->table = (coarse < nout) ? neighbours_for(nout/2) : NULL; job->sum = sum[k]; job->wgt = wgt[k];
+    if (coarse < nout && !job->table) { return -1; }
+    
+    smooth_stage(job, nout, output_slice);
+    return 0;
+}
+
+int smooth_gaussian(const float *map, long nside, double fwhm, long nout, float *out, double *min, double *max) {
+    if (nside < 1 || (nside & (nside-1)) || nout < 1 || nout > nside || (nout & (nout-1))) { return -1; }
+    
+    // coarse level sampling the beam, and variance left for stencil passes after degrading and upgrading
+    const double sigma = fmax(fwhm, 0.0)/sqrt(8.0*log(2.0)), spacing = sqrt(M_PI/3.0);
+    long coarse = nout; while (coarse > COARSEST && SAMPLING*spacing/(coarse/2) <= sigma) { coarse /= 2; }
+    
+    const double h = spacing/coarse; double variance = sigma*sigma;
+    for (long level = nside; level > coarse; level /= 2) { const double hl = spacing/level; variance -= 0.75*hl*hl; }
+    for (long level = coarse; level < nout; level *= 2) { const double hl = spacing/level; variance -= hl*hl/6.0; }
+    
+    const long passes = (variance > 0.0) ? (long)ceil(variance/(PASS_VARIANCE*h*h)) : 0;
+    const long npix = 12*coarse*coarse, finest = (coarse < nside) ? 3*nside*nside : 12*nside*nside;
+    
+    // numerator and denominator buffers (two sets, alternating between passes and levels), stencil and bounds
+    float *sum[2] = { malloc(finest*sizeof(float)), malloc(finest*sizeof(float)) };
+    float *wgt[2] = { malloc(finest*sizeof(float)), malloc(finest*sizeof(float)) };
+    float *stencil = passes ? malloc(9*npix*sizeof(float)) : NULL;
+    
+    long slices = smooth_nthreads ? smooth_nthreads : sysconf(_SC_NPROCESSORS_ONLN); if (slices < 1) { slices = 1; }
+    double (*bounds)[2] = calloc(slices, sizeof(double[2]));
+    
+    const double pass = passes ? variance/passes : 0.0, width = passes ? h*stencil_width(pass/(h*h)) : 0.0;
+    struct smooth_job job = { map, nside, 0, NULL, NULL, NULL, NULL, NULL, stencil, width, pass, out, bounds, 1 };
+    int status = -1;
+    
+    if (sum[0] && sum[1] && wgt[0] && wgt[1] && (stencil || !passes) && bounds) {
+        for (long s = 0; s < slices; s++) { bounds[s][0] = FLT_MAX; bounds[s][1] = -FLT_MAX; }
+        status = smooth_levels(&job, sum, wgt, coarse, nout, passes);
+    }
+    
+    if (status == 0) {
+        double minval = FLT_MAX, maxval = -FLT_MAX;
+        
+        for (long s = 0; s < slices; s++) {
+            if (bounds[s][0] < minval) { minval = bounds[s][0]; }
+            if (bounds[s][1] > maxval) { maxval = bounds[s][1]; }
+        }
+        
+        // maps without finite values get degenerate bounds
+        if (minval > maxval) { minval = maxval = 0.0; }
+        
+        *min = minval; *max = maxval;
+    }
+    
+    free(sum[0]); free(sum[1]); free(wgt[0]); free(wgt[1]); free(stencil); free(bounds);
+    return status;
+}
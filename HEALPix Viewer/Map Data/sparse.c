@@ -0,0 +1,139 @@
+//
+//  sparse.c
+//  HEALPix Viewer
+//
+//  Created by Andrei Frolov on 2026-10-17.
+//
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sparse.h"
+
+// partial-sky maps (e.g. balloon and ground-based surveys) observe contiguous
+// patches, so storing whole NESTED tiles keeps pixel lookup a couple of shifts
+// away, while most of the unobserved sky never gets allocated; tiles are kept
+// in NESTED order, so stored data is a NESTED-sorted subset of the full map
+
+// tile order (tiles of 4^SPARSE_ORDER pixels, i.e. 64x64 patches of a face)
+#define SPARSE_ORDER 6
+
+// bits in a coverage bitmap word
+#define WORD_BITS (8*sizeof(unsigned long))
+
+// allocate layout of given resolution with no tiles marked yet
+static sparse_layout *alloc_layout(long nside) {
+    sparse_layout *layout = calloc(1, sizeof(sparse_layout)); if (!layout) { return NULL; }
+    
+    long order = 0; while (order < SPARSE_ORDER && (1L << order) < nside) { order++; }
+    const long npix = 12*nside*nside, tiles = npix >> (2*order), words = (tiles + WORD_BITS-1)/WORD_BITS;
+    
+    layout->nside = nside; layout->order = order; layout->tiles = tiles;
+    layout->coverage = calloc(words, sizeof(unsigned long));
+    layout->slot = malloc(tiles*sizeof(long));
+    
+    if (!layout->coverage || !layout->slot) { free_sparse_layout(layout); return NULL; }
+    
+    return layout;
+}
+
+// assign storage slots to marked tiles in NESTED order
+static sparse_layout *assign_slots(sparse_layout *layout) {
+    const long tiles = layout->tiles, words = (tiles + WORD_BITS-1)/WORD_BITS;
+    
+    long filled = 0; for (long w = 0; w < words; w++) { filled += __builtin_popcountl(layout->coverage[w]); }
+    layout->filled = filled; layout->tile = malloc((filled ? filled : 1)*sizeof(long));
+    
+    if (!layout->tile) { free_sparse_layout(layout); return NULL; }
+    
+    for (long t = 0, s = 0; t < tiles; t++) {
+        if (layout->coverage[t/WORD_BITS] & (1UL << (t%WORD_BITS))) { layout->slot[t] = s; layout->tile[s] = t; s++; }
+        else { layout->slot[t] = -1; }
+    }
+    
+    return layout;
+}
+
+// build layout covering given pixels
+sparse_layout *make_sparse_layout(long nside, const long *idx, long nobs) {
+    sparse_layout *layout = alloc_layout(nside); if (!layout) { return NULL; }
+    const long order = layout->order;
+    
+    // mark tiles with observed pixels
+    for (long i = 0; i < nobs; i++) { const long t = idx[i] >> (2*order); layout->coverage[t/WORD_BITS] |= 1UL << (t%WORD_BITS); }
+    
+    return assign_slots(layout);
+}
+
+// rebuild layout from its table of stored tiles
+sparse_layout *make_sparse_layout_tiles(long nside, const long *tile, long filled) {
+    sparse_layout *layout = alloc_layout(nside); if (!layout) { return NULL; }
+    
+    // tiles must be distinct, in range, and in ascending order
+    for (long s = 0; s < filled; s++) {
+        const long t = tile[s];
+        if (t < 0 || t >= layout->tiles || (s > 0 && t <= tile[s-1])) { free_sparse_layout(layout); return NULL; }
+        
+        layout->coverage[t/WORD_BITS] |= 1UL << (t%WORD_BITS);
+    }
+    
+    return assign_slots(layout);
+}
+
+// free layout tables
+void free_sparse_layout(sparse_layout *layout) {
+    if (!layout) { return; }
+    
+    free(layout->coverage);
+    free(layout->slot);
+    free(layout->tile);
+    free(layout);
+}
+
+// number of pixels in a tile
+long sparse_tile(const sparse_layout *layout) { return 1L << (2*layout->order); }
+
+// size of map data stored in layout
+long sparse_size(const sparse_layout *layout) { return layout->filled << (2*layout->order); }
+
+// NESTED pixels to positions in stored data (pixels must be covered by layout)
+void sparse_pack(const sparse_layout *layout, const long *idx, long *pos, long n) {
+    const long k = 2*layout->order, mask = (1L << k) - 1;
+    for (long i = 0; i < n; i++) { const long p = idx[i]; pos[i] = (layout->slot[p >> k] << k) | (p & mask); }
+}
+
+// positions in stored data to NESTED pixels
+void sparse_unpack(const sparse_layout *layout, const long *pos, long *idx, long n) {
+    const long k = 2*layout->order, mask = (1L << k) - 1;
+    for (long i = 0; i < n; i++) { const long q = pos[i]; idx[i] = (layout->tile[q >> k] << k) | (q & mask); }
+}
+
+// NESTED pixels to positions in stored data (32-bit index)
+void sparse_pack32(const sparse_layout *layout, const int *idx, int *pos, long n) {
+    const long k = 2*layout->order, mask = (1L << k) - 1;
+    for (long i = 0; i < n; i++) { const long p = idx[i]; pos[i] = (int) ((layout->slot[p >> k] << k) | (p & mask)); }
+}
+
+// positions in stored data to NESTED pixels (32-bit index)
+void sparse_unpack32(const sparse_layout *layout, const int *pos, int *idx, long n) {
+    const long k = 2*layout->order, mask = (1L << k) - 1;
+    for (long i = 0; i < n; i++) { const long q = pos[i]; idx[i] = (int) ((layout->tile[q >> k] << k) | (q & mask)); }
+}
+
+// value of NESTED pixel p
+float sparse_value(const sparse_layout *layout, const float *data, long p) {
+    const long k = 2*layout->order, s = layout->slot[p >> k];
+    return (s < 0) ? NAN : data[(s << k) | (p & ((1L << k) - 1))];
+}
+
+// expand stored data into full-sky map
+void sparse_expand(const sparse_layout *layout, const float *data, float *out) {
+    const long tile = sparse_tile(layout);
+    
+    for (long t = 0; t < layout->tiles; t++) {
+        const long s = layout->slot[t]; float *p = out + t*tile;
+        
+        if (s < 0) { for (long i = 0; i < tile; i++) { p[i] = NAN; } }
+        else { memcpy(p, data + s*tile, tile*sizeof(float)); }
+    }
+}
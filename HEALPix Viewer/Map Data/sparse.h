@@ -0,0 +1,48 @@
+//
+//  sparse.h
+//  HEALPix Viewer
+//
+//  Created by Andrei Frolov on 2026-10-17.
+//
+
+#ifndef sparse_h
+#define sparse_h
+
+// sparse storage layout of a partial-sky NESTED map: the sphere is split into
+// tiles of consecutive pixels (square patches of a face), and only tiles with
+// observed pixels are stored, packed in NESTED order (unobserved pixels of a
+// stored tile are NaN); map data of this layout is a float array of size
+// filled*tile, and any number of maps can share the same layout
+typedef struct {
+    long nside, order;          // map resolution and tile order (tile = 4^order pixels)
+    long tiles, filled;         // number of tiles on the sphere, and of stored tiles
+    unsigned long *coverage;    // bitmap of stored tiles
+    long *slot;                 // storage slot of each tile (-1 if not stored)
+    long *tile;                 // tile stored in each slot (in ascending order)
+} sparse_layout;
+
+// layout covering NESTED pixels idx[0..nobs)
+sparse_layout *make_sparse_layout(long nside, const long *idx, long nobs);
+void free_sparse_layout(sparse_layout *layout);
+
+// layout storing given tiles (table of stored tiles of another layout, e.g. cached one);
+// returns NULL if tiles are out of range or not in strictly ascending order
+sparse_layout *make_sparse_layout_tiles(long nside, const long *tile, long filled);
+
+// number of pixels in a tile, and size of map data stored in layout
+long sparse_tile(const sparse_layout *layout);
+long sparse_size(const sparse_layout *layout);
+
+// convert NESTED pixels to positions in stored data and back (in place is fine)
+void sparse_pack(const sparse_layout *layout, const long *idx, long *pos, long n);
+void sparse_unpack(const sparse_layout *layout, const long *pos, long *idx, long n);
+void sparse_pack32(const sparse_layout *layout, const int *idx, int *pos, long n);
+void sparse_unpack32(const sparse_layout *layout, const int *pos, int *idx, long n);
+
+// value of NESTED pixel p (NaN if it is not stored)
+float sparse_value(const sparse_layout *layout, const float *data, long p);
+
+// expand stored data into full-sky map
+void sparse_expand(const sparse_layout *layout, const float *data, float *out);
+
+#endif /* sparse_h */
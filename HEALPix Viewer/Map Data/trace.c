@@ -0,0 +1,203 @@
+//
+//  trace.c
+//  HEALPix Viewer
+//
+//  Created by Andrei Frolov on 2026-10-17.
+//
+
+#include <time.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <sys/resource.h>
+#if defined(__APPLE__)
+#include <malloc/malloc.h>
+#elif defined(__GLIBC__)
+#include <malloc.h>
+#endif
+#include "trace.h"
+
+// stages are appended to a preallocated buffer by lock-free slot reservation, so that
+// concurrently converted chunks can be traced without serializing them; a stage is
+// published when it ends, and stages that never ended (e.g. on error) are left out
+
+// MARK: recorded stages
+
+struct trace_event {
+    char name[56];
+    int thread;                         // traced thread number (in order of first stage)
+    double start, duration;             // in seconds since tracing was enabled
+    double bytes;                       // bytes processed
+    double heap, delta, peak;           // heap in use at stage end, its change over stage, and peak resident size
+    atomic_int done;
+};
+
+static struct trace_event *events = NULL;
+static atomic_long count = 0;
+static atomic_int enabled = 0, threads = 0;
+static double origin = 0.0;
+
+// JSON output is serialized, so that concurrent loads do not garble the trace file
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+
+// MARK: clocks and memory counters
+
+// monotonic wall clock, in seconds
+static double now(void) {
+    struct timespec t; clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + 1.0e-9*t.tv_nsec;
+}
+
+// bytes currently allocated on the heap (all malloc zones)
+static double heap_in_use(void) {
+#if defined(__APPLE__)
+    malloc_statistics_t stats; malloc_zone_statistics(NULL, &stats); return stats.size_in_use;
+#elif defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 33)
+    struct mallinfo2 info = mallinfo2(); return (double) info.uordblks + info.hblkhd;
+#else
+    return 0.0;
+#endif
+}
+
+// peak resident size of the process so far, in bytes
+static double peak_resident(void) {
+    struct rusage usage; if (getrusage(RUSAGE_SELF, &usage)) { return 0.0; }
+#if defined(__APPLE__)
+    return usage.ru_maxrss;
+#else
+    return 1024.0*usage.ru_maxrss;
+#endif
+}
+
+// traced thread number of the calling thread
+static int thread_number(void) {
+    static _Thread_local int thread = 0;
+    if (!thread) { thread = atomic_fetch_add(&threads, 1) + 1; }
+    return thread;
+}
+
+// MARK: tracing
+
+void trace_enable(int enable) {
+    if (enable && !events) { events = calloc(TRACE_EVENTS, sizeof(struct trace_event)); if (!events) { return; } }
+    if (enable) { atomic_store(&count, 0); origin = now(); }
+    
+    atomic_store(&enabled, enable ? 1 : 0);
+}
+
+int trace_enabled(void) { return atomic_load_explicit(&enabled, memory_order_relaxed); }
+
+long trace_begin(const char *name) {
+    if (!atomic_load_explicit(&enabled, memory_order_relaxed)) { return -1; }
+    
+    const long k = atomic_fetch_add(&count, 1); if (k >= TRACE_EVENTS) { return -1; }
+    struct trace_event *e = events + k;
+    
+    strncpy(e->name, name, sizeof(e->name)-1); e->name[sizeof(e->name)-1] = 0;
+    e->thread = thread_number();
+    e->heap = heap_in_use();
+    e->start = now() - origin;
+    atomic_store_explicit(&e->done, 0, memory_order_relaxed);
+    
+    return k;
+}
+
+void trace_end(long stage, double bytes) {
+    if (stage < 0 || stage >= TRACE_EVENTS || !events) { return; }
+    struct trace_event *e = events + stage;
+    
+    e->duration = now() - origin - e->start;
+    e->bytes = bytes;
+    e->delta = heap_in_use() - e->heap; e->heap += e->delta;
+    e->peak = peak_resident();
+    
+    atomic_store_explicit(&e->done, 1, memory_order_release);
+}
+
+// number of stage slots that may hold completed stages
+static long recorded(void) {
+    const long n = atomic_load(&count);
+    return (!events) ? 0 : (n < TRACE_EVENTS) ? n : TRACE_EVENTS;
+}
+
+// MARK: export
+
+// write string with JSON escapes
+static void json_string(FILE *out, const char *s) {
+    fputc('"', out);
+    
+    for (; *s; s++) {
+        const unsigned char c = *s;
+        if (c == '"' || c == '\\') { fputc('\\', out); fputc(c, out); }
+        else if (c < 0x20) { fprintf(out, "\\u%04x", c); }
+        else { fputc(c, out); }
+    }
+    
+    fputc('"', out);
+}
+
+int trace_write_json(const char *file) {
+    pthread_mutex_lock(&lock);
+    FILE *out = fopen(file, "w"); if (!out) { pthread_mutex_unlock(&lock); return -1; }
+    const long n = recorded(); int first = 1;
+    
+    fprintf(out, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n");
+    
+    for (long k = 0; k < n; k++) {
+        const struct trace_event *e = events + k;
+        if (!atomic_load_explicit(&e->done, memory_order_acquire)) { continue; }
+            
+        // complete event for the stage, and heap counter sample at its end
+        fprintf(out, "%s  {\"name\": ", first ? "" : ",\n"); json_string(out, e->name);
+        fprintf(out, ", \"cat\": \"stage\", \"ph\": \"X\", \"pid\": 1, \"tid\": %d, \"ts\": %.3f, \"dur\": %.3f, "
+                "\"args\": {\"bytes\": %.0f, \"heap\": %.0f, \"delta\": %.0f, \"peak\": %.0f}},\n",
+                e->thread, 1.0e6*e->start, 1.0e6*e->duration, e->bytes, e->heap, e->delta, e->peak);
+        fprintf(out, "  {\"name\": \"memory\", \"ph\": \"C\", \"pid\": 1, \"ts\": %.3f, \"args\": {\"heap MB\": %.3f, \"peak MB\": %.3f}}",
+                1.0e6*(e->start + e->duration), e->heap/(1<<20), e->peak/(1<<20));
+        first = 0;
+    }
+    
+    fprintf(out, "\n]}\n");
+    
+    const int status = (ferror(out) | fclose(out)) ? -1 : 0;
+    pthread_mutex_unlock(&lock); return status;
+}
+
+void trace_summary(FILE *out, long first) {
+    const long n = recorded(); if (first < 0 || first >= n) { return; }
+    
+    // stages aggregated by name, in order of first appearance
+    struct { const char *name; long calls; double time, bytes, delta, peak; } *stage = calloc(n-first, sizeof(*stage));
+    long stages = 0; double start = 0.0, end = 0.0; if (!stage) { return; }
+    
+    for (long k = first; k < n; k++) {
+        const struct trace_event *e = events + k;
+        if (!atomic_load_explicit(&e->done, memory_order_acquire)) { continue; }
+        
+        long s = 0; while (s < stages && strcmp(stage[s].name, e->name)) { s++; }
+        if (s == stages) { stage[stages++].name = e->name; }
+        
+        stage[s].calls++; stage[s].time += e->duration; stage[s].bytes += e->bytes;
+        if (e->delta > stage[s].delta) { stage[s].delta = e->delta; }
+        if (e->peak > stage[s].peak) { stage[s].peak = e->peak; }
+        
+        if (s == 0 && stage[s].calls == 1) { start = e->start; end = e->start + e->duration; }
+        if (e->start < start) { start = e->start; }
+        if (e->start + e->duration > end) { end = e->start + e->duration; }
+    }
+    
+    // share is relative to wall time spanned by all stages (nested stages overlap)
+    const double MB = 1<<20, span = end - start;
+    fprintf(out, "%-32s %6s %11s %7s %10s %9s %9s %9s\n", "stage", "calls", "time [ms]", "share", "data [MB]", "MB/s", "heap +MB", "peak MB");
+    
+    for (long s = 0; s < stages; s++) {
+        fprintf(out, "%-32.32s %6ld %11.2f %6.1f%% %10.1f %9.0f %9.1f %9.1f\n", stage[s].name, stage[s].calls,
+                1.0e3*stage[s].time, (span > 0.0) ? 100.0*stage[s].time/span : 0.0, stage[s].bytes/MB,
+                (stage[s].time > 0.0) ? stage[s].bytes/MB/stage[s].time : 0.0, stage[s].delta/MB, stage[s].peak/MB);
+    }
+    
+    if (atomic_load(&count) > TRACE_EVENTS) { fprintf(out, "(%ld stages dropped)\n", atomic_load(&count) - TRACE_EVENTS); }
+    
+    free(stage);
+}
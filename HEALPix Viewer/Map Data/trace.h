@@ -0,0 +1,39 @@
+//
+//  trace.h
+//  HEALPix Viewer
+//
+//  Created by Andrei Frolov on 2026-10-17.
+//
+
+#ifndef trace_h
+#define trace_h
+
+#include <stdio.h>
+
+// stage-level instrumentation of map load pipeline: each stage records wall time,
+// bytes processed, and memory use (heap in use when the stage ends, its change over
+// the stage, and peak resident size of the process so far) into an event buffer,
+// which can be exported as Chrome trace event JSON (chrome://tracing or Perfetto)
+// or summarized as a table; tracing is off by default, and then a stage costs
+// a single flag test
+
+// maximal number of recorded stages (later ones are dropped)
+#define TRACE_EVENTS (1L<<14)
+
+// enable tracing (discarding stages recorded so far), or disable it
+void trace_enable(int enable);
+int trace_enabled(void);
+
+// begin a stage (safe to call from any thread), returning its handle (-1 if not recorded)
+long trace_begin(const char *name);
+
+// end a stage, recording number of bytes it processed
+void trace_end(long stage, double bytes);
+
+// write all recorded stages as Chrome trace event JSON, returning 0 on success and -1 on failure
+int trace_write_json(const char *file);
+
+// print summary table of stages recorded since (and including) specified one, aggregated by name
+void trace_summary(FILE *out, long first);
+
+#endif /* trace_h */
@@ -16,7 +16,6 @@ using namespace metal;
 #include "Components.metal"
 #include "Transforms.metal"
 #include "Projections.metal"
-#include "Reductions.metal"
 
 // checkerboard grid on spherical coordinates
 inline float4 grid(const float2 ang) {
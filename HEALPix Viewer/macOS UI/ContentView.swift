@@ -25,6 +25,8 @@ struct ContentView: View {
     
     // open files
     @State private var loading = false
+    @State private var fraction: Double? = nil
+    @State private var generation = 0
     @State private var file = [HpxFile]()
     @State private var loaded = [MapData]()
     @State private var selected: UUID? = nil
@@ -43,6 +45,7 @@ struct ContentView: View {
     @State private var map: MTLTexture? = nil
     @State private var lut: Map? = nil
     @State private var cdf: [Double]? = nil
+    @State private var moments: Moments? = nil
     @State private var data: MapData? = nil
     @State private var info: String? = nil
     @State private var ranked: Bool = false
@@ -140,6 +143,11 @@ struct ContentView: View {
                         .frame(minWidth: 210, maxWidth: .infinity)
                         .padding(.bottom, 10)
                 }
+                if let fraction = fraction {
+                    Divider()
+                    Text("Loading Data...").padding([.top], 5)
+                    ProgressView(value: fraction).padding([.leading,.trailing], 10).padding([.bottom], 2)
+                }
                 if (scheduled > 0) {
                     Divider()
                     Text("Analyzing Data...").padding([.top], 5)
@@ -241,7 +249,7 @@ struct ContentView: View {
                 }
                 Group {
                     if #available(macOS 13.0, *), (overlay == .statview && sidebar != .mixer) {
-                        StatView(cdf: $cdf, range: $state.range).background(.thinMaterial)
+                        StatView(cdf: $cdf, moments: $moments, range: $state.range).background(.thinMaterial)
                         .onChange(of: cdf) { value in if (value == nil) { overlay = .none } }
                     }
                     if (overlay == .infoview) {
@@ -385,9 +393,29 @@ struct ContentView: View {
     @MainActor func open(_ url: URL? = nil) {
         guard let url = url ?? showOpenPanel() else { return }
         
+        // previews still queued when loading finishes are stale
+        generation += 1; let current = generation
+        
         userTaskQueue.async {
-            self.loading = true; defer { self.loading = false }
-            guard let file = read_hpxfile(url: url) else { return }
+            self.loading = true; defer { self.loading = false; self.fraction = nil }
+            
+            // show coarse preview of default data source while the file is being loaded
+            let progress: LoadProgress = { fraction, preview, maps in
+                Task { @MainActor in
+                    guard self.generation == current, let m = preview.firstIndex(where: {MapCard.type($0.name) == DataSource.value}) ?? preview.indices.first else { return }
+                    
+                    // stash current settings before preview replaces the map shown
+                    if (self.fraction == nil) { data?.settings = state }
+                    
+                    self.loading = false; self.fraction = fraction
+                    preview[m].update(maps[m]); load(preview[m])
+                }
+            }
+            
+            // restore current map view if file could not be loaded
+            guard let file = read_hpxfile(url: url, progress: progress) else {
+                Task { @MainActor in self.generation += 1; if (loaded[selected] != nil) { load() } else { clear() } }; return
+            }
             
             self.file.append(file)
             self.loaded += file.list
@@ -396,14 +424,15 @@ struct ContentView: View {
             for map in file.list { analyze(map) }
             
             // select default data source
-            self.selected = (file.list.first(where: {MapCard.type($0.name) == DataSource.value}) ?? file.list.first)?.id
+            let id = (file.list.first(where: {MapCard.type($0.name) == DataSource.value}) ?? file.list.first)?.id
+            Task { @MainActor in self.generation += 1; self.selected = id }
         }
     }
     
     // clear map view
     @MainActor func clear() {
         map = nil; data = nil; info = nil
-        lut = nil; cdf = nil; ranked = false
+        lut = nil; cdf = nil; moments = nil; ranked = false
         annotation = "TEMPERATURE [μK]"
         datamin = 0.0; mumin = 0.0
         datamax = 0.0; mumax = 0.0
@@ -411,7 +440,7 @@ struct ContentView: View {
     
     // load map data
     @MainActor func load(_ map: Map, range: Bounds? = nil) {
-        lut = map; cdf = map.cdf; datamin = map.min; datamax = map.max
+        lut = map; cdf = map.cdf; moments = map.moments; datamin = map.min; datamax = map.max
         if keepState.range, let range = range { self.state.range = range }
         else { self.state.range = Bounds(mode: .full, min: datamin, max: datamax) }
     }
@@ -420,7 +449,7 @@ struct ContentView: View {
     @MainActor func load(_ map: MapData, force: Bool = false) {
         self.map = map.texture
         data = map; info = map.info
-        ranked = (map.ranked != nil)
+        ranked = (map.ranked != nil || map.data.cdf != nil)
         title = "\(map.name)[\(map.file)]"
         annotation = "\(map.name) [\(map.unit)]"
         mumin = map.data.min; mumax = map.data.max
@@ -444,15 +473,23 @@ struct ContentView: View {
         analyze(map); load(map); Task { barview?.draw() }
     }
     
-    // dispatch maps for analysis
-    func analyze(_ map: MapData) {
-        guard !map.analyzed else { return }; map.analyzed = true
+    // dispatch maps for analysis (deferred until needed if approximate CDF is available)
+    func analyze(_ map: MapData, force: Bool = false) {
+        guard !map.analyzed, (map.data.cdf == nil || force) else { return }; map.analyzed = true
         
         let m = map.data, n = Double(m.npix), workload = Int(n*log(1+n))
         scheduled += workload; analysisQueue.async {
-            m.index(); map.ranked = m.ranked()
-            for f in Function.cdf { map.state.bounds[f] = nil }
-            Task { @MainActor in completed += workload; if map == self.data { load(map, force: true) } }
+            let trace = LoadTrace.begin("analyze \(map.name)[\(map.file)]")
+            defer { LoadTrace.end(trace); LoadTrace.report(since: trace) }
+            
+            m.index(); let ranked = m.ranked()
+            if let key = map.cache { mapCache.store(index: m, key) }
+            
+            // exact ranks replace the estimate on main actor, where it is made
+            Task { @MainActor in
+                map.ranked = ranked; map.estimate = nil; for f in Function.cdf { map.state.bounds[f] = nil }
+                completed += workload; if map == self.data { load(map, force: true) }
+            }
         }
     }
     
@@ -474,10 +511,15 @@ struct ContentView: View {
         let transform = transform ?? state.transform
         guard let map = map ?? data, (map.state.transform != transform || force) else { return }
         
+        // exact index is needed for CDF transforms, approximate CDF from load stands in until it is sorted
+        if (Function.cdf.contains(transform.f) && map.ranked == nil) {
+            analyze(map, force: true); if map.estimate == nil, let cdf = map.data.cdf { map.estimate = map.data.ranked(cdf: cdf) }
+        }
+        
         // dispatch data transform
         switch transform.f {
             case .none, .equalize: break
-            case .normalize: if let ranked = map.ranked, let buffer = transformer.apply(map: ranked, transform: transform, recycle: map.buffer) { map.buffer = buffer } else { return }
+            case .normalize: if let ranked = map.ranked ?? map.estimate, let buffer = transformer.apply(map: ranked, transform: transform, recycle: map.buffer) { map.buffer = buffer } else { return }
             default: if let buffer = transformer.apply(map: map.data, transform: transform, recycle: map.buffer) { map.buffer = buffer } else { return }
         }
         
@@ -41,9 +41,11 @@ struct MixerView: View {
     // color primaries
     @AppStorage(Primaries.key) var primaries: Primaries = .defaultValue
     
-    // color mixer and correlator
+    // color mixer
     private let mixer = ColorMixer()
-    private let correlator = Correlator()
+    
+    // correlation in progress (results of superseded ones are dropped)
+    @State private var generation = 0
     
     // disclosure state
     @State private var expanded = (maps: true, decorrelate: true, primaries: false)
@@ -124,15 +126,31 @@ struct MixerView: View {
         .onChange(of: primaries) { value in colorize() }
     }
     
-    // compute average and covariance
+    // compute average and covariance off main actor, a subsampled estimate for quick feedback first
     func correlate(_ x: MapData? = nil, _ y: MapData? = nil, _ z: MapData? = nil) {
-        guard let x = x ?? loaded[id.x], let y = y ?? loaded[id.y], let z = z ?? loaded[id.z],
-              let (avg,cov) = correlator.correlate(x.available, y.available, z.available) else { return }
+        guard let x = x ?? loaded[id.x], let y = y ?? loaded[id.y], let z = z ?? loaded[id.z] else { return }
+        let maps = [x.available, y.available, z.available]; guard let pixels = Correlator.pixels(maps) else { return }
         
-        decorrelate.avg = avg
-        decorrelate.cov = cov
+        generation += 1; let current = generation
+        let strides = (pixels.npix > Self.sampled) ? [pixels.npix/Self.sampled, 1] : [1]
+        
+        Task.detached(priority: .userInitiated) {
+            for stride in strides {
+                guard await MainActor.run(body: { self.generation == current }),
+                      let (avg,cov) = withExtendedLifetime(maps, { Correlator(stride: stride).correlate(maps[0], maps[1], maps[2], pixels: pixels) }) else { return }
+                
+                await MainActor.run {
+                    guard (self.generation == current) else { return }
+                    decorrelate.avg = avg
+                    decorrelate.cov = cov
+                }
+            }
+        }
     }
     
+    // pixels sampled by quick correlation estimate
+    static let sampled = 1<<18
+    
     // render false color map
     func colorize(_ x: MapData? = nil, _ y: MapData? = nil, _ z: MapData? = nil, primaries: Primaries? = nil) {
         guard let x = x ?? loaded[id.x], let y = y ?? loaded[id.y], let z = z ?? loaded[id.z] else { return }
@@ -31,10 +31,12 @@ struct SettingsView: View {
     @AppStorage(TextureFormat.key) var texture = TextureFormat.defaultValue
     @AppStorage(AntiAliasing.key) var aliasing = AntiAliasing.defaultValue
     @AppStorage(ProxySize.key) var proxy = ProxySize.defaultValue
+    @AppStorage(CpuThreads.key) var threads = CpuThreads.defaultValue
+    @AppStorage(CacheSize.key) var cache = CacheSize.defaultValue
     
     // view styling parameters
     private let width: CGFloat = 520
-    private let height: CGFloat = 250
+    private let height: CGFloat = 310
     private let corner: CGFloat = 7
     private let offset: CGFloat = 13
     
@@ -147,16 +149,37 @@ struct SettingsView: View {
                     .stroke(Color.secondary.opacity(0.2), lineWidth: 1)
                 )
                 VStack {
-                    Picker("Proxy map size:", selection: $proxy) {
-                        ForEach(ProxySize.allCases, id: \.self) {
-                            Text($0.rawValue).tag($0)
-                        }
-                    }.frame(width: 190).disabled(true)
+                    HStack {
+                        Picker("Proxy map size:", selection: $proxy) {
+                            ForEach(ProxySize.allCases, id: \.self) {
+                                Text($0.rawValue).tag($0)
+                            }
+                        }.frame(width: 170).disabled(true)
+                        Picker("CPU:", selection: $threads) {
+                            ForEach(CpuThreads.allCases, id: \.self) {
+                                Text($0.rawValue).tag($0)
+                            }
+                        }.frame(width: 170)
+                    }
                     Text("Increase responsiveness of parameter adjustments").font(.footnote)
                 }.padding(corner).frame(width: 380).overlay(
                     RoundedRectangle(cornerRadius: corner)
                     .stroke(Color.secondary.opacity(0.2), lineWidth: 1)
                 )
+                VStack {
+                    HStack {
+                        Picker("Map cache:", selection: $cache) {
+                            ForEach(CacheSize.allCases, id: \.self) {
+                                Text($0.rawValue).tag($0)
+                            }
+                        }.frame(width: 170)
+                        Button("Clear Cache") { mapCache.clear() }.frame(width: 170)
+                    }
+                    Text("Reopen converted maps instantly, evicting least recently used").font(.footnote)
+                }.padding(corner).frame(width: 380).overlay(
+                    RoundedRectangle(cornerRadius: corner)
+                    .stroke(Color.secondary.opacity(0.2), lineWidth: 1)
+                )
             }
             .tabItem { Label("Performance", systemImage: "speedometer") }
         }
@@ -39,6 +39,7 @@ struct Statistics {
 @available(macOS 13.0, *)
 struct StatView: View {
     @Binding var cdf: [Double]?
+    @Binding var moments: Moments?
     @Binding var range: Bounds
     
     // summary statistics from CDF compendium
@@ -60,6 +61,12 @@ struct StatView: View {
             lambda4 += w * ((20.0*(F-1.5)*F + 12.0)*F - 1.0) * x
         }
         
+        // exact moments if accumulated on load
+        if let m = moments {
+            return Statistics(mean: m.mean, sigma: m.sigma, skewness: m.skewness, kurtosis: m.kurtosis,
+                              median: percentile(0.50), scale: lambda2, tau3: lambda3/lambda2, tau4: lambda4/lambda2)
+        }
+        
         // standard deviation
         let sigma = sqrt(mu2 - mu1*mu1)
         